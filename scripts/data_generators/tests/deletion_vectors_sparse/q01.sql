@@ -0,0 +1 @@
+delete from default.deletion_vectors_sparse where col between 10000 and 10099 or col == 77777;
\ No newline at end of file
@@ -0,0 +1,7 @@
+CREATE OR REPLACE TABLE default.rename_column (
+	id INT,
+	name STRING
+)
+TBLPROPERTIES (
+	'format-version'='2'
+);
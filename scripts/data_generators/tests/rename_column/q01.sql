@@ -0,0 +1,3 @@
+INSERT INTO default.rename_column VALUES
+	(1, 'Alice'),
+	(2, 'Bob');
@@ -0,0 +1,2 @@
+ALTER TABLE default.rename_column
+	RENAME COLUMN name TO given_name;
@@ -0,0 +1,2 @@
+INSERT INTO default.rename_column VALUES
+	(3, 'Charlie');
@@ -57,31 +57,87 @@ unique_ptr<IcebergDeletionVector> IcebergDeletionVector::FromBlob(data_ptr_t blo
 	return result_p;
 }
 
-void IcebergMultiFileList::ScanPuffinFile(const IcebergManifestEntry &entry) const {
-	auto file_path = entry.file_path;
-	D_ASSERT(!entry.referenced_data_file.empty());
+void IcebergMultiFileList::ScanPuffinFile(const vector<reference<const IcebergManifestEntry>> &entries) const {
+	D_ASSERT(!entries.empty());
+	auto &file_path = entries[0].get().file_path;
+
+	//! Read the blobs of all the deletion vectors with a single ranged read
+	int64_t range_start = NumericLimits<int64_t>::Maximum();
+	int64_t range_end = 0;
+	for (auto &entry_ref : entries) {
+		auto &entry = entry_ref.get();
+		D_ASSERT(entry.file_path == file_path);
+		D_ASSERT(!entry.referenced_data_file.empty());
+		D_ASSERT(!entry.content_offset.IsNull());
+		D_ASSERT(!entry.content_size_in_bytes.IsNull());
+
+		auto offset = entry.content_offset.GetValue<int64_t>();
+		auto length = entry.content_size_in_bytes.GetValue<int64_t>();
+		range_start = MinValue(range_start, offset);
+		range_end = MaxValue(range_end, offset + length);
+	}
 
 	auto caching_file_system = CachingFileSystem::Get(context);
 
 	auto caching_file_handle = caching_file_system.OpenFile(file_path, FileOpenFlags::FILE_FLAGS_READ);
 	data_ptr_t data = nullptr;
 
-	D_ASSERT(!entry.content_offset.IsNull());
-	D_ASSERT(!entry.content_size_in_bytes.IsNull());
+	auto buf_handle = caching_file_handle->Read(data, NumericCast<idx_t>(range_end - range_start),
+	                                            NumericCast<idx_t>(range_start));
+	auto buffer_data = buf_handle.Ptr();
 
-	auto offset = entry.content_offset.GetValue<int64_t>();
-	auto length = entry.content_size_in_bytes.GetValue<int64_t>();
+	vector<unique_ptr<IcebergDeletionVector>> deletion_vectors;
+	for (auto &entry_ref : entries) {
+		auto &entry = entry_ref.get();
+		auto offset = entry.content_offset.GetValue<int64_t>();
+		auto length = entry.content_size_in_bytes.GetValue<int64_t>();
+		deletion_vectors.push_back(
+		    IcebergDeletionVector::FromBlob(buffer_data + (offset - range_start), NumericCast<idx_t>(length)));
+	}
 
-	auto buf_handle = caching_file_handle->Read(data, length, offset);
-	auto buffer_data = buf_handle.Ptr();
+	lock_guard<mutex> guard(delete_lock);
+	for (idx_t i = 0; i < entries.size(); i++) {
+		deletion_vector_data.emplace(entries[i].get().referenced_data_file, std::move(deletion_vectors[i]));
+	}
+}
 
-	positional_delete_data.emplace(entry.referenced_data_file, IcebergDeletionVector::FromBlob(buffer_data, length));
+//! The end of the window of rows starting at 'offset' that share the high bits of their position
+static idx_t WindowEnd(row_t start_row_index, idx_t count, idx_t offset) {
+	const row_t current_row = start_row_index + offset;
+	const row_t next_high_boundary = ((current_row >> 32) + 1) << 32;
+	//! FIXME: How do we test this? These offsets are **huge**
+	return MinValue<idx_t>(start_row_index + count, next_high_boundary) - start_row_index;
 }
 
-idx_t IcebergDeletionVector::Filter(row_t start_row_index, idx_t count, SelectionVector &result_sel) {
+//! Whether any row in [start_row_index, start_row_index + count) is set in 'bitmaps'
+static bool HasDeletedRows(const unordered_map<int32_t, roaring::Roaring> &bitmaps, row_t start_row_index,
+                           idx_t count) {
+	for (idx_t offset = 0; offset < count; offset = WindowEnd(start_row_index, count, offset)) {
+		const row_t current_row = start_row_index + offset;
+		auto it = bitmaps.find(static_cast<int32_t>(current_row >> 32));
+		if (it == bitmaps.end()) {
+			continue;
+		}
+		auto &bitmap = it->second;
+		const auto last_row = start_row_index + WindowEnd(start_row_index, count, offset) - 1;
+		auto bit = bitmap.begin();
+		bit.move_equalorlarger(static_cast<uint32_t>(current_row & 0xFFFFFFFF));
+		if (bit != bitmap.end() && *bit <= static_cast<uint32_t>(last_row & 0xFFFFFFFF)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+idx_t IcebergDeletionVector::FilterBitmaps(const unordered_map<int32_t, roaring::Roaring> &bitmaps,
+                                           row_t start_row_index, idx_t count, SelectionVector &result_sel) {
 	if (count == 0) {
 		return 0;
 	}
+	//! Most vectors have no deleted rows: all of them are selected then, without filling 'result_sel'
+	if (!HasDeletedRows(bitmaps, start_row_index, count)) {
+		return count;
+	}
 	result_sel.Initialize(STANDARD_VECTOR_SIZE);
 	idx_t selection_idx = 0;
 
@@ -89,40 +145,35 @@ idx_t IcebergDeletionVector::Filter(row_t start_row_index, idx_t count, Selectio
 	while (offset < count) {
 		const row_t current_row = start_row_index + offset;
 		const int32_t high = static_cast<int32_t>(current_row >> 32);
-
-		const row_t next_high_boundary = ((static_cast<row_t>(high) + 1) << 32);
-		//! FIXME: How do we test this? These offsets are **huge**
-		const idx_t next_offset = MinValue<idx_t>(start_row_index + count, next_high_boundary) - start_row_index;
-
-		//! Update the state
-		if (!has_current_high || current_high != high) {
-			auto it = bitmaps.find(high);
-			if (it == bitmaps.end()) {
-				current_bitmap = nullptr;
-			} else {
-				current_bitmap = it->second;
-				bulk_context = roaring::BulkContext();
+		const row_t high_start = static_cast<row_t>(high) << 32;
+		const idx_t next_offset = WindowEnd(start_row_index, count, offset);
+
+		auto it = bitmaps.find(high);
+		if (it != bitmaps.end()) {
+			//! Walk the set bits from the first one inside [offset, next_offset), selecting the rows in the gaps
+			//! between them
+			auto &bitmap = it->second;
+			const auto last_low = static_cast<uint32_t>((start_row_index + next_offset - 1) & 0xFFFFFFFF);
+			auto bit = bitmap.begin();
+			bit.move_equalorlarger(static_cast<uint32_t>(current_row & 0xFFFFFFFF));
+			for (; bit != bitmap.end() && *bit <= last_low; ++bit) {
+				const auto deleted_offset = static_cast<idx_t>(high_start + *bit - start_row_index);
+				for (; offset < deleted_offset; offset++) {
+					result_sel.set_index(selection_idx++, offset);
+				}
+				offset++;
 			}
-			current_high = high;
-			has_current_high = true;
 		}
-
-		if (!current_bitmap) {
-			for (idx_t i = offset; i < next_offset; ++i) {
-				result_sel.set_index(selection_idx++, i);
-			}
-		} else {
-			const roaring::Roaring &bitmap = *current_bitmap;
-			for (idx_t i = offset; i < next_offset; ++i) {
-				uint32_t low_bits = static_cast<uint32_t>((start_row_index + i) & 0xFFFFFFFF);
-				const bool is_deleted = bitmap.containsBulk(bulk_context, low_bits);
-				result_sel.set_index(selection_idx, i);
-				selection_idx += !is_deleted;
-			}
+		//! No (more) deleted rows in this range
+		for (; offset < next_offset; offset++) {
+			result_sel.set_index(selection_idx++, offset);
 		}
-		offset = next_offset;
 	}
 	return selection_idx;
 }
 
+idx_t IcebergDeletionVector::Filter(row_t start_row_index, idx_t count, SelectionVector &result_sel) {
+	return FilterBitmaps(bitmaps, start_row_index, count, result_sel);
+}
+
 } // namespace duckdb
@@ -1,26 +1,70 @@
 #include "deletes/equality_delete.hpp"
 #include "iceberg_multi_file_list.hpp"
 
-#include "duckdb/planner/expression/bound_comparison_expression.hpp"
-#include "duckdb/planner/expression/bound_constant_expression.hpp"
-#include "duckdb/planner/expression/bound_operator_expression.hpp"
-#include "duckdb/planner/expression/bound_reference_expression.hpp"
-#include "duckdb/planner/expression/bound_conjunction_expression.hpp"
+#include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/function/create_sort_key.hpp"
 
 namespace duckdb {
 
-static void InitializeFromOtherChunk(DataChunk &target, DataChunk &other, const vector<column_t> &column_ids) {
-	vector<LogicalType> types;
-	for (auto &id : column_ids) {
-		types.push_back(other.data[id].GetType());
+void IcebergEqualityDeleteSet::CreateSortKeys(Vector keys[], idx_t count, Vector &sort_keys) const {
+	DataChunk key_chunk;
+	key_chunk.InitializeEmpty(types);
+	for (idx_t col_idx = 0; col_idx < types.size(); col_idx++) {
+		key_chunk.data[col_idx].Reference(keys[col_idx]);
 	}
-	target.InitializeEmpty(types);
+	key_chunk.SetCardinality(count);
+	vector<OrderModifiers> modifiers(types.size(), OrderModifiers(OrderType::ASCENDING, OrderByNullType::NULLS_LAST));
+	CreateSortKeyHelpers::CreateSortKey(key_chunk, modifiers, sort_keys);
+	sort_keys.Flatten(count);
+}
+
+void IcebergEqualityDeleteSet::AddKey(const string_t &key, sequence_number_t sequence_number) {
+	auto it = sequence_numbers.find(key);
+	if (it != sequence_numbers.end()) {
+		it->second = MaxValue(it->second, sequence_number);
+		return;
+	}
+	sequence_numbers.emplace(key_data.AddBlob(key), sequence_number);
+}
+
+void IcebergEqualityDeleteSet::Add(Vector keys[], idx_t count, sequence_number_t sequence_number) {
+	Vector sort_keys(LogicalType::BLOB, count);
+	CreateSortKeys(keys, count, sort_keys);
+	auto sort_key_data = FlatVector::GetData<string_t>(sort_keys);
+	for (idx_t i = 0; i < count; i++) {
+		AddKey(sort_key_data[i], sequence_number);
+	}
+}
+
+void IcebergEqualityDeleteSet::Merge(const IcebergEqualityDeleteSet &other) {
+	D_ASSERT(other.equality_ids == equality_ids);
+	for (auto &entry : other.sequence_numbers) {
+		AddKey(entry.first, entry.second);
+	}
+}
+
+idx_t IcebergEqualityDeleteSet::Filter(Vector keys[], idx_t count, sequence_number_t sequence_number,
+                                       SelectionVector &result_sel) const {
+	//! The key columns of the whole chunk are normalized at once, every row is then a single lookup
+	Vector sort_keys(LogicalType::BLOB, count);
+	CreateSortKeys(keys, count, sort_keys);
+	auto sort_key_data = FlatVector::GetData<string_t>(sort_keys);
+
+	idx_t selection_idx = 0;
+	for (idx_t i = 0; i < count; i++) {
+		auto it = sequence_numbers.find(sort_key_data[i]);
+		bool is_deleted = it != sequence_numbers.end() && it->second > sequence_number;
+		result_sel.set_index(selection_idx, i);
+		selection_idx += !is_deleted;
+	}
+	return selection_idx;
 }
 
 void IcebergMultiFileList::ScanEqualityDeleteFile(const IcebergManifestEntry &entry, DataChunk &result_p,
                                                   vector<MultiFileColumnDefinition> &local_columns,
                                                   const vector<MultiFileColumnDefinition> &global_columns,
-                                                  const vector<ColumnIndex> &column_indexes) const {
+                                                  const vector<ColumnIndex> &column_indexes,
+                                                  unique_ptr<IcebergEqualityDeleteSet> &deletes) const {
 	D_ASSERT(!entry.equality_ids.empty());
 	D_ASSERT(result_p.ColumnCount() == local_columns.size());
 
@@ -38,21 +82,11 @@ void IcebergMultiFileList::ScanEqualityDeleteFile(const IcebergManifestEntry &en
 	}
 
 	vector<column_t> column_ids;
-	DataChunk result;
 	for (auto id : entry.equality_ids) {
 		D_ASSERT(id_to_column.count(id));
 		column_ids.push_back(id_to_column[id]);
 	}
 
-	//! Get or create the equality delete data for this sequence number
-	auto it = equality_delete_data.find(entry.sequence_number);
-	if (it == equality_delete_data.end()) {
-		it = equality_delete_data
-		         .emplace(entry.sequence_number, make_uniq<IcebergEqualityDeleteData>(entry.sequence_number))
-		         .first;
-	}
-	auto &deletes = *it->second;
-
 	//! Map from column_id to 'global_columns' index, so we can create a reference to the correct global index
 	unordered_map<int32_t, column_t> id_to_global_column;
 	for (column_t i = 0; i < global_columns.size(); i++) {
@@ -71,45 +105,35 @@ void IcebergMultiFileList::ScanEqualityDeleteFile(const IcebergManifestEntry &en
 		global_id_to_result_id[global_id] = i;
 	}
 
-	//! Take only the relevant columns from the result
-	InitializeFromOtherChunk(result, result_p, column_ids);
-	result.ReferenceColumns(result_p, column_ids);
-	deletes.files.emplace_back(entry.partition_values, entry.partition_spec_id);
-	auto &rows = deletes.files.back().rows;
-	rows.resize(count);
-	D_ASSERT(result.ColumnCount() == entry.equality_ids.size());
-	for (idx_t col_idx = 0; col_idx < result.ColumnCount(); col_idx++) {
-		auto &field_id = entry.equality_ids[col_idx];
-		auto global_column_id = id_to_global_column[field_id];
-		auto &col = global_columns[global_column_id];
-		auto &vec = result.data[col_idx];
-
-		auto it = global_id_to_result_id.find(global_column_id);
-		if (it == global_id_to_result_id.end()) {
-			throw NotImplementedException("Equality deletes need the relevant columns to be selected");
-		}
-		global_column_id = it->second;
-
-		for (idx_t i = 0; i < count; i++) {
-			auto &row = rows[i];
-			auto constant = vec.GetValue(i);
-			unique_ptr<Expression> equality_filter;
-			auto bound_ref = make_uniq<BoundReferenceExpression>(col.type, global_column_id);
-			if (!constant.IsNull()) {
-				//! Create a COMPARE_NOT_EQUAL expression
-				equality_filter =
-				    make_uniq<BoundComparisonExpression>(ExpressionType::COMPARE_NOTEQUAL, std::move(bound_ref),
-				                                         make_uniq<BoundConstantExpression>(constant));
-			} else {
-				//! Construct an OPERATOR_IS_NOT_NULL expression instead
-				auto is_not_null =
-				    make_uniq<BoundOperatorExpression>(ExpressionType::OPERATOR_IS_NOT_NULL, LogicalType::BOOLEAN);
-				is_not_null->children.push_back(std::move(bound_ref));
-				equality_filter = std::move(is_not_null);
+	if (!deletes) {
+		vector<LogicalType> types;
+		vector<idx_t> result_columns;
+		for (auto &field_id : entry.equality_ids) {
+			auto global_column_id = id_to_global_column[field_id];
+			auto it = global_id_to_result_id.find(global_column_id);
+			if (it == global_id_to_result_id.end()) {
+				throw NotImplementedException("Equality deletes need the relevant columns to be selected");
 			}
-			row.filters.emplace(std::make_pair(field_id, std::move(equality_filter)));
+			types.push_back(global_columns[global_column_id].type);
+			result_columns.push_back(it->second);
+		}
+		deletes = make_uniq<IcebergEqualityDeleteSet>(entry.equality_ids, std::move(types), std::move(result_columns));
+	}
+
+	//! Take only the relevant columns from the result, cast to the types of the columns in the scan
+	vector<Vector> keys;
+	keys.reserve(column_ids.size());
+	for (idx_t col_idx = 0; col_idx < column_ids.size(); col_idx++) {
+		auto &vec = result_p.data[column_ids[col_idx]];
+		auto &type = deletes->types[col_idx];
+		if (vec.GetType() == type) {
+			keys.emplace_back(vec);
+		} else {
+			keys.emplace_back(type);
+			VectorOperations::DefaultCast(vec, keys.back(), count);
 		}
 	}
+	deletes->Add(keys.data(), count, entry.sequence_number);
 }
 
 } // namespace duckdb
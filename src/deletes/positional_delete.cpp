@@ -1,41 +1,65 @@
 #include "deletes/positional_delete.hpp"
+#include "deletes/deletion_vector.hpp"
 #include "iceberg_multi_file_list.hpp"
 
 namespace duckdb {
 
-void IcebergMultiFileList::ScanPositionalDeleteFile(DataChunk &result) const {
+void IcebergPositionalDeleteData::AddRows(const int64_t *row_ids, idx_t count) {
+	D_ASSERT(count <= STANDARD_VECTOR_SIZE);
+	uint32_t low_bits[STANDARD_VECTOR_SIZE];
+	idx_t i = 0;
+	while (i < count) {
+		//! Positions are sorted within a data file, so they are added to the bitmap of their high bits in batches
+		const int32_t high = static_cast<int32_t>(row_ids[i] >> 32);
+		idx_t batch_size = 0;
+		for (; i < count && static_cast<int32_t>(row_ids[i] >> 32) == high; i++) {
+			low_bits[batch_size++] = static_cast<uint32_t>(row_ids[i] & 0xFFFFFFFF);
+		}
+		bitmaps[high].addMany(batch_size, low_bits);
+	}
+}
+
+void IcebergPositionalDeleteData::Merge(const IcebergPositionalDeleteData &other) {
+	for (auto &entry : other.bitmaps) {
+		bitmaps[entry.first] |= entry.second;
+	}
+}
+
+void IcebergPositionalDeleteData::Finalize() {
+	for (auto &entry : bitmaps) {
+		entry.second.runOptimize();
+		entry.second.shrinkToFit();
+	}
+}
+
+idx_t IcebergPositionalDeleteData::Filter(row_t start_row_index, idx_t count, SelectionVector &result_sel) {
+	return IcebergDeletionVector::FilterBitmaps(bitmaps, start_row_index, count, result_sel);
+}
+
+void IcebergMultiFileList::ScanPositionalDeleteFile(
+    DataChunk &result, case_insensitive_map_t<unique_ptr<IcebergPositionalDeleteData>> &positional_deletes) const {
 	//! FIXME: might want to check the 'columns' of the 'reader' to check, field-ids are:
 	auto names = FlatVector::GetData<string_t>(result.data[0]);  //! 2147483546
 	auto row_ids = FlatVector::GetData<int64_t>(result.data[1]); //! 2147483545
 
 	auto count = result.size();
-	if (count == 0) {
-		return;
-	}
-	reference<string_t> current_file_path = names[0];
-
-	auto initial_key = current_file_path.get().GetString();
-	auto it = positional_delete_data.find(initial_key);
-	if (it == positional_delete_data.end()) {
-		it = positional_delete_data.emplace(initial_key, make_uniq<IcebergPositionalDeleteData>()).first;
-	}
-	reference<IcebergPositionalDeleteData> deletes = reinterpret_cast<IcebergPositionalDeleteData &>(*it->second);
-
-	for (idx_t i = 0; i < count; i++) {
-		auto &name = names[i];
-		auto &row_id = row_ids[i];
-
-		if (name != current_file_path.get()) {
-			current_file_path = name;
-			auto key = current_file_path.get().GetString();
-			auto it = positional_delete_data.find(key);
-			if (it == positional_delete_data.end()) {
-				it = positional_delete_data.emplace(key, make_uniq<IcebergPositionalDeleteData>()).first;
-			}
-			deletes = reinterpret_cast<IcebergPositionalDeleteData &>(*it->second);
+	//! Position delete files are sorted by 'file_path', so the deletes of a data file are a run of rows, which is added
+	//! at once
+	idx_t run_start = 0;
+	while (run_start < count) {
+		auto &name = names[run_start];
+		idx_t run_end = run_start + 1;
+		while (run_end < count && names[run_end] == name) {
+			run_end++;
 		}
 
-		deletes.get().AddRow(row_id);
+		auto key = name.GetString();
+		auto it = positional_deletes.find(key);
+		if (it == positional_deletes.end()) {
+			it = positional_deletes.emplace(key, make_uniq<IcebergPositionalDeleteData>()).first;
+		}
+		it->second->AddRows(row_ids + run_start, run_end - run_start);
+		run_start = run_end;
 	}
 }
 
@@ -15,6 +15,7 @@ vector<TableFunctionSet> IcebergFunctions::GetTableFunctions(ExtensionLoader &lo
 	functions.push_back(std::move(GetIcebergScanFunction(loader)));
 	functions.push_back(std::move(GetIcebergMetadataFunction()));
 	functions.push_back(std::move(GetIcebergToDuckLakeFunction()));
+	functions.push_back(std::move(GetIcebergToPaimonFunction()));
 
 	return functions;
 }
@@ -7,6 +7,8 @@
 #include "duckdb/catalog/catalog_entry/table_function_catalog_entry.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/execution/execution_context.hpp"
+#include "duckdb/parallel/task_executor.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 #include "duckdb/parallel/thread_context.hpp"
 #include "duckdb/parser/tableref/table_function_ref.hpp"
 #include "duckdb/parser/expression/constant_expression.hpp"
@@ -23,6 +25,18 @@ IcebergMultiFileList::IcebergMultiFileList(ClientContext &context_p, shared_ptr<
       fs(FileSystem::GetFileSystem(context)), scan_info(scan_info), path(path), lock(), options(options) {
 }
 
+IcebergMultiFileList::~IcebergMultiFileList() {
+	if (!manifest_executor) {
+		return;
+	}
+	//! Wait for the background manifest reads, the ones that didn't start yet are skipped
+	cancelled = true;
+	try {
+		manifest_executor->WorkOnTasks();
+	} catch (...) { // NOLINT
+	}
+}
+
 string IcebergMultiFileList::ToDuckDBPath(const string &raw_path) {
 	return raw_path;
 }
@@ -179,7 +193,7 @@ unique_ptr<MultiFileList> IcebergMultiFileList::ComplexFilterPushdown(ClientCont
 vector<OpenFileInfo> IcebergMultiFileList::GetAllFiles() {
 	vector<OpenFileInfo> file_list;
 	//! Lock is required because it reads the 'data_files' vector
-	lock_guard<mutex> guard(lock);
+	std::unique_lock<mutex> guard(lock);
 	for (idx_t i = 0; i < data_files.size(); i++) {
 		file_list.push_back(GetFileInternal(i, guard));
 	}
@@ -188,7 +202,7 @@ vector<OpenFileInfo> IcebergMultiFileList::GetAllFiles() {
 
 FileExpandResult IcebergMultiFileList::GetExpandResult() {
 	// GetFileInternal(1) will ensure files with index 0 and index 1 are expanded if they are available
-	lock_guard<mutex> guard(lock);
+	std::unique_lock<mutex> guard(lock);
 	GetFileInternal(1, guard);
 
 	if (data_files.size() > 1) {
@@ -201,9 +215,9 @@ FileExpandResult IcebergMultiFileList::GetExpandResult() {
 }
 
 idx_t IcebergMultiFileList::GetTotalFileCount() {
-	// FIXME: the 'added_files_count' + the 'existing_files_count'
-	// in the Manifest List should give us this information without scanning the manifest list
-	lock_guard<mutex> guard(lock);
+	//! NOTE: this enumerates every data file of every manifest, to apply the filters on the data files.
+	//! Estimates should use the counts of the manifest list instead, see GetCardinality.
+	std::unique_lock<mutex> guard(lock);
 
 	idx_t i = data_files.size();
 	while (!GetFileInternal(i, guard).path.empty()) {
@@ -213,24 +227,35 @@ idx_t IcebergMultiFileList::GetTotalFileCount() {
 }
 
 unique_ptr<NodeStatistics> IcebergMultiFileList::GetCardinality(ClientContext &context) {
-	idx_t cardinality = 0;
-
-	if (GetMetadata().iceberg_version == 1) {
-		//! We collect no cardinality information from manifests for V1 tables.
-		return nullptr;
+	std::unique_lock<mutex> guard(lock);
+	if (!initialized) {
+		InitializeFiles(guard);
 	}
 
-	//! Make sure we have fetched all manifests
-	(void)GetTotalFileCount();
-
+	//! The manifest list has the row counts of every manifest, the manifests themselves are not read
+	idx_t cardinality = 0;
 	for (idx_t i = 0; i < data_manifests.size(); i++) {
 		cardinality += data_manifests[i].added_rows_count;
 		cardinality += data_manifests[i].existing_rows_count;
 	}
+	for (auto &manifest_file : transaction_data_manifests) {
+		for (auto &data_file : manifest_file.get().data_files) {
+			cardinality += NumericCast<idx_t>(data_file.record_count);
+		}
+	}
+	idx_t deleted_rows = 0;
 	for (idx_t i = 0; i < delete_manifests.size(); i++) {
-		cardinality -= delete_manifests[i].added_rows_count;
+		deleted_rows += delete_manifests[i].added_rows_count;
+		deleted_rows += delete_manifests[i].existing_rows_count;
 	}
-	return make_uniq<NodeStatistics>(cardinality, cardinality);
+
+	if (GetMetadata().iceberg_version == 1 && cardinality == 0) {
+		//! The counts are optional in V1 manifest lists, and are not read
+		return nullptr;
+	}
+	//! Equality deletes don't necessarily match a row, so the deletes only lower the estimate
+	auto estimate = cardinality - MinValue(cardinality, deleted_rows);
+	return make_uniq<NodeStatistics>(estimate, cardinality);
 }
 
 IcebergPredicateStats IcebergPredicateStats::DeserializeBounds(const Value &lower_bound, const Value &upper_bound,
@@ -265,92 +290,151 @@ IcebergPredicateStats IcebergPredicateStats::DeserializeBounds(const Value &lowe
 	return res;
 }
 
-bool IcebergMultiFileList::FileMatchesFilter(const IcebergManifestEntry &file) {
-	D_ASSERT(!table_filters.filters.empty());
+bool IcebergMultiFileList::FileMatchesFilter(const IcebergManifestEntry &file) const {
+	return data_file_program.MatchesDataFile(file);
+}
 
-	auto &filters = table_filters.filters;
-	auto &schema = GetSchema().columns;
+namespace {
 
-	for (idx_t index = 0; index < schema.size(); index++) {
-		auto &column = *schema[index];
-		auto it = filters.find(index);
+class IcebergManifestReadTask : public BaseExecutorTask {
+public:
+	IcebergManifestReadTask(TaskExecutor &executor, IcebergMultiFileList &file_list, idx_t manifest_idx)
+	    : BaseExecutorTask(executor), file_list(file_list), manifest_idx(manifest_idx) {
+	}
+
+	void ExecuteTask() override {
+		file_list.TryReadDataManifest(manifest_idx);
+	}
+
+private:
+	IcebergMultiFileList &file_list;
+	idx_t manifest_idx;
+};
+
+} // namespace
 
-		if (it == filters.end()) {
+void IcebergMultiFileList::FilterDataFiles(vector<IcebergManifestEntry> &entries) {
+	idx_t count = 0;
+	for (idx_t i = 0; i < entries.size(); i++) {
+		auto &data_file = entries[i];
+
+		// Check whether current data file is filtered out.
+		if (!data_file_program.IsEmpty() && !FileMatchesFilter(data_file)) {
+			DUCKDB_LOG(context, IcebergLogType, "Iceberg Filter Pushdown, skipped 'data_file': '%s'",
+			           data_file.file_path);
+			//! Skip this file
 			continue;
 		}
-		if (file.lower_bounds.empty() || file.upper_bounds.empty()) {
-			//! There are no bounds statistics for the file, can't filter
+
+		// Check whether current data file belongs to an unknown puffin file, skip if so.
+		if (StringUtil::CIEquals(data_file.file_format, "puffin")) {
+			//! Skip this file
 			continue;
 		}
 
-		auto &column_id = column.id;
-		auto lower_bound_it = file.lower_bounds.find(column_id);
-		auto upper_bound_it = file.upper_bounds.find(column_id);
-		Value lower_bound;
-		Value upper_bound;
-		if (lower_bound_it != file.lower_bounds.end()) {
-			lower_bound = lower_bound_it->second;
-		}
-		if (upper_bound_it != file.upper_bounds.end()) {
-			upper_bound = upper_bound_it->second;
+		if (count != i) {
+			entries[count] = std::move(data_file);
 		}
+		count++;
+	}
+	entries.erase(entries.begin() + NumericCast<int64_t>(count), entries.end());
+}
 
-		auto stats = IcebergPredicateStats::DeserializeBounds(lower_bound, upper_bound, column.name, column.type);
+bool IcebergMultiFileList::TryReadDataManifest(idx_t manifest_idx) {
+	auto &slot = *data_manifest_slots[manifest_idx];
+	auto expected = IcebergManifestSlotState::PENDING;
+	if (!slot.state.compare_exchange_strong(expected, IcebergManifestSlotState::CLAIMED)) {
+		//! Another thread is decoding (or has decoded) this manifest
+		return false;
+	}
 
-		int64_t value_count = 0;
-		auto value_counts_it = file.value_counts.find(column_id);
-		if (value_counts_it != file.value_counts.end()) {
-			value_count = value_counts_it->second;
-		}
+	if (!cancelled) {
+		try {
+			auto &manifest = data_manifests[manifest_idx];
+			auto full_path = options.allow_moved_paths ? IcebergUtils::GetFullPath(path, manifest.manifest_path, fs)
+			                                           : manifest.manifest_path;
+			auto scan = make_uniq<AvroScan>("IcebergManifest", context, full_path);
 
-		auto null_counts_it = file.null_value_counts.find(column_id);
-		if (null_counts_it != file.null_value_counts.end()) {
-			auto &null_counts = null_counts_it->second;
-			stats.has_null = null_counts != 0;
-			stats.has_not_null = (value_count - null_counts) > 0;
-		} else {
-			stats.has_not_null = value_count > 0;
-		}
+			manifest_file::ManifestFileReader manifest_reader(GetMetadata().iceberg_version);
+			manifest_reader.Initialize(std::move(scan));
+			manifest_reader.SetSequenceNumber(manifest.sequence_number);
+			manifest_reader.SetPartitionSpecID(manifest.partition_spec_id);
 
-		auto nan_counts_it = file.nan_value_counts.find(column_id);
-		if (nan_counts_it != file.nan_value_counts.end()) {
-			auto &nan_counts = nan_counts_it->second;
-			stats.has_nan = nan_counts != 0;
+			while (!manifest_reader.Finished()) {
+				manifest_reader.Read(STANDARD_VECTOR_SIZE, slot.entries);
+			}
+			FilterDataFiles(slot.entries);
+		} catch (std::exception &ex) {
+			slot.error = ErrorData(ex);
 		}
+	}
 
-		auto &filter = *it->second;
-		if (!IcebergPredicate::MatchBounds(filter, stats, IcebergTransform::Identity())) {
-			//! If any predicate fails, exclude the file
-			return false;
-		}
+	{
+		lock_guard<mutex> guard(manifest_lock);
+		slot.state = IcebergManifestSlotState::READY;
 	}
+	manifest_cv.notify_all();
 	return true;
 }
 
-optional_ptr<const IcebergManifestEntry> IcebergMultiFileList::GetDataFile(idx_t file_id, lock_guard<mutex> &guard) {
+void IcebergMultiFileList::ScheduleDataManifestReads(std::unique_lock<mutex> &guard) {
+	if (!manifest_executor) {
+		//! Two manifests per thread are decoded ahead of the scan, so threads that finish a manifest find the next
+		//! one ready while the scan consumes the previous ones
+		auto thread_count = NumericCast<idx_t>(TaskScheduler::GetScheduler(context).NumberOfThreads());
+		prefetch_manifests = MaxValue<idx_t>(thread_count, 1) * 2;
+		manifest_executor = make_uniq<TaskExecutor>(context);
+		for (idx_t i = 0; i < data_manifests.size(); i++) {
+			data_manifest_slots.push_back(make_uniq<IcebergManifestSlot>());
+		}
+	}
+	auto end = MinValue<idx_t>(next_data_manifest + prefetch_manifests, data_manifests.size());
+	for (; scheduled_data_manifests < end; scheduled_data_manifests++) {
+		manifest_executor->ScheduleTask(
+		    make_uniq<IcebergManifestReadTask>(*manifest_executor, *this, scheduled_data_manifests));
+	}
+}
+
+IcebergManifestSlot &IcebergMultiFileList::WaitForDataManifest(idx_t manifest_idx) {
+	auto &slot = *data_manifest_slots[manifest_idx];
+	if (slot.state.load() != IcebergManifestSlotState::READY && !TryReadDataManifest(manifest_idx)) {
+		//! A background task is decoding the manifest, wait for it
+		std::unique_lock<mutex> guard(manifest_lock);
+		manifest_cv.wait(guard, [&]() { return slot.state.load() == IcebergManifestSlotState::READY; });
+	}
+	if (slot.error.HasError()) {
+		slot.error.Throw();
+	}
+	return slot;
+}
+
+optional_ptr<const IcebergManifestEntry> IcebergMultiFileList::GetDataFile(idx_t file_id,
+                                                                          std::unique_lock<mutex> &guard) {
 	if (file_id < data_files.size()) {
 		//! Have we already scanned this data file and returned it? If so, return it
 		return data_files[file_id];
 	}
 
 	while (file_id >= data_files.size()) {
-		if (current_data_files.empty() || data_file_idx >= current_data_files.size()) {
+		if (data_file_idx >= current_data_files.size()) {
 			current_data_files.clear();
-			//! Load the next manifest file
-			if (current_data_manifest != data_manifests.end()) {
-				auto &manifest = *current_data_manifest;
-				auto full_path = options.allow_moved_paths ? IcebergUtils::GetFullPath(path, manifest.manifest_path, fs)
-				                                           : manifest.manifest_path;
-				auto scan = make_uniq<AvroScan>("IcebergManifest", context, full_path);
-
-				data_manifest_reader->Initialize(std::move(scan));
-				data_manifest_reader->SetSequenceNumber(manifest.sequence_number);
-				data_manifest_reader->SetPartitionSpecID(manifest.partition_spec_id);
-
-				while (!data_manifest_reader->Finished()) {
-					data_manifest_reader->Read(STANDARD_VECTOR_SIZE, current_data_files);
+			data_file_idx = 0;
+			//! Take the entries of the next manifest file, which have already been decoded and filtered
+			if (next_data_manifest < data_manifests.size()) {
+				ScheduleDataManifestReads(guard);
+				//! The manifest is decoded (or waited on) without holding the list lock, so other scan threads can
+				//! take the data files that are already expanded in the meantime
+				auto manifest_idx = next_data_manifest;
+				guard.unlock();
+				auto &slot = WaitForDataManifest(manifest_idx);
+				guard.lock();
+				if (next_data_manifest != manifest_idx || data_file_idx < current_data_files.size()) {
+					//! Another thread consumed this manifest while the lock was released, check 'data_files' again
+					continue;
 				}
-				current_data_manifest++;
+				current_data_files = std::move(slot.entries);
+				next_data_manifest++;
+				ScheduleDataManifestReads(guard);
 			} else if (!transaction_data_manifests.empty()) {
 				if (transaction_data_idx >= transaction_data_manifests.size()) {
 					//! Exhausted all the transaction-local data
@@ -359,48 +443,23 @@ optional_ptr<const IcebergManifestEntry> IcebergMultiFileList::GetDataFile(idx_t
 				auto &manifest_file = transaction_data_manifests[transaction_data_idx].get();
 				auto &data_files = manifest_file.data_files;
 				current_data_files.insert(current_data_files.end(), data_files.begin(), data_files.end());
+				FilterDataFiles(current_data_files);
 				transaction_data_idx++;
 			} else {
 				//! No more data manifests to explore
 				return nullptr;
 			}
-
-			data_file_idx = 0;
-		}
-
-		optional_ptr<const IcebergManifestEntry> result;
-		while (data_file_idx < current_data_files.size()) {
-			auto &data_file = current_data_files[data_file_idx];
-			data_file_idx++;
-
-			// Check whether current data file is filtered out.
-			if (!table_filters.filters.empty() && !FileMatchesFilter(data_file)) {
-				DUCKDB_LOG(context, IcebergLogType, "Iceberg Filter Pushdown, skipped 'data_file': '%s'",
-				           data_file.file_path);
-				//! Skip this file
-				continue;
-			}
-
-			// Check whether current data file belongs to an unknown puffin file, skip if so.
-			if (StringUtil::CIEquals(data_file.file_format, "puffin")) {
-				//! Skip this file
-				continue;
-			}
-
-			result = data_file;
-			break;
-		}
-		if (!result) {
 			continue;
 		}
 
-		data_files.push_back(*result);
+		data_files.push_back(std::move(current_data_files[data_file_idx]));
+		data_file_idx++;
 	}
 
 	return data_files[file_id];
 }
 
-OpenFileInfo IcebergMultiFileList::GetFileInternal(idx_t file_id, lock_guard<mutex> &guard) {
+OpenFileInfo IcebergMultiFileList::GetFileInternal(idx_t file_id, std::unique_lock<mutex> &guard) {
 	if (!initialized) {
 		InitializeFiles(guard);
 	}
@@ -437,7 +496,7 @@ OpenFileInfo IcebergMultiFileList::GetFileInternal(idx_t file_id, lock_guard<mut
 }
 
 OpenFileInfo IcebergMultiFileList::GetFile(idx_t file_id) {
-	lock_guard<mutex> guard(lock);
+	std::unique_lock<mutex> guard(lock);
 	return GetFileInternal(file_id, guard);
 }
 
@@ -497,14 +556,21 @@ bool IcebergMultiFileList::ManifestMatchesFilter(const IcebergManifest &manifest
 		return true;
 	}
 
+	auto program_it = partition_programs.find(spec_id);
+	if (program_it == partition_programs.end()) {
+		program_it = partition_programs.emplace(spec_id, CompilePartitionProgram(partition_spec)).first;
+	}
+	return program_it->second.MatchesPartitions(field_summaries);
+}
+
+IcebergPruningProgram IcebergMultiFileList::CompilePartitionProgram(const IcebergPartitionSpec &partition_spec) {
+	IcebergPruningProgram program;
 	auto &schema = GetSchema().columns;
 	unordered_map<uint64_t, ColumnIndex> source_to_column_id;
 	IcebergTableSchema::PopulateSourceIdMap(source_to_column_id, schema, nullptr);
 
-	for (idx_t i = 0; i < field_summaries.size(); i++) {
-		auto &field_summary = field_summaries[i];
+	for (idx_t i = 0; i < partition_spec.fields.size(); i++) {
 		auto &field = partition_spec.fields[i];
-
 		const auto &column_id = source_to_column_id.at(field.source_id);
 
 		// Find if we have a filter for this source column
@@ -514,25 +580,34 @@ bool IcebergMultiFileList::ManifestMatchesFilter(const IcebergManifest &manifest
 		}
 
 		auto &column = IcebergTableSchema::GetFromColumnIndex(schema, column_id, 0);
-		auto result_type = field.transform.GetSerializedType(column.type);
-		auto stats = IcebergPredicateStats::DeserializeBounds(field_summary.lower_bound, field_summary.upper_bound,
-		                                                      column.name, result_type);
-		stats.has_nan = field_summary.contains_nan;
-		stats.has_null = field_summary.contains_null;
-		stats.has_not_null = true; // Not enough information in field_summary to determine if this should be false
-
-		if (!IcebergPredicate::MatchBounds(*table_filter, stats, field.transform)) {
-			return false;
+		if (field.transform.Type() == IcebergTransformType::IDENTITY) {
+			program.AddFilter(*table_filter, i, column.name, column.type);
+		} else {
+			program.AddTransformFilter(*table_filter, i, column.name, field.transform.GetSerializedType(column.type),
+			                           field.transform);
 		}
 	}
-	return true;
+	return program;
+}
+
+void IcebergMultiFileList::CompileDataFileProgram() {
+	auto &schema = GetSchema().columns;
+	for (idx_t index = 0; index < schema.size(); index++) {
+		auto it = table_filters.filters.find(index);
+		if (it == table_filters.filters.end()) {
+			continue;
+		}
+		auto &column = *schema[index];
+		data_file_program.AddFilter(*it->second, NumericCast<idx_t>(column.id), column.name, column.type);
+	}
 }
 
-void IcebergMultiFileList::InitializeFiles(lock_guard<mutex> &guard) {
+void IcebergMultiFileList::InitializeFiles(std::unique_lock<mutex> &guard) {
 	if (initialized) {
 		return;
 	}
 	initialized = true;
+	CompileDataFileProgram();
 
 	if (scan_info->snapshot) {
 		//! Load the snapshot
@@ -541,9 +616,6 @@ void IcebergMultiFileList::InitializeFiles(lock_guard<mutex> &guard) {
 		auto &metadata = GetMetadata();
 		auto &fs = FileSystem::GetFileSystem(context);
 
-		data_manifest_reader = make_uniq<manifest_file::ManifestFileReader>(metadata.iceberg_version);
-		delete_manifest_reader = make_uniq<manifest_file::ManifestFileReader>(metadata.iceberg_version);
-
 		// Read the manifest list, we need all the manifests to determine if we've seen all deletes
 		auto manifest_list_full_path = options.allow_moved_paths
 		                                   ? IcebergUtils::GetFullPath(iceberg_path, snapshot.manifest_list, fs)
@@ -596,61 +668,525 @@ void IcebergMultiFileList::InitializeFiles(lock_guard<mutex> &guard) {
 			}
 		}
 	}
+}
+
+namespace {
+
+class IcebergDeleteManifestReadTask : public BaseExecutorTask {
+public:
+	IcebergDeleteManifestReadTask(TaskExecutor &executor, const IcebergMultiFileList &file_list, idx_t manifest_idx,
+	                              vector<IcebergManifestEntry> &result)
+	    : BaseExecutorTask(executor), file_list(file_list), manifest_idx(manifest_idx), result(result) {
+	}
+
+	void ExecuteTask() override {
+		file_list.ReadDeleteManifest(manifest_idx, result);
+	}
+
+private:
+	const IcebergMultiFileList &file_list;
+	idx_t manifest_idx;
+	vector<IcebergManifestEntry> &result;
+};
+
+class IcebergDeleteFileReadTask : public BaseExecutorTask {
+public:
+	IcebergDeleteFileReadTask(TaskExecutor &executor, const IcebergMultiFileList &file_list, idx_t delete_idx,
+	                          const vector<MultiFileColumnDefinition> &global_columns,
+	                          const vector<ColumnIndex> &column_indexes)
+	    : BaseExecutorTask(executor), file_list(file_list), delete_idx(delete_idx), global_columns(global_columns),
+	      column_indexes(column_indexes) {
+	}
+
+	void ExecuteTask() override {
+		file_list.TryLoadDeleteFile(delete_idx, global_columns, column_indexes);
+	}
+
+private:
+	const IcebergMultiFileList &file_list;
+	idx_t delete_idx;
+	const vector<MultiFileColumnDefinition> &global_columns;
+	const vector<ColumnIndex> &column_indexes;
+};
+
+//! The field id of the 'file_path' column of positional delete files
+constexpr int32_t DELETE_FILE_PATH_FIELD_ID = 2147483546;
+
+} // namespace
+
+void IcebergMultiFileList::ReadDeleteManifest(idx_t manifest_idx, vector<IcebergManifestEntry> &result) const {
+	auto &manifest = delete_manifests[manifest_idx];
+	auto full_path = options.allow_moved_paths ? IcebergUtils::GetFullPath(path, manifest.manifest_path, fs)
+	                                           : manifest.manifest_path;
+	auto scan = make_uniq<AvroScan>("IcebergManifest", context, full_path);
+
+	manifest_file::ManifestFileReader manifest_reader(GetMetadata().iceberg_version);
+	manifest_reader.Initialize(std::move(scan));
+	manifest_reader.SetSequenceNumber(manifest.sequence_number);
+	manifest_reader.SetPartitionSpecID(manifest.partition_spec_id);
+
+	while (!manifest_reader.Finished()) {
+		manifest_reader.Read(STANDARD_VECTOR_SIZE, result);
+	}
+}
+
+string IcebergMultiFileList::GetPartitionKey(int32_t partition_spec_id,
+                                             const vector<pair<int32_t, Value>> &partition_values) const {
+	auto &partition_spec = GetMetadata().partition_specs.at(partition_spec_id);
+	if (!partition_spec.IsPartitioned()) {
+		return string();
+	}
+	auto result = to_string(partition_spec_id);
+	for (auto &partition_value : partition_values) {
+		result += "/" + to_string(partition_value.first) + "=" + partition_value.second.ToSQLString();
+	}
+	return result;
+}
+
+IcebergPredicateStats IcebergMultiFileList::GetColumnBounds(const IcebergManifestEntry &file, int32_t field_id) const {
+	IcebergPredicateStats result;
+	result.has_null = true;
+	result.has_nan = true;
+	auto null_counts_it = file.null_value_counts.find(field_id);
+	if (null_counts_it != file.null_value_counts.end()) {
+		result.has_null = null_counts_it->second != 0;
+	}
+	auto nan_counts_it = file.nan_value_counts.find(field_id);
+	if (nan_counts_it != file.nan_value_counts.end()) {
+		result.has_nan = nan_counts_it->second != 0;
+	}
+
+	optional_ptr<const IcebergColumnDefinition> column;
+	for (auto &schema_column : GetSchema().columns) {
+		if (schema_column->id == field_id) {
+			column = *schema_column;
+			break;
+		}
+	}
+	if (!column) {
+		//! Not a top-level column
+		return result;
+	}
+	auto &type = column->type;
+	if (type.id() != LogicalTypeId::FLOAT && type.id() != LogicalTypeId::DOUBLE) {
+		result.has_nan = false;
+	}
 
-	current_data_manifest = data_manifests.begin();
-	current_delete_manifest = delete_manifests.begin();
+	auto lower_bound_it = file.lower_bounds.find(field_id);
+	auto upper_bound_it = file.upper_bounds.find(field_id);
+	if (lower_bound_it == file.lower_bounds.end() || upper_bound_it == file.upper_bounds.end() ||
+	    lower_bound_it->second.IsNull() || upper_bound_it->second.IsNull()) {
+		return result;
+	}
+	auto lower_bound = IcebergValue::DeserializeValue(lower_bound_it->second.GetValueUnsafe<string_t>(), type);
+	auto upper_bound = IcebergValue::DeserializeValue(upper_bound_it->second.GetValueUnsafe<string_t>(), type);
+	if (lower_bound.HasError() || upper_bound.HasError()) {
+		//! The bounds were written for another type (before a type promotion), don't use them
+		return result;
+	}
+	result.lower_bound = lower_bound.GetValue();
+	result.upper_bound = upper_bound.GetValue();
+	return result;
 }
 
-void IcebergMultiFileList::ProcessDeletes(const vector<MultiFileColumnDefinition> &global_columns,
-                                          const vector<ColumnIndex> &column_indexes) const {
-	// In <=v2 we now have to process *all* delete manifests
-	// before we can be certain that we have all the delete data for the current file.
+bool IcebergMultiFileList::EqualityDeletesMayApply(
+    const IcebergDeleteFileSlot &delete_file, const IcebergManifestEntry &data_file,
+    unordered_map<int32_t, IcebergPredicateStats> &data_file_bounds) const {
+	auto &equality_ids = delete_file.entry.equality_ids;
+	for (idx_t i = 0; i < equality_ids.size(); i++) {
+		auto field_id = equality_ids[i];
+		auto data_file_it = data_file_bounds.find(field_id);
+		if (data_file_it == data_file_bounds.end()) {
+			data_file_it = data_file_bounds.emplace(field_id, GetColumnBounds(data_file, field_id)).first;
+		}
+		auto &data_bounds = data_file_it->second;
+		auto &delete_bounds = delete_file.equality_bounds[i];
+
+		if ((delete_bounds.has_null && data_bounds.has_null) || (delete_bounds.has_nan && data_bounds.has_nan)) {
+			//! The deletes can match rows outside of the bounds
+			continue;
+		}
+		if (delete_bounds.lower_bound.IsNull() || data_bounds.lower_bound.IsNull()) {
+			continue;
+		}
+		if (delete_bounds.upper_bound < data_bounds.lower_bound ||
+		    delete_bounds.lower_bound > data_bounds.upper_bound) {
+			//! No key of the delete file can match a row of the data file
+			return false;
+		}
+	}
+	return true;
+}
+
+void IcebergMultiFileList::InitializeDeleteIndex() const {
+	// In <=v2 any delete file of the snapshot could apply to the data file we're opening, so the delete manifests
+	// are read up front. Only their entries are indexed, the delete files are read once a data file they apply to is
+	// opened.
 
 	// v3 solves this, `referenced_data_file` will tell us which file the `data_file`
 	// is targeting before we open it, and there can only be one deletion vector per data file.
+	vector<vector<IcebergManifestEntry>> manifest_entries(delete_manifests.size());
+	TaskExecutor executor(context);
+	for (idx_t i = 0; i < delete_manifests.size(); i++) {
+		executor.ScheduleTask(make_uniq<IcebergDeleteManifestReadTask>(executor, *this, i, manifest_entries[i]));
+	}
+	executor.WorkOnTasks();
+
+	for (auto &entries : manifest_entries) {
+		for (auto &entry : entries) {
+			auto delete_idx = delete_index.files.size();
+			delete_index.files.push_back(make_uniq<IcebergDeleteFileSlot>(std::move(entry)));
+			auto &delete_file = delete_index.files.back()->entry;
+
+			auto partition_key = GetPartitionKey(delete_file.partition_spec_id, delete_file.partition_values);
+			if (delete_file.content == IcebergManifestEntryContentType::EQUALITY_DELETES) {
+				auto &slot = *delete_index.files.back();
+				for (auto field_id : delete_file.equality_ids) {
+					slot.equality_bounds.push_back(GetColumnBounds(delete_file, field_id));
+				}
+				delete_index.partitions[partition_key].equality.push_back(delete_idx);
+				continue;
+			}
+			if (!delete_file.referenced_data_file.empty()) {
+				delete_index.by_data_file[delete_file.referenced_data_file].push_back(delete_idx);
+				if (StringUtil::CIEquals(delete_file.file_format, "puffin")) {
+					delete_index.puffin_files[delete_file.file_path].push_back(delete_idx);
+				}
+				continue;
+			}
+			//! A positional delete file that targets a single data file has equal 'file_path' bounds
+			auto lower_bound_it = delete_file.lower_bounds.find(DELETE_FILE_PATH_FIELD_ID);
+			auto upper_bound_it = delete_file.upper_bounds.find(DELETE_FILE_PATH_FIELD_ID);
+			if (lower_bound_it != delete_file.lower_bounds.end() && upper_bound_it != delete_file.upper_bounds.end() &&
+			    !lower_bound_it->second.IsNull() && lower_bound_it->second == upper_bound_it->second) {
+				delete_index.by_data_file[StringValue::Get(lower_bound_it->second)].push_back(delete_idx);
+				continue;
+			}
+			delete_index.partitions[partition_key].positional.push_back(delete_idx);
+		}
+	}
 
-	// From the spec: "At most one deletion vector is allowed per data file in a snapshot"
+	//! Order by descending sequence number, so lookups stop at the first delete file older than the data file
+	auto &files = delete_index.files;
+	auto newer_first = [&](idx_t a, idx_t b) {
+		return files[a]->entry.sequence_number > files[b]->entry.sequence_number;
+	};
+	for (auto &entry : delete_index.partitions) {
+		std::sort(entry.second.positional.begin(), entry.second.positional.end(), newer_first);
+		std::sort(entry.second.equality.begin(), entry.second.equality.end(), newer_first);
+	}
+	auto by_offset = [&](idx_t a, idx_t b) {
+		return files[a]->entry.content_offset.GetValue<int64_t>() < files[b]->entry.content_offset.GetValue<int64_t>();
+	};
+	for (auto &entry : delete_index.puffin_files) {
+		std::sort(entry.second.begin(), entry.second.end(), by_offset);
+	}
+}
 
-	//! NOTE: The lock is required because we're reading from the 'data_files' vector
-	auto iceberg_path = GetPath();
-	auto &fs = FileSystem::GetFileSystem(context);
+void IcebergMultiFileList::GetDeleteFilesForDataFile(
+    const IcebergManifestEntry &data_file, vector<idx_t> &positional_deletes,
+    vector<reference<IcebergPartitionDeletes>> &equality_deletes) const {
+	const auto &file_path = data_file.file_path;
+	unordered_map<int32_t, IcebergPredicateStats> data_file_bounds;
+
+	bool has_deletion_vector = false;
+	auto data_file_it = delete_index.by_data_file.find(file_path);
+	if (data_file_it != delete_index.by_data_file.end()) {
+		for (auto delete_idx : data_file_it->second) {
+			auto &delete_file = delete_index.files[delete_idx]->entry;
+			if (delete_file.sequence_number < data_file.sequence_number) {
+				continue;
+			}
+			if (StringUtil::CIEquals(delete_file.file_format, "puffin")) {
+				//! From the spec: "At most one deletion vector is allowed per data file in a snapshot", it replaces
+				//! the positional delete files of the data file
+				positional_deletes = {delete_idx};
+				has_deletion_vector = true;
+				break;
+			}
+			positional_deletes.push_back(delete_idx);
+		}
+	}
 
-	while (current_delete_manifest != delete_manifests.end()) {
-		auto &manifest = *current_delete_manifest;
-		auto full_path = options.allow_moved_paths ? IcebergUtils::GetFullPath(iceberg_path, manifest.manifest_path, fs)
-		                                           : manifest.manifest_path;
-		auto scan = make_uniq<AvroScan>("IcebergManifest", context, full_path);
+	auto add_partition_deletes = [&](const string &partition_key) {
+		auto partition_it = delete_index.partitions.find(partition_key);
+		if (partition_it == delete_index.partitions.end()) {
+			return;
+		}
+		auto &deletes = partition_it->second;
+		//! Equality deletes apply to data files with a lower sequence number, whose bounds overlap theirs
+		for (auto delete_idx : deletes.equality) {
+			auto &delete_file = *delete_index.files[delete_idx];
+			if (delete_file.entry.sequence_number <= data_file.sequence_number) {
+				break;
+			}
+			if (EqualityDeletesMayApply(delete_file, data_file, data_file_bounds)) {
+				equality_deletes.push_back(deletes);
+				break;
+			}
+		}
+		if (has_deletion_vector) {
+			return;
+		}
+		//! Positional deletes apply to data files with the same or a lower sequence number
+		for (auto delete_idx : deletes.positional) {
+			auto &delete_file = delete_index.files[delete_idx]->entry;
+			if (delete_file.sequence_number < data_file.sequence_number) {
+				break;
+			}
+			auto lower_bound_it = delete_file.lower_bounds.find(DELETE_FILE_PATH_FIELD_ID);
+			if (lower_bound_it != delete_file.lower_bounds.end() && !lower_bound_it->second.IsNull() &&
+			    file_path < StringValue::Get(lower_bound_it->second)) {
+				continue;
+			}
+			auto upper_bound_it = delete_file.upper_bounds.find(DELETE_FILE_PATH_FIELD_ID);
+			if (upper_bound_it != delete_file.upper_bounds.end() && !upper_bound_it->second.IsNull() &&
+			    file_path > StringValue::Get(upper_bound_it->second)) {
+				continue;
+			}
+			positional_deletes.push_back(delete_idx);
+		}
+	};
+	add_partition_deletes(string());
+	auto partition_key = GetPartitionKey(data_file.partition_spec_id, data_file.partition_values);
+	if (!partition_key.empty()) {
+		add_partition_deletes(partition_key);
+	}
+}
 
-		delete_manifest_reader->Initialize(std::move(scan));
-		delete_manifest_reader->SetSequenceNumber(manifest.sequence_number);
-		delete_manifest_reader->SetPartitionSpecID(manifest.partition_spec_id);
+bool IcebergMultiFileList::TryLoadDeleteFile(idx_t delete_idx, const vector<MultiFileColumnDefinition> &global_columns,
+                                             const vector<ColumnIndex> &column_indexes) const {
+	auto &slot = *delete_index.files[delete_idx];
+	auto expected = IcebergManifestSlotState::PENDING;
+	if (!slot.state.compare_exchange_strong(expected, IcebergManifestSlotState::CLAIMED)) {
+		//! Another thread is reading (or has read) this delete file
+		return false;
+	}
 
-		IcebergManifestFile manifest_file(full_path);
-		while (!delete_manifest_reader->Finished()) {
-			delete_manifest_reader->Read(STANDARD_VECTOR_SIZE, manifest_file.data_files);
+	vector<idx_t> claimed {delete_idx};
+	try {
+		auto &entry = slot.entry;
+		if (StringUtil::CIEquals(entry.file_format, "parquet")) {
+			ScanDeleteFile(entry, global_columns, column_indexes, slot.equality_deletes);
+		} else if (StringUtil::CIEquals(entry.file_format, "puffin")) {
+			claimed = ClaimDeletionVectors(delete_idx);
+			vector<reference<const IcebergManifestEntry>> entries;
+			for (auto idx : claimed) {
+				entries.push_back(delete_index.files[idx]->entry);
+			}
+			ScanPuffinFile(entries);
+		} else {
+			throw NotImplementedException(
+			    "File format '%s' not supported for deletes, only supports 'parquet' and 'puffin' currently",
+			    entry.file_format);
 		}
+	} catch (std::exception &ex) {
+		for (auto idx : claimed) {
+			delete_index.files[idx]->error = ErrorData(ex);
+		}
+	}
 
-		current_delete_manifest++;
+	{
+		lock_guard<mutex> guard(delete_lock);
+		for (auto idx : claimed) {
+			delete_index.files[idx]->state = IcebergManifestSlotState::READY;
+		}
+	}
+	delete_cv.notify_all();
+	return true;
+}
 
-		for (auto &entry : manifest_file.data_files) {
-			if (StringUtil::CIEquals(entry.file_format, "parquet")) {
-				ScanDeleteFile(entry, global_columns, column_indexes);
-			} else if (StringUtil::CIEquals(entry.file_format, "puffin")) {
-				ScanPuffinFile(entry);
-			} else {
-				throw NotImplementedException(
-				    "File format '%s' not supported for deletes, only supports 'parquet' and 'puffin' currently",
-				    entry.file_format);
+vector<idx_t> IcebergMultiFileList::ClaimDeletionVectors(idx_t delete_idx) const {
+	vector<idx_t> result {delete_idx};
+	auto &entry = delete_index.files[delete_idx]->entry;
+	auto puffin_it = delete_index.puffin_files.find(entry.file_path);
+	if (puffin_it == delete_index.puffin_files.end()) {
+		return result;
+	}
+	auto &blobs = puffin_it->second;
+	auto position = NumericCast<idx_t>(std::find(blobs.begin(), blobs.end(), delete_idx) - blobs.begin());
+	D_ASSERT(position < blobs.size());
+
+	auto blob_start = [&](idx_t idx) {
+		return delete_index.files[idx]->entry.content_offset.GetValue<int64_t>();
+	};
+	auto blob_end = [&](idx_t idx) {
+		auto &blob = delete_index.files[idx]->entry;
+		return blob.content_offset.GetValue<int64_t>() + blob.content_size_in_bytes.GetValue<int64_t>();
+	};
+	auto try_claim = [&](idx_t idx) {
+		auto expected = IcebergManifestSlotState::PENDING;
+		return delete_index.files[idx]->state.compare_exchange_strong(expected, IcebergManifestSlotState::CLAIMED);
+	};
+
+	//! Extend the read to the deletion vectors after and before this one, as long as it stays small enough.
+	//! Deletion vectors claimed by other threads are read over, but not decoded.
+	auto range_start = blob_start(delete_idx);
+	auto range_end = blob_end(delete_idx);
+	for (idx_t i = position + 1; i < blobs.size(); i++) {
+		auto end = blob_end(blobs[i]);
+		if (end - range_start > IcebergDeleteFileIndex::MAX_PUFFIN_READ_SIZE) {
+			break;
+		}
+		if (try_claim(blobs[i])) {
+			result.push_back(blobs[i]);
+			range_end = MaxValue(range_end, end);
+		}
+	}
+	for (idx_t i = position; i > 0; i--) {
+		auto start = blob_start(blobs[i - 1]);
+		if (range_end - start > IcebergDeleteFileIndex::MAX_PUFFIN_READ_SIZE) {
+			break;
+		}
+		if (try_claim(blobs[i - 1])) {
+			result.push_back(blobs[i - 1]);
+			range_start = MinValue(range_start, start);
+		}
+	}
+	return result;
+}
+
+bool IcebergMultiFileList::TryLoadEqualityDeletes(IcebergPartitionDeletes &deletes,
+                                                  const vector<MultiFileColumnDefinition> &global_columns,
+                                                  const vector<ColumnIndex> &column_indexes) const {
+	auto expected = IcebergManifestSlotState::PENDING;
+	if (!deletes.equality_state.compare_exchange_strong(expected, IcebergManifestSlotState::CLAIMED)) {
+		//! Another thread is reading (or has read) these equality deletes
+		return false;
+	}
+
+	try {
+		//! Only the thread that claimed the partition reads its equality delete files
+		TaskExecutor executor(context);
+		for (auto delete_idx : deletes.equality) {
+			executor.ScheduleTask(
+			    make_uniq<IcebergDeleteFileReadTask>(executor, *this, delete_idx, global_columns, column_indexes));
+		}
+		executor.WorkOnTasks();
+
+		//! Merge the deletes of the files with the same equality ids, keeping the highest sequence number of each key
+		for (auto delete_idx : deletes.equality) {
+			auto &slot = *delete_index.files[delete_idx];
+			if (slot.error.HasError()) {
+				slot.error.Throw();
+			}
+			if (!slot.equality_deletes) {
+				//! The file has no rows
+				continue;
+			}
+			auto file_deletes = std::move(slot.equality_deletes);
+			bool merged = false;
+			for (auto &equality_set : deletes.equality_sets) {
+				if (equality_set->equality_ids == file_deletes->equality_ids) {
+					equality_set->Merge(*file_deletes);
+					merged = true;
+					break;
+				}
+			}
+			if (!merged) {
+				deletes.equality_sets.push_back(std::move(file_deletes));
+			}
+		}
+	} catch (std::exception &ex) {
+		deletes.equality_error = ErrorData(ex);
+	}
+
+	{
+		lock_guard<mutex> guard(delete_lock);
+		deletes.equality_state = IcebergManifestSlotState::READY;
+	}
+	delete_cv.notify_all();
+	return true;
+}
+
+unique_ptr<DeleteFilter>
+IcebergMultiFileList::LoadDeletesForFile(idx_t file_id, const IcebergManifestEntry &data_file,
+                                         const vector<MultiFileColumnDefinition> &global_columns,
+                                         const vector<ColumnIndex> &column_indexes) const {
+	if (delete_manifests.empty()) {
+		return nullptr;
+	}
+
+	vector<idx_t> delete_files;
+	vector<reference<IcebergPartitionDeletes>> equality_deletes;
+	{
+		lock_guard<mutex> guard(delete_lock);
+		if (!delete_index_initialized) {
+			InitializeDeleteIndex();
+			delete_index_initialized = true;
+		}
+		GetDeleteFilesForDataFile(data_file, delete_files, equality_deletes);
+	}
+	if (delete_files.empty() && equality_deletes.empty()) {
+		return nullptr;
+	}
+
+	//! Read the positional delete files no other thread has started on yet, in parallel
+	if (delete_files.size() == 1) {
+		TryLoadDeleteFile(delete_files[0], global_columns, column_indexes);
+	} else if (delete_files.size() > 1) {
+		TaskExecutor executor(context);
+		for (auto delete_idx : delete_files) {
+			if (delete_index.files[delete_idx]->state.load() != IcebergManifestSlotState::PENDING) {
+				continue;
 			}
+			executor.ScheduleTask(
+			    make_uniq<IcebergDeleteFileReadTask>(executor, *this, delete_idx, global_columns, column_indexes));
+		}
+		executor.WorkOnTasks();
+	}
+	for (auto &deletes : equality_deletes) {
+		TryLoadEqualityDeletes(deletes, global_columns, column_indexes);
+	}
+
+	std::unique_lock<mutex> guard(delete_lock);
+	for (auto &deletes_ref : equality_deletes) {
+		//! Wait for the equality deletes that other threads are reading
+		auto &deletes = deletes_ref.get();
+		delete_cv.wait(guard, [&]() { return deletes.equality_state.load() == IcebergManifestSlotState::READY; });
+		if (deletes.equality_error.HasError()) {
+			deletes.equality_error.Throw();
+		}
+		auto &file_deletes = equality_deletes_by_file[file_id];
+		for (auto &equality_set : deletes.equality_sets) {
+			file_deletes.push_back(*equality_set);
+		}
+	}
+	std::unique_lock<mutex> guard(delete_lock);
+	for (auto delete_idx : delete_files) {
+		//! Wait for the delete files that other threads are reading
+		auto &slot = *delete_index.files[delete_idx];
+		delete_cv.wait(guard, [&]() { return slot.state.load() == IcebergManifestSlotState::READY; });
+		if (slot.error.HasError()) {
+			slot.error.Throw();
 		}
 	}
 
-	D_ASSERT(current_delete_manifest == delete_manifests.end());
+	//! No other data file needs these deletes, take them out of the delete data
+	const auto &file_path = data_file.file_path;
+	auto deletion_vector_it = deletion_vector_data.find(file_path);
+	if (deletion_vector_it != deletion_vector_data.end()) {
+		auto deletion_vector = std::move(deletion_vector_it->second);
+		deletion_vector_data.erase(deletion_vector_it);
+		positional_delete_data.erase(file_path);
+		return std::move(deletion_vector);
+	}
+	auto positional_it = positional_delete_data.find(file_path);
+	if (positional_it == positional_delete_data.end()) {
+		return nullptr;
+	}
+	auto positional_deletes = std::move(positional_it->second);
+	positional_delete_data.erase(positional_it);
+	guard.unlock();
+
+	positional_deletes->Finalize();
+	return std::move(positional_deletes);
 }
 
 void IcebergMultiFileList::ScanDeleteFile(const IcebergManifestEntry &entry,
                                           const vector<MultiFileColumnDefinition> &global_columns,
-                                          const vector<ColumnIndex> &column_indexes) const {
+                                          const vector<ColumnIndex> &column_indexes,
+                                          unique_ptr<IcebergEqualityDeleteSet> &equality_deletes) const {
 	const auto &delete_file_path = entry.file_path;
 	auto &instance = DatabaseInstance::GetDatabase(context);
 	//! FIXME: delete files could also be made without row_ids,
@@ -700,14 +1236,26 @@ void IcebergMultiFileList::ScanDeleteFile(const IcebergManifestEntry &entry,
 
 	auto &multi_file_local_state = local_state->Cast<MultiFileLocalState>();
 
+	//! The file is read without holding the 'delete_lock', its deletes are added to the delete data afterwards
 	if (entry.content == IcebergManifestEntryContentType::POSITION_DELETES) {
+		case_insensitive_map_t<unique_ptr<IcebergPositionalDeleteData>> deletes;
 		do {
 			TableFunctionInput function_input(bind_data.get(), local_state.get(), global_state.get());
 			result.Reset();
 			parquet_scan.function(context, function_input, result);
 			result.Flatten();
-			ScanPositionalDeleteFile(result);
+			ScanPositionalDeleteFile(result, deletes);
 		} while (result.size() != 0);
+
+		lock_guard<mutex> guard(delete_lock);
+		for (auto &file_deletes : deletes) {
+			auto it = positional_delete_data.find(file_deletes.first);
+			if (it == positional_delete_data.end()) {
+				positional_delete_data.emplace(file_deletes.first, std::move(file_deletes.second));
+				continue;
+			}
+			it->second->Merge(*file_deletes.second);
+		}
 	} else if (entry.content == IcebergManifestEntryContentType::EQUALITY_DELETES) {
 		do {
 			TableFunctionInput function_input(bind_data.get(), local_state.get(), global_state.get());
@@ -715,19 +1263,9 @@ void IcebergMultiFileList::ScanDeleteFile(const IcebergManifestEntry &entry,
 			parquet_scan.function(context, function_input, result);
 			result.Flatten();
 			ScanEqualityDeleteFile(entry, result, multi_file_local_state.reader->columns, global_columns,
-			                       column_indexes);
+			                       column_indexes, equality_deletes);
 		} while (result.size() != 0);
 	}
 }
 
-//! FIXME: isn't this problematic if we need to scan the same delete file multiple times??
-unique_ptr<DeleteFilter> IcebergMultiFileList::GetPositionalDeletesForFile(const string &file_path) const {
-	auto it = positional_delete_data.find(file_path);
-	if (it != positional_delete_data.end()) {
-		// There is delete data for this file, return it
-		return std::move(it->second);
-	}
-	return nullptr;
-}
-
 } // namespace duckdb
@@ -10,11 +10,7 @@
 #include "duckdb/parallel/thread_context.hpp"
 #include "duckdb/parser/tableref/table_function_ref.hpp"
 #include "duckdb/parser/expression/constant_expression.hpp"
-#include "duckdb/planner/expression/bound_comparison_expression.hpp"
-#include "duckdb/planner/expression/bound_constant_expression.hpp"
-#include "duckdb/planner/expression/bound_operator_expression.hpp"
-#include "duckdb/planner/expression/bound_reference_expression.hpp"
-#include "duckdb/planner/expression/bound_conjunction_expression.hpp"
+#include "duckdb/common/unordered_set.hpp"
 
 #include "metadata/iceberg_predicate_stats.hpp"
 #include "metadata/iceberg_table_metadata.hpp"
@@ -263,18 +259,13 @@ void IcebergMultiFileReader::FinalizeBind(MultiFileReaderData &reader_data, cons
 	auto &reader = *reader_data.reader;
 	auto file_id = reader.file_list_idx.GetIndex();
 
+	IcebergManifestEntry data_file;
 	{
+		//! NOTE: The lock is required because we're reading from the 'data_files' vector
 		lock_guard<mutex> guard(multi_file_list.lock);
-		const auto &data_file = multi_file_list.data_files[file_id];
-		// The path of the data file where this chunk was read from
-		const auto &file_path = data_file.file_path;
-
-		lock_guard<mutex> delete_guard(multi_file_list.delete_lock);
-		if (multi_file_list.current_delete_manifest != multi_file_list.delete_manifests.end()) {
-			multi_file_list.ProcessDeletes(global_columns, global_column_ids);
-		}
-		reader.deletion_filter = std::move(multi_file_list.GetPositionalDeletesForFile(file_path));
+		data_file = multi_file_list.data_files[file_id];
 	}
+	reader.deletion_filter = multi_file_list.LoadDeletesForFile(file_id, data_file, global_columns, global_column_ids);
 
 	auto &local_columns = reader_data.reader->columns;
 	auto &metadata = multi_file_list.GetMetadata();
@@ -289,109 +280,55 @@ void IcebergMultiFileReader::FinalizeBind(MultiFileReaderData &reader_data, cons
 }
 
 void IcebergMultiFileReader::ApplyEqualityDeletes(ClientContext &context, DataChunk &output_chunk,
-                                                  const IcebergMultiFileList &multi_file_list,
+                                                  const IcebergMultiFileList &multi_file_list, idx_t file_id,
                                                   const IcebergManifestEntry &data_file,
                                                   const vector<MultiFileColumnDefinition> &local_columns) {
-	vector<reference<IcebergEqualityDeleteRow>> delete_rows;
-
-	auto &metadata = multi_file_list.GetMetadata();
-	auto delete_data_it = multi_file_list.equality_delete_data.upper_bound(data_file.sequence_number);
-	//! Look through all the equality delete files with a *higher* sequence number
-	for (; delete_data_it != multi_file_list.equality_delete_data.end(); delete_data_it++) {
-		auto &files = delete_data_it->second->files;
-		for (auto &file : files) {
-			auto &partition_spec = metadata.partition_specs.at(file.partition_spec_id);
-			if (partition_spec.IsPartitioned()) {
-				if (file.partition_spec_id != data_file.partition_spec_id) {
-					//! Not unpartitioned and the data does not share the same partition spec as the delete, skip the
-					//! delete file.
-					continue;
-				}
-				D_ASSERT(file.partition_values.size() == data_file.partition_values.size());
-				for (idx_t i = 0; i < file.partition_values.size(); i++) {
-					if (file.partition_values[i] != data_file.partition_values[i]) {
-						//! Same partition spec id, but the partitioning information doesn't match, delete file doesn't
-						//! apply.
-						continue;
-					}
-				}
-			}
-			delete_rows.insert(delete_rows.end(), file.rows.begin(), file.rows.end());
-		}
-	}
-
-	if (delete_rows.empty()) {
+	if (multi_file_list.delete_manifests.empty()) {
 		return;
 	}
+	optional_ptr<const vector<reference<IcebergEqualityDeleteSet>>> delete_sets;
+	{
+		//! NOTE: The lock is required because other data files can be added to the map, the hash tables of a data file
+		//! are no longer modified once it's opened
+		lock_guard<mutex> delete_guard(multi_file_list.delete_lock);
+		auto it = multi_file_list.equality_deletes_by_file.find(file_id);
+		if (it == multi_file_list.equality_deletes_by_file.end()) {
+			return;
+		}
+		delete_sets = it->second;
+	}
 
-	//! Map from column_id to 'local_columns' index
-	unordered_map<int32_t, column_t> id_to_local_column;
-	for (column_t i = 0; i < local_columns.size(); i++) {
-		auto &col = local_columns[i];
+	unordered_set<int32_t> local_field_ids;
+	for (auto &col : local_columns) {
 		D_ASSERT(!col.identifier.IsNull());
-		id_to_local_column[col.identifier.GetValue<int32_t>()] = i;
+		local_field_ids.insert(col.identifier.GetValue<int32_t>());
 	}
 
-	//! Create a big CONJUNCTION_AND of all the rows, illustrative example:
-	//! WHERE
-	//!	(col1 != 'A' OR col2 != 'B') AND
-	//!	(col1 != 'C' OR col2 != 'D') AND
-	//!	(col1 != 'X' OR col2 != 'Y') AND
-	//!	(col1 != 'Z' OR col2 != 'W')
-
-	vector<unique_ptr<Expression>> rows;
-	for (auto &row : delete_rows) {
-		vector<unique_ptr<Expression>> equalities;
-		for (auto &item : row.get().filters) {
-			auto &field_id = item.first;
-			auto &expression = item.second;
-
-			bool treat_as_null = !id_to_local_column.count(field_id);
-			if (treat_as_null) {
+	//! Probe the hash table of every set of equality ids with the key columns of the chunk, an anti-join
+	SelectionVector sel_vec(STANDARD_VECTOR_SIZE);
+	for (auto &delete_set_ref : *delete_sets) {
+		auto &delete_set = delete_set_ref.get();
+		auto count = output_chunk.size();
+		if (count == 0) {
+			return;
+		}
+		vector<Vector> keys;
+		keys.reserve(delete_set.equality_ids.size());
+		for (idx_t i = 0; i < delete_set.equality_ids.size(); i++) {
+			if (!local_field_ids.count(delete_set.equality_ids[i])) {
 				//! This column is not present in the file
 				//! For the purpose of the equality deletes, we are treating it as if its value is NULL (despite any
 				//! 'initial-default' that exists)
-
-				//! This means that if the expression is 'IS_NOT_NULL', the result is False for this column, otherwise
-				//! it's True (because nothing compares equal to NULL)
-				if (expression->type == ExpressionType::OPERATOR_IS_NOT_NULL) {
-					equalities.push_back(make_uniq<BoundConstantExpression>(Value::BOOLEAN(false)));
-				} else {
-					equalities.push_back(make_uniq<BoundConstantExpression>(Value::BOOLEAN(true)));
-				}
+				keys.emplace_back(Value(delete_set.types[i]));
 			} else {
-				equalities.push_back(expression->Copy());
+				keys.emplace_back(output_chunk.data[delete_set.result_columns[i]]);
 			}
 		}
-
-		unique_ptr<Expression> filter;
-		D_ASSERT(!equalities.empty());
-		if (equalities.size() > 1) {
-			auto conjunction_or = make_uniq<BoundConjunctionExpression>(ExpressionType::CONJUNCTION_OR);
-			conjunction_or->children = std::move(equalities);
-			filter = std::move(conjunction_or);
-		} else {
-			filter = std::move(equalities[0]);
+		auto remaining = delete_set.Filter(keys.data(), count, data_file.sequence_number, sel_vec);
+		if (remaining != count) {
+			output_chunk.Slice(sel_vec, remaining);
 		}
-		rows.push_back(std::move(filter));
 	}
-
-	unique_ptr<Expression> equality_delete_filter;
-	D_ASSERT(!rows.empty());
-	if (rows.size() == 1) {
-		equality_delete_filter = std::move(rows[0]);
-	} else {
-		auto conjunction_and = make_uniq<BoundConjunctionExpression>(ExpressionType::CONJUNCTION_AND);
-		conjunction_and->children = std::move(rows);
-		equality_delete_filter = std::move(conjunction_and);
-	}
-
-	//! Apply equality deletes
-	ExpressionExecutor expression_executor(context);
-	expression_executor.AddExpression(*equality_delete_filter);
-	SelectionVector sel_vec(STANDARD_VECTOR_SIZE);
-	idx_t count = expression_executor.SelectExpression(output_chunk, sel_vec);
-	output_chunk.Slice(sel_vec, count);
 }
 
 void IcebergMultiFileReader::FinalizeChunk(ClientContext &context, const MultiFileBindData &bind_data,
@@ -409,7 +346,7 @@ void IcebergMultiFileReader::FinalizeChunk(ClientContext &context, const MultiFi
 	auto file_id = reader.file_list_idx.GetIndex();
 	auto &data_file = multi_file_list.data_files[file_id];
 	auto &local_columns = reader.columns;
-	ApplyEqualityDeletes(context, output_chunk, multi_file_list, data_file, local_columns);
+	ApplyEqualityDeletes(context, output_chunk, multi_file_list, file_id, data_file, local_columns);
 }
 
 bool IcebergMultiFileReader::ParseOption(const string &key, const Value &val, MultiFileOptions &options,
@@ -19,10 +19,12 @@
 #include "duckdb/planner/operator/logical_comparison_join.hpp"
 #include "duckdb/common/file_opener.hpp"
 #include "duckdb/common/file_system.hpp"
+#include "duckdb/common/multi_file/multi_file_states.hpp"
 #include "duckdb/main/extension/extension_loader.hpp"
 #include "iceberg_metadata.hpp"
 #include "iceberg_utils.hpp"
 #include "iceberg_multi_file_reader.hpp"
+#include "iceberg_multi_file_list.hpp"
 #include "iceberg_functions.hpp"
 #include "storage/irc_table_entry.hpp"
 
@@ -46,6 +48,26 @@ static void IcebergScanSerialize(Serializer &serializer, const optional_ptr<Func
 	throw NotImplementedException("IcebergScan serialization not implemented");
 }
 
+static unique_ptr<BaseStatistics> IcebergScanStatistics(ClientContext &context, const FunctionData *bind_data_p,
+                                                        column_t column_index) {
+	auto &bind_data = bind_data_p->Cast<MultiFileBindData>();
+	auto &file_list = dynamic_cast<IcebergMultiFileList &>(*bind_data.file_list);
+	if (file_list.scan_info->owned_temp_data) {
+		//! Not scanning from a catalog, the metadata only lives as long as the scan, so building the statistics would
+		//! read every manifest again on each query
+		return nullptr;
+	}
+	auto &columns = file_list.GetSchema().columns;
+	if (column_index >= columns.size()) {
+		return nullptr;
+	}
+	auto statistics = file_list.GetMetadata().statistics_cache->Get(context, file_list.scan_info);
+	if (!statistics) {
+		return nullptr;
+	}
+	return statistics->GetColumnStatistics(columns[column_index]->id);
+}
+
 TableFunctionSet IcebergFunctions::GetIcebergScanFunction(ExtensionLoader &loader) {
 	// The iceberg_scan function is constructed by grabbing the parquet scan from the Catalog, then injecting the
 	// IcebergMultiFileReader into it to create a Iceberg-based multi file read
@@ -63,7 +85,7 @@ TableFunctionSet IcebergFunctions::GetIcebergScanFunction(ExtensionLoader &loade
 		function.serialize = IcebergScanSerialize;
 		function.deserialize = nullptr;
 
-		function.statistics = nullptr;
+		function.statistics = IcebergScanStatistics;
 		function.table_scan_progress = nullptr;
 		function.get_bind_info = nullptr;
 
@@ -0,0 +1,488 @@
+#include "iceberg_functions.hpp"
+#include "iceberg_multi_file_list.hpp"
+#include "iceberg_utils.hpp"
+#include "catalog_utils.hpp"
+#include "paimon_binary_row.hpp"
+#include "paimon_metadata.hpp"
+#include "storage/paimon_commit.hpp"
+#include "storage/paimon_table_writer.hpp"
+
+#include "duckdb/common/case_insensitive_map.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/main/client_context.hpp"
+
+#include "metadata/iceberg_predicate_stats.hpp"
+#include "metadata/iceberg_table_metadata.hpp"
+
+#include "yyjson.hpp"
+
+namespace duckdb {
+
+//! Migrates an Iceberg table to a new Paimon append table without copying data. The Parquet data files of the Iceberg
+//! table are referenced as-is through the 'externalPath' of their DataFileMeta, only the Paimon schema, manifests and
+//! a single snapshot are written. Iceberg's file-level bounds and null counts become the files' value stats.
+//!
+//! Only tables without delete files, that are unpartitioned or partitioned by identity transforms, can be migrated.
+//! Columns may have been added or dropped, but not renamed or promoted, as Paimon reads the columns by name.
+//! Both tables share the data files afterwards: expiring snapshots or compacting the Paimon table deletes files the
+//! Iceberg table may still refer to.
+struct IcebergToPaimonBindData : public TableFunctionData {
+	string iceberg_path;
+	string paimon_path;
+	IcebergOptions options;
+};
+
+struct IcebergToPaimonGlobalState : public GlobalTableFunctionState {
+	bool finished = false;
+};
+
+//! The Paimon type of 'column' (org.apache.paimon.types.DataType#asSQLString)
+static string PaimonTypeString(const IcebergColumnDefinition &column) {
+	auto &type = column.type;
+	string result;
+	switch (type.id()) {
+	case LogicalTypeId::BOOLEAN:
+		result = "BOOLEAN";
+		break;
+	case LogicalTypeId::INTEGER:
+		result = "INT";
+		break;
+	case LogicalTypeId::BIGINT:
+		result = "BIGINT";
+		break;
+	case LogicalTypeId::FLOAT:
+		result = "FLOAT";
+		break;
+	case LogicalTypeId::DOUBLE:
+		result = "DOUBLE";
+		break;
+	case LogicalTypeId::DECIMAL:
+		result = StringUtil::Format("DECIMAL(%d, %d)", DecimalType::GetWidth(type), DecimalType::GetScale(type));
+		break;
+	case LogicalTypeId::DATE:
+		result = "DATE";
+		break;
+	case LogicalTypeId::TIMESTAMP:
+		result = "TIMESTAMP(6)";
+		break;
+	case LogicalTypeId::TIMESTAMP_TZ:
+		result = "TIMESTAMP(6) WITH LOCAL TIME ZONE";
+		break;
+	case LogicalTypeId::VARCHAR:
+		result = "STRING";
+		break;
+	case LogicalTypeId::BLOB:
+		result = "BYTES";
+		break;
+	default:
+		throw NotImplementedException("Migrating Iceberg column \"%s\" of type %s to Paimon", column.name,
+		                              type.ToString());
+	}
+	return column.required ? result + " NOT NULL" : result;
+}
+
+//! Paimon matches the columns of data files by name, while Iceberg matches them by field id. The data files written
+//! under every schema of the table must therefore name and type the columns of 'schema' the same way.
+static void VerifyColumnNames(const IcebergTableMetadata &metadata, const IcebergTableSchema &schema) {
+	unordered_map<int32_t, reference<const IcebergColumnDefinition>> columns_by_id;
+	case_insensitive_map_t<int32_t> ids_by_name;
+	for (auto &column : schema.columns) {
+		columns_by_id.emplace(column->id, *column);
+		ids_by_name.emplace(column->name, column->id);
+	}
+	for (auto &entry : metadata.schemas) {
+		auto &other_schema = *entry.second;
+		for (auto &other_column : other_schema.columns) {
+			auto column_it = columns_by_id.find(other_column->id);
+			if (column_it != columns_by_id.end()) {
+				auto &column = column_it->second.get();
+				if (column.name != other_column->name) {
+					throw NotImplementedException("Migrating Iceberg tables with renamed columns to Paimon: column "
+					                              "\"%s\" was named \"%s\" in schema %d",
+					                              column.name, other_column->name, other_schema.schema_id);
+				}
+				if (column.type != other_column->type) {
+					throw NotImplementedException("Migrating Iceberg tables with promoted column types to Paimon: "
+					                              "column \"%s\" was of type %s in schema %d",
+					                              column.name, other_column->type.ToString(), other_schema.schema_id);
+				}
+				continue;
+			}
+			auto name_it = ids_by_name.find(other_column->name);
+			if (name_it != ids_by_name.end()) {
+				//! A dropped column, whose name was reused by a column that was added later
+				throw NotImplementedException("Migrating Iceberg tables with re-added columns to Paimon: column \"%s\" "
+				                              "is field %d, but was field %d in schema %d",
+				                              other_column->name, name_it->second, other_column->id,
+				                              other_schema.schema_id);
+			}
+		}
+	}
+}
+
+//! Write schema 0 of the Paimon table at 'paimon_path', fails if the table already has a schema
+static void WritePaimonSchema(FileSystem &fs, const string &paimon_path, const IcebergTableSchema &iceberg_schema,
+                              const PaimonSchema &schema) {
+	std::unique_ptr<yyjson_mut_doc, YyjsonDocDeleter> doc_p(yyjson_mut_doc_new(nullptr));
+	auto doc = doc_p.get();
+	auto root = yyjson_mut_obj(doc);
+	yyjson_mut_doc_set_root(doc, root);
+	yyjson_mut_obj_add_int(doc, root, "version", 3);
+	yyjson_mut_obj_add_sint(doc, root, "id", schema.id);
+
+	//! Iceberg field ids are unique within the table, so they are kept as the Paimon field ids
+	auto fields = yyjson_mut_obj_add_arr(doc, root, "fields");
+	int32_t highest_field_id = 0;
+	for (auto &column : iceberg_schema.columns) {
+		auto field = yyjson_mut_arr_add_obj(doc, fields);
+		yyjson_mut_obj_add_int(doc, field, "id", column->id);
+		yyjson_mut_obj_add_strcpy(doc, field, "name", column->name.c_str());
+		yyjson_mut_obj_add_strcpy(doc, field, "type", PaimonTypeString(*column).c_str());
+		highest_field_id = MaxValue(highest_field_id, column->id);
+	}
+	yyjson_mut_obj_add_int(doc, root, "highestFieldId", highest_field_id);
+	auto partition_keys = yyjson_mut_obj_add_arr(doc, root, "partitionKeys");
+	for (auto &key : schema.partition_keys) {
+		yyjson_mut_arr_add_strcpy(doc, partition_keys, key.c_str());
+	}
+	yyjson_mut_obj_add_arr(doc, root, "primaryKeys");
+	auto options = yyjson_mut_obj_add_obj(doc, root, "options");
+	for (auto &option : schema.options) {
+		yyjson_mut_obj_add_strcpy(doc, options, option.first.c_str(), option.second.c_str());
+	}
+	yyjson_mut_obj_add_sint(doc, root, "timeMillis", Timestamp::GetEpochMs(Timestamp::GetCurrentTimestamp()));
+
+	auto json = yyjson_mut_write(doc, YYJSON_WRITE_PRETTY, nullptr);
+	if (!json) {
+		throw InternalException("Failed to serialize the Paimon schema to JSON");
+	}
+	string content(json);
+	free(json);
+
+	for (auto &dir : {paimon_path, paimon_path + "/schema"}) {
+		if (!fs.DirectoryExists(dir)) {
+			fs.CreateDirectory(dir);
+		}
+	}
+	auto path = paimon_path + "/schema/schema-" + std::to_string(schema.id);
+	auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_EXCLUSIVE_CREATE |
+	                                    FileFlags::FILE_FLAGS_NULL_IF_EXISTS);
+	if (!handle) {
+		throw InvalidInputException("Can't migrate to \"%s\", it already holds a Paimon table", paimon_path);
+	}
+	handle->Write(const_cast<char *>(content.data()), content.size());
+	handle->Sync();
+	handle->Close();
+}
+
+//! Maps the partition values of Iceberg data files to Paimon partition rows
+class IcebergPartitionConverter {
+public:
+	IcebergPartitionConverter(const IcebergTableMetadata &metadata, const IcebergTableSchema &schema)
+	    : metadata(metadata), schema(schema) {
+		auto &default_spec = metadata.partition_specs.at(metadata.default_spec_id);
+		for (auto &field : default_spec.fields) {
+			if (field.transform.Type() == IcebergTransformType::VOID) {
+				continue;
+			}
+			auto &column = SourceColumn(default_spec, field);
+			source_ids.push_back(field.source_id);
+			partition_keys.push_back(column.name);
+			partition_types.push_back(column.type);
+		}
+	}
+
+public:
+	//! The Paimon partition row of 'entry'
+	vector<uint8_t> Convert(const IcebergManifestEntry &entry) {
+		if (partition_keys.empty()) {
+			return PaimonBinaryRow::EmptyRow();
+		}
+		auto &field_positions = GetSpec(entry.partition_spec_id);
+		vector<Value> values;
+		for (auto &type : partition_types) {
+			values.emplace_back(type);
+		}
+		for (auto &partition_value : entry.partition_values) {
+			auto position = field_positions.find(partition_value.first);
+			if (position == field_positions.end()) {
+				continue;
+			}
+			values[position->second] = partition_value.second.DefaultCastAs(partition_types[position->second]);
+		}
+		return PaimonBinaryRow::Serialize(values);
+	}
+
+public:
+	vector<string> partition_keys;
+	vector<LogicalType> partition_types;
+
+private:
+	const IcebergColumnDefinition &SourceColumn(const IcebergPartitionSpec &spec, const IcebergPartitionSpecField &field) {
+		for (auto &column : schema.columns) {
+			if (NumericCast<uint64_t>(column->id) == field.source_id) {
+				return *column;
+			}
+		}
+		throw NotImplementedException("Migrating Iceberg tables partitioned on nested field %d (partition spec %d) to "
+		                              "Paimon",
+		                              field.source_id, spec.spec_id);
+	}
+
+	//! The position in the partition keys of each partition field of spec 'spec_id', keyed on partition field id.
+	//! Paimon tables have a single partitioning, so every spec must partition on the same columns by identity.
+	const unordered_map<uint64_t, idx_t> &GetSpec(int32_t spec_id) {
+		auto entry = spec_positions.find(spec_id);
+		if (entry != spec_positions.end()) {
+			return entry->second;
+		}
+		auto spec = metadata.FindPartitionSpecById(spec_id);
+		if (!spec) {
+			throw InvalidInputException("Iceberg data file references 'partition_spec_id' %d which doesn't exist",
+			                            spec_id);
+		}
+		unordered_map<uint64_t, idx_t> positions;
+		for (auto &field : spec->fields) {
+			if (field.transform.Type() == IcebergTransformType::VOID) {
+				continue;
+			}
+			if (field.transform.Type() != IcebergTransformType::IDENTITY) {
+				throw NotImplementedException("Migrating Iceberg tables with '%s' partition transforms to Paimon, only "
+				                              "identity partitioning is supported",
+				                              field.transform.RawType());
+			}
+			auto position = std::find(source_ids.begin(), source_ids.end(), field.source_id);
+			if (position == source_ids.end()) {
+				throw NotImplementedException("Migrating Iceberg tables with evolved partition specs to Paimon: spec "
+				                              "%d partitions on field %d",
+				                              spec_id, field.source_id);
+			}
+			positions.emplace(field.partition_field_id, NumericCast<idx_t>(position - source_ids.begin()));
+		}
+		if (positions.size() != source_ids.size()) {
+			throw NotImplementedException("Migrating Iceberg tables with evolved partition specs to Paimon: spec %d "
+			                              "does not partition on all partition columns",
+			                              spec_id);
+		}
+		return spec_positions.emplace(spec_id, std::move(positions)).first->second;
+	}
+
+private:
+	const IcebergTableMetadata &metadata;
+	const IcebergTableSchema &schema;
+	//! The source field ids of the partition columns, in the order of the partition keys
+	vector<uint64_t> source_ids;
+	unordered_map<int32_t, unordered_map<uint64_t, idx_t>> spec_positions;
+};
+
+//! The value stats of an Iceberg data file: its lower and upper bounds and null counts per column
+static SimpleStats ConvertStats(const IcebergManifestEntry &entry, const IcebergTableSchema &schema) {
+	auto column_count = schema.columns.size();
+	PaimonBinaryRowWriter min_values(column_count);
+	PaimonBinaryRowWriter max_values(column_count);
+	SimpleStats result;
+	result.nullCounts.reserve(column_count);
+	for (idx_t col_idx = 0; col_idx < column_count; col_idx++) {
+		auto &column = *schema.columns[col_idx];
+		Value lower_bound;
+		Value upper_bound;
+		auto lower_bound_it = entry.lower_bounds.find(column.id);
+		if (lower_bound_it != entry.lower_bounds.end()) {
+			lower_bound = lower_bound_it->second;
+		}
+		auto upper_bound_it = entry.upper_bounds.find(column.id);
+		if (upper_bound_it != entry.upper_bounds.end()) {
+			upper_bound = upper_bound_it->second;
+		}
+		auto stats = IcebergPredicateStats::DeserializeBounds(lower_bound, upper_bound, column.name, column.type);
+		//! Iceberg bounds exclude NaN, Paimon's do not: drop them for columns holding NaN
+		auto nan_count_it = entry.nan_value_counts.find(column.id);
+		bool has_nan = nan_count_it != entry.nan_value_counts.end() && nan_count_it->second != 0;
+		if (stats.lower_bound.IsNull() || has_nan) {
+			min_values.SetNullAt(col_idx);
+		} else {
+			min_values.WriteValue(col_idx, stats.lower_bound);
+		}
+		if (stats.upper_bound.IsNull() || has_nan) {
+			max_values.SetNullAt(col_idx);
+		} else {
+			max_values.WriteValue(col_idx, stats.upper_bound);
+		}
+		auto null_count_it = entry.null_value_counts.find(column.id);
+		if (null_count_it != entry.null_value_counts.end()) {
+			result.nullCounts.push_back(Value::BIGINT(null_count_it->second));
+		} else {
+			result.nullCounts.emplace_back(LogicalType::BIGINT);
+		}
+	}
+	result.minValues = min_values.Serialize();
+	result.maxValues = max_values.Serialize();
+	return result;
+}
+
+static unique_ptr<FunctionData> IcebergToPaimonBind(ClientContext &context, TableFunctionBindInput &input,
+                                                    vector<LogicalType> &return_types, vector<string> &names) {
+	auto ret = make_uniq<IcebergToPaimonBindData>();
+	ret->iceberg_path = input.inputs[0].ToString();
+	ret->paimon_path = input.inputs[1].ToString();
+	auto &options = ret->options;
+	auto &snapshot_lookup = options.snapshot_lookup;
+
+	for (auto &kv : input.named_parameters) {
+		auto loption = StringUtil::Lower(kv.first);
+		auto &val = kv.second;
+		if (loption == "allow_moved_paths") {
+			options.allow_moved_paths = BooleanValue::Get(val);
+		} else if (loption == "metadata_compression_codec") {
+			options.metadata_compression_codec = StringValue::Get(val);
+		} else if (loption == "version") {
+			options.table_version = StringValue::Get(val);
+		} else if (loption == "version_name_format") {
+			auto value = StringValue::Get(kv.second);
+			auto string_substitutions = IcebergUtils::CountOccurrences(value, "%s");
+			if (string_substitutions != 2) {
+				throw InvalidInputException(
+				    "'version_name_format' has to contain two occurrences of '%s' in it, found %d", "%s",
+				    string_substitutions);
+			}
+			options.version_name_format = value;
+		} else if (loption == "snapshot_from_id") {
+			if (snapshot_lookup.snapshot_source != SnapshotSource::LATEST) {
+				throw InvalidInputException(
+				    "Can't use 'snapshot_from_id' in combination with 'snapshot_from_timestamp'");
+			}
+			snapshot_lookup.snapshot_source = SnapshotSource::FROM_ID;
+			snapshot_lookup.snapshot_id = val.GetValue<uint64_t>();
+		} else if (loption == "snapshot_from_timestamp") {
+			if (snapshot_lookup.snapshot_source != SnapshotSource::LATEST) {
+				throw InvalidInputException(
+				    "Can't use 'snapshot_from_id' in combination with 'snapshot_from_timestamp'");
+			}
+			snapshot_lookup.snapshot_source = SnapshotSource::FROM_TIMESTAMP;
+			snapshot_lookup.snapshot_timestamp = val.GetValue<timestamp_t>();
+		}
+	}
+
+	names = {"snapshot_id", "data_files", "record_count"};
+	return_types = {LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT};
+	return std::move(ret);
+}
+
+static unique_ptr<GlobalTableFunctionState> IcebergToPaimonInitGlobal(ClientContext &context,
+                                                                      TableFunctionInitInput &input) {
+	return make_uniq<IcebergToPaimonGlobalState>();
+}
+
+static void IcebergToPaimonFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &bind_data = data.bind_data->Cast<IcebergToPaimonBindData>();
+	auto &global_state = data.global_state->Cast<IcebergToPaimonGlobalState>();
+	if (global_state.finished) {
+		return;
+	}
+	global_state.finished = true;
+
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto &paimon_path = bind_data.paimon_path;
+	if (PaimonTableMetadata::LoadLatestSchema(paimon_path, fs) ||
+	    PaimonTableMetadata::FindLatestSnapshotId(paimon_path, fs) != 0) {
+		throw InvalidInputException("Can't migrate to \"%s\", it already holds a Paimon table", paimon_path);
+	}
+
+	IcebergMultiFileList file_list(context, nullptr, bind_data.iceberg_path, bind_data.options);
+	vector<LogicalType> types;
+	vector<string> column_names;
+	file_list.Bind(types, column_names);
+	if (!file_list.delete_manifests.empty()) {
+		throw NotImplementedException("Migrating Iceberg tables with delete files to Paimon, rewrite the table's data "
+		                              "files to apply the deletes first");
+	}
+	auto &metadata = file_list.GetMetadata();
+	auto &iceberg_schema = file_list.GetSchema();
+	VerifyColumnNames(metadata, iceberg_schema);
+	IcebergPartitionConverter partitions(metadata, iceberg_schema);
+
+	PaimonSchema schema;
+	schema.id = 0;
+	schema.partition_keys = partitions.partition_keys;
+	//! A bucket-unaware append table, data files are not assigned to buckets by key
+	schema.options["bucket"] = "-1";
+	schema.options["file.format"] = "parquet";
+	PaimonWriteLayout layout(context, paimon_path, schema, column_names, types);
+
+	auto snapshot = file_list.GetSnapshot();
+	auto creation_time = snapshot ? snapshot->timestamp_ms : Timestamp::GetCurrentTimestamp();
+	vector<PaimonManifestEntry> entries;
+	int64_t record_count = 0;
+	//! Expands all data files of the snapshot into 'data_files'. Paimon reads the files in their 'file.format', so
+	//! other formats than Parquet are rejected.
+	auto file_count = file_list.GetTotalFileCount();
+	for (idx_t file_idx = 0; file_idx < file_count; file_idx++) {
+		auto &data_file = file_list.data_files[file_idx];
+		if (!StringUtil::CIEquals(data_file.file_format, "parquet")) {
+			throw NotImplementedException("Migrating Iceberg data file \"%s\" in format '%s' to Paimon, only Parquet "
+			                              "data files are supported",
+			                              data_file.file_path, data_file.file_format);
+		}
+		auto file_path = bind_data.options.allow_moved_paths
+		                     ? IcebergUtils::GetFullPath(file_list.GetPath(), data_file.file_path, fs)
+		                     : data_file.file_path;
+
+		PaimonManifestEntry entry;
+		entry.kind = PaimonFileKind::ADD;
+		entry.partition = partitions.Convert(data_file);
+		entry.bucket = 0;
+		entry.totalBuckets = layout.total_buckets;
+		auto &meta = entry.file;
+		meta.fileName = file_path.substr(file_path.find_last_of('/') + 1);
+		meta.externalPath = file_path;
+		meta.fileSize = data_file.file_size_in_bytes;
+		meta.rowCount = data_file.record_count;
+		meta.minKey = PaimonBinaryRow::EmptyRow();
+		meta.maxKey = PaimonBinaryRow::EmptyRow();
+		meta.keyStats = SimpleStats::Empty();
+		meta.valueStats = ConvertStats(data_file, iceberg_schema);
+		//! Like Paimon's append writers, every row takes a sequence number
+		auto row_count = NumericCast<idx_t>(data_file.record_count);
+		meta.minSequenceNumber = layout.ReserveSequenceNumbers(entry.partition, entry.bucket, row_count);
+		meta.maxSequenceNumber = meta.minSequenceNumber + MaxValue<int64_t>(data_file.record_count - 1, 0);
+		meta.schemaId = schema.id;
+		meta.level = 0;
+		meta.creationTime = creation_time;
+		meta.deleteRowCount = 0;
+		meta.fileSource = FileSource::APPEND;
+		record_count += data_file.record_count;
+		entries.push_back(std::move(entry));
+	}
+
+	WritePaimonSchema(fs, paimon_path, iceberg_schema, schema);
+	int64_t snapshot_id = 0;
+	if (!entries.empty()) {
+		PaimonCommit commit(context, layout);
+		snapshot_id = commit.Commit(entries, PaimonCommitKind::APPEND);
+	}
+
+	output.SetValue(0, 0, Value::BIGINT(snapshot_id));
+	output.SetValue(1, 0, Value::BIGINT(NumericCast<int64_t>(entries.size())));
+	output.SetValue(2, 0, Value::BIGINT(record_count));
+	output.SetCardinality(1);
+}
+
+TableFunctionSet IcebergFunctions::GetIcebergToPaimonFunction() {
+	TableFunctionSet function_set("iceberg_to_paimon");
+
+	auto fun = TableFunction({LogicalType::VARCHAR, LogicalType::VARCHAR}, IcebergToPaimonFunction,
+	                         IcebergToPaimonBind, IcebergToPaimonInitGlobal);
+	fun.named_parameters["allow_moved_paths"] = LogicalType::BOOLEAN;
+	fun.named_parameters["metadata_compression_codec"] = LogicalType::VARCHAR;
+	fun.named_parameters["version"] = LogicalType::VARCHAR;
+	fun.named_parameters["version_name_format"] = LogicalType::VARCHAR;
+	fun.named_parameters["snapshot_from_timestamp"] = LogicalType::TIMESTAMP;
+	fun.named_parameters["snapshot_from_id"] = LogicalType::UBIGINT;
+	function_set.AddFunction(fun);
+
+	return function_set;
+}
+
+} // namespace duckdb
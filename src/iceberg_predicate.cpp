@@ -3,6 +3,8 @@
 #include "duckdb/planner/filter/conjunction_filter.hpp"
 #include "duckdb/planner/filter/null_filter.hpp"
 #include "duckdb/planner/filter/expression_filter.hpp"
+#include "duckdb/common/operator/comparison_operators.hpp"
+#include "duckdb/common/optional_idx.hpp"
 
 namespace duckdb {
 
@@ -121,4 +123,322 @@ bool IcebergPredicate::MatchBounds(const TableFilter &filter, const IcebergPredi
 	}
 }
 
+namespace {
+
+IcebergBoundsEncoding GetBoundsEncoding(const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::INTEGER:
+	case LogicalTypeId::DATE:
+		return IcebergBoundsEncoding::INT32;
+	case LogicalTypeId::BIGINT:
+	case LogicalTypeId::TIME:
+	case LogicalTypeId::TIMESTAMP:
+	case LogicalTypeId::TIMESTAMP_TZ:
+		return IcebergBoundsEncoding::INT64;
+	case LogicalTypeId::FLOAT:
+		return IcebergBoundsEncoding::FLOAT;
+	case LogicalTypeId::DOUBLE:
+		return IcebergBoundsEncoding::DOUBLE;
+	case LogicalTypeId::BOOLEAN:
+		return IcebergBoundsEncoding::BOOLEAN;
+	case LogicalTypeId::VARCHAR:
+		return IcebergBoundsEncoding::STRING;
+	default:
+		return IcebergBoundsEncoding::VALUE;
+	}
+}
+
+//! Same as IdentityTransform, with the comparison operators of DuckDB, which order NaN above every other value
+template <class T>
+bool CompareBounds(ExpressionType comparison, const T &constant, const T &lower_bound, const T &upper_bound) {
+	switch (comparison) {
+	case ExpressionType::COMPARE_EQUAL:
+		return GreaterThanEquals::Operation(constant, lower_bound) && LessThanEquals::Operation(constant, upper_bound);
+	case ExpressionType::COMPARE_GREATERTHAN:
+		return GreaterThan::Operation(upper_bound, constant);
+	case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+		return GreaterThanEquals::Operation(upper_bound, constant);
+	case ExpressionType::COMPARE_LESSTHAN:
+		return LessThan::Operation(lower_bound, constant);
+	case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+		return LessThanEquals::Operation(lower_bound, constant);
+	default:
+		return true;
+	}
+}
+
+template <class T>
+bool TryLoadBound(const string_t &blob, T &result) {
+	if (blob.GetSize() != sizeof(T)) {
+		return false;
+	}
+	memcpy(&result, blob.GetData(), sizeof(T));
+	return true;
+}
+
+template <>
+bool TryLoadBound(const string_t &blob, bool &result) {
+	if (blob.GetSize() != 1) {
+		return false;
+	}
+	result = blob.GetData()[0] != '\0';
+	return true;
+}
+
+template <class T>
+bool TryCompareBounds(ExpressionType comparison, const T &constant, const string_t &lower_blob,
+                      const string_t &upper_blob, bool &result) {
+	T lower_bound;
+	T upper_bound;
+	if (!TryLoadBound(lower_blob, lower_bound) || !TryLoadBound(upper_blob, upper_bound)) {
+		return false;
+	}
+	result = CompareBounds<T>(comparison, constant, lower_bound, upper_bound);
+	return true;
+}
+
+bool MatchesNullCheck(const IcebergPruningInstruction &instruction, bool has_null, bool has_not_null) {
+	return instruction.type == ExpressionType::OPERATOR_IS_NULL ? has_null : has_not_null;
+}
+
+optional_ptr<const Value> FindBound(const unordered_map<int32_t, Value> &bounds, int32_t field_id) {
+	auto it = bounds.find(field_id);
+	if (it == bounds.end()) {
+		return nullptr;
+	}
+	return it->second;
+}
+
+} // namespace
+
+bool IcebergPruningInstruction::MatchBounds(const Value &lower_bound, const Value &upper_bound) const {
+	D_ASSERT(!IsNullCheck());
+	if (lower_bound.IsNull() || upper_bound.IsNull()) {
+		//! Can't compare when there are no bounds
+		return true;
+	}
+
+	auto lower_blob = lower_bound.GetValueUnsafe<string_t>();
+	auto upper_blob = upper_bound.GetValueUnsafe<string_t>();
+	bool result;
+	switch (encoding) {
+	case IcebergBoundsEncoding::INT32:
+		if (TryCompareBounds(type, static_cast<int32_t>(integer_constant), lower_blob, upper_blob, result)) {
+			return result;
+		}
+		break;
+	case IcebergBoundsEncoding::INT64:
+		if (TryCompareBounds(type, integer_constant, lower_blob, upper_blob, result)) {
+			return result;
+		}
+		break;
+	case IcebergBoundsEncoding::FLOAT:
+		if (TryCompareBounds(type, static_cast<float>(floating_constant), lower_blob, upper_blob, result)) {
+			return result;
+		}
+		break;
+	case IcebergBoundsEncoding::DOUBLE:
+		if (TryCompareBounds(type, floating_constant, lower_blob, upper_blob, result)) {
+			return result;
+		}
+		break;
+	case IcebergBoundsEncoding::BOOLEAN:
+		if (TryCompareBounds(type, integer_constant != 0, lower_blob, upper_blob, result)) {
+			return result;
+		}
+		break;
+	case IcebergBoundsEncoding::STRING: {
+		string_t constant_string(string_constant.c_str(), UnsafeNumericCast<uint32_t>(string_constant.size()));
+		return CompareBounds<string_t>(type, constant_string, lower_blob, upper_blob);
+	}
+	case IcebergBoundsEncoding::VALUE:
+		break;
+	}
+
+	//! The other types, and the bounds written before a type promotion, are compared as deserialized Values
+	auto stats = IcebergPredicateStats::DeserializeBounds(lower_bound, upper_bound, name, column_type);
+	return CompareBounds<Value>(type, constant, stats.lower_bound, stats.upper_bound);
+}
+
+void IcebergPruningProgram::AddFilter(const TableFilter &filter, idx_t source, const string &name,
+                                      const LogicalType &type) {
+	IcebergPruningInstruction instruction;
+	instruction.source = source;
+	instruction.name = name;
+	instruction.column_type = type;
+
+	switch (filter.filter_type) {
+	case TableFilterType::CONSTANT_COMPARISON: {
+		auto &constant_filter = filter.Cast<ConstantFilter>();
+		auto &constant = constant_filter.constant;
+		switch (constant_filter.comparison_type) {
+		case ExpressionType::COMPARE_EQUAL:
+		case ExpressionType::COMPARE_GREATERTHAN:
+		case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+		case ExpressionType::COMPARE_LESSTHAN:
+		case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+			break;
+		default:
+			//! Can't be used for pruning
+			return;
+		}
+		if (constant.IsNull()) {
+			return;
+		}
+		instruction.type = constant_filter.comparison_type;
+		instruction.constant = constant;
+		if (constant.type() == type) {
+			instruction.encoding = GetBoundsEncoding(type);
+		}
+		switch (instruction.encoding) {
+		case IcebergBoundsEncoding::INT32:
+			instruction.integer_constant = constant.GetValueUnsafe<int32_t>();
+			break;
+		case IcebergBoundsEncoding::INT64:
+			instruction.integer_constant = constant.GetValueUnsafe<int64_t>();
+			break;
+		case IcebergBoundsEncoding::FLOAT:
+			instruction.floating_constant = constant.GetValueUnsafe<float>();
+			break;
+		case IcebergBoundsEncoding::DOUBLE:
+			instruction.floating_constant = constant.GetValueUnsafe<double>();
+			break;
+		case IcebergBoundsEncoding::BOOLEAN:
+			instruction.integer_constant = constant.GetValueUnsafe<bool>();
+			break;
+		case IcebergBoundsEncoding::STRING:
+			instruction.string_constant = StringValue::Get(constant);
+			break;
+		case IcebergBoundsEncoding::VALUE:
+			break;
+		}
+		instructions.push_back(std::move(instruction));
+		return;
+	}
+	case TableFilterType::CONJUNCTION_AND: {
+		auto &conjunction_and_filter = filter.Cast<ConjunctionAndFilter>();
+		for (auto &child : conjunction_and_filter.child_filters) {
+			AddFilter(*child, source, name, type);
+		}
+		return;
+	}
+	case TableFilterType::IS_NULL:
+		instruction.type = ExpressionType::OPERATOR_IS_NULL;
+		instructions.push_back(std::move(instruction));
+		return;
+	case TableFilterType::IS_NOT_NULL:
+		instruction.type = ExpressionType::OPERATOR_IS_NOT_NULL;
+		instructions.push_back(std::move(instruction));
+		return;
+	case TableFilterType::EXPRESSION_FILTER: {
+		auto &expression_filter = filter.Cast<ExpressionFilter>();
+		auto &expr = *expression_filter.expr;
+		if (expr.type == ExpressionType::OPERATOR_IS_NULL || expr.type == ExpressionType::OPERATOR_IS_NOT_NULL) {
+			instruction.type = expr.type;
+			instructions.push_back(std::move(instruction));
+		}
+		return;
+	}
+	default:
+		//! Can't be used for pruning
+		return;
+	}
+}
+
+void IcebergPruningProgram::AddTransformFilter(const TableFilter &filter, idx_t field_idx, const string &name,
+                                               const LogicalType &type, const IcebergTransform &transform) {
+	switch (transform.Type()) {
+	case IcebergTransformType::BUCKET:
+	case IcebergTransformType::TRUNCATE:
+	case IcebergTransformType::VOID:
+		//! Never used for pruning, see IcebergPredicate::MatchBounds
+		return;
+	default:
+		break;
+	}
+	TransformFilter transform_filter;
+	transform_filter.filter = filter.Copy();
+	transform_filter.field_idx = field_idx;
+	transform_filter.name = name;
+	transform_filter.type = type;
+	transform_filter.transform = transform;
+	transform_filters.push_back(std::move(transform_filter));
+}
+
+bool IcebergPruningProgram::MatchesDataFile(const IcebergManifestEntry &data_file) const {
+	D_ASSERT(transform_filters.empty());
+	if (data_file.lower_bounds.empty() || data_file.upper_bounds.empty()) {
+		//! There are no bounds statistics for the file, can't filter
+		return true;
+	}
+
+	//! The instructions of a column are next to each other, its bounds are only looked up once
+	optional_idx current_source;
+	optional_ptr<const Value> lower_bound;
+	optional_ptr<const Value> upper_bound;
+	for (auto &instruction : instructions) {
+		auto field_id = NumericCast<int32_t>(instruction.source);
+		if (instruction.IsNullCheck()) {
+			int64_t value_count = 0;
+			auto value_counts_it = data_file.value_counts.find(field_id);
+			if (value_counts_it != data_file.value_counts.end()) {
+				value_count = value_counts_it->second;
+			}
+			bool has_null = false;
+			bool has_not_null = value_count > 0;
+			auto null_counts_it = data_file.null_value_counts.find(field_id);
+			if (null_counts_it != data_file.null_value_counts.end()) {
+				has_null = null_counts_it->second != 0;
+				has_not_null = (value_count - null_counts_it->second) > 0;
+			}
+			if (!MatchesNullCheck(instruction, has_null, has_not_null)) {
+				return false;
+			}
+			continue;
+		}
+
+		if (!current_source.IsValid() || current_source.GetIndex() != instruction.source) {
+			current_source = instruction.source;
+			lower_bound = FindBound(data_file.lower_bounds, field_id);
+			upper_bound = FindBound(data_file.upper_bounds, field_id);
+		}
+		if (!lower_bound || !upper_bound) {
+			continue;
+		}
+		if (!instruction.MatchBounds(*lower_bound, *upper_bound)) {
+			//! If any predicate fails, exclude the file
+			return false;
+		}
+	}
+	return true;
+}
+
+bool IcebergPruningProgram::MatchesPartitions(const vector<FieldSummary> &field_summaries) const {
+	for (auto &instruction : instructions) {
+		auto &field_summary = field_summaries[instruction.source];
+		if (instruction.IsNullCheck()) {
+			//! Not enough information in the field summary to determine if it has non-NULL values
+			if (!MatchesNullCheck(instruction, field_summary.contains_null, true)) {
+				return false;
+			}
+			continue;
+		}
+		if (!instruction.MatchBounds(field_summary.lower_bound, field_summary.upper_bound)) {
+			return false;
+		}
+	}
+	for (auto &transform_filter : transform_filters) {
+		auto &field_summary = field_summaries[transform_filter.field_idx];
+		auto stats = IcebergPredicateStats::DeserializeBounds(field_summary.lower_bound, field_summary.upper_bound,
+		                                                      transform_filter.name, transform_filter.type);
+		stats.has_nan = field_summary.contains_nan;
+		stats.has_null = field_summary.contains_null;
+		stats.has_not_null = true;
+		if (!IcebergPredicate::MatchBounds(*transform_filter.filter, stats, transform_filter.transform)) {
+			return false;
+		}
+	}
+	return true;
+}
+
 } // namespace duckdb
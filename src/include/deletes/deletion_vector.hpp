@@ -12,19 +12,16 @@ public:
 
 public:
 	static unique_ptr<IcebergDeletionVector> FromBlob(data_ptr_t blob_start, idx_t blob_length);
+	//! Select the rows in [start_row_index, start_row_index + count) whose position is not set in 'bitmaps', which
+	//! hold the low bits of the positions by their high bits
+	static idx_t FilterBitmaps(const unordered_map<int32_t, roaring::Roaring> &bitmaps, row_t start_row_index,
+	                           idx_t count, SelectionVector &result_sel);
 
 public:
 	idx_t Filter(row_t start_row_index, idx_t count, SelectionVector &result_sel) override;
 
 public:
 	unordered_map<int32_t, roaring::Roaring> bitmaps;
-
-	//! State shared between Filter calls
-	roaring::BulkContext bulk_context;
-	optional_ptr<roaring::Roaring> current_bitmap;
-	bool has_current_high = false;
-	//! High bits of the current bitmap (the key in the map)
-	int32_t current_high;
 };
 
 } // namespace duckdb
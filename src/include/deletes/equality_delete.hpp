@@ -1,53 +1,54 @@
 #pragma once
 
-#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/string_map_set.hpp"
 #include "duckdb/common/vector.hpp"
+#include "duckdb/common/types/string_heap.hpp"
 #include "duckdb/common/types/value.hpp"
+#include "duckdb/common/types/vector.hpp"
 #include "duckdb/common/typedefs.hpp"
-#include "duckdb/planner/expression.hpp"
 
 namespace duckdb {
 
 using sequence_number_t = int64_t;
 
-struct IcebergEqualityDeleteRow {
+//! The equality deletes with the same 'equality_ids' of a partition, hashed on the normalized sort keys of their key
+//! tuples. A data row is deleted if its key matches a delete with a higher sequence number than its data file, so
+//! only the highest sequence number of each key is kept.
+struct IcebergEqualityDeleteSet {
 public:
-	IcebergEqualityDeleteRow() {
+	IcebergEqualityDeleteSet(vector<int32_t> equality_ids, vector<LogicalType> types, vector<idx_t> result_columns)
+	    : equality_ids(std::move(equality_ids)), types(std::move(types)), result_columns(std::move(result_columns)) {
 	}
-	IcebergEqualityDeleteRow(const IcebergEqualityDeleteRow &) = delete;
-	IcebergEqualityDeleteRow &operator=(const IcebergEqualityDeleteRow &) = delete;
-	IcebergEqualityDeleteRow(IcebergEqualityDeleteRow &&) = default;
-	IcebergEqualityDeleteRow &operator=(IcebergEqualityDeleteRow &&) = default;
 
 public:
-	//! Map of field-id to equality delete for the field
-	//! NOTE: these are either OPERATOR_IS_NULL or COMPARE_EQUAL
-	//! Also note: it's probably easiest to apply these to the 'output_chunk' of FinalizeChunk, so we can re-use
-	//! expressions. Otherwise the idx of the BoundReferenceExpression would have to change for every file.
-	unordered_map<int32_t, unique_ptr<Expression>> filters;
-};
-
-struct IcebergEqualityDeleteFile {
-public:
-	IcebergEqualityDeleteFile(vector<pair<int32_t, Value>> partition_values, int32_t partition_spec_id)
-	    : partition_values(partition_values), partition_spec_id(partition_spec_id) {
-	}
-
-public:
-	//! The partition value (struct) if the equality delete has partition information
-	vector<pair<int32_t, Value>> partition_values;
-	int32_t partition_spec_id;
-	vector<IcebergEqualityDeleteRow> rows;
-};
-
-struct IcebergEqualityDeleteData {
-public:
-	IcebergEqualityDeleteData(sequence_number_t sequence_number) : sequence_number(sequence_number) {
+	idx_t KeyCount() const {
+		return sequence_numbers.size();
 	}
+	//! Add 'count' deletes, 'keys' are the key columns, cast to 'types'
+	void Add(Vector keys[], idx_t count, sequence_number_t sequence_number);
+	//! Add the deletes of 'other', which has the same 'equality_ids'
+	void Merge(const IcebergEqualityDeleteSet &other);
+	//! Select the rows of 'keys' that are not deleted, for a data file with 'sequence_number'
+	idx_t Filter(Vector keys[], idx_t count, sequence_number_t sequence_number, SelectionVector &result_sel) const;
+
+private:
+	void AddKey(const string_t &key, sequence_number_t sequence_number);
+	//! Compute the sort keys of the key columns into the BLOB vector 'sort_keys', equal keys (NULLs included) have
+	//! equal sort keys
+	void CreateSortKeys(Vector keys[], idx_t count, Vector &sort_keys) const;
 
 public:
-	sequence_number_t sequence_number;
-	vector<IcebergEqualityDeleteFile> files;
+	//! The field ids of the key columns
+	vector<int32_t> equality_ids;
+	//! The (global) types of the key columns
+	vector<LogicalType> types;
+	//! The column of the scan's output chunk that holds each key column
+	vector<idx_t> result_columns;
+
+private:
+	//! The sort key of every key -> the highest sequence number of its deletes. The sort keys live in 'key_data'.
+	string_map_t<sequence_number_t> sequence_numbers;
+	StringHeap key_data;
 };
 
 } // namespace duckdb
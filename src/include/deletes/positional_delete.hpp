@@ -1,6 +1,8 @@
 #pragma once
 
 #include "duckdb/common/multi_file/multi_file_data.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include <roaring/roaring.hh>
 
 namespace duckdb {
 
@@ -10,27 +12,19 @@ public:
 	}
 
 public:
-	void AddRow(int64_t row_id) {
-		temp_invalid_rows.insert(row_id);
-	}
+	//! Add the deleted positions 'row_ids', at most STANDARD_VECTOR_SIZE
+	void AddRows(const int64_t *row_ids, idx_t count);
+	//! Add the deleted positions of 'other'
+	void Merge(const IcebergPositionalDeleteData &other);
+	//! Compress the bitmaps once all the deletes have been added
+	void Finalize();
 
-	idx_t Filter(row_t start_row_index, idx_t count, SelectionVector &result_sel) override {
-		if (count == 0) {
-			return 0;
-		}
-		result_sel.Initialize(STANDARD_VECTOR_SIZE);
-		idx_t selection_idx = 0;
-		for (idx_t i = 0; i < count; i++) {
-			if (!temp_invalid_rows.count(i + start_row_index)) {
-				result_sel.set_index(selection_idx++, i);
-			}
-		}
-		return selection_idx;
-	}
+	idx_t Filter(row_t start_row_index, idx_t count, SelectionVector &result_sel) override;
 
 public:
-	//! Store invalid rows here before finalizing into a SelectionVector
-	unordered_set<int64_t> temp_invalid_rows;
+	//! The deleted positions, split into bitmaps of the low bits by the high bits of the position, like the
+	//! deletion vectors
+	unordered_map<int32_t, roaring::Roaring> bitmaps;
 };
 
 } // namespace duckdb
@@ -25,6 +25,7 @@ private:
 	static TableFunctionSet GetIcebergScanFunction(ExtensionLoader &instance);
 	static TableFunctionSet GetIcebergMetadataFunction();
 	static TableFunctionSet GetIcebergToDuckLakeFunction();
+	static TableFunctionSet GetIcebergToPaimonFunction();
 };
 
 } // namespace duckdb
@@ -11,25 +11,90 @@
 #include "duckdb/common/multi_file/multi_file_list.hpp"
 #include "duckdb/common/types/batched_data_collection.hpp"
 #include "iceberg_metadata.hpp"
+#include "iceberg_predicate.hpp"
 #include "iceberg_utils.hpp"
 #include "manifest_reader.hpp"
 
 #include "duckdb/common/multi_file/multi_file_data.hpp"
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/error_data.hpp"
 #include "duckdb/common/list.hpp"
 #include "duckdb/common/unordered_map.hpp"
 #include "duckdb/planner/filter/constant_filter.hpp"
 #include "duckdb/planner/filter/null_filter.hpp"
 #include "duckdb/planner/table_filter.hpp"
 
+#include "deletes/deletion_vector.hpp"
 #include "deletes/equality_delete.hpp"
 #include "deletes/positional_delete.hpp"
+#include "metadata/iceberg_predicate_stats.hpp"
+
+#include <condition_variable>
 
 namespace duckdb {
 
+class TaskExecutor;
+
+enum class IcebergManifestSlotState : uint8_t { PENDING, CLAIMED, READY };
+
+//! A data manifest of the snapshot, decoded ahead of the scan by a background task, or by the scan thread that needs
+//! it first if no task has picked it up yet. Once 'state' is READY, 'entries' and 'error' are no longer written.
+struct IcebergManifestSlot {
+	atomic<IcebergManifestSlotState> state {IcebergManifestSlotState::PENDING};
+	//! The data files of the manifest that pass the filters
+	vector<IcebergManifestEntry> entries;
+	ErrorData error;
+};
+
+//! A delete file of the snapshot, read once the first data file it applies to is opened. Once 'state' is READY, the
+//! deletes of the file have been added to the delete data of the IcebergMultiFileList, or 'error' is set.
+struct IcebergDeleteFileSlot {
+	explicit IcebergDeleteFileSlot(IcebergManifestEntry entry_p) : entry(std::move(entry_p)) {
+	}
+
+	IcebergManifestEntry entry;
+	atomic<IcebergManifestSlotState> state {IcebergManifestSlotState::PENDING};
+	//! For equality delete files, the bounds of the equality columns, in the order of 'entry.equality_ids'
+	vector<IcebergPredicateStats> equality_bounds;
+	//! For equality delete files, the deletes read from the file until they are merged into their partition
+	unique_ptr<IcebergEqualityDeleteSet> equality_deletes;
+	ErrorData error;
+};
+
+//! The delete files of a partition, ordered by descending sequence number
+struct IcebergPartitionDeletes {
+	vector<idx_t> positional;
+	vector<idx_t> equality;
+	//! The equality delete files are read together, when the first data file they apply to is opened, and merged
+	//! into one hash table per set of equality ids. Once 'equality_state' is READY, 'equality_sets' are no longer
+	//! written.
+	atomic<IcebergManifestSlotState> equality_state {IcebergManifestSlotState::PENDING};
+	vector<unique_ptr<IcebergEqualityDeleteSet>> equality_sets;
+	ErrorData equality_error;
+};
+
+//! Index over the delete files of the snapshot, built from the delete manifests when the first data file is opened.
+//! Indexes refer to 'files'.
+struct IcebergDeleteFileIndex {
+	vector<unique_ptr<IcebergDeleteFileSlot>> files;
+	//! Deletion vectors, and positional delete files whose 'file_path' bounds are equal, by the data file they target
+	case_insensitive_map_t<vector<idx_t>> by_data_file;
+	//! The other delete files by partition, the ones of unpartitioned specs apply to all data files and are stored
+	//! under the empty key
+	unordered_map<string, IcebergPartitionDeletes> partitions;
+	//! The deletion vectors of each Puffin file, ordered by their offset in the file
+	case_insensitive_map_t<vector<idx_t>> puffin_files;
+
+public:
+	//! The most bytes of a Puffin file read at once, to read the deletion vectors stored next to each other together
+	static constexpr int64_t MAX_PUFFIN_READ_SIZE = 16LL * 1024LL * 1024LL;
+};
+
 struct IcebergMultiFileList : public MultiFileList {
 public:
 	IcebergMultiFileList(ClientContext &context, shared_ptr<IcebergScanInfo> scan_info, const string &path,
 	                     const IcebergOptions &options);
+	~IcebergMultiFileList() override;
 
 public:
 	static string ToDuckDBPath(const string &raw_path);
@@ -42,17 +107,35 @@ public:
 
 	void Bind(vector<LogicalType> &return_types, vector<string> &names);
 	unique_ptr<IcebergMultiFileList> PushdownInternal(ClientContext &context, TableFilterSet &new_filters) const;
-	void ScanPositionalDeleteFile(DataChunk &result) const;
+	void ScanPositionalDeleteFile(DataChunk &result,
+	                              case_insensitive_map_t<unique_ptr<IcebergPositionalDeleteData>> &deletes) const;
 	void ScanEqualityDeleteFile(const IcebergManifestEntry &entry, DataChunk &result,
 	                            vector<MultiFileColumnDefinition> &columns,
 	                            const vector<MultiFileColumnDefinition> &global_columns,
-	                            const vector<ColumnIndex> &column_indexes) const;
+	                            const vector<ColumnIndex> &column_indexes,
+	                            unique_ptr<IcebergEqualityDeleteSet> &deletes) const;
 	void ScanDeleteFile(const IcebergManifestEntry &entry, const vector<MultiFileColumnDefinition> &global_columns,
-	                    const vector<ColumnIndex> &column_indexes) const;
-	void ScanPuffinFile(const IcebergManifestEntry &entry) const;
-	unique_ptr<DeleteFilter> GetPositionalDeletesForFile(const string &file_path) const;
-	void ProcessDeletes(const vector<MultiFileColumnDefinition> &global_columns,
-	                    const vector<ColumnIndex> &column_indexes) const;
+	                    const vector<ColumnIndex> &column_indexes,
+	                    unique_ptr<IcebergEqualityDeleteSet> &equality_deletes) const;
+	//! Read the deletion vectors 'entries', stored in the same Puffin file
+	void ScanPuffinFile(const vector<reference<const IcebergManifestEntry>> &entries) const;
+	//! Read the delete files that apply to data file 'file_id', in parallel, and take its positional deletes out of
+	//! the delete data. Its equality deletes are stored in 'equality_deletes_by_file', for FinalizeChunk.
+	unique_ptr<DeleteFilter> LoadDeletesForFile(idx_t file_id, const IcebergManifestEntry &data_file,
+	                                            const vector<MultiFileColumnDefinition> &global_columns,
+	                                            const vector<ColumnIndex> &column_indexes) const;
+	//! Claim the unclaimed deletion vectors stored near deletion vector 'delete_idx' in its Puffin file, so they are
+	//! read together with it. Returns the claimed deletion vectors, including 'delete_idx'.
+	vector<idx_t> ClaimDeletionVectors(idx_t delete_idx) const;
+	//! Read delete file 'delete_idx' of the index, unless another thread claimed it first
+	bool TryLoadDeleteFile(idx_t delete_idx, const vector<MultiFileColumnDefinition> &global_columns,
+	                       const vector<ColumnIndex> &column_indexes) const;
+	//! Read the equality delete files of 'deletes' into its hash tables, unless another thread claimed them first
+	bool TryLoadEqualityDeletes(IcebergPartitionDeletes &deletes,
+	                            const vector<MultiFileColumnDefinition> &global_columns,
+	                            const vector<ColumnIndex> &column_indexes) const;
+	//! Read the entries of delete manifest 'manifest_idx'
+	void ReadDeleteManifest(idx_t manifest_idx, vector<IcebergManifestEntry> &result) const;
 
 public:
 	//! MultiFileList API
@@ -71,16 +154,48 @@ public:
 protected:
 	//! Get the i-th expanded file
 	OpenFileInfo GetFile(idx_t i) override;
-	OpenFileInfo GetFileInternal(idx_t i, lock_guard<mutex> &guard);
+	OpenFileInfo GetFileInternal(idx_t i, std::unique_lock<mutex> &guard);
 
 protected:
 	bool ManifestMatchesFilter(const IcebergManifest &manifest);
-	bool FileMatchesFilter(const IcebergManifestEntry &file);
+	bool FileMatchesFilter(const IcebergManifestEntry &file) const;
+	//! Compile the filters on the source columns of the fields of 'partition_spec'
+	IcebergPruningProgram CompilePartitionProgram(const IcebergPartitionSpec &partition_spec);
+	//! Compile the filters on the top-level columns into 'data_file_program'
+	void CompileDataFileProgram();
 	// TODO: How to guarantee we only call this after the filter pushdown?
-	void InitializeFiles(lock_guard<mutex> &guard);
+	void InitializeFiles(std::unique_lock<mutex> &guard);
 
-	//! NOTE: this requires the lock because it modifies the 'data_files' vector, potentially invalidating references
-	optional_ptr<const IcebergManifestEntry> GetDataFile(idx_t file_id, lock_guard<mutex> &guard);
+	//! NOTE: this requires the lock because it modifies the 'data_files' vector, potentially invalidating references.
+	//! The lock is released while a data manifest is decoded or waited on, and held again when this returns.
+	optional_ptr<const IcebergManifestEntry> GetDataFile(idx_t file_id, std::unique_lock<mutex> &guard);
+	//! Remove the data files that are filtered out, or that belong to a puffin file, from 'entries'
+	void FilterDataFiles(vector<IcebergManifestEntry> &entries);
+
+public:
+	//! Decode data manifest 'manifest_idx' into its slot, unless another thread claimed it first
+	bool TryReadDataManifest(idx_t manifest_idx);
+
+protected:
+	//! Schedule background reads of the data manifests, up to 'prefetch_manifests' ahead of the next one consumed
+	void ScheduleDataManifestReads(std::unique_lock<mutex> &guard);
+	//! The slot of data manifest 'manifest_idx', decoding it on this thread if no task has started on it yet
+	IcebergManifestSlot &WaitForDataManifest(idx_t manifest_idx);
+
+	//! NOTE: these require the 'delete_lock'
+	//! Read the delete manifests in parallel and index their entries into 'delete_index'
+	void InitializeDeleteIndex() const;
+	//! The positional delete files of 'delete_index', and the partitions whose equality deletes, apply to 'data_file'
+	void GetDeleteFilesForDataFile(const IcebergManifestEntry &data_file, vector<idx_t> &positional_deletes,
+	                               vector<reference<IcebergPartitionDeletes>> &equality_deletes) const;
+	string GetPartitionKey(int32_t partition_spec_id, const vector<pair<int32_t, Value>> &partition_values) const;
+	//! The bounds of column 'field_id' in 'file'. The bounds are NULL if they are unknown, NULLs and NaNs are assumed
+	//! to be present unless the counts say otherwise.
+	IcebergPredicateStats GetColumnBounds(const IcebergManifestEntry &file, int32_t field_id) const;
+	//! Whether the bounds of the equality columns of 'delete_file' overlap the ones of 'data_file', which has its
+	//! bounds cached in 'data_file_bounds'
+	bool EqualityDeletesMayApply(const IcebergDeleteFileSlot &delete_file, const IcebergManifestEntry &data_file,
+	                             unordered_map<int32_t, IcebergPredicateStats> &data_file_bounds) const;
 
 public:
 	ClientContext &context;
@@ -94,9 +209,10 @@ public:
 	vector<string> names;
 	vector<LogicalType> types;
 	TableFilterSet table_filters;
-
-	unique_ptr<manifest_file::ManifestFileReader> data_manifest_reader;
-	unique_ptr<manifest_file::ManifestFileReader> delete_manifest_reader;
+	//! The filters on the bounds of the data files, compiled in InitializeFiles
+	IcebergPruningProgram data_file_program;
+	//! partition_spec_id -> the filters on the field summaries of its manifests, compiled for the first one
+	unordered_map<int32_t, IcebergPruningProgram> partition_programs;
 
 	vector<IcebergManifestEntry> data_files;
 	vector<IcebergManifest> data_manifests;
@@ -106,16 +222,35 @@ public:
 	idx_t transaction_data_idx = 0;
 	idx_t transaction_delete_idx = 0;
 
-	vector<IcebergManifest>::iterator current_data_manifest;
-	mutable vector<IcebergManifest>::iterator current_delete_manifest;
+	//! One slot per entry of 'data_manifests', created when the first data file is requested
+	vector<unique_ptr<IcebergManifestSlot>> data_manifest_slots;
+	//! The next data manifest whose entries go to 'current_data_files'
+	idx_t next_data_manifest = 0;
+	//! The data manifests handed to background tasks so far
+	idx_t scheduled_data_manifests = 0;
+	//! How many data manifests are decoded ahead of the scan
+	idx_t prefetch_manifests = 0;
+	unique_ptr<TaskExecutor> manifest_executor;
+	//! Protects the transition of a slot to READY, waited on by scan threads that need a manifest being decoded
+	mutex manifest_lock;
+	std::condition_variable manifest_cv;
+	//! Set when the list is destroyed, tasks that did not start yet skip their manifest
+	atomic<bool> cancelled {false};
 	//! The data files of the manifest file that we last scanned
 	idx_t data_file_idx = 0;
 	vector<IcebergManifestEntry> current_data_files;
 
-	//! For each file that has a delete file, the state for processing that/those delete file(s)
-	mutable case_insensitive_map_t<unique_ptr<DeleteFilter>> positional_delete_data;
-	//! All equality deletes with sequence numbers higher than that of the data_file apply to that data_file
-	mutable map<sequence_number_t, unique_ptr<IcebergEqualityDeleteData>> equality_delete_data;
+	mutable bool delete_index_initialized = false;
+	mutable IcebergDeleteFileIndex delete_index;
+	//! Notified when a delete file slot becomes READY
+	mutable std::condition_variable delete_cv;
+	//! For each data file that has positional deletes and wasn't opened yet, the deletes read so far. Taken out of
+	//! the map when the data file is opened.
+	mutable case_insensitive_map_t<unique_ptr<IcebergPositionalDeleteData>> positional_delete_data;
+	//! Deletion vectors of the data files that weren't opened yet, which replace their positional deletes
+	mutable case_insensitive_map_t<unique_ptr<IcebergDeletionVector>> deletion_vector_data;
+	//! For each opened data file with equality deletes, the hash tables of the equality deletes that can apply to it
+	mutable unordered_map<idx_t, vector<reference<IcebergEqualityDeleteSet>>> equality_deletes_by_file;
 	mutable mutex delete_lock;
 
 	bool initialized = false;
@@ -1,6 +1,8 @@
 #pragma once
 #include "metadata/iceberg_transform.hpp"
 #include "metadata/iceberg_predicate_stats.hpp"
+#include "metadata/iceberg_manifest.hpp"
+#include "metadata/iceberg_manifest_list.hpp"
 #include "duckdb/planner/table_filter.hpp"
 
 namespace duckdb {
@@ -14,4 +16,64 @@ public:
 	                        const IcebergTransform &transform);
 };
 
+//! How an IcebergPruningInstruction reads the serialized bounds of its column
+enum class IcebergBoundsEncoding : uint8_t { INT32, INT64, FLOAT, DOUBLE, BOOLEAN, STRING, VALUE };
+
+//! A comparison or NULL check on the bounds of one column, with its constant converted ahead of time
+struct IcebergPruningInstruction {
+public:
+	//! Whether a column with the serialized bounds 'lower_bound' and 'upper_bound' can have values that pass the
+	//! comparison. Bounds of the common types are compared as their little-endian bytes, the others are deserialized.
+	bool MatchBounds(const Value &lower_bound, const Value &upper_bound) const;
+	bool IsNullCheck() const {
+		return type == ExpressionType::OPERATOR_IS_NULL || type == ExpressionType::OPERATOR_IS_NOT_NULL;
+	}
+
+public:
+	//! The field id of the column for data files, the index of the partition field for manifests
+	idx_t source;
+	//! COMPARE_* for comparisons, OPERATOR_IS_NULL or OPERATOR_IS_NOT_NULL for NULL checks
+	ExpressionType type;
+	IcebergBoundsEncoding encoding = IcebergBoundsEncoding::VALUE;
+	int64_t integer_constant = 0;
+	double floating_constant = 0;
+	string string_constant;
+	//! The constant as a Value, for the bounds that are deserialized
+	Value constant;
+	string name;
+	LogicalType column_type;
+};
+
+//! The filters of a scan on the bounds of data files, or on the partition field summaries of manifests, compiled once
+//! per scan. Conjunctions are flattened into a list of instructions that all have to pass, the filters that can't be
+//! used for pruning are left out.
+class IcebergPruningProgram {
+public:
+	//! Add 'filter' on the column 'source', of type 'type'
+	void AddFilter(const TableFilter &filter, idx_t source, const string &name, const LogicalType &type);
+	//! Add 'filter' on partition field 'field_idx', which has a transform other than identity
+	void AddTransformFilter(const TableFilter &filter, idx_t field_idx, const string &name, const LogicalType &type,
+	                        const IcebergTransform &transform);
+	bool IsEmpty() const {
+		return instructions.empty() && transform_filters.empty();
+	}
+
+	bool MatchesDataFile(const IcebergManifestEntry &data_file) const;
+	//! 'field_summaries' are in the order of the fields of the partition spec the program was compiled for
+	bool MatchesPartitions(const vector<FieldSummary> &field_summaries) const;
+
+private:
+	struct TransformFilter {
+		unique_ptr<TableFilter> filter;
+		idx_t field_idx;
+		string name;
+		LogicalType type;
+		IcebergTransform transform;
+	};
+
+	vector<IcebergPruningInstruction> instructions;
+	//! Filters on partition fields with a transform, matched on the deserialized bounds
+	vector<TransformFilter> transform_filters;
+};
+
 } // namespace duckdb
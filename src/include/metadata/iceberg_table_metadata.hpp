@@ -5,6 +5,7 @@
 #include "metadata/iceberg_partition_spec.hpp"
 #include "metadata/iceberg_table_schema.hpp"
 #include "metadata/iceberg_field_mapping.hpp"
+#include "metadata/iceberg_table_statistics.hpp"
 
 #include "iceberg_options.hpp"
 #include "rest_catalog/objects/table_metadata.hpp"
@@ -60,6 +61,10 @@ public:
 	//! schema_id -> schema
 	unordered_map<int32_t, shared_ptr<IcebergTableSchema>> schemas;
 	vector<IcebergFieldMapping> mappings;
+	//! snapshot_id -> statistics file
+	unordered_map<int64_t, IcebergStatisticsFile> statistics_files;
+	//! Column statistics of the snapshots, built from the manifests and the statistics files on first use
+	shared_ptr<IcebergTableStatisticsCache> statistics_cache = make_shared_ptr<IcebergTableStatisticsCache>();
 };
 
 } // namespace duckdb
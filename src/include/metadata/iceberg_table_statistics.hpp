@@ -0,0 +1,80 @@
+#pragma once
+
+#include "duckdb/common/case_insensitive_map.hpp"
+#include "duckdb/common/map.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/optional_idx.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/storage/statistics/base_statistics.hpp"
+#include "rest_catalog/objects/statistics_file.hpp"
+
+namespace duckdb {
+
+class ClientContext;
+struct IcebergScanInfo;
+
+//! A blob of a statistics file https://iceberg.apache.org/spec/#table-statistics
+struct IcebergBlobMetadata {
+	string type;
+	int64_t snapshot_id;
+	int64_t sequence_number;
+	vector<int32_t> fields;
+	case_insensitive_map_t<string> properties;
+};
+
+//! A Puffin file with statistics of a snapshot https://iceberg.apache.org/spec/#table-statistics
+struct IcebergStatisticsFile {
+public:
+	static IcebergStatisticsFile FromRESTObject(const rest_api_objects::StatisticsFile &statistics_file);
+
+public:
+	int64_t snapshot_id;
+	string statistics_path;
+	int64_t file_size_in_bytes;
+	int64_t file_footer_size_in_bytes;
+	vector<IcebergBlobMetadata> blob_metadata;
+
+public:
+	//! https://iceberg.apache.org/puffin-spec/#apache-datasketches-theta-v1-blob-type
+	static constexpr const char *THETA_SKETCH_BLOB_TYPE = "apache-datasketches-theta-v1";
+};
+
+//! The statistics of the top-level columns of a snapshot, by field id. The min/max and null counts are aggregated
+//! from the bounds and counts of the data files in the manifests, the distinct counts come from the theta sketches
+//! of the statistics file of the snapshot, or of its nearest ancestor that has one.
+class IcebergTableStatistics {
+public:
+	static shared_ptr<IcebergTableStatistics> Build(ClientContext &context, shared_ptr<IcebergScanInfo> scan_info);
+	//! The statistics of column 'field_id', nullptr if nothing is known about the column
+	unique_ptr<BaseStatistics> GetColumnStatistics(int32_t field_id) const;
+
+	//! The estimated distinct count of a serialized compact theta sketch, invalid if the sketch can't be read
+	static optional_idx EstimateThetaSketch(const_data_ptr_t data, idx_t size);
+
+private:
+	unordered_map<int32_t, unique_ptr<BaseStatistics>> columns;
+};
+
+//! The column statistics of the snapshots of a table, built on first use, shared by the copies of its metadata
+class IcebergTableStatisticsCache {
+public:
+	//! The statistics of the snapshot of 'scan_info', nullptr if the table has no snapshot or if the scan includes
+	//! uncommitted changes
+	shared_ptr<IcebergTableStatistics> Get(ClientContext &context, shared_ptr<IcebergScanInfo> scan_info);
+	bool Contains(int64_t snapshot_id, int32_t schema_id);
+
+private:
+	struct IcebergStatisticsEntry {
+		//! Held while the statistics are built
+		mutex build_lock;
+		//! NOTE: this requires the 'lock' of the cache
+		shared_ptr<IcebergTableStatistics> statistics;
+	};
+
+private:
+	mutex lock;
+	//! (snapshot_id, schema_id) -> statistics, built once on first use
+	map<pair<int64_t, int32_t>, shared_ptr<IcebergStatisticsEntry>> snapshots;
+};
+
+} // namespace duckdb
@@ -0,0 +1,69 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// paimon_binary_row.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/common/types/vector.hpp"
+#include "duckdb/common/vector.hpp"
+
+namespace duckdb {
+
+//! Writes rows in Paimon's BinaryRow layout, which is used for partitions, min/max keys and SimpleStats.
+//! The layout is: [null bits (incl. 8 bit header)][8 bytes per field][variable length part], little-endian.
+class PaimonBinaryRowWriter {
+public:
+	explicit PaimonBinaryRowWriter(idx_t arity);
+
+public:
+	void Reset();
+	void SetNullAt(idx_t pos);
+	//! Write 'value' at 'pos', values of unsupported types are written as NULL
+	void WriteValue(idx_t pos, const Value &value);
+	//! Write row 'row' of 'input' at 'pos', reading primitive types straight from the unified format
+	void WriteVector(idx_t pos, Vector &input, const UnifiedVectorFormat &format, idx_t row);
+	//! The row in the 'SerializationUtils.serializeBinaryRow' format (big-endian arity + row bytes)
+	vector<uint8_t> Serialize() const;
+	//! The row bytes, without the arity prefix
+	const vector<uint8_t> &RowBytes() const {
+		return buffer;
+	}
+	//! Matches BinaryRow#hashCode (MurmurHash3 over 4-byte words with seed 42), which Paimon uses for bucketing
+	int32_t HashCode() const;
+
+public:
+	static idx_t NullBitsSizeInBytes(idx_t arity);
+	//! Whether 'type' is stored in the fixed length part only
+	static bool IsFixedLength(const LogicalType &type);
+
+private:
+	idx_t FieldOffset(idx_t pos) const;
+	void WriteFixed(idx_t pos, const_data_ptr_t data, idx_t size);
+	void WriteVariable(idx_t pos, const_data_ptr_t data, idx_t size, idx_t reserved_size);
+	void WriteBytes(idx_t pos, const char *data, idx_t size);
+
+private:
+	idx_t arity;
+	idx_t fixed_size;
+	vector<uint8_t> buffer;
+};
+
+class PaimonBinaryRow {
+public:
+	//! Serialize 'values' into a single row, in the 'serializeBinaryRow' format
+	static vector<uint8_t> Serialize(const vector<Value> &values);
+	//! Deserialize a row produced by 'serializeBinaryRow', NULL values are returned for unsupported types
+	static vector<Value> Deserialize(const_data_ptr_t data, idx_t size, const vector<LogicalType> &types);
+	static vector<Value> Deserialize(const vector<uint8_t> &data, const vector<LogicalType> &types);
+	//! A BinaryRow with zero fields, used for unpartitioned tables and absent stats
+	static vector<uint8_t> EmptyRow();
+	static Value ToBlob(const vector<uint8_t> &data);
+};
+
+} // namespace duckdb
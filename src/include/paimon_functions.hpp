@@ -12,19 +12,33 @@
 
 namespace duckdb {
 class ExtensionLoader;
+class PaimonTableEntry;
 
 class PaimonFunctions {
 public:
     static vector<TableFunctionSet> GetTableFunctions(ExtensionLoader &loader);
     static vector<ScalarFunction> GetScalarFunctions();
+    // The table 'table_name' of an attached Paimon catalog, throws if it is not a Paimon table
+    static PaimonTableEntry &GetPaimonTableEntry(ClientContext &context, const string &table_name);
 
 private:
-    static TableFunctionSet GetPaimonSnapshotsFunction();
     static TableFunctionSet GetPaimonScanFunction(ExtensionLoader &instance);
+    // System tables, in paimon_system_tables.cpp
+    static TableFunctionSet GetPaimonSnapshotsFunction();
     static TableFunctionSet GetPaimonMetadataFunction();
+    static TableFunctionSet GetPaimonFilesFunction();
+    static TableFunctionSet GetPaimonManifestsFunction();
+    static TableFunctionSet GetPaimonPartitionsFunction();
+    static TableFunctionSet GetPaimonBucketsFunction();
     static TableFunctionSet GetPaimonCreateTableFunction();
     static TableFunctionSet GetPaimonInsertFunction();
     static TableFunctionSet GetPaimonAttachFunction();
+    static TableFunctionSet GetPaimonCompactFunction();
+    static TableFunctionSet GetPaimonLookupFunction();
+    static TableFunctionSet GetPaimonExpireSnapshotsFunction();
+    static TableFunctionSet GetPaimonRemoveOrphanFilesFunction();
+    // Metadata-only conversion into a DuckLake catalog, in paimon_to_ducklake.cpp
+    static TableFunctionSet GetPaimonToDuckLakeFunction();
 
     // Simple test function
     static void PaimonTestFunction(DataChunk &args, ExpressionState &state, Vector &result);
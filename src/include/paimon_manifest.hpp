@@ -0,0 +1,70 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// paimon_manifest.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/function/copy_function.hpp"
+
+#include "paimon_metadata.hpp"
+
+namespace duckdb {
+
+class ClientContext;
+
+namespace paimon_manifest {
+
+//! Version of the ManifestEntry and ManifestFileMeta serializers, written in the '_VERSION' column
+static constexpr const int32_t MANIFEST_ENTRY_VERSION = 2;
+static constexpr const int32_t MANIFEST_FILE_META_VERSION = 2;
+static constexpr const int32_t INDEX_MANIFEST_ENTRY_VERSION = 1;
+//! Default 'manifest.target-file-size'
+static constexpr const idx_t DEFAULT_MANIFEST_TARGET_FILE_SIZE = 8ULL * 1024ULL * 1024ULL;
+
+//! Get the avro copy function used to write manifests and manifest lists
+CopyFunction &GetAvroCopyFunction(ClientContext &context);
+
+//! The type of a SimpleStats struct (SimpleStats.SCHEMA)
+LogicalType SimpleStatsType();
+
+} // namespace paimon_manifest
+
+namespace paimon_manifest_file {
+
+//! Write 'entries' to manifest files of roughly 'target_file_size' bytes each, returns the metadata of every file.
+//! 'partition_types' are the types of the partition keys, used to compute the partition stats of each file.
+vector<PaimonManifestFileMeta> WriteToFiles(ClientContext &context, const FileStorePathFactory &path_factory,
+                                            const vector<PaimonManifestEntry> &entries,
+                                            const vector<LogicalType> &partition_types, int64_t schema_id,
+                                            idx_t target_file_size);
+//! Read all entries of the manifest file at 'path'
+vector<PaimonManifestEntry> ReadFromFile(ClientContext &context, const string &path);
+
+} // namespace paimon_manifest_file
+
+namespace paimon_manifest_list {
+
+//! Write a manifest list containing 'manifests' to 'path', returns the size of the written file
+idx_t WriteToFile(ClientContext &context, const string &path, const vector<PaimonManifestFileMeta> &manifests);
+//! Read the manifest file metas of the manifest list at 'path'
+vector<PaimonManifestFileMeta> ReadFromFile(ClientContext &context, const string &path);
+
+} // namespace paimon_manifest_list
+
+namespace paimon_index_manifest {
+
+//! Write an index manifest containing 'entries' to 'path', returns the size of the written file
+idx_t WriteToFile(ClientContext &context, const string &path, const vector<PaimonIndexManifestEntry> &entries);
+//! Read all entries of the index manifest at 'path'
+vector<PaimonIndexManifestEntry> ReadFromFile(ClientContext &context, const string &path);
+
+} // namespace paimon_index_manifest
+
+} // namespace duckdb
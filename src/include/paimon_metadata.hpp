@@ -11,6 +11,8 @@
 #include "duckdb/common/string.hpp"
 #include "duckdb/common/case_insensitive_map.hpp"
 #include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/common/optional_idx.hpp"
 #include <memory>
 #include <vector>
 #include <unordered_map>
@@ -24,7 +26,7 @@ class DataChunk;
 
 // Forward declarations for Paimon structures
 struct PaimonSnapshot;
-struct PaimonManifest;
+struct PaimonManifestFileMeta;
 struct PaimonManifestEntry;
 struct PaimonTableMetadata;
 
@@ -108,24 +110,34 @@ struct PaimonSnapshot {
     PaimonSnapshot &operator=(PaimonSnapshot &&) = default;
 };
 
-// Paimon manifest representation
-struct PaimonManifest {
-    string file_path;
-    string file_format;
-    uint64_t length;
-    uint32_t spec_id;
-    uint32_t content;
+// Kind of a manifest entry (matching org.apache.paimon.manifest.FileKind)
+enum class PaimonFileKind : int8_t {
+    ADD = 0,
+    DELETE = 1
 };
 
-// Paimon manifest entry
-struct PaimonManifestEntry {
-    string file_path;
-    string file_format;
-    uint64_t file_size_in_bytes;
-    uint32_t spec_id;
-    uint32_t content;
-    uint32_t status;
-    case_insensitive_map_t<string> partition_values;
+// Kind of a row in a primary key table data file, the _VALUE_KIND column (matching org.apache.paimon.types.RowKind)
+enum class PaimonRowKind : int8_t {
+    INSERT = 0,
+    UPDATE_BEFORE = 1,
+    UPDATE_AFTER = 2,
+    DELETE = 3
+};
+
+// How rows with the same primary key are merged (the 'merge-engine' table option)
+enum class PaimonMergeEngine : uint8_t {
+    DEDUPLICATE,
+    PARTIAL_UPDATE,
+    AGGREGATE,
+    FIRST_ROW
+};
+
+// What a primary key table writes as its changelog (the 'changelog-producer' table option)
+enum class PaimonChangelogProducer : uint8_t {
+    NONE,
+    INPUT,
+    LOOKUP,
+    FULL_COMPACTION
 };
 
 // Paimon schema field
@@ -141,6 +153,8 @@ struct PaimonSchema {
     int id;
     vector<PaimonSchemaField> fields;
     vector<string> partition_keys;  // Names of partition key columns
+    vector<string> primary_keys;    // Names of primary key columns, empty for append tables
+    case_insensitive_map_t<string> options;  // Table options, e.g. 'bucket'
 };
 
 // Helper struct for snapshot metadata parsing
@@ -166,6 +180,23 @@ public:
     PaimonSnapshot *FindSnapshotById(uint64_t snapshot_id);
     PaimonSnapshot *GetCurrentSnapshot(const PaimonOptions &options);
 
+    // Find the id of the latest snapshot, 0 if the table has none.
+    // The LATEST hint may lag behind concurrent commits, so newer snapshots are probed for.
+    static int64_t FindLatestSnapshotId(const string &table_location, FileSystem &fs);
+
+    // Find the id of the latest snapshot committed at or before 'timestamp', 0 if there is none.
+    // Binary searches the snapshots between the EARLIEST and LATEST hints, reading O(log n) snapshot files.
+    static int64_t FindSnapshotIdByTimestamp(const string &table_location, FileSystem &fs, timestamp_t timestamp);
+
+    // Find the id of the earliest snapshot, 0 if the table has none.
+    // Expiration deletes snapshots before it moves the EARLIEST hint, so the hint can point at a deleted snapshot.
+    static int64_t FindEarliestSnapshotId(const string &table_location, FileSystem &fs);
+
+    // Load the latest schema from the table's schema directory, returns nullptr if there is none
+    static unique_ptr<PaimonSchema> LoadLatestSchema(const string &table_location, FileSystem &fs);
+    // Load schema 'schema_id' (the schema a snapshot was written with), throws if it does not exist
+    static unique_ptr<PaimonSchema> LoadSchema(const string &table_location, FileSystem &fs, int64_t schema_id);
+
     // Schema parsing helpers
     static void ParseSchemaFromJson(yyjson_val *schema_obj, PaimonSchema &schema);
     static void ParseSchemaFieldFromJson(yyjson_val *field_obj, PaimonSchemaField &field);
@@ -192,10 +223,17 @@ enum class FileSource : int8_t {
     COMPACT = 1
 };
 
-// Simple statistics structure for Paimon
+// Simple statistics structure for Paimon (matching SimpleStats.SCHEMA)
+// Min and max values are serialized BinaryRows with one field per column, null counts are BIGINT (NULL if unknown)
 struct SimpleStats {
-    std::vector<std::string> colNames;
-    std::vector<std::vector<Value>> colStats;  // Each column's stats as array of values
+    std::vector<uint8_t> minValues;
+    std::vector<uint8_t> maxValues;
+    std::vector<Value> nullCounts;
+
+    // Stats without any columns
+    static SimpleStats Empty();
+    // The stats as a struct Value of (_MIN_VALUES, _MAX_VALUES, _NULL_COUNTS)
+    Value ToValue() const;
 };
 
 // Complete DataFileMeta structure matching Paimon DataFileMeta.SCHEMA (20 fields)
@@ -228,19 +266,19 @@ struct DataFileMeta {
     timestamp_t creationTime;
 
     // Delete information (field 13) - nullable
-    optional_ptr<int64_t> deleteRowCount;
+    optional_idx deleteRowCount;
 
-    // Index information (field 14) - nullable
-    optional_ptr<std::vector<uint8_t>> embeddedFileIndex;
+    // Index information (field 14) - empty when the file has no embedded index
+    std::vector<uint8_t> embeddedFileIndex;
 
-    // Source tracking (field 15) - nullable
-    optional_ptr<FileSource> fileSource;
+    // Source tracking (field 15)
+    FileSource fileSource = FileSource::APPEND;
 
     // Column information (fields 16-19)
-    std::vector<std::string> valueStatsCols;
-    optional_ptr<std::string> externalPath;
-    optional_ptr<int64_t> firstRowId;
-    optional_ptr<std::vector<std::string>> writeCols;
+    std::vector<std::string> valueStatsCols;   // Empty when the value stats cover all columns
+    std::string externalPath;                  // Empty when the file is stored under the table path
+    optional_idx firstRowId;
+    std::vector<std::string> writeCols;        // Empty when all columns were written
 
     // Constructor with defaults
     DataFileMeta() :
@@ -248,18 +286,59 @@ struct DataFileMeta {
         schemaId(0), level(0), creationTime(Timestamp::GetCurrentTimestamp()) {}
 };
 
-// BucketManager for deterministic bucket assignment
+// Paimon manifest entry (matching ManifestEntry.SCHEMA)
+struct PaimonManifestEntry {
+    PaimonFileKind kind = PaimonFileKind::ADD;
+    std::vector<uint8_t> partition;  // Serialized BinaryRow of the partition values
+    int32_t bucket = 0;
+    int32_t totalBuckets = 1;
+    DataFileMeta file;
+};
+
+// Paimon manifest file metadata, an entry of a manifest list (matching ManifestFileMeta.SCHEMA)
+struct PaimonManifestFileMeta {
+    std::string fileName;
+    int64_t fileSize = 0;
+    int64_t numAddedFiles = 0;
+    int64_t numDeletedFiles = 0;
+    SimpleStats partitionStats;  // Stats of the partition values of all entries
+    int64_t schemaId = 0;
+    int32_t minBucket = 0;
+    int32_t maxBucket = 0;
+    int32_t minLevel = 0;
+    int32_t maxLevel = 0;
+};
+
+// The range of an index file holding the deletion vector of one data file (matching DeletionVectorMeta)
+struct PaimonDeletionVectorMeta {
+    std::string dataFileName;
+    int32_t offset = 0;   // Start of the serialized vector, including its length prefix
+    int32_t length = 0;   // Size of the serialized vector, excluding its length prefix and checksum
+    optional_idx cardinality;
+};
+
+// Paimon index manifest entry, a live index file of a bucket (matching IndexManifestEntry.SCHEMA)
+struct PaimonIndexManifestEntry {
+    PaimonFileKind kind = PaimonFileKind::ADD;
+    std::vector<uint8_t> partition;  // Serialized BinaryRow of the partition values
+    int32_t bucket = 0;
+    std::string indexType;           // e.g. DELETION_VECTORS or HASH
+    std::string fileName;
+    int64_t fileSize = 0;
+    int64_t rowCount = 0;            // For deletion vector index files, the number of data files covered
+    std::vector<PaimonDeletionVectorMeta> deletionVectorRanges;
+};
+
+// BucketManager for deterministic bucket assignment, compatible with Paimon's fixed bucket mode
 class BucketManager {
 private:
     int numBuckets;
-    std::hash<std::string> hasher;
 
 public:
     BucketManager(int numBuckets);
 
-    // Bucket assignment methods
-    int assignBucket(const std::string& key) const;
-    int assignBucket(const std::vector<Value>& partitionValues, const Value& primaryKey) const;
+    // Bucket of a row, given the hash code of its bucket key BinaryRow (KeyAndBucketExtractor#bucket)
+    int assignBucket(int32_t bucketKeyHash) const;
 
     // Utility methods
     int getNumBuckets() const { return numBuckets; }
@@ -283,6 +362,10 @@ public:
     // Manifest paths (always Avro)
     std::string manifestFilePath(const std::string& uuid, int index) const;
     std::string manifestListFilePath(const std::string& uuid, int index) const;
+    std::string indexManifestFilePath(const std::string& uuid, int index) const;
+
+    // Index paths (e.g. deletion vectors)
+    std::string indexFilePath(const std::string& uuid, int counter) const;
 
     // Snapshot paths
     std::string snapshotFilePath(int64_t snapshotId) const;
@@ -295,6 +378,9 @@ public:
                                        const std::string& uuid, int counter, PaimonFileFormat format) const;
     std::string partitionedDeleteFilePath(const std::vector<std::pair<std::string, std::string>>& partition, int bucket,
                                          const std::string& uuid, int counter, PaimonFileFormat format) const;
+    std::string partitionedChangelogFilePath(const std::vector<std::pair<std::string, std::string>>& partition,
+                                            int bucket, const std::string& uuid, int counter,
+                                            PaimonFileFormat format) const;
 
     // Utility methods
     int getNumBuckets() const { return numBuckets; }
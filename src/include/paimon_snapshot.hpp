@@ -0,0 +1,67 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// paimon_snapshot.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/vector.hpp"
+
+#include "paimon_metadata.hpp"
+
+namespace duckdb {
+
+class ClientContext;
+
+//! The parts of a committed snapshot file needed to read or build on top of it
+struct PaimonSnapshotInfo {
+	int64_t id = 0;
+	int64_t schema_id = 0;
+	string base_manifest_list;
+	string delta_manifest_list;
+	//! Empty when the snapshot has no changelog / index manifest
+	string changelog_manifest_list;
+	string index_manifest;
+	string commit_user;
+	int64_t commit_identifier = 0;
+	string commit_kind;
+	int64_t time_millis = 0;
+	int64_t total_record_count = 0;
+	int64_t delta_record_count = 0;
+	int64_t changelog_record_count = 0;
+};
+
+namespace paimon_snapshot {
+
+//! Read snapshot 'snapshot_id' of the table at 'table_path'
+PaimonSnapshotInfo Read(ClientContext &context, const string &table_path, int64_t snapshot_id);
+//! Read the snapshot file at 'path', e.g. a tag (tags are copies of the snapshot they point at)
+PaimonSnapshotInfo ReadFile(ClientContext &context, const string &path);
+//! The manifests of the base and delta manifest lists of 'snapshot'
+vector<PaimonManifestFileMeta> ReadManifests(ClientContext &context, const string &table_path,
+                                             const PaimonSnapshotInfo &snapshot);
+//! All entries of 'manifests', in commit order
+vector<PaimonManifestEntry> ReadEntries(ClientContext &context, const string &table_path,
+                                        const vector<PaimonManifestFileMeta> &manifests);
+//! The data files that are live in 'snapshot'
+vector<PaimonManifestEntry> ReadLiveFiles(ClientContext &context, const string &table_path,
+                                          const PaimonSnapshotInfo &snapshot);
+//! Whether 'manifest' may hold entries of 'bucket' of the partition with values 'partition', judged by its bucket
+//! range and partition stats. 'partition_types' are the types of the partition keys.
+bool MayContainBucket(const PaimonManifestFileMeta &manifest, const vector<LogicalType> &partition_types,
+                      const vector<Value> &partition, int32_t bucket);
+
+//! Identifies a data file across ADD and DELETE entries (org.apache.paimon.manifest.FileEntry.Identifier)
+string EntryIdentifier(const PaimonManifestEntry &entry);
+//! Merge 'entries' in commit order: a DELETE cancels the ADD of the same file, returns the files that are still live
+vector<PaimonManifestEntry> MergeEntries(vector<PaimonManifestEntry> &entries);
+//! Path of the manifest (list) file 'file_name'
+string ManifestPath(const string &table_path, const string &file_name);
+
+} // namespace paimon_snapshot
+
+} // namespace duckdb
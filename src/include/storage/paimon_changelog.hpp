@@ -0,0 +1,80 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/paimon_changelog.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/types/data_chunk.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "paimon_metadata.hpp"
+
+#include <functional>
+
+namespace duckdb {
+
+class PaimonWriteLayout;
+
+//! Produces the changelog of one bucket of a primary key table for 'changelog-producer' = 'lookup'.
+//! Every written row is compared to the previous version of its key: new keys produce +I, changed keys a -U/+U pair,
+//! and deleted keys -D. The previous versions of the keys of a run are looked up in the files of the bucket whose
+//! [minKey, maxKey] range contains them, with the keys pushed into the parquet scans, and cached for the next runs
+//! up to MAX_CACHED_VERSIONS. The files written by the writer itself are looked up too, so evicted versions are found
+//! again.
+//! Each writer thread keeps its own lookup, so a key written by two threads of the same statement is compared to the
+//! committed version on both.
+class PaimonChangelogLookup {
+public:
+	PaimonChangelogLookup(ClientContext &context, PaimonWriteLayout &layout,
+	                      const vector<PaimonManifestEntry> &files);
+
+public:
+	//! Pass the changelog of 'run' (merged rows in the KeyValue layout, every key at most once) to 'callback', and
+	//! remember its rows as the latest versions of their keys
+	void Produce(DataChunk &run, const std::function<void(DataChunk &chunk)> &callback);
+	//! Look up the keys of the next runs in 'entry' too, a file written after the lookup was created
+	void AddFile(const PaimonManifestEntry &entry);
+
+public:
+	//! The number of versions kept between runs, the cache is cleared before a run that would exceed it
+	static constexpr idx_t MAX_CACHED_VERSIONS = 64 * STANDARD_VECTOR_SIZE;
+
+private:
+	struct FileCandidate {
+		PaimonManifestEntry entry;
+		//! The normalized sort keys of the file's min and max key
+		string min_key;
+		string max_key;
+	};
+
+private:
+	//! The normalized sort keys of the primary key of every row of 'chunk'
+	void ComputeKeys(DataChunk &chunk, vector<string> &result);
+	//! Load the latest versions of the keys of 'run' that are not cached
+	void LoadVersions(DataChunk &run);
+	//! Store row 'row' of 'chunk' as the latest version of 'key'
+	void Remember(DataChunk &chunk, idx_t row, const string &key);
+	//! Append row 'row' of 'source' to the changelog with row kind 'kind'
+	void Emit(DataChunk &source, idx_t row, PaimonRowKind kind, const std::function<void(DataChunk &chunk)> &callback);
+	bool IsLive(idx_t version) const;
+
+private:
+	ClientContext &context;
+	PaimonWriteLayout &layout;
+	idx_t key_count;
+	vector<FileCandidate> files;
+	//! The latest version of the cached keys in the KeyValue layout, and its row in 'versions' by normalized key.
+	//! Keys without a version map to INVALID_INDEX.
+	DataChunk versions;
+	unordered_map<string, idx_t> latest;
+	DataChunk changelog;
+	DataChunk key_chunk;
+	//! The keys of the run being produced
+	vector<string> keys;
+	SelectionVector single_row;
+};
+
+} // namespace duckdb
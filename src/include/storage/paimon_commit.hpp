@@ -0,0 +1,88 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/paimon_commit.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/vector.hpp"
+#include "paimon_metadata.hpp"
+#include "paimon_snapshot.hpp"
+
+namespace duckdb {
+
+class ClientContext;
+class FileSystem;
+class PaimonWriteLayout;
+
+//! The commit kind of a snapshot (org.apache.paimon.Snapshot.CommitKind)
+enum class PaimonCommitKind : uint8_t { APPEND, COMPACT, OVERWRITE, ANALYZE };
+
+//! Commits manifest entries as a new snapshot of a Paimon table.
+//!
+//! Commits are optimistic: the new snapshot is built on top of the latest snapshot, written to a temporary file and
+//! published with a rename that fails if the snapshot exists. If another writer created that snapshot first, the
+//! commit is rebased onto the new latest snapshot and retried. Data files and delta manifests are written once, only
+//! the base manifest list is rebuilt on a retry.
+class PaimonCommit {
+public:
+	PaimonCommit(ClientContext &context, PaimonWriteLayout &layout);
+
+public:
+	//! Commit 'entries' as a new snapshot, returns the id of the created snapshot.
+	//! 'changelog' holds the changelog files written with the entries, they go to the snapshot's changelog manifest list.
+	//! 'index_changes' adds and removes index files (e.g. deletion vectors), the other index files carry over.
+	int64_t Commit(const vector<PaimonManifestEntry> &entries, PaimonCommitKind kind,
+	               const vector<PaimonManifestEntry> &changelog = vector<PaimonManifestEntry>(),
+	               const vector<PaimonIndexManifestEntry> &index_changes = vector<PaimonIndexManifestEntry>());
+
+	//! Point the hint file at 'path' (LATEST or EARLIEST) at 'snapshot_id'
+	static void WriteHint(FileSystem &fs, const string &path, int64_t snapshot_id);
+
+public:
+	//! Default 'commit.max-retries'
+	static constexpr idx_t DEFAULT_COMMIT_MAX_RETRIES = 10;
+	//! Default 'manifest.merge-min-count'
+	static constexpr idx_t DEFAULT_MANIFEST_MERGE_MIN_COUNT = 30;
+	//! Default 'manifest.full-compaction-threshold-size'
+	static constexpr idx_t DEFAULT_MANIFEST_FULL_COMPACTION_SIZE = 16ULL * 1024ULL * 1024ULL;
+	//! Commit user written into the snapshots
+	static constexpr const char *COMMIT_USER = "duckdb-paimon";
+
+private:
+	//! The manifests of the snapshot after 'latest': its base and delta manifests, compacted if needed.
+	//! Files written while building it are added to 'new_files'.
+	//! The deletion vectors of 'index_changes' must refer to files that are live after rebasing.
+	vector<PaimonManifestFileMeta> BuildBaseManifests(const PaimonSnapshotInfo &latest,
+	                                                  const vector<PaimonManifestEntry> &entries,
+	                                                  const vector<PaimonIndexManifestEntry> &index_changes,
+	                                                  vector<string> &new_files);
+	//! Merge the runs of consecutive manifests smaller than 'manifest.target-file-size', larger manifests are kept.
+	//! Files written are added to 'new_files'.
+	vector<PaimonManifestFileMeta> MergeSmallManifests(const vector<PaimonManifestFileMeta> &manifests,
+	                                                   vector<string> &new_files);
+	//! Write the index manifest of the snapshot after 'latest', returns its file name (empty if there are no index
+	//! files). The written file is added to 'new_files'.
+	string BuildIndexManifest(const PaimonSnapshotInfo &latest, const vector<PaimonIndexManifestEntry> &index_changes,
+	                          const string &uuid, idx_t attempt, vector<string> &new_files);
+	//! Atomically publish snapshot 'snapshot_id' with 'content', returns false if it already exists
+	bool TryCreateSnapshot(int64_t snapshot_id, const string &content);
+	//! Point the LATEST (and initially EARLIEST) hints at 'snapshot_id'
+	void UpdateHints(int64_t snapshot_id);
+	void DeleteFiles(const vector<string> &paths);
+	//! Write 'entries' to manifests, and a manifest list of them to 'path'. The written paths are added to
+	//! 'written_files', returns the size of the manifest list.
+	idx_t WriteManifestList(const vector<PaimonManifestEntry> &entries, const string &path,
+	                        vector<string> &written_files);
+
+private:
+	ClientContext &context;
+	FileSystem &fs;
+	PaimonWriteLayout &layout;
+};
+
+} // namespace duckdb
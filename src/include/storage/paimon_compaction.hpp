@@ -0,0 +1,134 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/paimon_compaction.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/vector.hpp"
+#include "paimon_metadata.hpp"
+#include "paimon_snapshot.hpp"
+
+namespace duckdb {
+
+class ClientContext;
+class PaimonDeletionVectors;
+class PaimonWriteLayout;
+
+//! A sorted run of a bucket of a primary key table: a single level-0 file, or all files of a higher level.
+//! Every key occurs at most once in a sorted run.
+struct PaimonSortedRun {
+	int level = 0;
+	vector<PaimonManifestEntry> files;
+
+	idx_t TotalSize() const;
+};
+
+//! The files of a bucket picked for compaction, and the level they are rewritten to
+struct PaimonCompactUnit {
+	int output_level = 0;
+	vector<PaimonManifestEntry> files;
+	//! Whether retractions can be dropped, which is the case when no older data exists below the output level
+	bool drop_delete = false;
+};
+
+//! Paimon's universal compaction policy (org.apache.paimon.mergetree.compact.UniversalCompaction).
+//! Runs are ordered from newest to oldest, and a prefix of them is picked to reduce size amplification, to keep
+//! adjacent runs of a similar size together, or to bound the number of runs.
+class PaimonUniversalCompaction {
+public:
+	PaimonUniversalCompaction(idx_t max_size_amplification_percent, idx_t size_ratio, idx_t num_run_compaction_trigger);
+
+public:
+	//! Pick the runs to compact, returns false if the bucket does not need to be compacted
+	bool Pick(int num_levels, const vector<PaimonSortedRun> &runs, PaimonCompactUnit &result) const;
+	//! Pick all runs, rewriting them into the highest level
+	bool PickFull(int num_levels, const vector<PaimonSortedRun> &runs, PaimonCompactUnit &result) const;
+
+private:
+	bool PickForSizeAmplification(int max_level, const vector<PaimonSortedRun> &runs, PaimonCompactUnit &result) const;
+	bool PickForSizeRatio(int max_level, const vector<PaimonSortedRun> &runs, idx_t candidate_count, bool force_pick,
+	                      PaimonCompactUnit &result) const;
+	static void CreateUnit(int max_level, const vector<PaimonSortedRun> &runs, idx_t run_count,
+	                       PaimonCompactUnit &result);
+
+private:
+	idx_t max_size_amplification_percent;
+	idx_t size_ratio;
+	idx_t num_run_compaction_trigger;
+};
+
+//! What to compact, set by the caller of paimon_compact
+struct PaimonCompactOptions {
+	//! Rewrite every bucket regardless of the compaction policy: primary key tables are merged into the highest
+	//! level, append tables have all their small files packed
+	bool full = false;
+	//! Append tables only: rewrite every bucket clustered on these columns
+	vector<string> order_by;
+	//! Cluster on the z-order curve of the order columns instead of sorting on them lexicographically
+	bool zorder = false;
+};
+
+//! The outcome of compacting a table
+struct PaimonCompactionResult {
+	//! The COMPACT snapshot, 0 if nothing was compacted
+	int64_t snapshot_id = 0;
+	idx_t compacted_buckets = 0;
+	idx_t files_before = 0;
+	idx_t files_after = 0;
+};
+
+//! Compacts the buckets of a Paimon table.
+//! Primary key tables follow the universal compaction policy and merge sorted runs into higher levels, append tables
+//! bin-pack their small files up to the target file size. The compaction units are rewritten in parallel on DuckDB's
+//! task scheduler, and the rewritten files replace their inputs in a single COMPACT snapshot.
+class PaimonCompactor {
+public:
+	PaimonCompactor(ClientContext &context, PaimonWriteLayout &layout);
+	~PaimonCompactor();
+
+public:
+	PaimonCompactionResult Compact(const PaimonCompactOptions &options);
+	//! Rewrite the files of 'unit' as files of the unit's output level, merging the rows of primary key tables with
+	//! the merge engine. Adds the manifest entries replacing the unit's files to 'entries', and the paths of new files
+	//! to 'written_files'.
+	void CompactUnit(const PaimonCompactUnit &unit, vector<PaimonManifestEntry> &entries,
+	                 vector<string> &written_files);
+	//! Like Paimon writers, compact the buckets written by 'written_files' that reached the compaction trigger after
+	//! the write committed, unless the table is 'write-only'. Errors are logged, the write is already committed.
+	static void CompactAfterWrite(ClientContext &context, PaimonWriteLayout &layout,
+	                              const vector<PaimonManifestEntry> &written_files);
+
+public:
+	//! Default 'num-sorted-run.compaction-trigger'
+	static constexpr idx_t DEFAULT_NUM_SORTED_RUN_COMPACTION_TRIGGER = 5;
+	//! Default 'compaction.max-size-amplification-percent'
+	static constexpr idx_t DEFAULT_MAX_SIZE_AMPLIFICATION_PERCENT = 200;
+	//! Default 'compaction.size-ratio'
+	static constexpr idx_t DEFAULT_SIZE_RATIO = 1;
+	//! Default 'compaction.min.file-num' and 'compaction.max.file-num' of append tables
+	static constexpr idx_t DEFAULT_MIN_FILE_NUM = 5;
+	static constexpr idx_t DEFAULT_MAX_FILE_NUM = 50;
+
+private:
+	//! Compact the units picked from 'buckets', the live files of some of the buckets of 'snapshot'
+	PaimonCompactionResult CompactBuckets(const PaimonSnapshotInfo &snapshot,
+	                                      vector<vector<PaimonManifestEntry>> &buckets);
+	vector<PaimonCompactUnit> PickPrimaryKeyUnits(vector<vector<PaimonManifestEntry>> &buckets);
+	vector<PaimonCompactUnit> PickAppendUnits(vector<vector<PaimonManifestEntry>> &buckets);
+
+private:
+	ClientContext &context;
+	PaimonWriteLayout &layout;
+	PaimonCompactOptions options;
+	//! The indexes of the 'order_by' columns
+	vector<idx_t> order_columns;
+	//! The deletion vectors of the compacted snapshot, append tables only
+	unique_ptr<PaimonDeletionVectors> deletion_vectors;
+};
+
+} // namespace duckdb
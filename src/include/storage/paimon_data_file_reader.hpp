@@ -0,0 +1,69 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/paimon_data_file_reader.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/types/data_chunk.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/planner/table_filter.hpp"
+#include "duckdb/parallel/thread_context.hpp"
+#include "duckdb/execution/execution_context.hpp"
+
+namespace roaring {
+class Roaring;
+} // namespace roaring
+
+namespace duckdb {
+
+struct PaimonDataFileBindData;
+
+//! Streams the rows of a single Paimon data file through the parquet table function.
+//! Rows are returned in the layout of 'bind' (the KeyValue layout on primary key tables), in file order.
+class PaimonDataFileReader {
+public:
+	//! 'filters' are keyed on the columns of the layout. They are pushed into the parquet scan, which skips row groups
+	//! by their statistics and bloom filters, and may return rows that do not match.
+	//! 'deleted_rows' is the deletion vector of the file, the rows at its positions are skipped. With 'row_numbers'
+	//! the position in the file of every returned row is available through RowNumbers.
+	PaimonDataFileReader(ClientContext &context, const PaimonDataFileBindData &bind, const string &file_path,
+	                     optional_ptr<const TableFilterSet> filters = nullptr,
+	                     optional_ptr<const roaring::Roaring> deleted_rows = nullptr, bool row_numbers = false);
+
+public:
+	//! Read the next chunk of rows into 'result', which must be initialized (with Initialize) with the types of
+	//! the layout. Returns false once the file is exhausted.
+	bool Next(DataChunk &result);
+	//! The positions in the file (BIGINT) of the rows last returned by Next, if the reader was created with
+	//! 'row_numbers' or 'deleted_rows'
+	Vector &RowNumbers() {
+		return row_numbers;
+	}
+
+private:
+	ClientContext &context;
+	TableFunction scan;
+	unique_ptr<FunctionData> bind_data;
+	unique_ptr<TableFilterSet> scan_filters;
+	unique_ptr<GlobalTableFunctionState> global_state;
+	unique_ptr<LocalTableFunctionState> local_state;
+	ThreadContext thread_context;
+	ExecutionContext execution_context;
+	//! For every column of the layout its index in 'scan_chunk', or INVALID_INDEX if the file does not have it
+	vector<idx_t> column_mapping;
+	//! The types of the projected columns as stored in the file, they are cast to the layout's types if needed
+	vector<LogicalType> file_types;
+	vector<LogicalType> layout_types;
+	DataChunk scan_chunk;
+	optional_ptr<const roaring::Roaring> deleted_rows;
+	//! The index of the 'file_row_number' column in 'scan_chunk', or INVALID_INDEX if it is not read
+	idx_t row_number_idx = DConstants::INVALID_INDEX;
+	Vector row_numbers;
+	SelectionVector live_rows;
+};
+
+} // namespace duckdb
@@ -0,0 +1,100 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/paimon_data_file_writer.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/function/copy_function.hpp"
+#include "duckdb/execution/execution_context.hpp"
+#include "paimon_metadata.hpp"
+#include "paimon_binary_row.hpp"
+
+namespace duckdb {
+
+class PaimonTableEntry;
+
+//! The parquet copy function, bound once and shared by every data file written for a table.
+//! Files of primary key tables use the KeyValue layout: the key columns (prefixed with '_KEY_'), '_SEQUENCE_NUMBER',
+//! '_VALUE_KIND', and then all columns of the table.
+struct PaimonDataFileBindData {
+public:
+	PaimonDataFileBindData(ClientContext &context, PaimonTableEntry &table, const vector<idx_t> &key_indexes);
+	//! The layout of the data files of a table with 'column_names' and 'column_types', for reading them only: the
+	//! copy function is not bound
+	PaimonDataFileBindData(const vector<string> &column_names, const vector<LogicalType> &column_types,
+	                       const vector<idx_t> &key_indexes);
+
+public:
+	bool IsKeyValue() const {
+		return key_count > 0;
+	}
+
+public:
+	//! Field ids of the KeyValue system columns (org.apache.paimon.table.SpecialFields)
+	static constexpr int32_t KEY_FIELD_ID_START = NumericLimits<int32_t>::Maximum() / 2;
+	static constexpr int32_t SEQUENCE_NUMBER_FIELD_ID = NumericLimits<int32_t>::Maximum() - 1;
+	static constexpr int32_t VALUE_KIND_FIELD_ID = NumericLimits<int32_t>::Maximum() - 2;
+
+public:
+	CopyFunction copy;
+	unique_ptr<FunctionData> bind_data;
+	//! The names and types of the written columns
+	vector<string> names;
+	vector<LogicalType> types;
+	//! The number of key columns, 0 for append tables
+	idx_t key_count = 0;
+	//! Index of the first table column in the written columns
+	idx_t value_offset = 0;
+};
+
+//! Writes a single Paimon data file through the parquet copy function.
+//! The file's DataFileMeta (row count, size and value stats) is built from the statistics collected by the writer.
+class PaimonDataFileWriter {
+public:
+	PaimonDataFileWriter(ExecutionContext &context, PaimonDataFileBindData &bind, string file_path);
+
+public:
+	void Append(ExecutionContext &context, DataChunk &chunk);
+	//! The bytes written to the file so far (rows still buffered in the row group are not included)
+	idx_t FileSize() const;
+	idx_t RowCount() const {
+		return row_count;
+	}
+	const string &FilePath() const {
+		return file_path;
+	}
+	//! Flush and close the file, and return its metadata
+	DataFileMeta Finalize(ExecutionContext &context);
+
+public:
+	//! Paimon's default 'metadata.stats-mode' is 'truncate(16)'
+	static constexpr idx_t STATS_TRUNCATE_LENGTH = 16;
+
+private:
+	//! The stats of written columns [begin, end)
+	SimpleStats ConvertStatistics(idx_t begin, idx_t end) const;
+	//! Track the key range, sequence numbers and retractions of a chunk in the KeyValue layout
+	void TrackKeyValues(DataChunk &chunk);
+
+private:
+	ClientContext &context;
+	PaimonDataFileBindData &bind;
+	string file_path;
+	unique_ptr<GlobalFunctionData> global_state;
+	unique_ptr<LocalFunctionData> local_state;
+	CopyFunctionFileStatistics file_stats;
+	idx_t row_count = 0;
+
+	//! KeyValue files only: rows are appended sorted by key, so the first and last rows hold the min and max key
+	PaimonBinaryRowWriter min_key;
+	PaimonBinaryRowWriter max_key;
+	int64_t min_sequence_number = NumericLimits<int64_t>::Maximum();
+	int64_t max_sequence_number = NumericLimits<int64_t>::Minimum();
+	idx_t delete_row_count = 0;
+};
+
+} // namespace duckdb
@@ -14,7 +14,8 @@
 
 namespace duckdb {
 
-//! PhysicalDelete represents a DELETE operation
+//! DELETE from a Paimon primary key table. The primary key of every deleted row is written as a DELETE row into new
+//! level-0 files, which retract the previous versions when the table is read or compacted.
 class PaimonDelete : public PhysicalOperator {
 public:
 	PaimonDelete(PhysicalPlan &physical_plan, vector<LogicalType> types, TableCatalogEntry &tableref,
@@ -35,10 +36,21 @@ public:
 public:
 	// Source interface
 	SourceResultType GetData(ExecutionContext &context, DataChunk &chunk, OperatorSourceInput &input) const override;
+	bool IsSource() const override {
+		return true;
+	}
 
 	// Sink interface
 	SinkResultType Sink(ExecutionContext &context, DataChunk &chunk, OperatorSinkInput &input) const override;
 	SinkCombineResultType Combine(ExecutionContext &context, OperatorSinkCombineInput &input) const override;
+	SinkFinalizeType Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
+	                          OperatorSinkFinalizeInput &input) const override;
+	bool IsSink() const override {
+		return true;
+	}
+	bool ParallelSink() const override {
+		return true;
+	}
 
 	// State interface
 	unique_ptr<GlobalSinkState> GetGlobalSinkState(ClientContext &context) const override;
@@ -48,9 +60,40 @@ public:
 	// Operator interface
 	string GetName() const override;
 	InsertionOrderPreservingMap<string> ParamsToString() const override;
+};
+
+//! DELETE from a Paimon append table, without scanning the table. The WHERE clause is evaluated per data file: files
+//! it selects entirely, by their partition values or value stats, are removed with DELETE manifest entries. Files it
+//! may select partially are read, and the positions of the selected rows are added to their deletion vectors.
+class PaimonAppendDelete : public PhysicalOperator {
+public:
+	PaimonAppendDelete(PhysicalPlan &physical_plan, vector<LogicalType> types, TableCatalogEntry &tableref,
+	                   vector<unique_ptr<Expression>> conjuncts, idx_t estimated_cardinality);
+
+public:
+	//! The table to delete from
+	TableCatalogEntry &tableref;
+	//! The conjuncts of the WHERE clause, referencing the columns of the table by index. Empty to delete all rows.
+	vector<unique_ptr<Expression>> conjuncts;
 
-private:
-	mutable bool finished = false;
+public:
+	//! The conjuncts of the WHERE clause of the plan producing the rows to delete, which must be a (filtered) scan of
+	//! 'table'. Column references are rewritten to the indexes of the table's columns.
+	static vector<unique_ptr<Expression>> ExtractConjuncts(PhysicalOperator &plan, TableCatalogEntry &table);
+
+public:
+	// Source interface
+	SourceResultType GetData(ExecutionContext &context, DataChunk &chunk, OperatorSourceInput &input) const override;
+	bool IsSource() const override {
+		return true;
+	}
+
+	// State interface
+	unique_ptr<GlobalSourceState> GetGlobalSourceState(ClientContext &context) const override;
+
+	// Operator interface
+	string GetName() const override;
+	InsertionOrderPreservingMap<string> ParamsToString() const override;
 };
 
 } // namespace duckdb
@@ -0,0 +1,87 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/paimon_deletion_vectors.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/map.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "paimon_metadata.hpp"
+#include "paimon_snapshot.hpp"
+
+#include <roaring/roaring.hh>
+
+namespace duckdb {
+
+//! The deletion vectors of the data files of a snapshot, stored in Paimon 'DELETION_VECTORS' index files.
+//! A bucket has one index file, holding the vectors of all of its data files that have deleted rows: a version byte,
+//! followed for every data file by the size of its vector, the vector (a magic number and a portable 32-bit roaring
+//! bitmap of the positions of the deleted rows) and a CRC32 of the vector.
+class PaimonDeletionVectors {
+public:
+	PaimonDeletionVectors(ClientContext &context, const string &table_path, const PaimonSnapshotInfo &snapshot);
+
+public:
+	//! Whether no data file of the snapshot has deleted rows
+	bool Empty() const {
+		return vectors.empty();
+	}
+	//! Read the deletion vector of data file 'file_name' into 'result', returns false if none of its rows are deleted
+	bool Read(const string &file_name, roaring::Roaring &result) const;
+	//! The deletion vectors of all data files of 'bucket' of 'partition', keyed on data file name
+	map<string, roaring::Roaring> ReadBucket(const vector<uint8_t> &partition, int32_t bucket) const;
+	//! Replace the index files of 'bucket' of 'partition' by one holding 'bucket_vectors', or by none if it is empty.
+	//! The index manifest changes are added to 'changes', and the path of the new index file to 'written_files'.
+	void WriteBucket(const vector<uint8_t> &partition, int32_t bucket,
+	                 const map<string, roaring::Roaring> &bucket_vectors, vector<PaimonIndexManifestEntry> &changes,
+	                 vector<string> &written_files);
+	//! The live index files of the snapshot
+	const vector<PaimonIndexManifestEntry> &IndexFiles() const {
+		return index_files;
+	}
+
+	//! The live index files of 'snapshot'
+	static vector<PaimonIndexManifestEntry> ReadIndexFiles(ClientContext &context, const string &table_path,
+	                                                       const PaimonSnapshotInfo &snapshot);
+	//! Apply the ADD and DELETE entries of 'changes' to the live index files 'index_files'.
+	//! Returns false if a removed index file is not live, i.e. a concurrent commit replaced it first.
+	static bool MergeIndexFiles(vector<PaimonIndexManifestEntry> &index_files,
+	                            const vector<PaimonIndexManifestEntry> &changes);
+	//! Path of the index file 'file_name'
+	static string IndexFilePath(const string &table_path, const string &file_name);
+
+public:
+	//! IndexManifestEntry type of deletion vector index files (DeletionVectorsIndexFile.DELETION_VECTORS_INDEX)
+	static constexpr const char *INDEX_TYPE = "DELETION_VECTORS";
+	//! BitmapDeletionVector.MAGIC_NUMBER
+	static constexpr int32_t MAGIC_NUMBER = 1581511376;
+	//! DeletionVectorsIndexFile.VERSION_ID_V1
+	static constexpr uint8_t VERSION_ID = 1;
+
+private:
+	//! Where the vector of a data file is stored: an index file, and its range in it
+	struct VectorLocation {
+		idx_t index_file;
+		idx_t range;
+	};
+	static string BucketKey(const vector<uint8_t> &partition, int32_t bucket);
+
+private:
+	ClientContext &context;
+	string table_path;
+	FileStorePathFactory path_factory;
+	vector<PaimonIndexManifestEntry> index_files;
+	//! The deletion vector index files of every bucket, keyed on (partition, bucket)
+	unordered_map<string, vector<idx_t>> bucket_index_files;
+	//! The vector of every data file that has deleted rows, keyed on data file name
+	unordered_map<string, VectorLocation> vectors;
+	//! Index files are named index-<uuid>-<counter>, with one uuid per instance
+	string file_uuid;
+	idx_t file_counter = 0;
+};
+
+} // namespace duckdb
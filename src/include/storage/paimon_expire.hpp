@@ -0,0 +1,120 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/paimon_expire.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/limits.hpp"
+#include "duckdb/common/optional_idx.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/common/unordered_set.hpp"
+#include "duckdb/common/vector.hpp"
+#include "paimon_snapshot.hpp"
+
+namespace duckdb {
+
+class ClientContext;
+class FileSystem;
+class PaimonWriteLayout;
+
+//! Which snapshots to expire, set by the caller of paimon_expire_snapshots. Unset fields fall back to the table's
+//! 'snapshot.num-retained.min' and 'snapshot.time-retained' options.
+struct PaimonExpireOptions {
+	//! Always retain the latest 'retain_last' snapshots
+	optional_idx retain_last;
+	//! Only expire snapshots committed before this time
+	bool has_older_than = false;
+	timestamp_t older_than;
+};
+
+//! The outcome of expiring snapshots
+struct PaimonExpireResult {
+	idx_t expired_snapshots = 0;
+	//! Data, changelog and index files
+	idx_t deleted_data_files = 0;
+	//! Manifests, manifest lists and index manifests
+	idx_t deleted_manifests = 0;
+	//! The earliest snapshot after expiration, 0 if the table has no snapshots
+	int64_t earliest_snapshot_id = 0;
+};
+
+//! A file left behind by a failed commit or write, found by PaimonOrphanFileCleaner
+struct PaimonOrphanFile {
+	string path;
+	idx_t size = 0;
+};
+
+//! Expires old snapshots of a Paimon table (org.apache.paimon.operation.ExpireSnapshotsImpl).
+//!
+//! Snapshots are expired from the earliest one, until 'snapshot.num-retained.min' (or 'retain_last') snapshots remain
+//! or a snapshot newer than 'snapshot.time-retained' (or 'older_than') is reached. Snapshots beyond
+//! 'snapshot.num-retained.max' are expired regardless of their age. The data files removed by the expired snapshots,
+//! and the manifests, changelogs and index files only they refer to, are deleted in parallel. Files of tagged
+//! snapshots are kept. The snapshot files are deleted last, from the oldest one, before the EARLIEST hint is advanced,
+//! so an interrupted expiration leaves a readable table and is completed by the next one.
+class PaimonSnapshotExpirer {
+public:
+	PaimonSnapshotExpirer(ClientContext &context, PaimonWriteLayout &layout);
+
+public:
+	PaimonExpireResult Expire(const PaimonExpireOptions &options);
+
+public:
+	//! Default 'snapshot.num-retained.min'
+	static constexpr idx_t DEFAULT_NUM_RETAINED_MIN = 10;
+	//! Default 'snapshot.num-retained.max'
+	static constexpr idx_t DEFAULT_NUM_RETAINED_MAX = NumericLimits<int32_t>::Maximum();
+	//! Default 'snapshot.time-retained', in milliseconds
+	static constexpr int64_t DEFAULT_TIME_RETAINED = 60LL * 60LL * 1000LL;
+
+private:
+	//! Expire the snapshots in [earliest_id, end_id), 'end_id' becomes the earliest snapshot
+	void ExpireUntil(int64_t earliest_id, int64_t end_id, PaimonExpireResult &result);
+
+private:
+	ClientContext &context;
+	FileSystem &fs;
+	PaimonWriteLayout &layout;
+};
+
+//! Removes files in the directories of a Paimon table that no snapshot or tag refers to: data, changelog, manifest
+//! and index files written by commits that failed or lost a conflict, and stale hint files. Only files older than
+//! 'older_than' are removed, as files of commits in progress are not referenced yet.
+class PaimonOrphanFileCleaner {
+public:
+	PaimonOrphanFileCleaner(ClientContext &context, PaimonWriteLayout &layout);
+
+public:
+	//! Find the orphan files last modified before 'older_than', and delete them unless 'dry_run' is set
+	vector<PaimonOrphanFile> Clean(timestamp_t older_than, bool dry_run);
+
+public:
+	//! Default age of the files paimon_remove_orphan_files removes, in milliseconds
+	static constexpr int64_t DEFAULT_OLDER_THAN = 24LL * 60LL * 60LL * 1000LL;
+
+private:
+	//! The paths of all files the snapshots and tags of the table refer to
+	unordered_set<string> ReferencedFiles();
+	//! List the files of 'dir' into 'result', descending into partition and bucket directories
+	void ListDataFiles(const string &dir, vector<string> &result);
+
+private:
+	ClientContext &context;
+	FileSystem &fs;
+	PaimonWriteLayout &layout;
+};
+
+namespace paimon_expire {
+
+//! Delete 'paths' in parallel, returns how many existed
+idx_t DeleteFiles(ClientContext &context, const vector<string> &paths);
+//! The tagged snapshots of the table at 'table_path'
+vector<PaimonSnapshotInfo> ReadTags(ClientContext &context, const string &table_path);
+
+} // namespace paimon_expire
+
+} // namespace duckdb
@@ -33,6 +33,7 @@ public:
 	bool IsSink() const override;
 	bool ParallelSink() const override;
 	SinkResultType Sink(ExecutionContext &context, DataChunk &chunk, OperatorSinkInput &input) const override;
+	SinkCombineResultType Combine(ExecutionContext &context, OperatorSinkCombineInput &input) const override;
 	SinkFinalizeType Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
 	                         OperatorSinkFinalizeInput &input) const override;
 	unique_ptr<GlobalSinkState> GetGlobalSinkState(ClientContext &context) const override;
@@ -47,8 +48,7 @@ public:
 
 private:
 	// Helper methods
-	void WriteChunkToParquet(ClientContext &context, DataChunk &chunk, const string &file_path) const;
-	void UpdatePaimonMetadata(ClientContext &context, const struct PaimonInsertGlobalState &global_state) const;
+	void UpdatePaimonMetadata(ClientContext &context, PaimonInsertGlobalState &global_state) const;
 
 public:
 	TableCatalogEntry *table;
@@ -0,0 +1,58 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/paimon_lookup.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/types/column/column_data_collection.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "paimon_metadata.hpp"
+
+namespace duckdb {
+
+class PaimonWriteLayout;
+
+//! Point lookups by primary key against the latest snapshot of a primary key table.
+//! Every key is routed to its partition and bucket, and only the files of that bucket whose [minKey, maxKey] range
+//! contains the key are read. The keys of a file are pushed into its parquet scan, so row groups that cannot contain
+//! them are skipped by their statistics and bloom filters.
+class PaimonKeyLookup {
+public:
+	PaimonKeyLookup(ClientContext &context, PaimonWriteLayout &layout);
+
+public:
+	//! The types of the keys, in primary key order
+	const vector<LogicalType> &KeyTypes() const {
+		return key_types;
+	}
+	//! Look up 'keys' (one column per primary key column), and append the latest version of every key that exists
+	//! to 'result' (all columns of the table). Keys are returned at most once, in the order they were first passed.
+	void Lookup(ColumnDataCollection &keys, ColumnDataCollection &result) const;
+
+private:
+	struct FileCandidate {
+		PaimonManifestEntry entry;
+		//! The normalized sort keys of the file's min and max key
+		string min_key;
+		string max_key;
+	};
+	//! Routing key of a primary key: the partition BinaryRow followed by the bucket
+	string RoutingKey(const vector<Value> &key) const;
+
+private:
+	ClientContext &context;
+	PaimonWriteLayout &layout;
+	idx_t key_count;
+	vector<LogicalType> key_types;
+	//! For every partition / bucket key column, its position in the primary key
+	vector<idx_t> partition_key_positions;
+	vector<idx_t> bucket_key_positions;
+	//! The live files of every bucket, keyed on (partition, bucket)
+	unordered_map<string, vector<FileCandidate>> bucket_files;
+};
+
+} // namespace duckdb
@@ -0,0 +1,67 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/paimon_merge_reader.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/types/data_chunk.hpp"
+#include "duckdb/common/types/selection_vector.hpp"
+#include "duckdb/function/create_sort_key.hpp"
+#include "paimon_metadata.hpp"
+
+namespace duckdb {
+
+class PaimonDeletionVectors;
+class PaimonWriteLayout;
+struct PaimonSortedRunReader;
+
+//! Merges the sorted runs of a bucket of a primary key table on their key: every level-0 file is a run, and so are
+//! all files of a higher level. For every key, the version picked by the merge engine is returned, in key order and
+//! in the KeyValue layout. Used to merge on read and to compact.
+class PaimonMergeReader {
+public:
+	//! 'files' are data files of one bucket. With 'drop_retractions', keys whose picked version is a DELETE or
+	//! UPDATE_BEFORE row are left out, otherwise the retraction is returned. Rows removed by 'deletion_vectors' are
+	//! skipped.
+	PaimonMergeReader(ClientContext &context, const PaimonWriteLayout &layout, const vector<PaimonManifestEntry> &files,
+	                  bool drop_retractions, optional_ptr<const PaimonDeletionVectors> deletion_vectors = nullptr);
+	~PaimonMergeReader();
+
+public:
+	//! Read the next merged rows into 'result', which must be initialized with the types of the layout.
+	//! Returns false once all runs are exhausted.
+	bool Next(DataChunk &result);
+
+	//! The order of the keys of data files, which must match the order of the sorted write buffer
+	static vector<OrderModifiers> KeyOrderModifiers(idx_t key_count);
+
+private:
+	//! The run holding the version of the key that survives the merge, or INVALID_INDEX if the key is dropped
+	idx_t PickWinner(const vector<idx_t> &group) const;
+	//! Move run 'run_idx' to its next row, returns false once the run is exhausted
+	bool Advance(idx_t run_idx, DataChunk &result);
+	void EmitRow(idx_t run_idx, DataChunk &result);
+	void FlushPending(DataChunk &result);
+	//! Whether run 'a' is after run 'b' in the merge: by key, and by sequence number within a key
+	bool RunGreater(idx_t a, idx_t b) const;
+
+private:
+	const PaimonWriteLayout &layout;
+	bool drop_retractions;
+	vector<unique_ptr<PaimonSortedRunReader>> runs;
+	//! Min-heap of the runs that are not exhausted, on their current row
+	vector<idx_t> heap;
+	bool initialized = false;
+	//! The runs holding the versions of the current key
+	vector<idx_t> group;
+	//! Consecutive rows emitted from the same chunk of a run, copied to the result at once
+	idx_t pending_run = 0;
+	SelectionVector pending_sel;
+	idx_t pending_count = 0;
+};
+
+} // namespace duckdb
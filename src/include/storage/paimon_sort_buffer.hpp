@@ -0,0 +1,61 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/paimon_sort_buffer.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/optional_ptr.hpp"
+#include "duckdb/common/types/data_chunk.hpp"
+#include "paimon_metadata.hpp"
+
+#include <functional>
+
+namespace duckdb {
+
+//! Write buffer of one bucket of a primary key table.
+//! Rows are buffered in arrival order together with their sequence number and row kind. On flush they are sorted
+//! by (primary key, sequence number) on DuckDB's normalized sort keys, rows with the same key are merged by the
+//! merge engine, and the result is emitted in the KeyValue layout as a single sorted run.
+class PaimonSortBuffer {
+public:
+	PaimonSortBuffer(Allocator &allocator, const vector<LogicalType> &types, const vector<idx_t> &key_indexes,
+	                 PaimonMergeEngine merge_engine);
+
+public:
+	//! Buffer the rows of 'chunk', which get sequence numbers [first_sequence_number, first_sequence_number + size)
+	void Append(DataChunk &chunk, int64_t first_sequence_number, PaimonRowKind kind);
+	idx_t Count() const {
+		return rows.size();
+	}
+	//! The memory held by the buffered rows
+	idx_t MemoryUsage() const;
+	//! Sort and merge the buffered rows, and pass them to 'callback' in chunks of (keys, _SEQUENCE_NUMBER,
+	//! _VALUE_KIND, values). If 'changelog' is set, it receives all buffered rows before they are merged, in the
+	//! same layout and order. The buffer is empty afterwards.
+	void Flush(const std::function<void(DataChunk &chunk)> &callback,
+	           optional_ptr<const std::function<void(DataChunk &chunk)>> changelog = nullptr);
+
+private:
+	//! Sort the buffered rows by (key, sequence number) into 'order', returns the sorted rows that remain after
+	//! merging rows with the same key with the merge engine
+	vector<sel_t> SortRows(vector<sel_t> &order);
+	//! Pass the rows 'order' to 'callback' in the KeyValue layout
+	void EmitRows(const vector<sel_t> &order, const std::function<void(DataChunk &chunk)> &callback);
+
+private:
+	Allocator &allocator;
+	vector<idx_t> key_indexes;
+	PaimonMergeEngine merge_engine;
+	//! The table columns followed by the sequence number and row kind
+	DataChunk rows;
+	DataChunk scratch;
+	idx_t sequence_idx;
+	idx_t kind_idx;
+	vector<LogicalType> key_types;
+};
+
+} // namespace duckdb
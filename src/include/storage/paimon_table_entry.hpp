@@ -25,6 +25,8 @@ public:
     // TableCatalogEntry overrides
     unique_ptr<BaseStatistics> GetStatistics(ClientContext &context) override;
     TableFunction GetScanFunction(ClientContext &context, unique_ptr<FunctionData> &bind_data) override;
+    // The primary key columns on primary key tables, which UPDATE and DELETE write new rows for
+    vector<column_t> GetRowIdColumns() const override;
     TableStorageInfo GetStorageInfo(ClientContext &context) override;
 
     // Storage interface
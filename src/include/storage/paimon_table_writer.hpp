@@ -0,0 +1,216 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/paimon_table_writer.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/unordered_set.hpp"
+#include "storage/paimon_changelog.hpp"
+#include "storage/paimon_data_file_writer.hpp"
+#include "storage/paimon_sort_buffer.hpp"
+#include "paimon_binary_row.hpp"
+#include "paimon_metadata.hpp"
+
+namespace duckdb {
+
+class PaimonTableEntry;
+
+//! How the rows of a Paimon table are routed to partitions, buckets and data files.
+//! Read from the table's latest schema once per write, and shared by all writer threads.
+class PaimonWriteLayout {
+public:
+	PaimonWriteLayout(ClientContext &context, PaimonTableEntry &table);
+	//! The layout of the table at 'table_path' with 'schema', for reading the table or committing files that already
+	//! exist (e.g. those migrated by iceberg_to_paimon). No data files can be written through it, 'bind' only
+	//! describes the layout of the data files.
+	PaimonWriteLayout(ClientContext &context, const string &table_path, const PaimonSchema &schema,
+	                  vector<string> column_names, vector<LogicalType> column_types);
+
+public:
+	bool IsPartitioned() const {
+		return !partition_key_indexes.empty();
+	}
+	bool HasPrimaryKey() const {
+		return !primary_key_indexes.empty();
+	}
+	//! Whether all rows of a partition go to the same bucket
+	bool SingleBucket() const {
+		return bucket_manager.getNumBuckets() <= 1;
+	}
+	//! The value of table option 'name', or an empty string if it is not set
+	string GetOption(const string &name) const;
+	//! The value of a numeric or memory size (e.g. '8 mb') table option, or 'default_value' if it is not set
+	idx_t GetIntegerOption(const string &name, idx_t default_value) const;
+	idx_t GetMemorySizeOption(const string &name, idx_t default_value) const;
+	//! The value of a duration table option (e.g. '1 h', '30 min', '7d') in milliseconds, or 'default_value'
+	int64_t GetDurationOption(const string &name, int64_t default_value) const;
+	//! The path of a new data file in 'bucket' of 'partition', creating its directory if needed
+	string NewDataFilePath(ClientContext &context, const vector<pair<string, string>> &partition, int bucket);
+	//! The path of a new changelog file in 'bucket' of 'partition', creating its directory if needed
+	string NewChangelogFilePath(ClientContext &context, const vector<pair<string, string>> &partition, int bucket);
+	//! The 'key=value' directories of the serialized partition row 'partition'
+	vector<pair<string, string>> PartitionPath(const vector<uint8_t> &partition) const;
+	//! The path of the data file of an existing manifest entry
+	string DataFilePath(const PaimonManifestEntry &entry) const;
+	//! Throw if the table uses options that the writer and the compactor do not support. Maintenance that only
+	//! removes files or reads the table (expiration, orphan files, conversions) doesn't need to call it.
+	void CheckWritable() const;
+	//! Reserve 'count' sequence numbers in 'bucket' of 'partition', returns the first one.
+	//! Sequence numbers increase per bucket across all writer threads and commits.
+	int64_t ReserveSequenceNumbers(const vector<uint8_t> &partition, int32_t bucket, idx_t count);
+	//! The live files of 'bucket' of 'partition' in the latest snapshot when the bucket was first used
+	vector<PaimonManifestEntry> BucketFiles(const vector<uint8_t> &partition, int32_t bucket);
+
+private:
+	//! The sequence numbers and live files of a bucket
+	struct BucketState {
+		int64_t next_sequence_number = 0;
+		vector<PaimonManifestEntry> files;
+	};
+
+private:
+	//! Read the keys, bucketing and options of 'schema'
+	void Initialize(optional_ptr<const PaimonSchema> schema);
+	//! The state of 'bucket' of 'partition', restored on first use from the manifests of the latest snapshot that
+	//! may hold files of the bucket. Sequence numbers continue after those of the bucket's live files.
+	//! Must be called with 'sequence_lock' held.
+	BucketState &GetBucketState(const vector<uint8_t> &partition, int32_t bucket);
+	static string SequenceKey(const vector<uint8_t> &partition, int32_t bucket);
+	void CreateBucketDirectory(ClientContext &context, const vector<pair<string, string>> &partition, int bucket);
+
+public:
+	//! Default 'target-file-size' of primary key tables
+	static constexpr idx_t DEFAULT_PRIMARY_KEY_TARGET_FILE_SIZE = 128ULL * 1024ULL * 1024ULL;
+	//! Default 'target-file-size' of append tables
+	static constexpr idx_t DEFAULT_APPEND_TARGET_FILE_SIZE = 256ULL * 1024ULL * 1024ULL;
+	//! Default 'write-buffer-size'
+	static constexpr idx_t DEFAULT_WRITE_BUFFER_SIZE = 256ULL * 1024ULL * 1024ULL;
+	//! Partition path value used for NULL partition values ('partition.default-name')
+	static constexpr const char *DEFAULT_PARTITION_NAME = "__DEFAULT_PARTITION__";
+
+public:
+	string table_path;
+	int64_t schema_id = 0;
+	vector<string> column_names;
+	vector<LogicalType> column_types;
+	//! The copy function used for the data files, bound for the KeyValue layout on primary key tables
+	unique_ptr<PaimonDataFileBindData> bind;
+	//! The options of the table's latest schema
+	case_insensitive_map_t<string> options;
+	vector<string> partition_keys;
+	vector<idx_t> partition_key_indexes;
+	vector<LogicalType> partition_types;
+	vector<string> primary_keys;
+	vector<idx_t> primary_key_indexes;
+	//! The columns hashed to pick a bucket ('bucket-key', or the primary key without the partition keys)
+	vector<idx_t> bucket_key_indexes;
+	//! The 'bucket' option, -1 for bucket-unaware append tables
+	int total_buckets = 1;
+	BucketManager bucket_manager;
+	idx_t target_file_size;
+	//! The 'manifest.target-file-size' option
+	idx_t manifest_target_file_size;
+	//! Memory of the sorted write buffers of a writer of a primary key table ('write-buffer-size')
+	idx_t write_buffer_size;
+	PaimonMergeEngine merge_engine = PaimonMergeEngine::DEDUPLICATE;
+	//! The 'changelog-producer' option, always NONE for append tables
+	PaimonChangelogProducer changelog_producer = PaimonChangelogProducer::NONE;
+	FileStorePathFactory path_factory;
+	//! Data files are named data-<uuid>-<counter>, with one uuid per write
+	string file_uuid;
+	atomic<idx_t> file_counter;
+
+private:
+	mutex directory_lock;
+	unordered_set<string> created_directories;
+	ClientContext &context;
+	mutex sequence_lock;
+	//! The buckets written so far, keyed on (partition, bucket)
+	unordered_map<string, BucketState> buckets;
+	//! The manifests of the latest snapshot, read when the first bucket is restored
+	bool manifests_loaded = false;
+	vector<PaimonManifestFileMeta> manifests;
+	//! The entries of the manifests read so far, by index in 'manifests'
+	unordered_map<idx_t, vector<PaimonManifestEntry>> manifest_entries;
+};
+
+//! Thread-local writer that splits incoming chunks by partition and bucket, and appends the rows to one open data
+//! file per (partition, bucket). Files are rolled over once they reach the target file size.
+//! On primary key tables rows first go to a sorted write buffer per bucket, which is flushed as a level-0 sorted run
+//! when the writer's buffers exceed 'write-buffer-size', and when the writer is flushed. With a changelog producer the
+//! flushed rows are also written to changelog files: as they came in ('input'), or compared to the previous versions
+//! of their keys ('lookup').
+class PaimonTableWriter {
+public:
+	explicit PaimonTableWriter(PaimonWriteLayout &layout);
+
+public:
+	//! Write the rows of 'chunk' (all table columns). Primary key tables store them with row kind 'kind': updates and
+	//! deletes are written as UPDATE_AFTER and DELETE rows of their key, and resolved when the table is read.
+	void Append(ExecutionContext &context, DataChunk &chunk, PaimonRowKind kind = PaimonRowKind::INSERT);
+	//! Close all open data files, and move the entries of every file written so far into 'result'
+	//! Changelog files go to 'changelog_result'
+	void Flush(ExecutionContext &context, vector<PaimonManifestEntry> &result,
+	           vector<PaimonManifestEntry> &changelog_result);
+
+private:
+	struct BucketWriter {
+		vector<pair<string, string>> partition_path;
+		vector<uint8_t> partition;
+		int bucket;
+		unique_ptr<PaimonDataFileWriter> file;
+		//! Primary key tables only
+		unique_ptr<PaimonSortBuffer> buffer;
+		idx_t buffered_memory = 0;
+		unique_ptr<PaimonDataFileWriter> changelog_file;
+		unique_ptr<PaimonChangelogLookup> lookup;
+	};
+	//! The rows of a chunk that go to the same (partition, bucket)
+	struct RowGroup {
+		string key;
+		idx_t first_row;
+		SelectionVector sel;
+		idx_t count;
+	};
+
+private:
+	//! Routing key of 'row': the partition BinaryRow followed by the bucket
+	void ComputeRoutingKey(DataChunk &chunk, idx_t row, string &result);
+	//! Split the rows of 'chunk' into row groups by routing key, returns the number of groups
+	idx_t RouteRows(DataChunk &chunk);
+	BucketWriter &GetBucketWriter(ClientContext &context, const string &key, DataChunk &chunk, idx_t row);
+	void WriteRows(ExecutionContext &context, BucketWriter &writer, DataChunk &chunk, PaimonRowKind kind);
+	void BufferRows(ExecutionContext &context, BucketWriter &writer, DataChunk &chunk, PaimonRowKind kind);
+	void FlushBuffer(ExecutionContext &context, BucketWriter &writer);
+	void AppendToBucket(ExecutionContext &context, BucketWriter &writer, DataChunk &chunk);
+	void CloseFile(ExecutionContext &context, BucketWriter &writer);
+	void AppendToChangelog(ExecutionContext &context, BucketWriter &writer, DataChunk &chunk);
+	void CloseChangelogFile(ExecutionContext &context, BucketWriter &writer);
+	//! The manifest entry of a file of 'writer'
+	PaimonManifestEntry FinalizeFile(ExecutionContext &context, BucketWriter &writer, PaimonDataFileWriter &file);
+
+private:
+	PaimonWriteLayout &layout;
+	unordered_map<string, unique_ptr<BucketWriter>> bucket_writers;
+	vector<PaimonManifestEntry> written_files;
+	vector<PaimonManifestEntry> written_changelog_files;
+	//! The memory of the write buffers of all buckets
+	idx_t buffered_memory = 0;
+
+	//! Scratch space for routing, reused across chunks
+	PaimonBinaryRowWriter partition_row;
+	PaimonBinaryRowWriter bucket_key_row;
+	vector<UnifiedVectorFormat> column_formats;
+	vector<RowGroup> row_groups;
+	unordered_map<string, idx_t> row_group_map;
+	string row_key;
+	DataChunk slice;
+};
+
+} // namespace duckdb
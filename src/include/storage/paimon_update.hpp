@@ -14,7 +14,8 @@
 
 namespace duckdb {
 
-//! PhysicalUpdate represents an UPDATE operation
+//! UPDATE of a Paimon primary key table. The updated rows are written as UPDATE_AFTER rows of their key into new
+//! level-0 files, which replace the previous versions when the table is read or compacted.
 class PaimonUpdate : public PhysicalOperator {
 public:
 	PaimonUpdate(PhysicalPlan &physical_plan, vector<LogicalType> types, TableCatalogEntry &tableref,
@@ -40,10 +41,21 @@ public:
 public:
 	// Source interface
 	SourceResultType GetData(ExecutionContext &context, DataChunk &chunk, OperatorSourceInput &input) const override;
+	bool IsSource() const override {
+		return true;
+	}
 
 	// Sink interface
 	SinkResultType Sink(ExecutionContext &context, DataChunk &chunk, OperatorSinkInput &input) const override;
 	SinkCombineResultType Combine(ExecutionContext &context, OperatorSinkCombineInput &input) const override;
+	SinkFinalizeType Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
+	                          OperatorSinkFinalizeInput &input) const override;
+	bool IsSink() const override {
+		return true;
+	}
+	bool ParallelSink() const override {
+		return true;
+	}
 
 	// State interface
 	unique_ptr<GlobalSinkState> GetGlobalSinkState(ClientContext &context) const override;
@@ -53,9 +65,6 @@ public:
 	// Operator interface
 	string GetName() const override;
 	InsertionOrderPreservingMap<string> ParamsToString() const override;
-
-private:
-	mutable bool finished = false;
 };
 
 } // namespace duckdb
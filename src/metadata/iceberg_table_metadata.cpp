@@ -253,6 +253,12 @@ IcebergTableMetadata IcebergTableMetadata::FromTableMetadata(rest_api_objects::T
 	for (auto &spec : table_metadata.partition_specs) {
 		res.partition_specs.emplace(spec.spec_id, IcebergPartitionSpec::ParseFromJson(spec));
 	}
+	if (table_metadata.has_statistics) {
+		for (auto &statistics_file : table_metadata.statistics) {
+			res.statistics_files.emplace(statistics_file.snapshot_id,
+			                             IcebergStatisticsFile::FromRESTObject(statistics_file));
+		}
+	}
 	if (!table_metadata.has_current_schema_id) {
 		if (res.iceberg_version == 1) {
 			throw NotImplementedException("Reading of the V1 'schema' field is not currently supported");
@@ -0,0 +1,454 @@
+#include "metadata/iceberg_table_statistics.hpp"
+
+#include "iceberg_logging.hpp"
+#include "iceberg_metadata.hpp"
+#include "iceberg_multi_file_list.hpp"
+#include "iceberg_value.hpp"
+#include "catalog_utils.hpp"
+
+#include "duckdb/common/error_data.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/operator/cast_operators.hpp"
+#include "duckdb/common/unordered_set.hpp"
+#include "duckdb/storage/statistics/numeric_stats.hpp"
+#include "duckdb/storage/statistics/string_stats.hpp"
+
+namespace duckdb {
+
+IcebergStatisticsFile IcebergStatisticsFile::FromRESTObject(const rest_api_objects::StatisticsFile &statistics_file) {
+	IcebergStatisticsFile res;
+	res.snapshot_id = statistics_file.snapshot_id;
+	res.statistics_path = statistics_file.statistics_path;
+	res.file_size_in_bytes = statistics_file.file_size_in_bytes;
+	res.file_footer_size_in_bytes = statistics_file.file_footer_size_in_bytes;
+	for (auto &blob : statistics_file.blob_metadata) {
+		IcebergBlobMetadata blob_metadata;
+		blob_metadata.type = blob.type;
+		blob_metadata.snapshot_id = blob.snapshot_id;
+		blob_metadata.sequence_number = blob.sequence_number;
+		blob_metadata.fields = blob.fields;
+		if (blob.has_properties) {
+			blob_metadata.properties = blob.properties;
+		}
+		res.blob_metadata.push_back(std::move(blob_metadata));
+	}
+	return res;
+}
+
+namespace {
+
+//! The bounds and null counts of a column, over the data files of a snapshot
+struct IcebergColumnAggregate {
+	//! Whether every data file with values for the column has bounds for it
+	bool has_bounds = true;
+	Value min;
+	Value max;
+	//! The NULLs and the values (NULLs included) of the column, counted while every data file has the counts
+	bool has_counts = true;
+	idx_t null_count = 0;
+	idx_t value_count = 0;
+	bool has_nan = false;
+
+public:
+	bool CanHaveNull() const {
+		return !has_counts || null_count != 0;
+	}
+	bool CanHaveValid() const {
+		return !has_counts || null_count != value_count;
+	}
+};
+
+bool SupportsMinMax(const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::BOOLEAN:
+	case LogicalTypeId::INTEGER:
+	case LogicalTypeId::BIGINT:
+	case LogicalTypeId::FLOAT:
+	case LogicalTypeId::DOUBLE:
+	case LogicalTypeId::DECIMAL:
+	case LogicalTypeId::DATE:
+	case LogicalTypeId::TIME:
+	case LogicalTypeId::TIMESTAMP:
+	case LogicalTypeId::TIMESTAMP_TZ:
+	case LogicalTypeId::TIMESTAMP_NS:
+	case LogicalTypeId::VARCHAR:
+		return true;
+	default:
+		return false;
+	}
+}
+
+void AggregateColumn(const IcebergManifestEntry &data_file, const IcebergColumnDefinition &column,
+                     IcebergColumnAggregate &aggregate) {
+	auto field_id = column.id;
+	auto &type = column.type;
+
+	//! NULLs and NaNs are assumed to be present unless the counts say otherwise
+	auto null_counts_it = data_file.null_value_counts.find(field_id);
+	auto value_counts_it = data_file.value_counts.find(field_id);
+	auto has_null_count = null_counts_it != data_file.null_value_counts.end();
+	auto has_value_count = value_counts_it != data_file.value_counts.end();
+	if (has_null_count && has_value_count && null_counts_it->second >= 0 &&
+	    value_counts_it->second >= null_counts_it->second) {
+		aggregate.null_count += NumericCast<idx_t>(null_counts_it->second);
+		aggregate.value_count += NumericCast<idx_t>(value_counts_it->second);
+	} else {
+		aggregate.has_counts = false;
+	}
+	if (type.id() == LogicalTypeId::FLOAT || type.id() == LogicalTypeId::DOUBLE) {
+		auto nan_counts_it = data_file.nan_value_counts.find(field_id);
+		if (nan_counts_it == data_file.nan_value_counts.end() || nan_counts_it->second != 0) {
+			aggregate.has_nan = true;
+		}
+	}
+	if (!aggregate.has_bounds) {
+		return;
+	}
+
+	auto lower_bound_it = data_file.lower_bounds.find(field_id);
+	auto upper_bound_it = data_file.upper_bounds.find(field_id);
+	if (lower_bound_it == data_file.lower_bounds.end() || upper_bound_it == data_file.upper_bounds.end() ||
+	    lower_bound_it->second.IsNull() || upper_bound_it->second.IsNull()) {
+		//! A file without bounds only keeps the bounds of the others valid if the column is NULL in all its rows
+		if (!has_null_count || !has_value_count || value_counts_it->second != null_counts_it->second) {
+			aggregate.has_bounds = false;
+		}
+		return;
+	}
+	auto lower_bound = IcebergValue::DeserializeValue(lower_bound_it->second.GetValueUnsafe<string_t>(), type);
+	auto upper_bound = IcebergValue::DeserializeValue(upper_bound_it->second.GetValueUnsafe<string_t>(), type);
+	if (lower_bound.HasError() || upper_bound.HasError()) {
+		//! The bounds were written for another type (before a type promotion), don't use them
+		aggregate.has_bounds = false;
+		return;
+	}
+	auto &min = lower_bound.GetValue();
+	auto &max = upper_bound.GetValue();
+	if (aggregate.min.IsNull() || min < aggregate.min) {
+		aggregate.min = min;
+	}
+	if (aggregate.max.IsNull() || max > aggregate.max) {
+		aggregate.max = max;
+	}
+}
+
+unique_ptr<BaseStatistics> CreateColumnStatistics(const LogicalType &type, const IcebergColumnAggregate &aggregate,
+                                                  optional_idx distinct_count) {
+	auto has_min_max = aggregate.has_bounds && !aggregate.min.IsNull() && SupportsMinMax(type);
+	if (aggregate.has_nan) {
+		//! NaN sorts above every other value in DuckDB, but the bounds of Iceberg leave it out
+		has_min_max = false;
+	}
+
+	auto stats = has_min_max ? BaseStatistics::CreateEmpty(type) : BaseStatistics::CreateUnknown(type);
+	if (has_min_max) {
+		if (stats.GetStatsType() == StatisticsType::NUMERIC_STATS) {
+			NumericStats::SetMin(stats, aggregate.min);
+			NumericStats::SetMax(stats, aggregate.max);
+		} else {
+			D_ASSERT(stats.GetStatsType() == StatisticsType::STRING_STATS);
+			auto &min = StringValue::Get(aggregate.min);
+			auto &max = StringValue::Get(aggregate.max);
+			StringStats::Update(stats, string_t(min.c_str(), UnsafeNumericCast<uint32_t>(min.size())));
+			StringStats::Update(stats, string_t(max.c_str(), UnsafeNumericCast<uint32_t>(max.size())));
+			//! String bounds can be truncated, so they say nothing about the length or the characters of the values
+			StringStats::ResetMaxStringLength(stats);
+			StringStats::SetContainsUnicode(stats);
+		}
+	}
+	stats.Set(aggregate.CanHaveValid() ? StatsInfo::CAN_HAVE_VALID_VALUES : StatsInfo::CANNOT_HAVE_VALID_VALUES);
+	stats.Set(aggregate.CanHaveNull() ? StatsInfo::CAN_HAVE_NULL_VALUES : StatsInfo::CANNOT_HAVE_NULL_VALUES);
+	if (distinct_count.IsValid()) {
+		stats.SetDistinctCount(distinct_count.GetIndex());
+	}
+	return stats.ToUnique();
+}
+
+//! Writers store the estimate of a theta sketch in the 'ndv' property of its blob
+optional_idx ParseDistinctCount(const char *ndv) {
+	uint64_t result;
+	if (!ndv || !TryCast::Operation<string_t, uint64_t>(string_t(ndv), result, true)) {
+		return optional_idx();
+	}
+	return optional_idx(result);
+}
+
+//! The statistics file of 'snapshot', or of its nearest ancestor that has one
+optional_ptr<const IcebergStatisticsFile> FindStatisticsFile(const IcebergTableMetadata &metadata,
+                                                             const IcebergSnapshot &snapshot) {
+	optional_ptr<const IcebergSnapshot> current = snapshot;
+	for (idx_t depth = 0; current && depth < metadata.snapshots.size(); depth++) {
+		auto statistics_it = metadata.statistics_files.find(current->snapshot_id);
+		if (statistics_it != metadata.statistics_files.end()) {
+			return statistics_it->second;
+		}
+		if (!current->has_parent_snapshot) {
+			break;
+		}
+		auto parent_it = metadata.snapshots.find(current->parent_snapshot_id);
+		current = parent_it == metadata.snapshots.end() ? nullptr : &parent_it->second;
+	}
+	return nullptr;
+}
+
+//! Read the theta sketches of the 'missing' fields from the footer and the blobs of the Puffin file
+//! https://iceberg.apache.org/puffin-spec/#file-structure
+void ReadThetaSketches(ClientContext &context, const IcebergStatisticsFile &statistics_file,
+                       const unordered_set<int32_t> &missing, unordered_map<int32_t, idx_t> &distinct_counts) {
+	constexpr char PUFFIN_MAGIC[] = {'P', 'F', 'A', '1'};
+	constexpr idx_t PUFFIN_MAGIC_SIZE = 4;
+	//! Magic, FooterPayload, FooterPayloadSize, Flags, Magic
+	constexpr idx_t MIN_FOOTER_SIZE = PUFFIN_MAGIC_SIZE + sizeof(int32_t) + sizeof(uint32_t) + PUFFIN_MAGIC_SIZE;
+	constexpr uint32_t FOOTER_PAYLOAD_COMPRESSED = 1;
+
+	auto &path = statistics_file.statistics_path;
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ);
+	auto file_size = NumericCast<idx_t>(handle->GetFileSize());
+	auto footer_size = NumericCast<idx_t>(statistics_file.file_footer_size_in_bytes);
+	if (footer_size < MIN_FOOTER_SIZE || footer_size > file_size) {
+		throw InvalidInputException("Puffin file '%s' has an invalid footer size of %d bytes", path, footer_size);
+	}
+
+	auto footer = make_unsafe_uniq_array<data_t>(footer_size);
+	handle->Read(footer.get(), footer_size, file_size - footer_size);
+	auto footer_end = footer.get() + footer_size;
+	if (memcmp(footer.get(), PUFFIN_MAGIC, PUFFIN_MAGIC_SIZE) ||
+	    memcmp(footer_end - PUFFIN_MAGIC_SIZE, PUFFIN_MAGIC, PUFFIN_MAGIC_SIZE)) {
+		throw InvalidInputException("Magic bytes mismatch, Puffin file '%s' is corrupt!", path);
+	}
+	auto payload_size = Load<int32_t>(footer_end - MIN_FOOTER_SIZE + PUFFIN_MAGIC_SIZE);
+	auto flags = Load<uint32_t>(footer_end - PUFFIN_MAGIC_SIZE - sizeof(uint32_t));
+	if (flags & FOOTER_PAYLOAD_COMPRESSED) {
+		throw NotImplementedException("Compressed Puffin footers are not supported");
+	}
+	if (payload_size < 0 || NumericCast<idx_t>(payload_size) + MIN_FOOTER_SIZE != footer_size) {
+		throw InvalidInputException("Puffin file '%s' has an invalid footer payload size", path);
+	}
+
+	auto doc = std::unique_ptr<yyjson_doc, YyjsonDocDeleter>(
+	    yyjson_read(char_ptr_cast(footer.get() + PUFFIN_MAGIC_SIZE), NumericCast<size_t>(payload_size), 0));
+	if (!doc) {
+		throw InvalidInputException("Failed to parse the footer of Puffin file '%s'", path);
+	}
+	auto blobs = yyjson_obj_get(yyjson_doc_get_root(doc.get()), "blobs");
+	size_t idx, max;
+	yyjson_val *blob;
+	yyjson_arr_foreach(blobs, idx, max, blob) {
+		auto type = yyjson_get_str(yyjson_obj_get(blob, "type"));
+		auto fields = yyjson_obj_get(blob, "fields");
+		if (!type || strcmp(type, IcebergStatisticsFile::THETA_SKETCH_BLOB_TYPE) || yyjson_arr_size(fields) != 1) {
+			continue;
+		}
+		auto field_id = NumericCast<int32_t>(yyjson_get_sint(yyjson_arr_get_first(fields)));
+		if (!missing.count(field_id) || distinct_counts.count(field_id)) {
+			continue;
+		}
+		auto distinct_count =
+		    ParseDistinctCount(yyjson_get_str(yyjson_obj_get(yyjson_obj_get(blob, "properties"), "ndv")));
+		if (distinct_count.IsValid()) {
+			distinct_counts.emplace(field_id, distinct_count.GetIndex());
+			continue;
+		}
+		if (yyjson_get_str(yyjson_obj_get(blob, "compression-codec"))) {
+			DUCKDB_LOG(context, IcebergLogType, "Iceberg Statistics, skipped compressed theta sketch of field %d in '%s'",
+			           field_id, path);
+			continue;
+		}
+
+		auto offset = NumericCast<idx_t>(yyjson_get_sint(yyjson_obj_get(blob, "offset")));
+		auto length = NumericCast<idx_t>(yyjson_get_sint(yyjson_obj_get(blob, "length")));
+		if (offset + length > file_size) {
+			throw InvalidInputException("Blob of field %d is out of bounds of Puffin file '%s'", field_id, path);
+		}
+		auto sketch = make_unsafe_uniq_array<data_t>(length);
+		handle->Read(sketch.get(), length, offset);
+		auto estimate = IcebergTableStatistics::EstimateThetaSketch(sketch.get(), length);
+		if (estimate.IsValid()) {
+			distinct_counts.emplace(field_id, estimate.GetIndex());
+		}
+	}
+}
+
+//! The distinct counts of the columns, by field id, from the statistics file of 'snapshot' or of its nearest ancestor
+unordered_map<int32_t, idx_t> ReadDistinctCounts(ClientContext &context, const IcebergTableMetadata &metadata,
+                                                 const IcebergSnapshot &snapshot) {
+	unordered_map<int32_t, idx_t> result;
+	auto statistics_file = FindStatisticsFile(metadata, snapshot);
+	if (!statistics_file) {
+		return result;
+	}
+
+	//! The estimates are usually in the properties of the blobs, only read the sketches that don't have one
+	unordered_set<int32_t> missing;
+	for (auto &blob : statistics_file->blob_metadata) {
+		if (blob.type != IcebergStatisticsFile::THETA_SKETCH_BLOB_TYPE || blob.fields.size() != 1) {
+			continue;
+		}
+		auto ndv_it = blob.properties.find("ndv");
+		auto distinct_count = ndv_it == blob.properties.end() ? optional_idx() : ParseDistinctCount(ndv_it->second.c_str());
+		if (distinct_count.IsValid()) {
+			result.emplace(blob.fields[0], distinct_count.GetIndex());
+		} else {
+			missing.insert(blob.fields[0]);
+		}
+	}
+	if (missing.empty()) {
+		return result;
+	}
+	try {
+		ReadThetaSketches(context, *statistics_file, missing, result);
+	} catch (std::exception &ex) {
+		//! The distinct counts are only estimates, a statistics file that can't be read doesn't fail the query
+		ErrorData error(ex);
+		DUCKDB_LOG(context, IcebergLogType, "Iceberg Statistics, failed to read the theta sketches of '%s': %s",
+		           statistics_file->statistics_path, error.RawMessage());
+	}
+	return result;
+}
+
+} // namespace
+
+shared_ptr<IcebergTableStatistics> IcebergTableStatistics::Build(ClientContext &context,
+                                                                 shared_ptr<IcebergScanInfo> scan_info) {
+	D_ASSERT(scan_info->snapshot);
+	D_ASSERT(!scan_info->transaction_data);
+	auto result = make_shared_ptr<IcebergTableStatistics>();
+
+	//! Enumerate the data files of every data manifest of the snapshot, the manifests are decoded in parallel by the
+	//! background tasks of the file list, as they are for a scan
+	IcebergOptions options;
+	IcebergMultiFileList file_list(context, scan_info, scan_info->metadata_path, options);
+	vector<LogicalType> types;
+	vector<string> names;
+	file_list.Bind(types, names);
+	if (file_list.GetTotalFileCount() == 0) {
+		return result;
+	}
+
+	auto &metadata = scan_info->metadata;
+	auto &columns = scan_info->schema.columns;
+	vector<IcebergColumnAggregate> aggregates(columns.size());
+	for (auto &data_file : file_list.data_files) {
+		for (idx_t i = 0; i < columns.size(); i++) {
+			AggregateColumn(data_file, *columns[i], aggregates[i]);
+		}
+	}
+
+	auto distinct_counts = ReadDistinctCounts(context, metadata, *scan_info->snapshot);
+	for (idx_t i = 0; i < columns.size(); i++) {
+		auto &column = *columns[i];
+		optional_idx distinct_count;
+		auto distinct_count_it = distinct_counts.find(column.id);
+		if (distinct_count_it != distinct_counts.end()) {
+			distinct_count = distinct_count_it->second;
+		}
+		result->columns.emplace(column.id, CreateColumnStatistics(column.type, aggregates[i], distinct_count));
+	}
+	return result;
+}
+
+unique_ptr<BaseStatistics> IcebergTableStatistics::GetColumnStatistics(int32_t field_id) const {
+	auto it = columns.find(field_id);
+	if (it == columns.end()) {
+		return nullptr;
+	}
+	return it->second->ToUnique();
+}
+
+optional_idx IcebergTableStatistics::EstimateThetaSketch(const_data_ptr_t data, idx_t size) {
+	//! The serialization of the compact sketches of Apache DataSketches: a preamble of 1 to 3 longs, with the number of
+	//! retained entries and theta, the fraction of the hash space the entries were sampled from
+	constexpr uint8_t COMPACT_SKETCH_FAMILY = 3;
+	constexpr uint8_t EMPTY_FLAG = 1 << 2;
+	constexpr uint64_t MAX_THETA = NumericLimits<int64_t>::Maximum();
+
+	if (size < sizeof(uint64_t)) {
+		return optional_idx();
+	}
+	auto preamble_longs = idx_t(data[0] & 0x3F);
+	auto serial_version = data[1];
+	auto family = data[2];
+	auto flags = data[5];
+	if (family != COMPACT_SKETCH_FAMILY || preamble_longs == 0 || size < preamble_longs * sizeof(uint64_t)) {
+		return optional_idx();
+	}
+
+	uint64_t entries = 0;
+	uint64_t theta = MAX_THETA;
+	if (serial_version == 3) {
+		if (preamble_longs == 1) {
+			//! Empty, or a single entry
+			return optional_idx(flags & EMPTY_FLAG ? 0 : 1);
+		}
+		entries = Load<uint32_t>(data + sizeof(uint64_t));
+		if (preamble_longs > 2) {
+			theta = Load<uint64_t>(data + 2 * sizeof(uint64_t));
+		}
+	} else if (serial_version == 4) {
+		//! Compressed entries, their count is stored in 'num_entries_bytes' bytes after the preamble
+		auto num_entries_bytes = idx_t(data[4]);
+		auto num_entries_offset = preamble_longs * sizeof(uint64_t);
+		if (num_entries_bytes > sizeof(uint32_t) || size < num_entries_offset + num_entries_bytes) {
+			return optional_idx();
+		}
+		if (preamble_longs > 1) {
+			theta = Load<uint64_t>(data + sizeof(uint64_t));
+		}
+		for (idx_t i = 0; i < num_entries_bytes; i++) {
+			entries |= uint64_t(data[num_entries_offset + i]) << (i * 8);
+		}
+	} else {
+		return optional_idx();
+	}
+
+	if (theta == 0 || theta > MAX_THETA) {
+		return optional_idx();
+	}
+	if (theta == MAX_THETA) {
+		return optional_idx(entries);
+	}
+	return optional_idx(LossyNumericCast<idx_t>(double(entries) * double(MAX_THETA) / double(theta)));
+}
+
+bool IcebergTableStatisticsCache::Contains(int64_t snapshot_id, int32_t schema_id) {
+	lock_guard<mutex> guard(lock);
+	auto it = snapshots.find(make_pair(snapshot_id, schema_id));
+	return it != snapshots.end() && it->second->statistics;
+}
+
+shared_ptr<IcebergTableStatistics> IcebergTableStatisticsCache::Get(ClientContext &context,
+                                                                    shared_ptr<IcebergScanInfo> scan_info) {
+	if (!scan_info->snapshot || scan_info->transaction_data) {
+		return nullptr;
+	}
+	auto key = make_pair(scan_info->snapshot->snapshot_id, scan_info->schema.schema_id);
+
+	shared_ptr<IcebergStatisticsEntry> entry;
+	{
+		lock_guard<mutex> guard(lock);
+		auto &snapshot_entry = snapshots[key];
+		if (!snapshot_entry) {
+			snapshot_entry = make_shared_ptr<IcebergStatisticsEntry>();
+		}
+		if (snapshot_entry->statistics) {
+			return snapshot_entry->statistics;
+		}
+		entry = snapshot_entry;
+	}
+	//! Only one query builds the statistics of a snapshot, the others wait for it instead of reading every manifest
+	//! again. The cache lock isn't held meanwhile, so the planning of queries on other snapshots isn't blocked.
+	lock_guard<mutex> build_guard(entry->build_lock);
+	{
+		lock_guard<mutex> guard(lock);
+		if (entry->statistics) {
+			return entry->statistics;
+		}
+	}
+	auto statistics = IcebergTableStatistics::Build(context, std::move(scan_info));
+	lock_guard<mutex> guard(lock);
+	entry->statistics = statistics;
+	return statistics;
+}
+
+} // namespace duckdb
@@ -0,0 +1,464 @@
+#include "paimon_binary_row.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/date.hpp"
+#include "duckdb/common/types/time.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/common/types/decimal.hpp"
+#include "duckdb/common/types/hugeint.hpp"
+
+namespace duckdb {
+
+static constexpr idx_t BINARY_ROW_HEADER_SIZE_IN_BITS = 8;
+static constexpr idx_t BINARY_ROW_MAX_COMPACT_BYTES = 7;
+static constexpr idx_t BINARY_ROW_NON_COMPACT_DECIMAL_BYTES = 16;
+static constexpr uint8_t BINARY_ROW_DECIMAL_MAX_COMPACT_PRECISION = 18;
+
+PaimonBinaryRowWriter::PaimonBinaryRowWriter(idx_t arity) : arity(arity) {
+	fixed_size = NullBitsSizeInBytes(arity) + arity * 8;
+	Reset();
+}
+
+idx_t PaimonBinaryRowWriter::NullBitsSizeInBytes(idx_t arity) {
+	return ((arity + 63 + BINARY_ROW_HEADER_SIZE_IN_BITS) / 64) * 8;
+}
+
+bool PaimonBinaryRowWriter::IsFixedLength(const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::BOOLEAN:
+	case LogicalTypeId::TINYINT:
+	case LogicalTypeId::SMALLINT:
+	case LogicalTypeId::INTEGER:
+	case LogicalTypeId::BIGINT:
+	case LogicalTypeId::FLOAT:
+	case LogicalTypeId::DOUBLE:
+	case LogicalTypeId::DATE:
+	case LogicalTypeId::TIME:
+	case LogicalTypeId::TIMESTAMP_MS:
+	case LogicalTypeId::TIMESTAMP_SEC:
+		return true;
+	case LogicalTypeId::DECIMAL:
+		return DecimalType::GetWidth(type) <= BINARY_ROW_DECIMAL_MAX_COMPACT_PRECISION;
+	default:
+		return false;
+	}
+}
+
+void PaimonBinaryRowWriter::Reset() {
+	buffer.assign(fixed_size, 0);
+}
+
+idx_t PaimonBinaryRowWriter::FieldOffset(idx_t pos) const {
+	D_ASSERT(pos < arity);
+	return NullBitsSizeInBytes(arity) + pos * 8;
+}
+
+void PaimonBinaryRowWriter::SetNullAt(idx_t pos) {
+	auto bit_index = pos + BINARY_ROW_HEADER_SIZE_IN_BITS;
+	buffer[bit_index / 8] |= static_cast<uint8_t>(1 << (bit_index % 8));
+	memset(buffer.data() + FieldOffset(pos), 0, 8);
+}
+
+void PaimonBinaryRowWriter::WriteFixed(idx_t pos, const_data_ptr_t data, idx_t size) {
+	D_ASSERT(size <= 8);
+	auto offset = FieldOffset(pos);
+	memset(buffer.data() + offset, 0, 8);
+	memcpy(buffer.data() + offset, data, size);
+}
+
+void PaimonBinaryRowWriter::WriteVariable(idx_t pos, const_data_ptr_t data, idx_t size, idx_t reserved_size) {
+	auto cursor = buffer.size();
+	auto rounded_size = AlignValue<idx_t, 8>(MaxValue<idx_t>(size, reserved_size));
+	buffer.resize(cursor + rounded_size, 0);
+	if (size) {
+		memcpy(buffer.data() + cursor, data, size);
+	}
+	auto offset_and_size = (static_cast<uint64_t>(cursor) << 32) | static_cast<uint64_t>(size);
+	Store<uint64_t>(offset_and_size, buffer.data() + FieldOffset(pos));
+}
+
+void PaimonBinaryRowWriter::WriteBytes(idx_t pos, const char *data, idx_t size) {
+	if (size > BINARY_ROW_MAX_COMPACT_BYTES) {
+		WriteVariable(pos, const_data_ptr_cast(data), size, 0);
+		return;
+	}
+	//! Short values are stored inline, the highest byte holds a mark bit and the length
+	auto offset = FieldOffset(pos);
+	memset(buffer.data() + offset, 0, 8);
+	if (size) {
+		memcpy(buffer.data() + offset, data, size);
+	}
+	buffer[offset + 7] = static_cast<uint8_t>(0x80 | size);
+}
+
+template <class T>
+static void WriteFixedValue(PaimonBinaryRowWriter &writer, idx_t pos, T value,
+                            void (PaimonBinaryRowWriter::*write)(idx_t, const_data_ptr_t, idx_t)) {
+	(writer.*write)(pos, const_data_ptr_cast(&value), sizeof(T));
+}
+
+//! Minimal big-endian two's complement encoding, matching java.math.BigInteger#toByteArray
+static string HugeintToUnscaledBytes(hugeint_t value) {
+	uint8_t bytes[16];
+	auto upper = static_cast<uint64_t>(value.upper);
+	for (idx_t i = 0; i < 8; i++) {
+		bytes[i] = static_cast<uint8_t>(upper >> (56 - i * 8));
+		bytes[8 + i] = static_cast<uint8_t>(value.lower >> (56 - i * 8));
+	}
+	idx_t start = 0;
+	while (start < 15) {
+		bool redundant_zero = bytes[start] == 0x00 && !(bytes[start + 1] & 0x80);
+		bool redundant_sign = bytes[start] == 0xFF && (bytes[start + 1] & 0x80);
+		if (!redundant_zero && !redundant_sign) {
+			break;
+		}
+		start++;
+	}
+	return string(const_char_ptr_cast(bytes + start), 16 - start);
+}
+
+static hugeint_t UnscaledBytesToHugeint(const_data_ptr_t data, idx_t size) {
+	if (size == 0 || size > 16) {
+		throw InvalidInputException("Invalid unscaled decimal of %llu bytes in Paimon BinaryRow", size);
+	}
+	uint8_t bytes[16];
+	uint8_t sign = (data[0] & 0x80) ? 0xFF : 0x00;
+	memset(bytes, sign, 16 - size);
+	memcpy(bytes + 16 - size, data, size);
+	uint64_t upper = 0;
+	uint64_t lower = 0;
+	for (idx_t i = 0; i < 8; i++) {
+		upper = (upper << 8) | bytes[i];
+		lower = (lower << 8) | bytes[8 + i];
+	}
+	hugeint_t result;
+	result.upper = static_cast<int64_t>(upper);
+	result.lower = lower;
+	return result;
+}
+
+void PaimonBinaryRowWriter::WriteValue(idx_t pos, const Value &value) {
+	if (value.IsNull()) {
+		SetNullAt(pos);
+		return;
+	}
+	auto &type = value.type();
+	auto write = &PaimonBinaryRowWriter::WriteFixed;
+	switch (type.id()) {
+	case LogicalTypeId::BOOLEAN:
+		WriteFixedValue<uint8_t>(*this, pos, BooleanValue::Get(value) ? 1 : 0, write);
+		break;
+	case LogicalTypeId::TINYINT:
+		WriteFixedValue<int8_t>(*this, pos, TinyIntValue::Get(value), write);
+		break;
+	case LogicalTypeId::SMALLINT:
+		WriteFixedValue<int16_t>(*this, pos, SmallIntValue::Get(value), write);
+		break;
+	case LogicalTypeId::INTEGER:
+		WriteFixedValue<int32_t>(*this, pos, IntegerValue::Get(value), write);
+		break;
+	case LogicalTypeId::BIGINT:
+		WriteFixedValue<int64_t>(*this, pos, BigIntValue::Get(value), write);
+		break;
+	case LogicalTypeId::FLOAT:
+		WriteFixedValue<float>(*this, pos, FloatValue::Get(value), write);
+		break;
+	case LogicalTypeId::DOUBLE:
+		WriteFixedValue<double>(*this, pos, DoubleValue::Get(value), write);
+		break;
+	case LogicalTypeId::DATE:
+		WriteFixedValue<int32_t>(*this, pos, value.GetValue<date_t>().days, write);
+		break;
+	case LogicalTypeId::TIME:
+		//! Paimon stores TIME as milliseconds of the day
+		WriteFixedValue<int32_t>(*this, pos, static_cast<int32_t>(value.GetValue<dtime_t>().micros / 1000), write);
+		break;
+	case LogicalTypeId::TIMESTAMP_MS:
+		WriteFixedValue<int64_t>(*this, pos, value.GetValueUnsafe<int64_t>(), write);
+		break;
+	case LogicalTypeId::TIMESTAMP_SEC:
+		WriteFixedValue<int64_t>(*this, pos, value.GetValueUnsafe<int64_t>() * 1000, write);
+		break;
+	case LogicalTypeId::TIMESTAMP:
+	case LogicalTypeId::TIMESTAMP_TZ:
+	case LogicalTypeId::TIMESTAMP_NS: {
+		//! Non-compact timestamp: milliseconds in the variable part, nano-of-millisecond in the fixed part
+		auto raw = value.GetValueUnsafe<int64_t>();
+		int64_t units_per_milli = type.id() == LogicalTypeId::TIMESTAMP_NS ? 1000000 : 1000;
+		int64_t millis = raw / units_per_milli;
+		if (raw % units_per_milli < 0) {
+			millis--;
+		}
+		auto nanos_of_milli = (raw - millis * units_per_milli) * (1000000 / units_per_milli);
+		auto cursor = buffer.size();
+		buffer.resize(cursor + 8, 0);
+		Store<int64_t>(millis, buffer.data() + cursor);
+		auto offset_and_nanos = (static_cast<uint64_t>(cursor) << 32) | static_cast<uint64_t>(nanos_of_milli);
+		Store<uint64_t>(offset_and_nanos, buffer.data() + FieldOffset(pos));
+		break;
+	}
+	case LogicalTypeId::DECIMAL: {
+		auto width = DecimalType::GetWidth(type);
+		if (width <= BINARY_ROW_DECIMAL_MAX_COMPACT_PRECISION) {
+			int64_t unscaled;
+			switch (type.InternalType()) {
+			case PhysicalType::INT16:
+				unscaled = value.GetValueUnsafe<int16_t>();
+				break;
+			case PhysicalType::INT32:
+				unscaled = value.GetValueUnsafe<int32_t>();
+				break;
+			default:
+				unscaled = value.GetValueUnsafe<int64_t>();
+				break;
+			}
+			WriteFixedValue<int64_t>(*this, pos, unscaled, write);
+		} else {
+			auto bytes = HugeintToUnscaledBytes(value.GetValueUnsafe<hugeint_t>());
+			WriteVariable(pos, const_data_ptr_cast(bytes.data()), bytes.size(), BINARY_ROW_NON_COMPACT_DECIMAL_BYTES);
+		}
+		break;
+	}
+	case LogicalTypeId::VARCHAR:
+	case LogicalTypeId::BLOB: {
+		auto &str = StringValue::Get(value);
+		WriteBytes(pos, str.data(), str.size());
+		break;
+	}
+	default:
+		SetNullAt(pos);
+		break;
+	}
+}
+
+template <class T>
+static T GetVectorValue(const UnifiedVectorFormat &format, idx_t idx) {
+	return UnifiedVectorFormat::GetData<T>(format)[idx];
+}
+
+void PaimonBinaryRowWriter::WriteVector(idx_t pos, Vector &input, const UnifiedVectorFormat &format, idx_t row) {
+	auto idx = format.sel->get_index(row);
+	if (!format.validity.RowIsValid(idx)) {
+		SetNullAt(pos);
+		return;
+	}
+	auto write = &PaimonBinaryRowWriter::WriteFixed;
+	switch (input.GetType().id()) {
+	case LogicalTypeId::BOOLEAN:
+		WriteFixedValue<uint8_t>(*this, pos, GetVectorValue<bool>(format, idx) ? 1 : 0, write);
+		break;
+	case LogicalTypeId::TINYINT:
+		WriteFixedValue<int8_t>(*this, pos, GetVectorValue<int8_t>(format, idx), write);
+		break;
+	case LogicalTypeId::SMALLINT:
+		WriteFixedValue<int16_t>(*this, pos, GetVectorValue<int16_t>(format, idx), write);
+		break;
+	case LogicalTypeId::INTEGER:
+		WriteFixedValue<int32_t>(*this, pos, GetVectorValue<int32_t>(format, idx), write);
+		break;
+	case LogicalTypeId::BIGINT:
+		WriteFixedValue<int64_t>(*this, pos, GetVectorValue<int64_t>(format, idx), write);
+		break;
+	case LogicalTypeId::FLOAT:
+		WriteFixedValue<float>(*this, pos, GetVectorValue<float>(format, idx), write);
+		break;
+	case LogicalTypeId::DOUBLE:
+		WriteFixedValue<double>(*this, pos, GetVectorValue<double>(format, idx), write);
+		break;
+	case LogicalTypeId::DATE:
+		WriteFixedValue<int32_t>(*this, pos, GetVectorValue<date_t>(format, idx).days, write);
+		break;
+	case LogicalTypeId::VARCHAR:
+	case LogicalTypeId::BLOB: {
+		auto str = GetVectorValue<string_t>(format, idx);
+		WriteBytes(pos, str.GetData(), str.GetSize());
+		break;
+	}
+	default:
+		WriteValue(pos, input.GetValue(row));
+		break;
+	}
+}
+
+static inline uint32_t RotateLeft(uint32_t value, int shift) {
+	return (value << shift) | (value >> (32 - shift));
+}
+
+int32_t PaimonBinaryRowWriter::HashCode() const {
+	static constexpr uint32_t DEFAULT_SEED = 42;
+	D_ASSERT(buffer.size() % 4 == 0);
+	uint32_t h1 = DEFAULT_SEED;
+	for (idx_t i = 0; i < buffer.size(); i += 4) {
+		auto k1 = Load<uint32_t>(buffer.data() + i);
+		k1 *= 0xcc9e2d51;
+		k1 = RotateLeft(k1, 15);
+		k1 *= 0x1b873593;
+		h1 ^= k1;
+		h1 = RotateLeft(h1, 13);
+		h1 = h1 * 5 + 0xe6546b64;
+	}
+	h1 ^= static_cast<uint32_t>(buffer.size());
+	h1 ^= h1 >> 16;
+	h1 *= 0x85ebca6b;
+	h1 ^= h1 >> 13;
+	h1 *= 0xc2b2ae35;
+	h1 ^= h1 >> 16;
+	return static_cast<int32_t>(h1);
+}
+
+vector<uint8_t> PaimonBinaryRowWriter::Serialize() const {
+	vector<uint8_t> result(4 + buffer.size());
+	auto arity_value = static_cast<uint32_t>(arity);
+	result[0] = static_cast<uint8_t>(arity_value >> 24);
+	result[1] = static_cast<uint8_t>(arity_value >> 16);
+	result[2] = static_cast<uint8_t>(arity_value >> 8);
+	result[3] = static_cast<uint8_t>(arity_value);
+	memcpy(result.data() + 4, buffer.data(), buffer.size());
+	return result;
+}
+
+vector<uint8_t> PaimonBinaryRow::Serialize(const vector<Value> &values) {
+	PaimonBinaryRowWriter writer(values.size());
+	for (idx_t i = 0; i < values.size(); i++) {
+		writer.WriteValue(i, values[i]);
+	}
+	return writer.Serialize();
+}
+
+vector<uint8_t> PaimonBinaryRow::EmptyRow() {
+	PaimonBinaryRowWriter writer(0);
+	return writer.Serialize();
+}
+
+Value PaimonBinaryRow::ToBlob(const vector<uint8_t> &data) {
+	return Value::BLOB(data.data(), data.size());
+}
+
+static string ReadBytes(const_data_ptr_t row, idx_t row_size, idx_t field_offset) {
+	auto offset_and_size = Load<uint64_t>(row + field_offset);
+	if (offset_and_size & (1ULL << 63)) {
+		auto size = (offset_and_size >> 56) & 0x7F;
+		return string(const_char_ptr_cast(row + field_offset), size);
+	}
+	auto offset = offset_and_size >> 32;
+	auto size = offset_and_size & 0xFFFFFFFF;
+	if (offset + size > row_size) {
+		throw InvalidInputException("Corrupt variable length field in Paimon BinaryRow");
+	}
+	return string(const_char_ptr_cast(row + offset), size);
+}
+
+vector<Value> PaimonBinaryRow::Deserialize(const_data_ptr_t data, idx_t size, const vector<LogicalType> &types) {
+	if (size < 4) {
+		throw InvalidInputException("Paimon BinaryRow is too small (%llu bytes)", size);
+	}
+	idx_t arity = (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+	              (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+	auto row = data + 4;
+	auto row_size = size - 4;
+	auto null_bits_size = PaimonBinaryRowWriter::NullBitsSizeInBytes(arity);
+	if (row_size < null_bits_size + arity * 8) {
+		throw InvalidInputException("Paimon BinaryRow with arity %llu is truncated", arity);
+	}
+
+	vector<Value> result;
+	result.reserve(types.size());
+	for (idx_t pos = 0; pos < types.size(); pos++) {
+		auto &type = types[pos];
+		if (pos >= arity) {
+			result.emplace_back(type);
+			continue;
+		}
+		auto bit_index = pos + BINARY_ROW_HEADER_SIZE_IN_BITS;
+		if (row[bit_index / 8] & (1 << (bit_index % 8))) {
+			result.emplace_back(type);
+			continue;
+		}
+		auto field_offset = null_bits_size + pos * 8;
+		auto field = row + field_offset;
+		switch (type.id()) {
+		case LogicalTypeId::BOOLEAN:
+			result.push_back(Value::BOOLEAN(Load<uint8_t>(field) != 0));
+			break;
+		case LogicalTypeId::TINYINT:
+			result.push_back(Value::TINYINT(Load<int8_t>(field)));
+			break;
+		case LogicalTypeId::SMALLINT:
+			result.push_back(Value::SMALLINT(Load<int16_t>(field)));
+			break;
+		case LogicalTypeId::INTEGER:
+			result.push_back(Value::INTEGER(Load<int32_t>(field)));
+			break;
+		case LogicalTypeId::BIGINT:
+			result.push_back(Value::BIGINT(Load<int64_t>(field)));
+			break;
+		case LogicalTypeId::FLOAT:
+			result.push_back(Value::FLOAT(Load<float>(field)));
+			break;
+		case LogicalTypeId::DOUBLE:
+			result.push_back(Value::DOUBLE(Load<double>(field)));
+			break;
+		case LogicalTypeId::DATE:
+			result.push_back(Value::DATE(date_t(Load<int32_t>(field))));
+			break;
+		case LogicalTypeId::TIME:
+			result.push_back(Value::TIME(dtime_t(static_cast<int64_t>(Load<int32_t>(field)) * 1000)));
+			break;
+		case LogicalTypeId::TIMESTAMP_MS:
+			result.push_back(Value::TIMESTAMPMS(timestamp_ms_t(Load<int64_t>(field))));
+			break;
+		case LogicalTypeId::TIMESTAMP_SEC:
+			result.push_back(Value::TIMESTAMPSEC(timestamp_sec_t(Load<int64_t>(field) / 1000)));
+			break;
+		case LogicalTypeId::TIMESTAMP:
+		case LogicalTypeId::TIMESTAMP_TZ:
+		case LogicalTypeId::TIMESTAMP_NS: {
+			auto offset_and_nanos = Load<uint64_t>(field);
+			auto offset = offset_and_nanos >> 32;
+			auto nanos_of_milli = static_cast<int64_t>(offset_and_nanos & 0xFFFFFFFF);
+			if (offset + 8 > row_size) {
+				throw InvalidInputException("Corrupt timestamp field in Paimon BinaryRow");
+			}
+			auto millis = Load<int64_t>(row + offset);
+			if (type.id() == LogicalTypeId::TIMESTAMP_NS) {
+				result.push_back(Value::TIMESTAMPNS(timestamp_ns_t(millis * 1000000 + nanos_of_milli)));
+			} else if (type.id() == LogicalTypeId::TIMESTAMP_TZ) {
+				result.push_back(Value::TIMESTAMPTZ(timestamp_tz_t(millis * 1000 + nanos_of_milli / 1000)));
+			} else {
+				result.push_back(Value::TIMESTAMP(timestamp_t(millis * 1000 + nanos_of_milli / 1000)));
+			}
+			break;
+		}
+		case LogicalTypeId::DECIMAL: {
+			auto width = DecimalType::GetWidth(type);
+			auto scale = DecimalType::GetScale(type);
+			if (width <= BINARY_ROW_DECIMAL_MAX_COMPACT_PRECISION) {
+				result.push_back(Value::DECIMAL(Load<int64_t>(field), width, scale));
+			} else {
+				auto bytes = ReadBytes(row, row_size, field_offset);
+				auto unscaled = UnscaledBytesToHugeint(const_data_ptr_cast(bytes.data()), bytes.size());
+				result.push_back(Value::DECIMAL(unscaled, width, scale));
+			}
+			break;
+		}
+		case LogicalTypeId::VARCHAR:
+			result.push_back(Value(ReadBytes(row, row_size, field_offset)));
+			break;
+		case LogicalTypeId::BLOB: {
+			auto bytes = ReadBytes(row, row_size, field_offset);
+			result.push_back(Value::BLOB(const_data_ptr_cast(bytes.data()), bytes.size()));
+			break;
+		}
+		default:
+			result.emplace_back(type);
+			break;
+		}
+	}
+	return result;
+}
+
+vector<Value> PaimonBinaryRow::Deserialize(const vector<uint8_t> &data, const vector<LogicalType> &types) {
+	return Deserialize(data.data(), data.size(), types);
+}
+
+} // namespace duckdb
@@ -62,11 +62,15 @@ static void LoadInternal(ExtensionLoader &loader) {
 
 	// Load required extensions
 	ExtensionHelper::AutoLoadExtension(instance, "parquet");
+	ExtensionHelper::AutoLoadExtension(instance, "avro");
 
 	// Verify required extensions are loaded
 	if (!instance.ExtensionIsLoaded("parquet")) {
 		throw MissingExtensionException("The paimon extension requires the parquet extension to be loaded!");
 	}
+	if (!instance.ExtensionIsLoaded("avro")) {
+		throw MissingExtensionException("The paimon extension requires the avro extension to be loaded!");
+	}
 
 	auto &config = DBConfig::GetConfig(instance);
 
@@ -6,7 +6,9 @@
 #include "duckdb/function/cast/cast_function_set.hpp"
 #include "duckdb/function/cast/default_casts.hpp"
 #include "duckdb/parser/expression/function_expression.hpp"
+#include "duckdb/common/atomic.hpp"
 #include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string_util.hpp"
 #include "duckdb/common/file_opener.hpp"
 #include "duckdb/planner/table_filter.hpp"
 #include "duckdb/main/extension/extension_loader.hpp"
@@ -14,6 +16,19 @@
 #include "duckdb/common/multi_file/multi_file_reader.hpp"
 #include "duckdb/common/multi_file/multi_file_list.hpp"
 #include "iceberg_utils.hpp"
+#include "paimon_snapshot.hpp"
+#include "storage/paimon_compaction.hpp"
+#include "storage/paimon_data_file_reader.hpp"
+#include "storage/paimon_deletion_vectors.hpp"
+#include "storage/paimon_expire.hpp"
+#include "storage/paimon_lookup.hpp"
+#include "storage/paimon_merge_reader.hpp"
+#include "storage/paimon_table_entry.hpp"
+#include "storage/paimon_table_writer.hpp"
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/parser/qualified_name.hpp"
+#include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/common/types/column/column_data_collection.hpp"
 
 #include <unordered_map>
 #include <utility>
@@ -21,105 +36,6 @@
 
 namespace duckdb {
 
-//===--------------------------------------------------------------------===//
-// Paimon Snapshots Function
-//===--------------------------------------------------------------------===//
-struct PaimonSnapshotsBindData : public TableFunctionData {
-    string filename;
-    PaimonOptions options;
-};
-
-struct PaimonSnapshotGlobalTableFunctionState : public GlobalTableFunctionState {
-public:
-    static unique_ptr<GlobalTableFunctionState> Init(ClientContext &context, TableFunctionInitInput &input) {
-        auto bind_data = input.bind_data->Cast<PaimonSnapshotsBindData>();
-        auto global_state = make_uniq<PaimonSnapshotGlobalTableFunctionState>();
-
-        FileSystem &fs = FileSystem::GetFileSystem(context);
-
-        auto paimon_meta_path = PaimonTableMetadata::GetMetaDataPath(context, bind_data.filename, fs, bind_data.options);
-        auto table_metadata = PaimonTableMetadata::Parse(paimon_meta_path, fs, bind_data.options.metadata_compression_codec);
-        global_state->metadata = std::move(table_metadata);
-
-        // Convert map to vector for easier iteration
-        for (auto &pair : global_state->metadata->snapshots) {
-            global_state->snapshots_list.push_back(pair.second);
-        }
-
-        global_state->current_index = 0;
-        return std::move(global_state);
-    }
-
-    unique_ptr<PaimonTableMetadata> metadata;
-    vector<PaimonSnapshot> snapshots_list;
-    idx_t current_index;
-};
-
-static unique_ptr<FunctionData> PaimonSnapshotsBind(ClientContext &context, TableFunctionBindInput &input,
-                                                    vector<LogicalType> &return_types, vector<string> &names) {
-    auto bind_data = make_uniq<PaimonSnapshotsBindData>();
-
-    for (auto &kv : input.named_parameters) {
-        auto loption = StringUtil::Lower(kv.first);
-        if (loption == "metadata_compression_codec") {
-            bind_data->options.metadata_compression_codec = StringValue::Get(kv.second);
-        } else if (loption == "version") {
-            bind_data->options.table_version = StringValue::Get(kv.second);
-        }
-        // TODO: Add more Paimon-specific options
-    }
-
-    auto input_string = input.inputs[0].ToString();
-    bind_data->filename = IcebergUtils::GetStorageLocation(context, input_string);
-
-    names.emplace_back("snapshot_id");
-    return_types.emplace_back(LogicalType::UBIGINT);
-
-    names.emplace_back("sequence_number");
-    return_types.emplace_back(LogicalType::UBIGINT);
-
-    names.emplace_back("timestamp_ms");
-    return_types.emplace_back(LogicalType::TIMESTAMP);
-
-    names.emplace_back("manifest_list");
-    return_types.emplace_back(LogicalType::VARCHAR);
-
-    return std::move(bind_data);
-}
-
-static void PaimonSnapshotsFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
-    auto &global_state = data.global_state->Cast<PaimonSnapshotGlobalTableFunctionState>();
-    idx_t i = 0;
-
-    while (global_state.current_index < global_state.snapshots_list.size() && i < STANDARD_VECTOR_SIZE) {
-        auto &snapshot = global_state.snapshots_list[global_state.current_index];
-
-        FlatVector::GetData<uint64_t>(output.data[0])[i] = snapshot.snapshot_id;
-        FlatVector::GetData<uint64_t>(output.data[1])[i] = snapshot.sequence_number;
-        FlatVector::GetData<timestamp_t>(output.data[2])[i] = snapshot.timestamp_ms;
-        string_t manifest_string_t = StringVector::AddString(output.data[3], string_t(snapshot.manifest_list));
-        FlatVector::GetData<string_t>(output.data[3])[i] = manifest_string_t;
-
-        global_state.current_index++;
-        i++;
-    }
-
-    output.SetCardinality(i);
-}
-
-//===--------------------------------------------------------------------===//
-// Paimon Snapshots Table Function
-//===--------------------------------------------------------------------===//
-TableFunctionSet PaimonFunctions::GetPaimonSnapshotsFunction() {
-    TableFunctionSet function_set("paimon_snapshots");
-    TableFunction table_function({LogicalType::VARCHAR}, PaimonSnapshotsFunction, PaimonSnapshotsBind,
-                                 PaimonSnapshotGlobalTableFunctionState::Init);
-    table_function.named_parameters["metadata_compression_codec"] = LogicalType::VARCHAR;
-    table_function.named_parameters["version"] = LogicalType::VARCHAR;
-    function_set.AddFunction(table_function);
-    return function_set;
-}
-
 // Paimon Scan Function
 static void AddPaimonNamedParameters(TableFunction &fun) {
     fun.named_parameters["allow_moved_paths"] = LogicalType::BOOLEAN;
@@ -132,16 +48,52 @@ static void AddPaimonNamedParameters(TableFunction &fun) {
 //===--------------------------------------------------------------------===//
 // Paimon Scan Bind Data
 //===--------------------------------------------------------------------===//
+//! A unit of work of the scan
+struct PaimonScanSplit {
+    //! The data files read by the split
+    vector<PaimonManifestEntry> files;
+};
+
 struct PaimonScanBindData : public TableFunctionData {
     string table_location;
     PaimonOptions options;
-    unique_ptr<PaimonTableMetadata> metadata;
-    vector<string> file_paths;
+    //! The snapshot that is read, 0 if the table has no snapshot yet
+    int64_t snapshot_id = 0;
+    //! The layout of the data files, from the schema the snapshot was written with
+    unique_ptr<PaimonWriteLayout> layout;
+    vector<PaimonScanSplit> splits;
+    //! The deletion vectors of the snapshot's data files, nullptr if no rows are deleted
+    unique_ptr<PaimonDeletionVectors> deletion_vectors;
+    //! Whether the splits are buckets of a primary key table, whose files are merged on their key
+    bool merge_on_read = false;
 };
 
+static LogicalType PaimonTypeToLogicalType(const PaimonDataType &type) {
+    switch (type.type_root) {
+    case PaimonTypeRoot::INT:
+        return LogicalType::INTEGER;
+    case PaimonTypeRoot::LONG:
+        return LogicalType::BIGINT;
+    case PaimonTypeRoot::FLOAT:
+        return LogicalType::FLOAT;
+    case PaimonTypeRoot::DOUBLE:
+        return LogicalType::DOUBLE;
+    case PaimonTypeRoot::BOOLEAN:
+        return LogicalType::BOOLEAN;
+    case PaimonTypeRoot::DATE:
+        return LogicalType::DATE;
+    case PaimonTypeRoot::TIMESTAMP:
+        return LogicalType::TIMESTAMP;
+    case PaimonTypeRoot::BINARY:
+        return LogicalType::BLOB;
+    case PaimonTypeRoot::STRING:
+    default:
+        return LogicalType::VARCHAR;
+    }
+}
+
 static unique_ptr<FunctionData> PaimonScanBind(ClientContext &context, TableFunctionBindInput &input,
                                                 vector<LogicalType> &return_types, vector<string> &names) {
-    std::cerr << "PAIMON: PaimonScanBind called with input: " << input.inputs[0].ToString() << std::endl;
     auto bind_data = make_uniq<PaimonScanBindData>();
 
     // Parse input parameters
@@ -151,187 +103,202 @@ static unique_ptr<FunctionData> PaimonScanBind(ClientContext &context, TableFunc
             bind_data->options.metadata_compression_codec = StringValue::Get(kv.second);
         } else if (loption == "version") {
             bind_data->options.table_version = StringValue::Get(kv.second);
-        } else if (loption == "snapshot_from_timestamp") {
-            // TODO: Implement timestamp-based snapshot selection
-        } else if (loption == "snapshot_from_id") {
-            // TODO: Implement snapshot ID selection
+        } else if (loption == "snapshot_from_timestamp" || loption == "snapshot_from_id") {
+            auto &snapshot_lookup = bind_data->options.snapshot_lookup;
+            if (snapshot_lookup.snapshot_source != PaimonOptions::SnapshotLookup::SnapshotSource::LATEST) {
+                throw InvalidInputException("Can't use 'snapshot_from_id' in combination with 'snapshot_from_timestamp'");
+            }
+            if (loption == "snapshot_from_timestamp") {
+                snapshot_lookup.snapshot_source = PaimonOptions::SnapshotLookup::SnapshotSource::FROM_TIMESTAMP;
+                snapshot_lookup.snapshot_timestamp = kv.second.GetValue<timestamp_t>();
+            } else {
+                snapshot_lookup.snapshot_source = PaimonOptions::SnapshotLookup::SnapshotSource::FROM_ID;
+                snapshot_lookup.snapshot_id = kv.second.GetValue<uint64_t>();
+            }
         }
     }
+    bool latest = bind_data->options.snapshot_lookup.snapshot_source ==
+                      PaimonOptions::SnapshotLookup::SnapshotSource::LATEST &&
+                  bind_data->options.table_version == "latest";
 
-    // Get table location
     auto input_string = input.inputs[0].ToString();
     bind_data->table_location = IcebergUtils::GetStorageLocation(context, input_string);
+    auto &table_location = bind_data->table_location;
 
-    // Read Paimon table metadata
+    // Resolve the snapshot to read. A time travel target that does not exist is an error, a table without
+    // snapshots is empty
     FileSystem &fs = FileSystem::GetFileSystem(context);
-    try {
-        auto paimon_meta_path = PaimonTableMetadata::GetMetaDataPath(context, bind_data->table_location, fs, bind_data->options);
-        std::cerr << "PAIMON: Metadata path: " << paimon_meta_path << std::endl;
-        bind_data->metadata = PaimonTableMetadata::Parse(paimon_meta_path, fs, bind_data->options.metadata_compression_codec);
-        std::cerr << "PAIMON: Metadata parsed successfully" << std::endl;
-    } catch (const std::exception &e) {
-        std::cerr << "PAIMON: Metadata parsing failed: " << e.what() << std::endl;
-        // Create fallback metadata
-        bind_data->metadata = make_uniq<PaimonTableMetadata>();
-        bind_data->metadata->table_format_version = "1";
-        bind_data->metadata->schema = make_uniq<PaimonSchema>();
-        bind_data->metadata->schema->id = 1;
-
-        // Add default fields
-        PaimonSchemaField id_field;
-        id_field.id = 1;
-        id_field.name = "id";
-        id_field.type.type_root = PaimonTypeRoot::LONG;
-        bind_data->metadata->schema->fields.push_back(id_field);
-
-        PaimonSchemaField name_field;
-        name_field.id = 2;
-        name_field.name = "name";
-        name_field.type.type_root = PaimonTypeRoot::STRING;
-        bind_data->metadata->schema->fields.push_back(name_field);
-
-        PaimonSchemaField age_field;
-        age_field.id = 3;
-        age_field.name = "age";
-        age_field.type.type_root = PaimonTypeRoot::INT;
-        bind_data->metadata->schema->fields.push_back(age_field);
-
-        PaimonSchemaField city_field;
-        city_field.id = 4;
-        city_field.name = "city";
-        city_field.type.type_root = PaimonTypeRoot::STRING;
-        bind_data->metadata->schema->fields.push_back(city_field);
-    }
-
-    // Discover data files (skip snapshot logic for now)
-
-    // TODO: Read manifest files to discover data files
-    // For now, use a simple approach - look for data files in the table directory
-    // Discover data files from manifests (proper Paimon implementation)
-    try {
-        vector<string> files = DiscoverDataFilesFromManifests(context, bind_data->table_location, fs);
-        bind_data->file_paths = std::move(files);
-        std::cerr << "PAIMON: Discovered " << bind_data->file_paths.size() << " files from manifests" << std::endl;
-    } catch (std::exception &e) {
-        // Fallback: try to discover files directly from bucket directories
-        std::cerr << "PAIMON: Manifest-based discovery failed, trying direct discovery: " << e.what() << std::endl;
-        try {
-            vector<string> files = DiscoverDataFilesDirectly(context, bind_data->table_location, fs);
-            bind_data->file_paths = std::move(files);
-            std::cerr << "PAIMON: Direct discovery found " << bind_data->file_paths.size() << " files" << std::endl;
-        } catch (std::exception &e2) {
-            std::cerr << "PAIMON: Direct discovery also failed: " << e2.what() << std::endl;
+    PaimonSnapshotInfo snapshot;
+    if (latest) {
+        bind_data->snapshot_id = PaimonTableMetadata::FindLatestSnapshotId(table_location, fs);
+        if (bind_data->snapshot_id > 0) {
+            snapshot = paimon_snapshot::Read(context, table_location, bind_data->snapshot_id);
         }
+    } else {
+        auto snapshot_path = PaimonTableMetadata::GetMetaDataPath(context, table_location, fs, bind_data->options);
+        snapshot = paimon_snapshot::ReadFile(context, snapshot_path);
+        bind_data->snapshot_id = snapshot.id;
     }
 
-    // Set return schema based on Paimon table schema
-    if (bind_data->metadata->schema && !bind_data->metadata->schema->fields.empty()) {
-        for (auto &field : bind_data->metadata->schema->fields) {
-            names.push_back(field.name);
-
-            // Convert Paimon data types to DuckDB types
-            // This is a simplified conversion - real implementation would handle all types
-            switch (field.type.type_root) {
-                case PaimonTypeRoot::STRING:
-                    return_types.push_back(LogicalType::VARCHAR);
-                    break;
-                case PaimonTypeRoot::INT:
-                case PaimonTypeRoot::LONG:
-                    return_types.push_back(LogicalType::BIGINT);
-                    break;
-                case PaimonTypeRoot::FLOAT:
-                case PaimonTypeRoot::DOUBLE:
-                    return_types.push_back(LogicalType::DOUBLE);
-                    break;
-                case PaimonTypeRoot::BOOLEAN:
-                    return_types.push_back(LogicalType::BOOLEAN);
-                    break;
-                case PaimonTypeRoot::TIMESTAMP:
-                    return_types.push_back(LogicalType::TIMESTAMP);
-                    break;
-                case PaimonTypeRoot::DATE:
-                    return_types.push_back(LogicalType::DATE);
-                    break;
-                default:
-                    return_types.push_back(LogicalType::VARCHAR); // Fallback
-                    break;
+    // The columns are those of the schema the snapshot was written with
+    unique_ptr<PaimonSchema> schema;
+    if (bind_data->snapshot_id > 0) {
+        schema = PaimonTableMetadata::LoadSchema(table_location, fs, snapshot.schema_id);
+    } else {
+        schema = PaimonTableMetadata::LoadLatestSchema(table_location, fs);
+        if (!schema) {
+            throw IOException("Paimon table has no schema: " + table_location);
+        }
+    }
+    for (auto &field : schema->fields) {
+        names.push_back(field.name);
+        return_types.push_back(PaimonTypeToLogicalType(field.type));
+    }
+    bind_data->layout = make_uniq<PaimonWriteLayout>(context, table_location, *schema, names, return_types);
+
+    // Plan from the manifests of the snapshot
+    auto &layout = *bind_data->layout;
+    if (layout.HasPrimaryKey() && (layout.merge_engine == PaimonMergeEngine::PARTIAL_UPDATE ||
+                                   layout.merge_engine == PaimonMergeEngine::AGGREGATE)) {
+        throw NotImplementedException("Reading Paimon primary key tables with merge-engine '%s'",
+                                      layout.GetOption("merge-engine"));
+    }
+    // Files of primary key tables with deletion vectors hold no older versions of their keys: level 0 files are not
+    // visible until they are compacted, and the rows they replace are removed by deletion vectors
+    bool deletion_vectors_mode = StringUtil::CIEquals(layout.GetOption("deletion-vectors.enabled"), "true");
+    bind_data->merge_on_read = layout.HasPrimaryKey() && !deletion_vectors_mode;
+    if (bind_data->snapshot_id > 0) {
+        // Every data file of an append table is a split, the files of a bucket of a primary key table are merged on
+        // their key, so every bucket is a split
+        unordered_map<string, idx_t> bucket_splits;
+        for (auto &entry : paimon_snapshot::ReadLiveFiles(context, table_location, snapshot)) {
+            if (layout.HasPrimaryKey() && deletion_vectors_mode && entry.file.level == 0) {
+                continue;
+            }
+            if (!bind_data->merge_on_read) {
+                PaimonScanSplit split;
+                split.files.push_back(std::move(entry));
+                bind_data->splits.push_back(std::move(split));
+                continue;
+            }
+            string bucket_key(const_char_ptr_cast(entry.partition.data()), entry.partition.size());
+            bucket_key.append(const_char_ptr_cast(&entry.bucket), sizeof(entry.bucket));
+            auto split_entry = bucket_splits.emplace(bucket_key, bind_data->splits.size());
+            if (split_entry.second) {
+                bind_data->splits.emplace_back();
             }
+            bind_data->splits[split_entry.first->second].files.push_back(std::move(entry));
+        }
+        bind_data->deletion_vectors = make_uniq<PaimonDeletionVectors>(context, table_location, snapshot);
+        if (bind_data->deletion_vectors->Empty()) {
+            bind_data->deletion_vectors.reset();
         }
     }
+    return std::move(bind_data);
+}
 
-    if (return_types.empty()) {
-        // Fallback schema if no metadata available
-        names = {"data"};
-        return_types = {LogicalType::VARCHAR};
+struct PaimonScanGlobalState : public GlobalTableFunctionState {
+    explicit PaimonScanGlobalState(idx_t split_count) : split_count(split_count) {
     }
 
-    return std::move(bind_data);
+    idx_t MaxThreads() const override {
+        return MaxValue<idx_t>(split_count, 1);
+    }
+
+    idx_t split_count;
+    atomic<idx_t> next_split {0};
+};
+
+struct PaimonScanLocalState : public LocalTableFunctionState {
+    //! The reader of the current split, nullptr if the next split has to be claimed. Splits of primary key tables
+    //! are read by 'merge_reader'.
+    unique_ptr<PaimonDataFileReader> reader;
+    unique_ptr<PaimonMergeReader> merge_reader;
+    //! The deletion vector of the file that is read
+    roaring::Roaring deleted_rows;
+    //! Rows in the layout of the data files
+    DataChunk chunk;
+    SelectionVector sel {STANDARD_VECTOR_SIZE};
+};
+
+//! Drop the DELETE and UPDATE_BEFORE rows of 'chunk', which is in the KeyValue layout
+static void DropRetractions(DataChunk &chunk, idx_t key_count, SelectionVector &sel) {
+    UnifiedVectorFormat kinds;
+    chunk.data[key_count + 1].ToUnifiedFormat(chunk.size(), kinds);
+    auto kind_data = UnifiedVectorFormat::GetData<int8_t>(kinds);
+    idx_t count = 0;
+    for (idx_t row = 0; row < chunk.size(); row++) {
+        auto kind = static_cast<PaimonRowKind>(kind_data[kinds.sel->get_index(row)]);
+        if (kind == PaimonRowKind::INSERT || kind == PaimonRowKind::UPDATE_AFTER) {
+            sel.set_index(count++, row);
+        }
+    }
+    if (count < chunk.size()) {
+        chunk.Slice(sel, count);
+    }
 }
 
-static unique_ptr<GlobalTableFunctionState> PaimonScanInitGlobal(ClientContext &context, TableFunctionInitInput &input) {
+static unique_ptr<GlobalTableFunctionState> PaimonScanInitGlobal(ClientContext &context,
+                                                                 TableFunctionInitInput &input) {
     auto &bind_data = input.bind_data->Cast<PaimonScanBindData>();
-    auto global_state = make_uniq<PaimonScanGlobalTableFunctionState>();
+    return make_uniq<PaimonScanGlobalState>(bind_data.splits.size());
+}
 
-    // Initialize state for reading discovered data files
-    global_state->current_file_idx = 0;
-    return std::move(global_state);
+static unique_ptr<LocalTableFunctionState> PaimonScanInitLocal(ExecutionContext &context, TableFunctionInitInput &input,
+                                                               GlobalTableFunctionState *global_state) {
+    auto &bind_data = input.bind_data->Cast<PaimonScanBindData>();
+    auto local_state = make_uniq<PaimonScanLocalState>();
+    local_state->chunk.Initialize(context.client, bind_data.layout->bind->types);
+    return std::move(local_state);
 }
 
 static void PaimonScanFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
     auto &bind_data = data.bind_data->Cast<PaimonScanBindData>();
-    auto &global_state = data.global_state->Cast<PaimonScanGlobalTableFunctionState>();
-
-    std::cerr << "PAIMON: PaimonScanFunction called, files: " << bind_data.file_paths.size() << ", current_idx: " << global_state.current_file_idx << std::endl;
-
-    // Check if we have more files to process
-    if (global_state.current_file_idx >= bind_data.file_paths.size()) {
-        std::cerr << "PAIMON: No more files to process" << std::endl;
-        output.SetCardinality(0);
-        return;
-    }
-
-    // Get the current file to process
-    string current_file = bind_data.file_paths[global_state.current_file_idx];
-    std::cerr << "PAIMON: Processing file: " << current_file << std::endl;
-
-    try {
-        // Read data from the current parquet file
-        string query = "SELECT * FROM read_parquet('" + current_file + "')";
-        std::cerr << "PAIMON: Executing query: " << query << std::endl;
-        auto result = context.Query(query, false);
-
-        if (result && result->data.size() > 0) {
-            std::cerr << "PAIMON: Got result with " << result->data[0].size() << " rows" << std::endl;
-            // Copy the data to output
-            output.Reference(result->data[0]);
-            global_state.current_file_idx++;
-        } else {
-            std::cerr << "PAIMON: No result or empty result" << std::endl;
-            // No data from this file, try next file
-            global_state.current_file_idx++;
-            output.SetCardinality(0);
+    auto &global_state = data.global_state->Cast<PaimonScanGlobalState>();
+    auto &local_state = data.local_state->Cast<PaimonScanLocalState>();
+    auto &layout = *bind_data.layout;
+
+    while (true) {
+        if (!local_state.reader && !local_state.merge_reader) {
+            auto split_idx = global_state.next_split++;
+            if (split_idx >= bind_data.splits.size()) {
+                output.SetCardinality(0);
+                return;
+            }
+            auto &split = bind_data.splits[split_idx];
+            // Rows removed by a deletion vector are skipped by the readers
+            auto &deletion_vectors = bind_data.deletion_vectors;
+            if (bind_data.merge_on_read) {
+                local_state.merge_reader =
+                    make_uniq<PaimonMergeReader>(context, layout, split.files, true, deletion_vectors.get());
+            } else {
+                auto &file = split.files[0];
+                auto has_deleted =
+                    deletion_vectors && deletion_vectors->Read(file.file.fileName, local_state.deleted_rows);
+                local_state.reader = make_uniq<PaimonDataFileReader>(
+                    context, *layout.bind, layout.DataFilePath(file), nullptr,
+                    has_deleted ? &local_state.deleted_rows : nullptr);
+            }
         }
-    } catch (const std::exception &e) {
-        std::cerr << "PAIMON: Exception reading file: " << e.what() << std::endl;
-        // Skip this file and try the next one
-        global_state.current_file_idx++;
-        output.SetCardinality(0);
-    }
-}
-
-// Helper function to determine file format from extension
-static string GetFileFormatFromExtension(const string &file_path) {
-    if (StringUtil::EndsWith(file_path, ".parquet")) {
-        return "parquet";
-    } else if (StringUtil::EndsWith(file_path, ".orc")) {
-        return "orc";
-    } else if (StringUtil::EndsWith(file_path, ".json") || StringUtil::EndsWith(file_path, ".jsonl")) {
-        return "json";
-    } else if (StringUtil::EndsWith(file_path, ".csv")) {
-        return "csv";
-    } else {
-        // Default to parquet for unknown extensions
-        return "parquet";
+        bool has_rows = local_state.merge_reader ? local_state.merge_reader->Next(local_state.chunk)
+                                                 : local_state.reader->Next(local_state.chunk);
+        if (!has_rows) {
+            local_state.reader.reset();
+            local_state.merge_reader.reset();
+            continue;
+        }
+        if (layout.HasPrimaryKey() && !bind_data.merge_on_read) {
+            DropRetractions(local_state.chunk, layout.bind->key_count, local_state.sel);
+            if (local_state.chunk.size() == 0) {
+                continue;
+            }
+        }
+        // The columns of the table follow the key and system columns of the KeyValue layout
+        for (idx_t col_idx = 0; col_idx < output.ColumnCount(); col_idx++) {
+            output.data[col_idx].Reference(local_state.chunk.data[layout.bind->value_offset + col_idx]);
+        }
+        output.SetCardinality(local_state.chunk.size());
+        return;
     }
 }
 
@@ -339,10 +306,10 @@ static string GetFileFormatFromExtension(const string &file_path) {
 // Paimon Scan Function
 //===--------------------------------------------------------------------===//
 TableFunctionSet PaimonFunctions::GetPaimonScanFunction(ExtensionLoader &loader) {
-    // Create a simpler paimon_scan function that directly reads parquet files
     TableFunctionSet function_set("paimon_scan");
 
-    TableFunction table_function({LogicalType::VARCHAR}, PaimonScanFunction, PaimonScanBind, PaimonScanInitGlobal);
+    TableFunction table_function({LogicalType::VARCHAR}, PaimonScanFunction, PaimonScanBind, PaimonScanInitGlobal,
+                                 PaimonScanInitLocal);
     table_function.late_materialization = false;
 
     table_function.serialize = nullptr;
@@ -417,36 +384,13 @@ static void PaimonCreateTableExecute(ClientContext &context, TableFunctionInput
             schema_content = bind_data->schema_json;
         }
 
-        // Write schema file
-        string schema_file = schema_dir + "/schema-1";
+        // Write schema file. The table has no snapshot until its first commit, a snapshot pointing at manifest
+        // lists that do not exist would make the table unreadable
+        string schema_file = schema_dir + "/schema-0";
         std::ofstream schema_out(schema_file);
         schema_out << schema_content;
         schema_out.close();
 
-        // Create initial snapshot file
-        string snapshot_content = R"({
-  "version": 1,
-  "id": 1,
-  "schemaId": 1,
-  "baseManifestList": "manifest-list-1",
-  "timestampMs": )" + std::to_string(Timestamp::GetCurrentTimestamp().value) + R"(,
-  "summary": {
-    "operation": "append",
-    "spark.app.id": "duckdb-paimon"
-  }
-})";
-
-        string snapshot_file = snapshot_dir + "/snapshot-1";
-        std::ofstream snapshot_out(snapshot_file);
-        snapshot_out << snapshot_content;
-        snapshot_out.close();
-
-        // Create LATEST file
-        string latest_file = snapshot_dir + "/LATEST";
-        std::ofstream latest_out(latest_file);
-        latest_out << "snapshot-1";
-        latest_out.close();
-
         // Return success message
         string result_msg = "Paimon table created successfully at: " + bind_data->table_path;
         output.SetValue(0, 0, Value(result_msg));
@@ -470,234 +414,369 @@ TableFunctionSet PaimonFunctions::GetPaimonCreateTableFunction() {
 }
 
 
-// Paimon Metadata Function
-struct PaimonMetaDataBindData : public TableFunctionData {
-    unique_ptr<PaimonTableMetadata> paimon_table;
+// Paimon Compact Function
+struct PaimonCompactBindData : public TableFunctionData {
+    string table_name;
+    PaimonCompactOptions options;
 };
 
-struct PaimonMetaDataGlobalTableFunctionState : public GlobalTableFunctionState {
-public:
+struct PaimonCompactGlobalState : public GlobalTableFunctionState {
     static unique_ptr<GlobalTableFunctionState> Init(ClientContext &context, TableFunctionInitInput &input) {
-        return make_uniq<PaimonMetaDataGlobalTableFunctionState>();
+        return make_uniq<PaimonCompactGlobalState>();
     }
 
-    idx_t current_manifest_idx = 0;
-    idx_t current_manifest_entry_idx = 0;
+    bool finished = false;
 };
 
-static unique_ptr<FunctionData> PaimonMetaDataBind(ClientContext &context, TableFunctionBindInput &input,
-                                                   vector<LogicalType> &return_types, vector<string> &names) {
-    auto ret = make_uniq<PaimonMetaDataBindData>();
-
-    FileSystem &fs = FileSystem::GetFileSystem(context);
-    auto input_string = input.inputs[0].ToString();
-    auto filename = IcebergUtils::GetStorageLocation(context, input_string);
+PaimonTableEntry &PaimonFunctions::GetPaimonTableEntry(ClientContext &context, const string &table_name) {
+    auto qualified_name = QualifiedName::Parse(table_name);
+    auto &table = Catalog::GetEntry<TableCatalogEntry>(context, qualified_name.catalog, qualified_name.schema,
+                                                       qualified_name.name);
+    if (table.ParentCatalog().GetCatalogType() != "paimon") {
+        throw InvalidInputException("\"%s\" is not a Paimon table", table_name);
+    }
+    return table.Cast<PaimonTableEntry>();
+}
 
-    PaimonOptions options;
+static unique_ptr<FunctionData> PaimonCompactBind(ClientContext &context, TableFunctionBindInput &input,
+                                                  vector<LogicalType> &return_types, vector<string> &names) {
+    auto bind_data = make_uniq<PaimonCompactBindData>();
+    bind_data->table_name = input.inputs[0].ToString();
     for (auto &kv : input.named_parameters) {
         auto loption = StringUtil::Lower(kv.first);
-        if (loption == "metadata_compression_codec") {
-            options.metadata_compression_codec = StringValue::Get(kv.second);
-        } else if (loption == "version") {
-            options.table_version = StringValue::Get(kv.second);
+        if (loption == "full") {
+            bind_data->options.full = BooleanValue::Get(kv.second);
+        } else if (loption == "order_by") {
+            for (auto &column : StringUtil::Split(kv.second.ToString(), ',')) {
+                bind_data->options.order_by.push_back(StringUtil::Strip(column));
+            }
+        } else if (loption == "order_strategy") {
+            auto strategy = StringUtil::Lower(kv.second.ToString());
+            if (strategy == "zorder") {
+                bind_data->options.zorder = true;
+            } else if (strategy != "order") {
+                throw InvalidInputException("Unrecognized Paimon compaction order_strategy '%s', expected 'order' "
+                                            "or 'zorder'",
+                                            strategy);
+            }
         }
-        // TODO: Handle snapshot selection options
+    }
+    if (bind_data->options.zorder && bind_data->options.order_by.empty()) {
+        throw InvalidInputException("order_strategy 'zorder' requires order_by columns");
     }
 
-    auto paimon_meta_path = PaimonTableMetadata::GetMetaDataPath(context, filename, fs, options);
-    ret->paimon_table = PaimonTableMetadata::Parse(paimon_meta_path, fs, options.metadata_compression_codec);
+    names = {"snapshot_id", "compacted_buckets", "files_before", "files_after"};
+    return_types = {LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT};
+    return std::move(bind_data);
+}
 
-    // Define output schema for metadata
-    names.emplace_back("file_path");
-    return_types.emplace_back(LogicalType::VARCHAR);
+static void PaimonCompactExecute(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+    auto &bind_data = data.bind_data->Cast<PaimonCompactBindData>();
+    auto &global_state = data.global_state->Cast<PaimonCompactGlobalState>();
+    if (global_state.finished) {
+        return;
+    }
+    global_state.finished = true;
+
+    auto &table = PaimonFunctions::GetPaimonTableEntry(context, bind_data.table_name);
+    PaimonWriteLayout layout(context, table);
+    PaimonCompactor compactor(context, layout);
+    auto result = compactor.Compact(bind_data.options);
+
+    // A NULL snapshot id means no bucket needed to be compacted
+    output.SetValue(0, 0, result.snapshot_id == 0 ? Value(LogicalType::BIGINT) : Value::BIGINT(result.snapshot_id));
+    output.SetValue(1, 0, Value::BIGINT(NumericCast<int64_t>(result.compacted_buckets)));
+    output.SetValue(2, 0, Value::BIGINT(NumericCast<int64_t>(result.files_before)));
+    output.SetValue(3, 0, Value::BIGINT(NumericCast<int64_t>(result.files_after)));
+    output.SetCardinality(1);
+}
 
-    names.emplace_back("file_size_in_bytes");
-    return_types.emplace_back(LogicalType::UBIGINT);
+TableFunctionSet PaimonFunctions::GetPaimonCompactFunction() {
+    TableFunctionSet function_set("paimon_compact");
 
-    names.emplace_back("file_format");
-    return_types.emplace_back(LogicalType::VARCHAR);
+    TableFunction table_function({LogicalType::VARCHAR}, PaimonCompactExecute, PaimonCompactBind,
+                                 PaimonCompactGlobalState::Init);
+    table_function.name = "paimon_compact";
+    // Rewrite every bucket, instead of only the buckets picked by the compaction policy
+    table_function.named_parameters["full"] = LogicalType::BOOLEAN;
+    // Append tables: cluster the rewritten files on these (comma separated) columns, with 'order' or 'zorder'
+    table_function.named_parameters["order_by"] = LogicalType::VARCHAR;
+    table_function.named_parameters["order_strategy"] = LogicalType::VARCHAR;
 
-    return std::move(ret);
+    function_set.AddFunction(table_function);
+    return function_set;
 }
 
-static void PaimonMetaDataFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
-    // TODO: Implement metadata reading - this is a stub for now
-    output.SetCardinality(0);
+// Paimon Expire Snapshots Function
+struct PaimonExpireBindData : public TableFunctionData {
+    string table_name;
+    PaimonExpireOptions options;
+};
+
+struct PaimonExpireGlobalState : public GlobalTableFunctionState {
+    static unique_ptr<GlobalTableFunctionState> Init(ClientContext &context, TableFunctionInitInput &input) {
+        return make_uniq<PaimonExpireGlobalState>();
+    }
+
+    bool finished = false;
+};
+
+static unique_ptr<FunctionData> PaimonExpireBind(ClientContext &context, TableFunctionBindInput &input,
+                                                 vector<LogicalType> &return_types, vector<string> &names) {
+    auto bind_data = make_uniq<PaimonExpireBindData>();
+    bind_data->table_name = input.inputs[0].ToString();
+    for (auto &kv : input.named_parameters) {
+        auto loption = StringUtil::Lower(kv.first);
+        if (kv.second.IsNull()) {
+            continue;
+        }
+        if (loption == "retain_last") {
+            auto retain_last = BigIntValue::Get(kv.second);
+            if (retain_last < 1) {
+                throw InvalidInputException("retain_last must be at least 1");
+            }
+            bind_data->options.retain_last = NumericCast<idx_t>(retain_last);
+        } else if (loption == "older_than") {
+            bind_data->options.has_older_than = true;
+            bind_data->options.older_than = kv.second.GetValue<timestamp_t>();
+        }
+    }
+
+    names = {"expired_snapshots", "deleted_data_files", "deleted_manifests", "earliest_snapshot_id"};
+    return_types = {LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT};
+    return std::move(bind_data);
 }
 
-//===--------------------------------------------------------------------===//
-// Paimon Metadata Function
-//===--------------------------------------------------------------------===//
-TableFunctionSet PaimonFunctions::GetPaimonMetadataFunction() {
-    TableFunctionSet function_set("paimon_metadata");
-    TableFunction table_function({LogicalType::VARCHAR}, PaimonMetaDataFunction, PaimonMetaDataBind,
-                                 PaimonMetaDataGlobalTableFunctionState::Init);
-    table_function.named_parameters["metadata_compression_codec"] = LogicalType::VARCHAR;
-    table_function.named_parameters["version"] = LogicalType::VARCHAR;
-    function_set.AddFunction(table_function);
-    return function_set;
+static void PaimonExpireExecute(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+    auto &bind_data = data.bind_data->Cast<PaimonExpireBindData>();
+    auto &global_state = data.global_state->Cast<PaimonExpireGlobalState>();
+    if (global_state.finished) {
+        return;
+    }
+    global_state.finished = true;
+
+    auto &table = PaimonFunctions::GetPaimonTableEntry(context, bind_data.table_name);
+    PaimonWriteLayout layout(context, table);
+    PaimonSnapshotExpirer expirer(context, layout);
+    auto result = expirer.Expire(bind_data.options);
+
+    output.SetValue(0, 0, Value::BIGINT(NumericCast<int64_t>(result.expired_snapshots)));
+    output.SetValue(1, 0, Value::BIGINT(NumericCast<int64_t>(result.deleted_data_files)));
+    output.SetValue(2, 0, Value::BIGINT(NumericCast<int64_t>(result.deleted_manifests)));
+    output.SetValue(3, 0,
+                    result.earliest_snapshot_id == 0 ? Value(LogicalType::BIGINT)
+                                                     : Value::BIGINT(result.earliest_snapshot_id));
+    output.SetCardinality(1);
 }
 
-vector<TableFunctionSet> PaimonFunctions::GetTableFunctions(ExtensionLoader &loader) {
-    vector<TableFunctionSet> functions;
+TableFunctionSet PaimonFunctions::GetPaimonExpireSnapshotsFunction() {
+    TableFunctionSet function_set("paimon_expire_snapshots");
 
-    functions.push_back(std::move(GetPaimonSnapshotsFunction()));
-    functions.push_back(std::move(GetPaimonScanFunction(loader)));
-    functions.push_back(std::move(GetPaimonMetadataFunction()));
-    functions.push_back(std::move(GetPaimonCreateTableFunction()));
-    functions.push_back(std::move(GetPaimonInsertFunction()));
-    functions.push_back(std::move(GetPaimonAttachFunction()));
+    TableFunction table_function({LogicalType::VARCHAR}, PaimonExpireExecute, PaimonExpireBind,
+                                 PaimonExpireGlobalState::Init);
+    table_function.name = "paimon_expire_snapshots";
+    // Retain at least this many snapshots, defaults to the 'snapshot.num-retained.min' table option
+    table_function.named_parameters["retain_last"] = LogicalType::BIGINT;
+    // Only expire snapshots committed before this time, defaults to now minus 'snapshot.time-retained'
+    table_function.named_parameters["older_than"] = LogicalType::TIMESTAMP;
 
-    return functions;
+    function_set.AddFunction(table_function);
+    return function_set;
 }
 
-// File discovery helper functions
-static vector<string> DiscoverDataFilesFromManifests(ClientContext &context, const string &table_location, FileSystem &fs) {
-    vector<string> files;
+// Paimon Remove Orphan Files Function
+struct PaimonRemoveOrphanFilesBindData : public TableFunctionData {
+    string table_name;
+    timestamp_t older_than;
+    bool dry_run = false;
+};
 
-    // Read the latest snapshot to find manifest list
-    string latest_snapshot_path = table_location + "/snapshot/LATEST";
-    if (!fs.FileExists(latest_snapshot_path)) {
-        throw IOException("No LATEST snapshot pointer found");
+struct PaimonRemoveOrphanFilesGlobalState : public GlobalTableFunctionState {
+    static unique_ptr<GlobalTableFunctionState> Init(ClientContext &context, TableFunctionInitInput &input) {
+        return make_uniq<PaimonRemoveOrphanFilesGlobalState>();
     }
 
-    string snapshot_id = IcebergUtils::FileToString(latest_snapshot_path, fs);
-    StringUtil::Trim(snapshot_id);
+    bool cleaned = false;
+    vector<PaimonOrphanFile> orphan_files;
+    idx_t offset = 0;
+};
 
-    string snapshot_file = table_location + "/snapshot/" + snapshot_id;
-    if (!fs.FileExists(snapshot_file)) {
-        throw IOException("Snapshot file not found: " + snapshot_file);
+static unique_ptr<FunctionData> PaimonRemoveOrphanFilesBind(ClientContext &context, TableFunctionBindInput &input,
+                                                            vector<LogicalType> &return_types, vector<string> &names) {
+    auto bind_data = make_uniq<PaimonRemoveOrphanFilesBindData>();
+    bind_data->table_name = input.inputs[0].ToString();
+    bind_data->older_than = Timestamp::FromEpochMs(Timestamp::GetEpochMs(Timestamp::GetCurrentTimestamp()) -
+                                                   PaimonOrphanFileCleaner::DEFAULT_OLDER_THAN);
+    for (auto &kv : input.named_parameters) {
+        auto loption = StringUtil::Lower(kv.first);
+        if (kv.second.IsNull()) {
+            continue;
+        }
+        if (loption == "older_than") {
+            bind_data->older_than = kv.second.GetValue<timestamp_t>();
+        } else if (loption == "dry_run") {
+            bind_data->dry_run = BooleanValue::Get(kv.second);
+        }
     }
 
-    // Parse snapshot to find manifest list
-    string snapshot_content = IcebergUtils::FileToString(snapshot_file, fs);
-    auto doc = std::unique_ptr<yyjson_doc, YyjsonDocDeleter>(
-        yyjson_read(snapshot_content.c_str(), snapshot_content.size(), 0));
+    names = {"file_path", "file_size_in_bytes"};
+    return_types = {LogicalType::VARCHAR, LogicalType::UBIGINT};
+    return std::move(bind_data);
+}
 
-    if (!doc) {
-        throw InvalidInputException("Failed to parse snapshot JSON");
+static void PaimonRemoveOrphanFilesExecute(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+    auto &bind_data = data.bind_data->Cast<PaimonRemoveOrphanFilesBindData>();
+    auto &global_state = data.global_state->Cast<PaimonRemoveOrphanFilesGlobalState>();
+    if (!global_state.cleaned) {
+        global_state.cleaned = true;
+        auto &table = PaimonFunctions::GetPaimonTableEntry(context, bind_data.table_name);
+        PaimonWriteLayout layout(context, table);
+        PaimonOrphanFileCleaner cleaner(context, layout);
+        global_state.orphan_files = cleaner.Clean(bind_data.older_than, bind_data.dry_run);
     }
 
-    auto root = yyjson_doc_get_root(doc.get());
-    auto manifest_list_path_val = yyjson_obj_get(root, "deltaManifestList");
-    if (!manifest_list_path_val) {
-        throw InvalidInputException("No deltaManifestList in snapshot");
+    // One row per removed file (or per file that would be removed, with dry_run)
+    idx_t count = 0;
+    auto &orphan_files = global_state.orphan_files;
+    while (global_state.offset < orphan_files.size() && count < STANDARD_VECTOR_SIZE) {
+        auto &orphan_file = orphan_files[global_state.offset++];
+        output.SetValue(0, count, Value(orphan_file.path));
+        output.SetValue(1, count, Value::UBIGINT(orphan_file.size));
+        count++;
     }
+    output.SetCardinality(count);
+}
 
-    string manifest_list_relative = yyjson_get_str(manifest_list_path_val);
-    string manifest_list_path = table_location + "/" + manifest_list_relative;
+TableFunctionSet PaimonFunctions::GetPaimonRemoveOrphanFilesFunction() {
+    TableFunctionSet function_set("paimon_remove_orphan_files");
 
-    // Parse manifest list to find manifest files
-    string manifest_list_content = IcebergUtils::FileToString(manifest_list_path, fs);
-    auto manifest_doc = std::unique_ptr<yyjson_doc, YyjsonDocDeleter>(
-        yyjson_read(manifest_list_content.c_str(), manifest_list_content.size(), 0));
+    TableFunction table_function({LogicalType::VARCHAR}, PaimonRemoveOrphanFilesExecute, PaimonRemoveOrphanFilesBind,
+                                 PaimonRemoveOrphanFilesGlobalState::Init);
+    table_function.name = "paimon_remove_orphan_files";
+    // Only remove files last modified before this time, defaults to one day ago
+    table_function.named_parameters["older_than"] = LogicalType::TIMESTAMP;
+    // List the orphan files without removing them
+    table_function.named_parameters["dry_run"] = LogicalType::BOOLEAN;
 
-    if (!manifest_doc) {
-        throw InvalidInputException("Failed to parse manifest list JSON");
-    }
-
-    auto manifest_root = yyjson_doc_get_root(manifest_doc.get());
-    auto manifest_entries = yyjson_obj_get(manifest_root, "entries");
+    function_set.AddFunction(table_function);
+    return function_set;
+}
 
-    if (manifest_entries && yyjson_is_arr(manifest_entries)) {
-        size_t idx, max;
-        yyjson_val *entry;
-        yyjson_arr_foreach(manifest_entries, idx, max, entry) {
-            auto manifest_file_val = yyjson_obj_get(entry, "_FILE_NAME");
-            if (manifest_file_val) {
-                string manifest_file = yyjson_get_str(manifest_file_val);
-                string full_manifest_path = table_location + "/" + manifest_file;
+// Paimon Lookup Function
+struct PaimonLookupBindData : public TableFunctionData {
+    string table_name;
+};
 
-                // Parse manifest file to find data files
-                string manifest_content = IcebergUtils::FileToString(full_manifest_path, fs);
-                auto data_doc = std::unique_ptr<yyjson_doc, YyjsonDocDeleter>(
-                    yyjson_read(manifest_content.c_str(), manifest_content.size(), 0));
+struct PaimonLookupGlobalState : public GlobalTableFunctionState {
+    static unique_ptr<GlobalTableFunctionState> Init(ClientContext &context, TableFunctionInitInput &input) {
+        auto &bind_data = input.bind_data->Cast<PaimonLookupBindData>();
+        auto result = make_uniq<PaimonLookupGlobalState>();
+        auto &table = PaimonFunctions::GetPaimonTableEntry(context, bind_data.table_name);
+        result->layout = make_uniq<PaimonWriteLayout>(context, table);
+        result->lookup = make_uniq<PaimonKeyLookup>(context, *result->layout);
+        return std::move(result);
+    }
 
-                if (data_doc) {
-                    auto data_root = yyjson_doc_get_root(data_doc.get());
-                    auto data_entries = yyjson_obj_get(data_root, "entries");
+    unique_ptr<PaimonWriteLayout> layout;
+    unique_ptr<PaimonKeyLookup> lookup;
+};
 
-                    if (data_entries && yyjson_is_arr(data_entries)) {
-                        size_t data_idx, data_max;
-                        yyjson_val *data_entry;
-                        yyjson_arr_foreach(data_entries, data_idx, data_max, data_entry) {
-                            auto file_obj = yyjson_obj_get(data_entry, "_FILE");
-                            if (file_obj) {
-                                auto file_name_val = yyjson_obj_get(file_obj, "_FILE_NAME");
-                                if (file_name_val) {
-                                    string file_name = yyjson_get_str(file_name_val);
-                                    string full_file_path = table_location + "/" + file_name;
-                                    files.push_back(full_file_path);
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
+struct PaimonLookupLocalState : public LocalTableFunctionState {
+    static unique_ptr<LocalTableFunctionState> Init(ExecutionContext &context, TableFunctionInitInput &input,
+                                                    GlobalTableFunctionState *global_state) {
+        auto &lookup = *global_state->Cast<PaimonLookupGlobalState>().lookup;
+        auto result = make_uniq<PaimonLookupLocalState>();
+        result->keys = make_uniq<ColumnDataCollection>(context.client, lookup.KeyTypes());
+        result->key_chunk.Initialize(context.client, lookup.KeyTypes());
+        return std::move(result);
     }
 
-    return files;
-}
+    // The keys are buffered, and looked up in a single batch once the input is exhausted
+    unique_ptr<ColumnDataCollection> keys;
+    DataChunk key_chunk;
+    unique_ptr<ColumnDataCollection> result;
+    ColumnDataScanState scan_state;
+};
 
-static vector<string> DiscoverDataFilesDirectly(ClientContext &context, const string &table_location, FileSystem &fs) {
-    vector<string> files;
+static unique_ptr<FunctionData> PaimonLookupBind(ClientContext &context, TableFunctionBindInput &input,
+                                                 vector<LogicalType> &return_types, vector<string> &names) {
+    auto bind_data = make_uniq<PaimonLookupBindData>();
+    bind_data->table_name = input.inputs[0].ToString();
+    auto &table = PaimonFunctions::GetPaimonTableEntry(context, bind_data->table_name);
+    for (auto &column : table.GetColumns().Logical()) {
+        names.push_back(column.Name());
+        return_types.push_back(column.Type());
+    }
+    return std::move(bind_data);
+}
 
-    // Optimized parallel directory traversal for partitioned tables
-    // Use breadth-first search with work queue for better performance
+static OperatorResultType PaimonLookupInOut(ExecutionContext &context, TableFunctionInput &data, DataChunk &input,
+                                            DataChunk &output) {
+    auto &local_state = data.local_state->Cast<PaimonLookupLocalState>();
+    auto &key_chunk = local_state.key_chunk;
+    if (input.ColumnCount() != key_chunk.ColumnCount()) {
+        throw InvalidInputException("paimon_lookup expects %llu key columns (the primary key of the table), got %llu",
+                                    key_chunk.ColumnCount(), input.ColumnCount());
+    }
+    key_chunk.Reset();
+    for (idx_t col_idx = 0; col_idx < input.ColumnCount(); col_idx++) {
+        VectorOperations::Cast(context.client, input.data[col_idx], key_chunk.data[col_idx], input.size());
+    }
+    key_chunk.SetCardinality(input.size());
+    local_state.keys->Append(key_chunk);
+    return OperatorResultType::NEED_MORE_INPUT;
+}
 
-    // First pass: collect all directories to search
-    vector<string> directories_to_search;
-    directories_to_search.push_back(table_location);
+static OperatorFinalizeResultType PaimonLookupFinal(ExecutionContext &context, TableFunctionInput &data,
+                                                    DataChunk &output) {
+    auto &global_state = data.global_state->Cast<PaimonLookupGlobalState>();
+    auto &local_state = data.local_state->Cast<PaimonLookupLocalState>();
+    if (!local_state.result) {
+        local_state.result = make_uniq<ColumnDataCollection>(context.client, global_state.layout->column_types);
+        global_state.lookup->Lookup(*local_state.keys, *local_state.result);
+        local_state.keys.reset();
+        local_state.result->InitializeScan(local_state.scan_state);
+    }
+    if (!local_state.result->Scan(local_state.scan_state, output)) {
+        return OperatorFinalizeResultType::FINISHED;
+    }
+    return OperatorFinalizeResultType::HAVE_MORE_OUTPUT;
+}
 
-    // Breadth-first traversal to find all bucket directories
-    while (!directories_to_search.empty()) {
-        string current_dir = directories_to_search.back();
-        directories_to_search.pop_back();
+TableFunctionSet PaimonFunctions::GetPaimonLookupFunction() {
+    TableFunctionSet function_set("paimon_lookup");
 
-        try {
-            vector<string> bucket_dirs;
-            vector<string> partition_dirs;
+    // paimon_lookup('table', (SELECT key FROM keys)) returns the latest row of every key that exists
+    TableFunction table_function({LogicalType::VARCHAR, LogicalType::TABLE}, nullptr, PaimonLookupBind,
+                                 PaimonLookupGlobalState::Init, PaimonLookupLocalState::Init);
+    table_function.name = "paimon_lookup";
+    table_function.in_out_function = PaimonLookupInOut;
+    table_function.in_out_function_final = PaimonLookupFinal;
 
-            fs.ListFiles(current_dir, [&](const string &name, bool is_dir) {
-                if (is_dir) {
-                    string full_path = current_dir + "/" + name;
-                    if (StringUtil::StartsWith(name, "bucket-")) {
-                        // Found a bucket directory - collect it for file scanning
-                        bucket_dirs.push_back(full_path);
-                    } else if (name.find('=') != string::npos) {
-                        // Looks like a partition directory (contains =)
-                        partition_dirs.push_back(full_path);
-                    }
-                }
-            });
-
-            // Process bucket directories immediately (breadth-first)
-            for (const auto& bucket_dir : bucket_dirs) {
-                fs.ListFiles(bucket_dir, [&](const string &file, bool is_file_dir) {
-                    if (!is_file_dir && (StringUtil::EndsWith(file, ".parquet") ||
-                                       StringUtil::EndsWith(file, ".orc"))) {
-                        // Build relative path from table root
-                        string rel_path = bucket_dir.substr(table_location.size());
-                        if (rel_path.starts_with("/")) {
-                            rel_path = rel_path.substr(1);
-                        }
-                        files.push_back(rel_path + "/" + file);
-                    }
-                });
-            }
+    function_set.AddFunction(table_function);
+    return function_set;
+}
 
-            // Add partition directories to search queue
-            directories_to_search.insert(directories_to_search.end(),
-                                       partition_dirs.begin(), partition_dirs.end());
+vector<TableFunctionSet> PaimonFunctions::GetTableFunctions(ExtensionLoader &loader) {
+    vector<TableFunctionSet> functions;
 
-        } catch (const std::exception &e) {
-            // Directory might not exist or be accessible
-            std::cerr << "PAIMON: Failed to search directory " << current_dir << ": " << e.what() << std::endl;
-        }
-    }
+    functions.push_back(std::move(GetPaimonSnapshotsFunction()));
+    functions.push_back(std::move(GetPaimonScanFunction(loader)));
+    functions.push_back(std::move(GetPaimonMetadataFunction()));
+    functions.push_back(std::move(GetPaimonFilesFunction()));
+    functions.push_back(std::move(GetPaimonManifestsFunction()));
+    functions.push_back(std::move(GetPaimonPartitionsFunction()));
+    functions.push_back(std::move(GetPaimonBucketsFunction()));
+    functions.push_back(std::move(GetPaimonCreateTableFunction()));
+    functions.push_back(std::move(GetPaimonInsertFunction()));
+    functions.push_back(std::move(GetPaimonAttachFunction()));
+    functions.push_back(std::move(GetPaimonCompactFunction()));
+    functions.push_back(std::move(GetPaimonLookupFunction()));
+    functions.push_back(std::move(GetPaimonExpireSnapshotsFunction()));
+    functions.push_back(std::move(GetPaimonRemoveOrphanFilesFunction()));
+    functions.push_back(std::move(GetPaimonToDuckLakeFunction()));
 
-    return files;
+    return functions;
 }
 
 // Simple test function implementation
@@ -734,9 +813,14 @@ TableFunctionSet PaimonFunctions::GetPaimonInsertFunction() {
 }
 
 // Paimon Attach Function Bind
+struct PaimonAttachBindData : public TableFunctionData {
+    string table_location;
+    vector<string> file_paths;
+};
+
 static unique_ptr<FunctionData> PaimonAttachBind(ClientContext &context, TableFunctionBindInput &input,
                                                  vector<LogicalType> &return_types, vector<string> &names) {
-    auto bind_data = make_uniq<PaimonScanBindData>();
+    auto bind_data = make_uniq<PaimonAttachBindData>();
 
     // Parse warehouse path
     if (input.inputs.size() >= 1) {
@@ -777,7 +861,7 @@ static unique_ptr<FunctionData> PaimonAttachBind(ClientContext &context, TableFu
 
 // Paimon Attach Function Execute
 static void PaimonAttachExecute(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
-    auto &bind_data = data.bind_data->Cast<PaimonScanBindData>();
+    auto &bind_data = data.bind_data->Cast<PaimonAttachBindData>();
 
     // Return information about discovered tables
     idx_t row_count = 0;
@@ -0,0 +1,726 @@
+#include "paimon_manifest.hpp"
+#include "paimon_binary_row.hpp"
+
+#include "duckdb/catalog/catalog_entry/copy_function_catalog_entry.hpp"
+#include "duckdb/catalog/catalog_entry/table_function_catalog_entry.hpp"
+#include "duckdb/common/types/uuid.hpp"
+#include "duckdb/execution/execution_context.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/parallel/thread_context.hpp"
+#include "duckdb/parser/parsed_data/copy_info.hpp"
+#include "duckdb/parser/tableref/table_function_ref.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/caching_file_system.hpp"
+
+#include <functional>
+
+namespace duckdb {
+
+namespace paimon_manifest {
+
+CopyFunction &GetAvroCopyFunction(ClientContext &context) {
+	auto &db = *context.db;
+	auto &system_catalog = Catalog::GetSystemCatalog(db);
+	auto data = CatalogTransaction::GetSystemTransaction(db);
+	auto &schema = system_catalog.GetSchema(data, DEFAULT_SCHEMA);
+	auto entry = schema.GetEntry(data, CatalogType::COPY_FUNCTION_ENTRY, "avro");
+	if (!entry) {
+		throw MissingExtensionException("Did not find avro copy function required to write paimon manifests");
+	}
+	return entry->Cast<CopyFunctionCatalogEntry>().function;
+}
+
+LogicalType SimpleStatsType() {
+	child_list_t<LogicalType> children;
+	children.emplace_back("_MIN_VALUES", LogicalType::BLOB);
+	children.emplace_back("_MAX_VALUES", LogicalType::BLOB);
+	children.emplace_back("_NULL_COUNTS", LogicalType::LIST(LogicalType::BIGINT));
+	return LogicalType::STRUCT(std::move(children));
+}
+
+} // namespace paimon_manifest
+
+//===--------------------------------------------------------------------===//
+// Vector helpers
+//===--------------------------------------------------------------------===//
+template <class T>
+static void SetFixed(Vector &result, idx_t row, T value) {
+	FlatVector::GetData<T>(result)[row] = value;
+}
+
+static void SetNull(Vector &result, idx_t row) {
+	FlatVector::SetNull(result, row, true);
+}
+
+static void SetString(Vector &result, idx_t row, const string &value) {
+	FlatVector::GetData<string_t>(result)[row] = StringVector::AddString(result, value);
+}
+
+static void SetBlob(Vector &result, idx_t row, const vector<uint8_t> &value) {
+	FlatVector::GetData<string_t>(result)[row] =
+	    StringVector::AddStringOrBlob(result, const_char_ptr_cast(value.data()), value.size());
+}
+
+static void SetStringList(Vector &result, idx_t row, const vector<string> &values) {
+	vector<Value> list;
+	for (auto &value : values) {
+		list.emplace_back(value);
+	}
+	result.SetValue(row, Value::LIST(LogicalType::VARCHAR, std::move(list)));
+}
+
+static void SetSimpleStats(Vector &result, idx_t row, const SimpleStats &stats) {
+	auto &children = StructVector::GetEntries(result);
+	SetBlob(*children[0], row, stats.minValues);
+	SetBlob(*children[1], row, stats.maxValues);
+	children[2]->SetValue(row, Value::LIST(LogicalType::BIGINT, stats.nullCounts));
+}
+
+//! Write 'data' to 'path' with the avro copy function, returns the size of the written file
+static idx_t WriteAvroFile(ClientContext &context, const string &path, const vector<string> &names,
+                           const vector<LogicalType> &types,
+                           const std::function<idx_t(DataChunk &data, idx_t offset)> &fill, idx_t count) {
+	auto &copy = paimon_manifest::GetAvroCopyFunction(context);
+	auto &allocator = BufferManager::GetBufferManager(context).GetBufferAllocator();
+
+	CopyInfo copy_info;
+	copy_info.is_from = false;
+	copy_info.options["root_name"].push_back(Value("org.apache.paimon.avro.generated.record"));
+
+	CopyFunctionBindInput input(copy_info);
+	input.file_extension = "avro";
+
+	{
+		ThreadContext thread_context(context);
+		ExecutionContext execution_context(context, thread_context, nullptr);
+		auto bind_data = copy.copy_to_bind(context, input, names, types);
+
+		auto global_state = copy.copy_to_initialize_global(context, *bind_data, path);
+		auto local_state = copy.copy_to_initialize_local(execution_context, *bind_data);
+
+		//! Rows are converted one vector at a time, so memory use is independent of the number of entries
+		DataChunk data;
+		data.Initialize(allocator, types);
+		for (idx_t offset = 0; offset < count;) {
+			data.Reset();
+			auto written = fill(data, offset);
+			data.SetCardinality(written);
+			copy.copy_to_sink(execution_context, *bind_data, *global_state, *local_state, data);
+			offset += written;
+		}
+		copy.copy_to_combine(execution_context, *bind_data, *global_state, *local_state);
+		copy.copy_to_finalize(context, *bind_data, *global_state);
+	}
+
+	auto file_system = CachingFileSystem::Get(context);
+	auto file_handle = file_system.OpenFile(path, FileOpenFlags::FILE_FLAGS_READ);
+	return file_handle->GetFileSize();
+}
+
+//! Scan the avro file at 'path' with read_avro, calling 'callback' for every chunk
+static void ScanAvroFile(ClientContext &context, const string &path,
+                         const std::function<void(DataChunk &chunk, const vector<string> &names)> &callback) {
+	auto &instance = DatabaseInstance::GetDatabase(context);
+	auto &system_catalog = Catalog::GetSystemCatalog(instance);
+	auto data = CatalogTransaction::GetSystemTransaction(instance);
+	auto &schema = system_catalog.GetSchema(data, DEFAULT_SCHEMA);
+	auto catalog_entry = schema.GetEntry(data, CatalogType::TABLE_FUNCTION_ENTRY, "read_avro");
+	if (!catalog_entry) {
+		throw MissingExtensionException("Did not find read_avro function required to read paimon manifests");
+	}
+	auto avro_scan = catalog_entry->Cast<TableFunctionCatalogEntry>().functions.functions[0];
+
+	vector<Value> children {Value(path)};
+	named_parameter_map_t named_params;
+	vector<LogicalType> input_types;
+	vector<string> input_names;
+	TableFunctionRef empty;
+	TableFunctionBindInput bind_input(children, named_params, input_types, input_names, nullptr, nullptr, avro_scan,
+	                                  empty);
+	vector<LogicalType> return_types;
+	vector<string> return_names;
+	auto bind_data = avro_scan.bind(context, bind_input, return_types, return_names);
+
+	vector<column_t> column_ids;
+	for (idx_t i = 0; i < return_types.size(); i++) {
+		column_ids.push_back(i);
+	}
+	ThreadContext thread_context(context);
+	ExecutionContext execution_context(context, thread_context, nullptr);
+	TableFunctionInitInput input(bind_data.get(), column_ids, vector<idx_t>(), nullptr);
+	auto global_state = avro_scan.init_global(context, input);
+	auto local_state = avro_scan.init_local(execution_context, input, global_state.get());
+
+	DataChunk chunk;
+	chunk.Initialize(context, return_types, STANDARD_VECTOR_SIZE);
+	while (true) {
+		chunk.Reset();
+		TableFunctionInput function_input(bind_data.get(), local_state.get(), global_state.get());
+		avro_scan.function(context, function_input, chunk);
+		if (chunk.size() == 0) {
+			break;
+		}
+		callback(chunk, return_names);
+	}
+}
+
+static idx_t FindField(const vector<string> &names, const string &name, const string &path) {
+	for (idx_t i = 0; i < names.size(); i++) {
+		if (names[i] == name) {
+			return i;
+		}
+	}
+	throw InvalidInputException("Paimon manifest \"%s\" is missing the field \"%s\"", path, name);
+}
+
+//! Look up the fields of a struct Value by name, missing (older) fields are returned as NULL
+class StructFields {
+public:
+	explicit StructFields(const LogicalType &type) {
+		auto &child_types = StructType::GetChildTypes(type);
+		for (idx_t i = 0; i < child_types.size(); i++) {
+			indexes.emplace(child_types[i].first, i);
+		}
+	}
+
+	Value Get(const vector<Value> &children, const string &name) const {
+		auto entry = indexes.find(name);
+		if (entry == indexes.end()) {
+			return Value();
+		}
+		return children[entry->second];
+	}
+
+private:
+	case_insensitive_map_t<idx_t> indexes;
+};
+
+static vector<uint8_t> GetBlob(const Value &value) {
+	if (value.IsNull()) {
+		return vector<uint8_t>();
+	}
+	auto &str = StringValue::Get(value);
+	return vector<uint8_t>(str.begin(), str.end());
+}
+
+static vector<string> GetStringList(const Value &value) {
+	vector<string> result;
+	if (value.IsNull()) {
+		return result;
+	}
+	for (auto &child : ListValue::GetChildren(value)) {
+		result.push_back(child.ToString());
+	}
+	return result;
+}
+
+static SimpleStats GetSimpleStats(const Value &value) {
+	SimpleStats result;
+	if (value.IsNull()) {
+		return SimpleStats::Empty();
+	}
+	StructFields fields(value.type());
+	auto &children = StructValue::GetChildren(value);
+	result.minValues = GetBlob(fields.Get(children, "_MIN_VALUES"));
+	result.maxValues = GetBlob(fields.Get(children, "_MAX_VALUES"));
+	auto null_counts = fields.Get(children, "_NULL_COUNTS");
+	if (!null_counts.IsNull()) {
+		for (auto &null_count : ListValue::GetChildren(null_counts)) {
+			result.nullCounts.push_back(null_count.DefaultCastAs(LogicalType::BIGINT));
+		}
+	}
+	return result;
+}
+
+template <class T>
+static T GetNumeric(const Value &value, T default_value = 0) {
+	if (value.IsNull()) {
+		return default_value;
+	}
+	return value.GetValue<T>();
+}
+
+namespace paimon_manifest_file {
+
+static LogicalType DataFileMetaType() {
+	auto stats_type = paimon_manifest::SimpleStatsType();
+	child_list_t<LogicalType> children;
+	children.emplace_back("_FILE_NAME", LogicalType::VARCHAR);
+	children.emplace_back("_FILE_SIZE", LogicalType::BIGINT);
+	children.emplace_back("_ROW_COUNT", LogicalType::BIGINT);
+	children.emplace_back("_MIN_KEY", LogicalType::BLOB);
+	children.emplace_back("_MAX_KEY", LogicalType::BLOB);
+	children.emplace_back("_KEY_STATS", stats_type);
+	children.emplace_back("_VALUE_STATS", stats_type);
+	children.emplace_back("_MIN_SEQUENCE_NUMBER", LogicalType::BIGINT);
+	children.emplace_back("_MAX_SEQUENCE_NUMBER", LogicalType::BIGINT);
+	children.emplace_back("_SCHEMA_ID", LogicalType::BIGINT);
+	children.emplace_back("_LEVEL", LogicalType::INTEGER);
+	children.emplace_back("_EXTRA_FILES", LogicalType::LIST(LogicalType::VARCHAR));
+	//! TIMESTAMP(3), stored as milliseconds since the epoch
+	children.emplace_back("_CREATION_TIME", LogicalType::BIGINT);
+	children.emplace_back("_DELETE_ROW_COUNT", LogicalType::BIGINT);
+	children.emplace_back("_EMBEDDED_FILE_INDEX", LogicalType::BLOB);
+	children.emplace_back("_FILE_SOURCE", LogicalType::TINYINT);
+	children.emplace_back("_VALUE_STATS_COLS", LogicalType::LIST(LogicalType::VARCHAR));
+	children.emplace_back("_EXTERNAL_PATH", LogicalType::VARCHAR);
+	children.emplace_back("_FIRST_ROW_ID", LogicalType::BIGINT);
+	children.emplace_back("_WRITE_COLS", LogicalType::LIST(LogicalType::VARCHAR));
+	return LogicalType::STRUCT(std::move(children));
+}
+
+static void SetDataFileMeta(Vector &vector, idx_t row, const DataFileMeta &file) {
+	auto &children = StructVector::GetEntries(vector);
+	idx_t col_idx = 0;
+	// _FILE_NAME
+	SetString(*children[col_idx++], row, file.fileName);
+	// _FILE_SIZE
+	SetFixed<int64_t>(*children[col_idx++], row, file.fileSize);
+	// _ROW_COUNT
+	SetFixed<int64_t>(*children[col_idx++], row, file.rowCount);
+	// _MIN_KEY
+	SetBlob(*children[col_idx++], row, file.minKey);
+	// _MAX_KEY
+	SetBlob(*children[col_idx++], row, file.maxKey);
+	// _KEY_STATS
+	SetSimpleStats(*children[col_idx++], row, file.keyStats);
+	// _VALUE_STATS
+	SetSimpleStats(*children[col_idx++], row, file.valueStats);
+	// _MIN_SEQUENCE_NUMBER
+	SetFixed<int64_t>(*children[col_idx++], row, file.minSequenceNumber);
+	// _MAX_SEQUENCE_NUMBER
+	SetFixed<int64_t>(*children[col_idx++], row, file.maxSequenceNumber);
+	// _SCHEMA_ID
+	SetFixed<int64_t>(*children[col_idx++], row, file.schemaId);
+	// _LEVEL
+	SetFixed<int32_t>(*children[col_idx++], row, file.level);
+	// _EXTRA_FILES
+	SetStringList(*children[col_idx++], row, file.extraFiles);
+	// _CREATION_TIME
+	SetFixed<int64_t>(*children[col_idx++], row, Timestamp::GetEpochMs(file.creationTime));
+	// _DELETE_ROW_COUNT
+	if (file.deleteRowCount.IsValid()) {
+		SetFixed<int64_t>(*children[col_idx++], row, NumericCast<int64_t>(file.deleteRowCount.GetIndex()));
+	} else {
+		SetNull(*children[col_idx++], row);
+	}
+	// _EMBEDDED_FILE_INDEX
+	if (!file.embeddedFileIndex.empty()) {
+		SetBlob(*children[col_idx++], row, file.embeddedFileIndex);
+	} else {
+		SetNull(*children[col_idx++], row);
+	}
+	// _FILE_SOURCE
+	SetFixed<int8_t>(*children[col_idx++], row, static_cast<int8_t>(file.fileSource));
+	// _VALUE_STATS_COLS, NULL means the value stats cover all columns
+	if (!file.valueStatsCols.empty()) {
+		SetStringList(*children[col_idx++], row, file.valueStatsCols);
+	} else {
+		SetNull(*children[col_idx++], row);
+	}
+	// _EXTERNAL_PATH
+	if (!file.externalPath.empty()) {
+		SetString(*children[col_idx++], row, file.externalPath);
+	} else {
+		SetNull(*children[col_idx++], row);
+	}
+	// _FIRST_ROW_ID
+	if (file.firstRowId.IsValid()) {
+		SetFixed<int64_t>(*children[col_idx++], row, NumericCast<int64_t>(file.firstRowId.GetIndex()));
+	} else {
+		SetNull(*children[col_idx++], row);
+	}
+	// _WRITE_COLS
+	if (!file.writeCols.empty()) {
+		SetStringList(*children[col_idx++], row, file.writeCols);
+	} else {
+		SetNull(*children[col_idx++], row);
+	}
+}
+
+static DataFileMeta GetDataFileMeta(const Value &value) {
+	StructFields fields(value.type());
+	auto &children = StructValue::GetChildren(value);
+
+	DataFileMeta file;
+	file.fileName = fields.Get(children, "_FILE_NAME").ToString();
+	file.fileSize = GetNumeric<int64_t>(fields.Get(children, "_FILE_SIZE"));
+	file.rowCount = GetNumeric<int64_t>(fields.Get(children, "_ROW_COUNT"));
+	file.minKey = GetBlob(fields.Get(children, "_MIN_KEY"));
+	file.maxKey = GetBlob(fields.Get(children, "_MAX_KEY"));
+	file.keyStats = GetSimpleStats(fields.Get(children, "_KEY_STATS"));
+	file.valueStats = GetSimpleStats(fields.Get(children, "_VALUE_STATS"));
+	file.minSequenceNumber = GetNumeric<int64_t>(fields.Get(children, "_MIN_SEQUENCE_NUMBER"));
+	file.maxSequenceNumber = GetNumeric<int64_t>(fields.Get(children, "_MAX_SEQUENCE_NUMBER"));
+	file.schemaId = GetNumeric<int64_t>(fields.Get(children, "_SCHEMA_ID"));
+	file.level = GetNumeric<int32_t>(fields.Get(children, "_LEVEL"));
+	file.extraFiles = GetStringList(fields.Get(children, "_EXTRA_FILES"));
+	file.creationTime = Timestamp::FromEpochMs(GetNumeric<int64_t>(fields.Get(children, "_CREATION_TIME")));
+	auto delete_row_count = fields.Get(children, "_DELETE_ROW_COUNT");
+	if (!delete_row_count.IsNull()) {
+		file.deleteRowCount = NumericCast<idx_t>(delete_row_count.GetValue<int64_t>());
+	}
+	file.embeddedFileIndex = GetBlob(fields.Get(children, "_EMBEDDED_FILE_INDEX"));
+	file.fileSource = static_cast<FileSource>(GetNumeric<int8_t>(fields.Get(children, "_FILE_SOURCE")));
+	file.valueStatsCols = GetStringList(fields.Get(children, "_VALUE_STATS_COLS"));
+	auto external_path = fields.Get(children, "_EXTERNAL_PATH");
+	if (!external_path.IsNull()) {
+		file.externalPath = external_path.ToString();
+	}
+	auto first_row_id = fields.Get(children, "_FIRST_ROW_ID");
+	if (!first_row_id.IsNull()) {
+		file.firstRowId = NumericCast<idx_t>(first_row_id.GetValue<int64_t>());
+	}
+	file.writeCols = GetStringList(fields.Get(children, "_WRITE_COLS"));
+	return file;
+}
+
+//! Rough size of an entry in the manifest file, used to split large manifests
+static idx_t EstimateEntrySize(const PaimonManifestEntry &entry) {
+	auto &file = entry.file;
+	return 128 + entry.partition.size() + file.fileName.size() + file.minKey.size() + file.maxKey.size() +
+	       file.keyStats.minValues.size() + file.keyStats.maxValues.size() + file.valueStats.minValues.size() +
+	       file.valueStats.maxValues.size() + 8 * (file.keyStats.nullCounts.size() + file.valueStats.nullCounts.size());
+}
+
+//! Partition stats and bucket/level ranges of the entries in [begin, end)
+static void ComputeFileMeta(const vector<PaimonManifestEntry> &entries, idx_t begin, idx_t end,
+                            const vector<LogicalType> &partition_types, PaimonManifestFileMeta &result) {
+	auto field_count = partition_types.size();
+	vector<Value> min_values(field_count);
+	vector<Value> max_values(field_count);
+	vector<int64_t> null_counts(field_count, 0);
+	for (idx_t i = 0; i < field_count; i++) {
+		min_values[i] = Value(partition_types[i]);
+		max_values[i] = Value(partition_types[i]);
+	}
+
+	for (idx_t entry_idx = begin; entry_idx < end; entry_idx++) {
+		auto &entry = entries[entry_idx];
+		if (entry.kind == PaimonFileKind::ADD) {
+			result.numAddedFiles++;
+		} else {
+			result.numDeletedFiles++;
+		}
+		if (entry_idx == begin) {
+			result.minBucket = result.maxBucket = entry.bucket;
+			result.minLevel = result.maxLevel = entry.file.level;
+		} else {
+			result.minBucket = MinValue(result.minBucket, entry.bucket);
+			result.maxBucket = MaxValue(result.maxBucket, entry.bucket);
+			result.minLevel = MinValue(result.minLevel, entry.file.level);
+			result.maxLevel = MaxValue(result.maxLevel, entry.file.level);
+		}
+		if (field_count == 0) {
+			continue;
+		}
+		auto partition = PaimonBinaryRow::Deserialize(entry.partition, partition_types);
+		for (idx_t i = 0; i < field_count; i++) {
+			auto &value = partition[i];
+			if (value.IsNull()) {
+				null_counts[i]++;
+				continue;
+			}
+			if (min_values[i].IsNull() || value < min_values[i]) {
+				min_values[i] = value;
+			}
+			if (max_values[i].IsNull() || value > max_values[i]) {
+				max_values[i] = value;
+			}
+		}
+	}
+
+	result.partitionStats.minValues = PaimonBinaryRow::Serialize(min_values);
+	result.partitionStats.maxValues = PaimonBinaryRow::Serialize(max_values);
+	for (auto null_count : null_counts) {
+		result.partitionStats.nullCounts.push_back(Value::BIGINT(null_count));
+	}
+}
+
+static PaimonManifestFileMeta WriteToFile(ClientContext &context, const string &path,
+                                          const vector<PaimonManifestEntry> &entries, idx_t begin, idx_t end,
+                                          const vector<LogicalType> &partition_types, int64_t schema_id) {
+	vector<string> names {"_VERSION", "_KIND", "_PARTITION", "_BUCKET", "_TOTAL_BUCKETS", "_FILE"};
+	vector<LogicalType> types {LogicalType::INTEGER, LogicalType::TINYINT, LogicalType::BLOB,
+	                           LogicalType::INTEGER, LogicalType::INTEGER, DataFileMetaType()};
+
+	auto fill = [&](DataChunk &data, idx_t offset) {
+		auto count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, end - begin - offset);
+		for (idx_t row = 0; row < count; row++) {
+			auto &entry = entries[begin + offset + row];
+			idx_t col_idx = 0;
+			// _VERSION
+			SetFixed<int32_t>(data.data[col_idx++], row, paimon_manifest::MANIFEST_ENTRY_VERSION);
+			// _KIND
+			SetFixed<int8_t>(data.data[col_idx++], row, static_cast<int8_t>(entry.kind));
+			// _PARTITION
+			SetBlob(data.data[col_idx++], row, entry.partition);
+			// _BUCKET
+			SetFixed<int32_t>(data.data[col_idx++], row, entry.bucket);
+			// _TOTAL_BUCKETS
+			SetFixed<int32_t>(data.data[col_idx++], row, entry.totalBuckets);
+			// _FILE
+			SetDataFileMeta(data.data[col_idx++], row, entry.file);
+		}
+		return count;
+	};
+
+	PaimonManifestFileMeta result;
+	result.fileName = path.substr(path.find_last_of('/') + 1);
+	result.schemaId = schema_id;
+	result.fileSize = NumericCast<int64_t>(WriteAvroFile(context, path, names, types, fill, end - begin));
+	ComputeFileMeta(entries, begin, end, partition_types, result);
+	return result;
+}
+
+vector<PaimonManifestFileMeta> WriteToFiles(ClientContext &context, const FileStorePathFactory &path_factory,
+                                            const vector<PaimonManifestEntry> &entries,
+                                            const vector<LogicalType> &partition_types, int64_t schema_id,
+                                            idx_t target_file_size) {
+	vector<PaimonManifestFileMeta> result;
+	auto uuid = UUID::ToString(UUID::GenerateRandomUUID());
+	idx_t begin = 0;
+	idx_t estimated_size = 0;
+	for (idx_t i = 0; i < entries.size(); i++) {
+		estimated_size += EstimateEntrySize(entries[i]);
+		if (estimated_size >= target_file_size || i + 1 == entries.size()) {
+			auto path = path_factory.manifestFilePath(uuid, NumericCast<int>(result.size()));
+			result.push_back(WriteToFile(context, path, entries, begin, i + 1, partition_types, schema_id));
+			begin = i + 1;
+			estimated_size = 0;
+		}
+	}
+	return result;
+}
+
+vector<PaimonManifestEntry> ReadFromFile(ClientContext &context, const string &path) {
+	vector<PaimonManifestEntry> result;
+	ScanAvroFile(context, path, [&](DataChunk &chunk, const vector<string> &names) {
+		auto kind_idx = FindField(names, "_KIND", path);
+		auto partition_idx = FindField(names, "_PARTITION", path);
+		auto bucket_idx = FindField(names, "_BUCKET", path);
+		auto total_buckets_idx = FindField(names, "_TOTAL_BUCKETS", path);
+		auto file_idx = FindField(names, "_FILE", path);
+		for (idx_t row = 0; row < chunk.size(); row++) {
+			PaimonManifestEntry entry;
+			entry.kind = static_cast<PaimonFileKind>(GetNumeric<int8_t>(chunk.GetValue(kind_idx, row)));
+			entry.partition = GetBlob(chunk.GetValue(partition_idx, row));
+			entry.bucket = GetNumeric<int32_t>(chunk.GetValue(bucket_idx, row));
+			entry.totalBuckets = GetNumeric<int32_t>(chunk.GetValue(total_buckets_idx, row));
+			entry.file = GetDataFileMeta(chunk.GetValue(file_idx, row));
+			result.push_back(std::move(entry));
+		}
+	});
+	return result;
+}
+
+} // namespace paimon_manifest_file
+
+namespace paimon_manifest_list {
+
+idx_t WriteToFile(ClientContext &context, const string &path, const vector<PaimonManifestFileMeta> &manifests) {
+	vector<string> names {"_VERSION",          "_FILE_NAME", "_FILE_SIZE",  "_NUM_ADDED_FILES",
+	                      "_NUM_DELETED_FILES", "_PARTITION_STATS", "_SCHEMA_ID", "_MIN_BUCKET",
+	                      "_MAX_BUCKET",        "_MIN_LEVEL",  "_MAX_LEVEL"};
+	vector<LogicalType> types {LogicalType::INTEGER, LogicalType::VARCHAR,
+	                           LogicalType::BIGINT,  LogicalType::BIGINT,
+	                           LogicalType::BIGINT,  paimon_manifest::SimpleStatsType(),
+	                           LogicalType::BIGINT,  LogicalType::INTEGER,
+	                           LogicalType::INTEGER, LogicalType::INTEGER,
+	                           LogicalType::INTEGER};
+
+	auto fill = [&](DataChunk &data, idx_t offset) {
+		auto count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, manifests.size() - offset);
+		for (idx_t row = 0; row < count; row++) {
+			auto &manifest = manifests[offset + row];
+			idx_t col_idx = 0;
+			// _VERSION
+			SetFixed<int32_t>(data.data[col_idx++], row, paimon_manifest::MANIFEST_FILE_META_VERSION);
+			// _FILE_NAME
+			SetString(data.data[col_idx++], row, manifest.fileName);
+			// _FILE_SIZE
+			SetFixed<int64_t>(data.data[col_idx++], row, manifest.fileSize);
+			// _NUM_ADDED_FILES
+			SetFixed<int64_t>(data.data[col_idx++], row, manifest.numAddedFiles);
+			// _NUM_DELETED_FILES
+			SetFixed<int64_t>(data.data[col_idx++], row, manifest.numDeletedFiles);
+			// _PARTITION_STATS
+			SetSimpleStats(data.data[col_idx++], row, manifest.partitionStats);
+			// _SCHEMA_ID
+			SetFixed<int64_t>(data.data[col_idx++], row, manifest.schemaId);
+			// _MIN_BUCKET
+			SetFixed<int32_t>(data.data[col_idx++], row, manifest.minBucket);
+			// _MAX_BUCKET
+			SetFixed<int32_t>(data.data[col_idx++], row, manifest.maxBucket);
+			// _MIN_LEVEL
+			SetFixed<int32_t>(data.data[col_idx++], row, manifest.minLevel);
+			// _MAX_LEVEL
+			SetFixed<int32_t>(data.data[col_idx++], row, manifest.maxLevel);
+		}
+		return count;
+	};
+	return WriteAvroFile(context, path, names, types, fill, manifests.size());
+}
+
+vector<PaimonManifestFileMeta> ReadFromFile(ClientContext &context, const string &path) {
+	vector<PaimonManifestFileMeta> result;
+	ScanAvroFile(context, path, [&](DataChunk &chunk, const vector<string> &names) {
+		auto file_name_idx = FindField(names, "_FILE_NAME", path);
+		auto file_size_idx = FindField(names, "_FILE_SIZE", path);
+		auto num_added_idx = FindField(names, "_NUM_ADDED_FILES", path);
+		auto num_deleted_idx = FindField(names, "_NUM_DELETED_FILES", path);
+		auto partition_stats_idx = FindField(names, "_PARTITION_STATS", path);
+		auto schema_id_idx = FindField(names, "_SCHEMA_ID", path);
+		//! The bucket and level ranges were added in later versions of the format
+		optional_idx min_bucket_idx, max_bucket_idx, min_level_idx, max_level_idx;
+		for (idx_t i = 0; i < names.size(); i++) {
+			if (names[i] == "_MIN_BUCKET") {
+				min_bucket_idx = i;
+			} else if (names[i] == "_MAX_BUCKET") {
+				max_bucket_idx = i;
+			} else if (names[i] == "_MIN_LEVEL") {
+				min_level_idx = i;
+			} else if (names[i] == "_MAX_LEVEL") {
+				max_level_idx = i;
+			}
+		}
+		auto get_optional = [&](const optional_idx &col_idx, idx_t row) {
+			return col_idx.IsValid() ? GetNumeric<int32_t>(chunk.GetValue(col_idx.GetIndex(), row)) : 0;
+		};
+		for (idx_t row = 0; row < chunk.size(); row++) {
+			PaimonManifestFileMeta manifest;
+			manifest.fileName = chunk.GetValue(file_name_idx, row).ToString();
+			manifest.fileSize = GetNumeric<int64_t>(chunk.GetValue(file_size_idx, row));
+			manifest.numAddedFiles = GetNumeric<int64_t>(chunk.GetValue(num_added_idx, row));
+			manifest.numDeletedFiles = GetNumeric<int64_t>(chunk.GetValue(num_deleted_idx, row));
+			manifest.partitionStats = GetSimpleStats(chunk.GetValue(partition_stats_idx, row));
+			manifest.schemaId = GetNumeric<int64_t>(chunk.GetValue(schema_id_idx, row));
+			//! Manifest lists written before the bucket range was tracked cover every bucket
+			manifest.minBucket = min_bucket_idx.IsValid() ? get_optional(min_bucket_idx, row)
+			                                              : NumericLimits<int32_t>::Minimum();
+			manifest.maxBucket = max_bucket_idx.IsValid() ? get_optional(max_bucket_idx, row)
+			                                              : NumericLimits<int32_t>::Maximum();
+			manifest.minLevel = get_optional(min_level_idx, row);
+			manifest.maxLevel = get_optional(max_level_idx, row);
+			result.push_back(std::move(manifest));
+		}
+	});
+	return result;
+}
+
+} // namespace paimon_manifest_list
+
+namespace paimon_index_manifest {
+
+//! The type of a DeletionVectorMeta struct (DeletionVectorMeta.SCHEMA)
+static LogicalType DeletionVectorMetaType() {
+	child_list_t<LogicalType> children;
+	children.emplace_back("f0", LogicalType::VARCHAR);
+	children.emplace_back("f1", LogicalType::INTEGER);
+	children.emplace_back("f2", LogicalType::INTEGER);
+	children.emplace_back("_CARDINALITY", LogicalType::BIGINT);
+	return LogicalType::STRUCT(std::move(children));
+}
+
+idx_t WriteToFile(ClientContext &context, const string &path, const vector<PaimonIndexManifestEntry> &entries) {
+	vector<string> names {"_VERSION",   "_KIND",      "_PARTITION", "_BUCKET",   "_INDEX_TYPE",
+	                      "_FILE_NAME", "_FILE_SIZE", "_ROW_COUNT", "_DELETIONS_VECTORS_RANGES"};
+	auto range_type = DeletionVectorMetaType();
+	vector<LogicalType> types {LogicalType::INTEGER, LogicalType::TINYINT, LogicalType::BLOB,
+	                           LogicalType::INTEGER, LogicalType::VARCHAR, LogicalType::VARCHAR,
+	                           LogicalType::BIGINT,  LogicalType::BIGINT,  LogicalType::LIST(range_type)};
+
+	auto fill = [&](DataChunk &data, idx_t offset) {
+		auto count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, entries.size() - offset);
+		for (idx_t row = 0; row < count; row++) {
+			auto &entry = entries[offset + row];
+			idx_t col_idx = 0;
+			// _VERSION
+			SetFixed<int32_t>(data.data[col_idx++], row, paimon_manifest::INDEX_MANIFEST_ENTRY_VERSION);
+			// _KIND
+			SetFixed<int8_t>(data.data[col_idx++], row, static_cast<int8_t>(entry.kind));
+			// _PARTITION
+			SetBlob(data.data[col_idx++], row, entry.partition);
+			// _BUCKET
+			SetFixed<int32_t>(data.data[col_idx++], row, entry.bucket);
+			// _INDEX_TYPE
+			SetString(data.data[col_idx++], row, entry.indexType);
+			// _FILE_NAME
+			SetString(data.data[col_idx++], row, entry.fileName);
+			// _FILE_SIZE
+			SetFixed<int64_t>(data.data[col_idx++], row, entry.fileSize);
+			// _ROW_COUNT
+			SetFixed<int64_t>(data.data[col_idx++], row, entry.rowCount);
+			// _DELETIONS_VECTORS_RANGES, only set for deletion vector index files
+			auto &ranges_vector = data.data[col_idx++];
+			if (entry.deletionVectorRanges.empty()) {
+				SetNull(ranges_vector, row);
+				continue;
+			}
+			vector<Value> ranges;
+			for (auto &range : entry.deletionVectorRanges) {
+				auto cardinality = range.cardinality.IsValid()
+				                       ? Value::BIGINT(NumericCast<int64_t>(range.cardinality.GetIndex()))
+				                       : Value(LogicalType::BIGINT);
+				ranges.push_back(Value::STRUCT(range_type, {Value(range.dataFileName), Value::INTEGER(range.offset),
+				                                            Value::INTEGER(range.length), std::move(cardinality)}));
+			}
+			ranges_vector.SetValue(row, Value::LIST(range_type, std::move(ranges)));
+		}
+		return count;
+	};
+	return WriteAvroFile(context, path, names, types, fill, entries.size());
+}
+
+vector<PaimonIndexManifestEntry> ReadFromFile(ClientContext &context, const string &path) {
+	vector<PaimonIndexManifestEntry> result;
+	ScanAvroFile(context, path, [&](DataChunk &chunk, const vector<string> &names) {
+		auto kind_idx = FindField(names, "_KIND", path);
+		auto partition_idx = FindField(names, "_PARTITION", path);
+		auto bucket_idx = FindField(names, "_BUCKET", path);
+		auto index_type_idx = FindField(names, "_INDEX_TYPE", path);
+		auto file_name_idx = FindField(names, "_FILE_NAME", path);
+		auto file_size_idx = FindField(names, "_FILE_SIZE", path);
+		auto row_count_idx = FindField(names, "_ROW_COUNT", path);
+		//! Index files other than deletion vectors (e.g. HASH) have no ranges
+		optional_idx ranges_idx;
+		for (idx_t i = 0; i < names.size(); i++) {
+			if (names[i] == "_DELETIONS_VECTORS_RANGES") {
+				ranges_idx = i;
+			}
+		}
+		for (idx_t row = 0; row < chunk.size(); row++) {
+			PaimonIndexManifestEntry entry;
+			entry.kind = static_cast<PaimonFileKind>(GetNumeric<int8_t>(chunk.GetValue(kind_idx, row)));
+			entry.partition = GetBlob(chunk.GetValue(partition_idx, row));
+			entry.bucket = GetNumeric<int32_t>(chunk.GetValue(bucket_idx, row));
+			entry.indexType = chunk.GetValue(index_type_idx, row).ToString();
+			entry.fileName = chunk.GetValue(file_name_idx, row).ToString();
+			entry.fileSize = GetNumeric<int64_t>(chunk.GetValue(file_size_idx, row));
+			entry.rowCount = GetNumeric<int64_t>(chunk.GetValue(row_count_idx, row));
+			auto ranges = ranges_idx.IsValid() ? chunk.GetValue(ranges_idx.GetIndex(), row) : Value();
+			if (!ranges.IsNull()) {
+				for (auto &range_value : ListValue::GetChildren(ranges)) {
+					StructFields fields(range_value.type());
+					auto &children = StructValue::GetChildren(range_value);
+					PaimonDeletionVectorMeta range;
+					range.dataFileName = fields.Get(children, "f0").ToString();
+					range.offset = GetNumeric<int32_t>(fields.Get(children, "f1"));
+					range.length = GetNumeric<int32_t>(fields.Get(children, "f2"));
+					auto cardinality = fields.Get(children, "_CARDINALITY");
+					if (!cardinality.IsNull()) {
+						range.cardinality = NumericCast<idx_t>(cardinality.GetValue<int64_t>());
+					}
+					entry.deletionVectorRanges.push_back(std::move(range));
+				}
+			}
+			result.push_back(std::move(entry));
+		}
+	});
+	return result;
+}
+
+} // namespace paimon_index_manifest
+
+} // namespace duckdb
@@ -1,4 +1,5 @@
 #include "paimon_metadata.hpp"
+#include "paimon_binary_row.hpp"
 #include "duckdb/common/file_system.hpp"
 #include "duckdb/common/file_opener.hpp"
 #include "duckdb/common/exception.hpp"
@@ -32,74 +33,24 @@ string PaimonTableMetadata::GetMetaDataPath(ClientContext &context, const string
             break;
         }
         case PaimonOptions::SnapshotLookup::SnapshotSource::FROM_TIMESTAMP: {
-            // For timestamp lookup, we need to find the right snapshot
-            // Parse all snapshot files to find the one with the correct timestamp
-            vector<string> snapshot_files;
-            fs.ListFiles(snapshot_dir, [&](const string &fname, bool is_dir) {
-                if (!is_dir && fname.find("snapshot-") == 0) {
-                    snapshot_files.push_back(fname);
-                }
-            });
-
-            if (snapshot_files.empty()) {
-                throw IOException("No snapshot files found in: " + snapshot_dir);
-            }
-
-            // Find the snapshot with the highest timestamp <= requested timestamp
-            timestamp_t requested_time = options.snapshot_lookup.snapshot_timestamp;
-            timestamp_t best_timestamp = NumericLimits<timestamp_t>::Minimum();
-            string best_snapshot_file;
-
-            for (const auto &snapshot_file : snapshot_files) {
-                try {
-                    string full_path = snapshot_dir + "/" + snapshot_file;
-                    auto snapshot_metadata = ParseSnapshotMetadata(full_path, fs, options.metadata_compression_codec);
-
-                    if (snapshot_metadata.timestamp_ms <= requested_time &&
-                        snapshot_metadata.timestamp_ms > best_timestamp) {
-                        best_timestamp = snapshot_metadata.timestamp_ms;
-                        best_snapshot_file = snapshot_file;
-                    }
-                } catch (const std::exception &e) {
-                    // Skip malformed snapshot files
-                    std::cerr << "PAIMON: Skipping malformed snapshot file " << snapshot_file << ": " << e.what() << std::endl;
-                }
-            }
-
-            if (best_snapshot_file.empty()) {
-                throw IOException("No snapshot found for timestamp " + std::to_string(requested_time) + " in: " + snapshot_dir);
+            // The latest snapshot committed at or before the requested time
+            auto snapshot_id = FindSnapshotIdByTimestamp(table_location, fs, options.snapshot_lookup.snapshot_timestamp);
+            if (snapshot_id == 0) {
+                throw IOException("No snapshot found for timestamp " +
+                                  Timestamp::ToString(options.snapshot_lookup.snapshot_timestamp) + " in: " + snapshot_dir);
             }
-
-            snapshot_filename = best_snapshot_file;
+            snapshot_filename = "snapshot-" + std::to_string(snapshot_id);
             break;
         }
         case PaimonOptions::SnapshotLookup::SnapshotSource::LATEST:
         default: {
             // For Paimon, we need to find the latest snapshot
             if (options.table_version == "latest") {
-                // Look for LATEST file first
-                string latest_file = snapshot_dir + "/LATEST";
-                if (fs.FileExists(latest_file)) {
-                    snapshot_filename = IcebergUtils::FileToString(latest_file, fs);
-                    // Trim whitespace from filename
-                    StringUtil::Trim(snapshot_filename);
-                } else {
-                    // Find the highest numbered snapshot file
-                    vector<string> files;
-                    fs.ListFiles(snapshot_dir, [&](const string &fname, bool is_dir) {
-                        if (!is_dir && fname.find("snapshot-") == 0) {
-                            files.push_back(fname);
-                        }
-                    });
-
-                    if (files.empty()) {
-                        throw IOException("No snapshot files found in: " + snapshot_dir);
-                    }
-
-                    // Sort and pick the latest
-                    sort(files.begin(), files.end());
-                    snapshot_filename = files.back();
+                auto latest_id = FindLatestSnapshotId(table_location, fs);
+                if (latest_id == 0) {
+                    throw IOException("No snapshot files found in: " + snapshot_dir);
                 }
+                snapshot_filename = "snapshot-" + std::to_string(latest_id);
             } else {
                 // Handle specific version
                 snapshot_filename = "snapshot-" + options.table_version;
@@ -116,20 +67,131 @@ string PaimonTableMetadata::GetMetaDataPath(ClientContext &context, const string
     return full_path;
 }
 
-SnapshotMetadata PaimonTableMetadata::ParseSnapshotMetadata(const string &metadata_path, FileSystem &fs,
-                                                            const string &compression_codec) {
-    SnapshotMetadata result;
+// Parse a snapshot id from a LATEST/EARLIEST hint or a snapshot file name, returns 0 if it is not one
+static int64_t ParseSnapshotId(string name) {
+    StringUtil::Trim(name);
+    if (StringUtil::StartsWith(name, "snapshot-")) {
+        name = name.substr(9);
+    }
+    if (name.empty() || name.size() > 18) {
+        return 0;
+    }
+    for (auto c : name) {
+        if (!StringUtil::CharacterIsDigit(c)) {
+            return 0;
+        }
+    }
+    return std::stoll(name);
+}
+
+int64_t PaimonTableMetadata::FindLatestSnapshotId(const string &table_location, FileSystem &fs) {
+    string snapshot_dir = table_location + "/snapshot";
+    if (!fs.DirectoryExists(snapshot_dir)) {
+        return 0;
+    }
+
+    int64_t latest_id = 0;
+    string latest_file = snapshot_dir + "/LATEST";
+    if (fs.FileExists(latest_file)) {
+        latest_id = ParseSnapshotId(IcebergUtils::FileToString(latest_file, fs));
+    }
+    if (latest_id == 0) {
+        // No usable hint, list the snapshot directory
+        fs.ListFiles(snapshot_dir, [&](const string &fname, bool is_dir) {
+            if (!is_dir && StringUtil::StartsWith(fname, "snapshot-")) {
+                latest_id = MaxValue(latest_id, ParseSnapshotId(fname));
+            }
+        });
+    }
+    // Snapshots are created before the hint is updated, so the hint can be behind
+    while (fs.FileExists(snapshot_dir + "/snapshot-" + std::to_string(latest_id + 1))) {
+        latest_id++;
+    }
+    return latest_id;
+}
+
+int64_t PaimonTableMetadata::FindEarliestSnapshotId(const string &table_location, FileSystem &fs) {
+    string snapshot_dir = table_location + "/snapshot";
+    auto latest_id = FindLatestSnapshotId(table_location, fs);
+    if (latest_id == 0) {
+        return 0;
+    }
+
+    int64_t earliest_id = 0;
+    string earliest_file = snapshot_dir + "/EARLIEST";
+    if (fs.FileExists(earliest_file)) {
+        earliest_id = ParseSnapshotId(IcebergUtils::FileToString(earliest_file, fs));
+    }
+    if (earliest_id == 0 || earliest_id > latest_id) {
+        // No usable hint, list the snapshot directory
+        earliest_id = latest_id;
+        fs.ListFiles(snapshot_dir, [&](const string &fname, bool is_dir) {
+            auto id = is_dir || !StringUtil::StartsWith(fname, "snapshot-") ? 0 : ParseSnapshotId(fname);
+            if (id > 0) {
+                earliest_id = MinValue(earliest_id, id);
+            }
+        });
+    }
+    // Snapshot ids are dense, skip the snapshots an interrupted expiration already deleted
+    while (earliest_id < latest_id && !fs.FileExists(snapshot_dir + "/snapshot-" + std::to_string(earliest_id))) {
+        earliest_id++;
+    }
+    return earliest_id;
+}
 
-    // For now, create mock data since we don't have real Paimon snapshot parsing
-    // TODO: Implement proper Paimon snapshot JSON parsing
-    result.timestamp_ms = Timestamp::GetCurrentTimestamp();
-    result.snapshot_id = 1;
+int64_t PaimonTableMetadata::FindSnapshotIdByTimestamp(const string &table_location, FileSystem &fs,
+                                                       timestamp_t timestamp) {
+    string snapshot_dir = table_location + "/snapshot";
+    auto latest_id = FindLatestSnapshotId(table_location, fs);
+    if (latest_id == 0) {
+        return 0;
+    }
+    auto earliest_id = FindEarliestSnapshotId(table_location, fs);
+    auto requested_ms = Timestamp::GetEpochMs(timestamp);
+    auto snapshot_time_ms = [&](int64_t snapshot_id) {
+        auto snapshot_path = snapshot_dir + "/snapshot-" + std::to_string(snapshot_id);
+        return Timestamp::GetEpochMs(ParseSnapshotMetadata(snapshot_path, fs, string()).timestamp_ms);
+    };
+
+    if (snapshot_time_ms(earliest_id) > requested_ms) {
+        return 0;
+    }
+    if (snapshot_time_ms(latest_id) <= requested_ms) {
+        return latest_id;
+    }
+    // Snapshot ids are dense between the earliest and latest snapshot, and their commit times increase with the id.
+    // The snapshot at 'low' is at or before the requested time, the one at 'high' after it.
+    auto low = earliest_id;
+    auto high = latest_id;
+    while (high - low > 1) {
+        auto mid = low + (high - low) / 2;
+        if (snapshot_time_ms(mid) <= requested_ms) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
 
-    // In a real implementation, we would:
-    // 1. Read the JSON file
-    // 2. Parse timestamp-ms field
-    // 3. Parse snapshot-id field
+SnapshotMetadata PaimonTableMetadata::ParseSnapshotMetadata(const string &metadata_path, FileSystem &fs,
+                                                            const string &compression_codec) {
+    // Snapshot files are plain JSON, only the id and commit time are needed
+    string json_content = IcebergUtils::FileToString(metadata_path, fs);
+    auto doc = std::unique_ptr<yyjson_doc, YyjsonDocDeleter>(yyjson_read(json_content.c_str(), json_content.size(), 0));
+    if (!doc) {
+        throw InvalidInputException("Failed to parse Paimon snapshot JSON from: " + metadata_path);
+    }
+    auto root = yyjson_doc_get_root(doc.get());
+    auto id_val = yyjson_obj_get(root, "id");
+    auto time_val = yyjson_obj_get(root, "timeMillis");
+    if (!id_val || !yyjson_is_int(id_val) || !time_val || !yyjson_is_int(time_val)) {
+        throw InvalidInputException("Paimon snapshot is missing its id or timeMillis: " + metadata_path);
+    }
 
+    SnapshotMetadata result;
+    result.snapshot_id = NumericCast<uint64_t>(yyjson_get_sint(id_val));
+    result.timestamp_ms = Timestamp::FromEpochMs(yyjson_get_sint(time_val));
     return result;
 }
 
@@ -273,7 +335,82 @@ PaimonSnapshot *PaimonTableMetadata::GetCurrentSnapshot(const PaimonOptions &opt
     }
 }
 
+static void ParseStringArray(yyjson_val *array_obj, vector<string> &result) {
+    if (!array_obj || !yyjson_is_arr(array_obj)) {
+        return;
+    }
+    size_t idx, max;
+    yyjson_val *val;
+    yyjson_arr_foreach(array_obj, idx, max, val) {
+        if (yyjson_is_str(val)) {
+            result.emplace_back(yyjson_get_str(val));
+        }
+    }
+}
+
+unique_ptr<PaimonSchema> PaimonTableMetadata::LoadLatestSchema(const string &table_location, FileSystem &fs) {
+    string schema_dir = table_location + "/schema";
+    if (!fs.DirectoryExists(schema_dir)) {
+        return nullptr;
+    }
+
+    // Schema files are named schema-<id>, the latest schema has the highest id
+    int64_t latest_id = -1;
+    fs.ListFiles(schema_dir, [&](const string &fname, bool is_dir) {
+        if (is_dir || !StringUtil::StartsWith(fname, "schema-")) {
+            return;
+        }
+        auto id_str = fname.substr(7);
+        if (id_str.empty() || id_str.find_first_not_of("0123456789") != string::npos) {
+            return;
+        }
+        latest_id = MaxValue<int64_t>(latest_id, std::stoll(id_str));
+    });
+    if (latest_id < 0) {
+        return nullptr;
+    }
+
+    return LoadSchema(table_location, fs, latest_id);
+}
+
+unique_ptr<PaimonSchema> PaimonTableMetadata::LoadSchema(const string &table_location, FileSystem &fs,
+                                                         int64_t schema_id) {
+    string schema_path = table_location + "/schema/schema-" + std::to_string(schema_id);
+    if (!fs.FileExists(schema_path)) {
+        throw IOException("Paimon schema file does not exist: " + schema_path);
+    }
+    string json_content = IcebergUtils::FileToString(schema_path, fs);
+    auto doc = std::unique_ptr<yyjson_doc, YyjsonDocDeleter>(
+        yyjson_read(json_content.c_str(), json_content.size(), 0));
+    if (!doc) {
+        throw InvalidInputException("Failed to parse Paimon schema JSON from: " + schema_path);
+    }
+    auto root = yyjson_doc_get_root(doc.get());
+    if (!root || !yyjson_is_obj(root)) {
+        throw InvalidInputException("Invalid Paimon schema JSON: " + schema_path);
+    }
+
+    auto schema = make_uniq<PaimonSchema>();
+    schema->id = static_cast<int>(schema_id);
+    ParseSchemaFromJson(root, *schema);
+    return schema;
+}
+
 void PaimonTableMetadata::ParseSchemaFromJson(yyjson_val *schema_obj, PaimonSchema &schema) {
+    // Parse partition keys, primary keys and table options
+    ParseStringArray(yyjson_obj_get(schema_obj, "partitionKeys"), schema.partition_keys);
+    ParseStringArray(yyjson_obj_get(schema_obj, "primaryKeys"), schema.primary_keys);
+    auto options_obj = yyjson_obj_get(schema_obj, "options");
+    if (options_obj && yyjson_is_obj(options_obj)) {
+        size_t idx, max;
+        yyjson_val *key, *val;
+        yyjson_obj_foreach(options_obj, idx, max, key, val) {
+            if (yyjson_is_str(val)) {
+                schema.options[yyjson_get_str(key)] = yyjson_get_str(val);
+            }
+        }
+    }
+
     // Parse fields array
     auto fields_obj = yyjson_obj_get(schema_obj, "fields");
     if (fields_obj && yyjson_is_arr(fields_obj)) {
@@ -402,6 +539,14 @@ std::string FileStorePathFactory::manifestListFilePath(const std::string& uuid,
     return tablePath + "/manifest/manifest-list-" + uuid + "-" + std::to_string(index) + ".avro";
 }
 
+std::string FileStorePathFactory::indexManifestFilePath(const std::string& uuid, int index) const {
+    return tablePath + "/manifest/index-manifest-" + uuid + "-" + std::to_string(index) + ".avro";
+}
+
+std::string FileStorePathFactory::indexFilePath(const std::string& uuid, int counter) const {
+    return tablePath + "/index/index-" + uuid + "-" + std::to_string(counter);
+}
+
 std::string FileStorePathFactory::snapshotFilePath(int64_t snapshotId) const {
     return tablePath + "/snapshot/snapshot-" + std::to_string(snapshotId);
 }
@@ -437,6 +582,14 @@ std::string FileStorePathFactory::partitionedDeleteFilePath(const std::vector<st
     return basePath + "/" + filename;
 }
 
+std::string FileStorePathFactory::partitionedChangelogFilePath(const std::vector<std::pair<std::string, std::string>>& partition,
+                                                              int bucket, const std::string& uuid, int counter,
+                                                              PaimonFileFormat format) const {
+    std::string basePath = partitionBucketPath(partition, bucket);
+    std::string filename = "changelog-" + uuid + "-" + std::to_string(counter) + getFormatExtension(format);
+    return basePath + "/" + filename;
+}
+
 std::string FileStorePathFactory::getFormatExtension(PaimonFileFormat format) const {
     switch (format) {
         case PaimonFileFormat::PARQUET:
@@ -450,28 +603,32 @@ std::string FileStorePathFactory::getFormatExtension(PaimonFileFormat format) co
     }
 }
 
-// BucketManager implementation
-BucketManager::BucketManager(int numBuckets) : numBuckets(numBuckets) {
+// SimpleStats implementation
+SimpleStats SimpleStats::Empty() {
+    SimpleStats result;
+    result.minValues = PaimonBinaryRow::EmptyRow();
+    result.maxValues = PaimonBinaryRow::EmptyRow();
+    return result;
 }
 
-int BucketManager::assignBucket(const std::string& key) const {
-    size_t hashValue = hasher(key);
-    return static_cast<int>(hashValue % numBuckets);
+Value SimpleStats::ToValue() const {
+    child_list_t<Value> children;
+    children.emplace_back("_MIN_VALUES", PaimonBinaryRow::ToBlob(minValues));
+    children.emplace_back("_MAX_VALUES", PaimonBinaryRow::ToBlob(maxValues));
+    children.emplace_back("_NULL_COUNTS", Value::LIST(LogicalType::BIGINT, nullCounts));
+    return Value::STRUCT(std::move(children));
 }
 
-int BucketManager::assignBucket(const std::vector<Value>& partitionValues, const Value& primaryKey) const {
-    // Create a composite key from partition values and primary key
-    std::string compositeKey;
+// BucketManager implementation
+BucketManager::BucketManager(int numBuckets) : numBuckets(numBuckets) {
+}
 
-    // Add partition values
-    for (const auto& partValue : partitionValues) {
-        compositeKey += partValue.ToString() + "|";
+int BucketManager::assignBucket(int32_t bucketKeyHash) const {
+    if (numBuckets <= 1) {
+        return 0;
     }
-
-    // Add primary key
-    compositeKey += primaryKey.ToString();
-
-    return assignBucket(compositeKey);
+    // Math.abs(hash % numBuckets), with Java's truncating remainder
+    return std::abs(bucketKeyHash % numBuckets);
 }
 
 std::vector<int> BucketManager::getAllBuckets() const {
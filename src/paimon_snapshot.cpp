@@ -0,0 +1,152 @@
+#include "paimon_snapshot.hpp"
+#include "paimon_binary_row.hpp"
+#include "paimon_manifest.hpp"
+#include "iceberg_utils.hpp"
+#include "catalog_utils.hpp"
+
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "yyjson.hpp"
+
+namespace duckdb {
+
+namespace paimon_snapshot {
+
+string ManifestPath(const string &table_path, const string &file_name) {
+	return table_path + "/manifest/" + file_name;
+}
+
+PaimonSnapshotInfo Read(ClientContext &context, const string &table_path, int64_t snapshot_id) {
+	return ReadFile(context, table_path + "/snapshot/snapshot-" + std::to_string(snapshot_id));
+}
+
+PaimonSnapshotInfo ReadFile(ClientContext &context, const string &path) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto content = IcebergUtils::FileToString(path, fs);
+	auto doc = std::unique_ptr<yyjson_doc, YyjsonDocDeleter>(yyjson_read(content.c_str(), content.size(), 0));
+	if (!doc) {
+		throw InvalidInputException("Failed to parse Paimon snapshot JSON from: " + path);
+	}
+	auto root = yyjson_doc_get_root(doc.get());
+
+	auto get_string = [&](const char *key) {
+		auto val = yyjson_obj_get(root, key);
+		return val && yyjson_is_str(val) ? string(yyjson_get_str(val)) : string();
+	};
+	auto get_int = [&](const char *key) -> int64_t {
+		auto val = yyjson_obj_get(root, key);
+		return val && yyjson_is_int(val) ? yyjson_get_sint(val) : 0;
+	};
+
+	PaimonSnapshotInfo result;
+	result.id = get_int("id");
+	result.schema_id = get_int("schemaId");
+	result.base_manifest_list = get_string("baseManifestList");
+	result.delta_manifest_list = get_string("deltaManifestList");
+	result.changelog_manifest_list = get_string("changelogManifestList");
+	result.index_manifest = get_string("indexManifest");
+	result.commit_user = get_string("commitUser");
+	result.commit_identifier = get_int("commitIdentifier");
+	result.commit_kind = get_string("commitKind");
+	result.time_millis = get_int("timeMillis");
+	result.total_record_count = get_int("totalRecordCount");
+	result.delta_record_count = get_int("deltaRecordCount");
+	result.changelog_record_count = get_int("changelogRecordCount");
+	return result;
+}
+
+vector<PaimonManifestFileMeta> ReadManifests(ClientContext &context, const string &table_path,
+                                             const PaimonSnapshotInfo &snapshot) {
+	vector<PaimonManifestFileMeta> result;
+	for (auto &list : {snapshot.base_manifest_list, snapshot.delta_manifest_list}) {
+		if (list.empty()) {
+			continue;
+		}
+		auto manifests = paimon_manifest_list::ReadFromFile(context, ManifestPath(table_path, list));
+		for (auto &manifest : manifests) {
+			result.push_back(std::move(manifest));
+		}
+	}
+	return result;
+}
+
+vector<PaimonManifestEntry> ReadEntries(ClientContext &context, const string &table_path,
+                                        const vector<PaimonManifestFileMeta> &manifests) {
+	vector<PaimonManifestEntry> result;
+	for (auto &manifest : manifests) {
+		auto entries = paimon_manifest_file::ReadFromFile(context, ManifestPath(table_path, manifest.fileName));
+		for (auto &entry : entries) {
+			result.push_back(std::move(entry));
+		}
+	}
+	return result;
+}
+
+vector<PaimonManifestEntry> ReadLiveFiles(ClientContext &context, const string &table_path,
+                                          const PaimonSnapshotInfo &snapshot) {
+	auto entries = ReadEntries(context, table_path, ReadManifests(context, table_path, snapshot));
+	return MergeEntries(entries);
+}
+
+bool MayContainBucket(const PaimonManifestFileMeta &manifest, const vector<LogicalType> &partition_types,
+                      const vector<Value> &partition, int32_t bucket) {
+	if (bucket < manifest.minBucket || bucket > manifest.maxBucket) {
+		return false;
+	}
+	auto &stats = manifest.partitionStats;
+	if (partition_types.empty() || stats.minValues.empty() || stats.maxValues.empty()) {
+		return true;
+	}
+	auto min_values = PaimonBinaryRow::Deserialize(stats.minValues, partition_types);
+	auto max_values = PaimonBinaryRow::Deserialize(stats.maxValues, partition_types);
+	for (idx_t i = 0; i < partition.size() && i < min_values.size(); i++) {
+		//! NULL partition values and missing stats are not pruned on
+		if (partition[i].IsNull() || min_values[i].IsNull() || max_values[i].IsNull()) {
+			continue;
+		}
+		if (partition[i] < min_values[i] || partition[i] > max_values[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+string EntryIdentifier(const PaimonManifestEntry &entry) {
+	string result(const_char_ptr_cast(entry.partition.data()), entry.partition.size());
+	result += "/" + std::to_string(entry.bucket) + "/" + std::to_string(entry.file.level) + "/" + entry.file.fileName;
+	if (!entry.file.externalPath.empty()) {
+		result += "/" + entry.file.externalPath;
+	}
+	return result;
+}
+
+vector<PaimonManifestEntry> MergeEntries(vector<PaimonManifestEntry> &entries) {
+	unordered_map<string, idx_t> live_files;
+	vector<bool> live(entries.size(), false);
+	for (idx_t i = 0; i < entries.size(); i++) {
+		auto identifier = EntryIdentifier(entries[i]);
+		if (entries[i].kind == PaimonFileKind::ADD) {
+			live_files[identifier] = i;
+			live[i] = true;
+			continue;
+		}
+		auto entry = live_files.find(identifier);
+		if (entry != live_files.end()) {
+			live[entry->second] = false;
+			live_files.erase(entry);
+		}
+	}
+	vector<PaimonManifestEntry> result;
+	result.reserve(live_files.size());
+	for (idx_t i = 0; i < entries.size(); i++) {
+		if (live[i]) {
+			result.push_back(std::move(entries[i]));
+		}
+	}
+	return result;
+}
+
+} // namespace paimon_snapshot
+
+} // namespace duckdb
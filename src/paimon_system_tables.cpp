@@ -0,0 +1,1064 @@
+#include "paimon_functions.hpp"
+#include "paimon_binary_row.hpp"
+#include "paimon_manifest.hpp"
+#include "paimon_metadata.hpp"
+#include "paimon_snapshot.hpp"
+#include "iceberg_utils.hpp"
+#include "storage/paimon_table_entry.hpp"
+#include "storage/paimon_table_writer.hpp"
+
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/unordered_set.hpp"
+#include "duckdb/parallel/task_executor.hpp"
+#include "duckdb/parser/qualified_name.hpp"
+#include "duckdb/planner/expression/bound_between_expression.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_comparison_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/expression/bound_operator_expression.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+
+#include <algorithm>
+#include <functional>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Shared
+//===--------------------------------------------------------------------===//
+// The system tables describe the snapshots, manifests and files of a table, like Paimon's $snapshots, $manifests,
+// $files, $partitions and $buckets tables. They stream over the snapshot and manifest files: snapshots and manifests
+// are read in parallel, a batch of snapshots or a single manifest at a time per thread, so the files of a table are
+// never all held in memory. Filters on snapshot ids and partitions are pushed down to skip snapshot and manifest
+// files, they stay in the plan and are still evaluated on the produced rows.
+
+namespace {
+
+using manifest_callback_t = std::function<void(vector<PaimonManifestEntry> &entries)>;
+
+class ReadManifestTask : public BaseExecutorTask {
+public:
+	ReadManifestTask(TaskExecutor &executor, ClientContext &context, string path, const manifest_callback_t &callback)
+	    : BaseExecutorTask(executor), context(context), path(std::move(path)), callback(callback) {
+	}
+
+	void ExecuteTask() override {
+		auto entries = paimon_manifest_file::ReadFromFile(context, path);
+		callback(entries);
+	}
+
+private:
+	ClientContext &context;
+	string path;
+	const manifest_callback_t &callback;
+};
+
+} // namespace
+
+//! Read 'manifests' in parallel on the task executor, 'callback' is called from multiple threads
+static void ReadManifestsInParallel(ClientContext &context, const string &table_path,
+                                    const vector<PaimonManifestFileMeta> &manifests,
+                                    const manifest_callback_t &callback) {
+	TaskExecutor executor(context);
+	for (auto &manifest : manifests) {
+		executor.ScheduleTask(make_uniq<ReadManifestTask>(
+		    executor, context, paimon_snapshot::ManifestPath(table_path, manifest.fileName), callback));
+	}
+	executor.WorkOnTasks();
+}
+
+//! The files removed by the DELETE entries of 'manifests'. A live file is an ADD entry whose file is not removed, so
+//! only the manifests holding DELETE entries are read up front.
+static unordered_set<string> ReadDeletedFiles(ClientContext &context, const string &table_path,
+                                              const vector<PaimonManifestFileMeta> &manifests) {
+	vector<PaimonManifestFileMeta> delete_manifests;
+	for (auto &manifest : manifests) {
+		if (manifest.numDeletedFiles > 0) {
+			delete_manifests.push_back(manifest);
+		}
+	}
+	unordered_set<string> result;
+	mutex lock;
+	ReadManifestsInParallel(context, table_path, delete_manifests, [&](vector<PaimonManifestEntry> &entries) {
+		lock_guard<mutex> guard(lock);
+		for (auto &entry : entries) {
+			if (entry.kind == PaimonFileKind::DELETE) {
+				result.insert(paimon_snapshot::EntryIdentifier(entry));
+			}
+		}
+	});
+	return result;
+}
+
+//! Whether 'expr' references column 'column_index' of the table function scanned by 'get'
+static bool IsColumn(LogicalGet &get, const Expression &expr, idx_t column_index) {
+	if (expr.GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+		return false;
+	}
+	auto &colref = expr.Cast<BoundColumnRefExpression>();
+	auto &column_ids = get.GetColumnIds();
+	return colref.binding.table_index == get.table_index && colref.binding.column_index < column_ids.size() &&
+	       column_ids[colref.binding.column_index].GetPrimaryIndex() == column_index;
+}
+
+static optional_ptr<const Value> GetConstant(const Expression &expr) {
+	if (expr.GetExpressionClass() != ExpressionClass::BOUND_CONSTANT) {
+		return nullptr;
+	}
+	auto &value = expr.Cast<BoundConstantExpression>().value;
+	if (value.IsNull()) {
+		return nullptr;
+	}
+	return &value;
+}
+
+//! Match 'filter' against 'column <comparison> constant', with the column on either side
+static bool MatchComparison(LogicalGet &get, const Expression &filter, idx_t column_index, ExpressionType &comparison,
+                            optional_ptr<const Value> &constant) {
+	if (filter.GetExpressionClass() != ExpressionClass::BOUND_COMPARISON) {
+		return false;
+	}
+	auto &expr = filter.Cast<BoundComparisonExpression>();
+	comparison = expr.GetExpressionType();
+	if (IsColumn(get, *expr.left, column_index)) {
+		constant = GetConstant(*expr.right);
+	} else if (IsColumn(get, *expr.right, column_index)) {
+		constant = GetConstant(*expr.left);
+		comparison = FlipComparisonExpression(comparison);
+	} else {
+		return false;
+	}
+	return constant != nullptr;
+}
+
+static void SetString(Vector &vector, idx_t row, const string &value) {
+	FlatVector::GetData<string_t>(vector)[row] = StringVector::AddString(vector, value);
+}
+
+//===--------------------------------------------------------------------===//
+// Snapshots
+//===--------------------------------------------------------------------===//
+struct PaimonSnapshotsBindData : public TableFunctionData {
+	string table_path;
+	//! Narrowed by filters on snapshot_id
+	int64_t min_snapshot_id = 0;
+	int64_t max_snapshot_id = NumericLimits<int64_t>::Maximum();
+};
+
+struct PaimonSnapshotsGlobalState : public GlobalTableFunctionState {
+	int64_t first_snapshot_id = 0;
+	int64_t last_snapshot_id = 0;
+	idx_t batch_count = 0;
+	atomic<idx_t> next_batch {0};
+
+	idx_t MaxThreads() const override {
+		return MaxValue<idx_t>(batch_count, 1);
+	}
+};
+
+struct PaimonSnapshotsLocalState : public LocalTableFunctionState {
+	vector<PaimonSnapshotInfo> snapshots;
+	idx_t position = 0;
+	idx_t batch_index = 0;
+};
+
+//! Snapshots are read in batches of consecutive ids, a batch is emitted in order of id
+static constexpr idx_t SNAPSHOT_BATCH_SIZE = 64;
+
+//! A table of an attached Paimon catalog, or the location of a table
+static string ResolveTablePath(ClientContext &context, const string &input) {
+	if (input.find('/') == string::npos && input.find(':') == string::npos) {
+		auto qualified_name = QualifiedName::Parse(input);
+		auto table = Catalog::GetEntry<TableCatalogEntry>(context, qualified_name.catalog, qualified_name.schema,
+		                                                  qualified_name.name, OnEntryNotFound::RETURN_NULL);
+		if (table && table->ParentCatalog().GetCatalogType() == "paimon") {
+			return table->Cast<PaimonTableEntry>().GetTablePath();
+		}
+	}
+	return IcebergUtils::GetStorageLocation(context, input);
+}
+
+static unique_ptr<FunctionData> PaimonSnapshotsBind(ClientContext &context, TableFunctionBindInput &input,
+                                                    vector<LogicalType> &return_types, vector<string> &names) {
+	auto bind_data = make_uniq<PaimonSnapshotsBindData>();
+	bind_data->table_path = ResolveTablePath(context, input.inputs[0].ToString());
+
+	names = {"snapshot_id",
+	         "schema_id",
+	         "commit_user",
+	         "commit_identifier",
+	         "commit_kind",
+	         "commit_time",
+	         "base_manifest_list",
+	         "delta_manifest_list",
+	         "changelog_manifest_list",
+	         "total_record_count",
+	         "delta_record_count",
+	         "changelog_record_count"};
+	return_types = {LogicalType::BIGINT,  LogicalType::BIGINT,    LogicalType::VARCHAR, LogicalType::BIGINT,
+	                LogicalType::VARCHAR, LogicalType::TIMESTAMP, LogicalType::VARCHAR, LogicalType::VARCHAR,
+	                LogicalType::VARCHAR, LogicalType::BIGINT,    LogicalType::BIGINT,  LogicalType::BIGINT};
+	return std::move(bind_data);
+}
+
+static void PaimonSnapshotsPushdownFilter(ClientContext &context, LogicalGet &get, FunctionData *bind_data_p,
+                                          vector<unique_ptr<Expression>> &filters) {
+	auto &bind_data = bind_data_p->Cast<PaimonSnapshotsBindData>();
+	auto &min_id = bind_data.min_snapshot_id;
+	auto &max_id = bind_data.max_snapshot_id;
+	auto restrict_range = [&](ExpressionType comparison, int64_t value) {
+		switch (comparison) {
+		case ExpressionType::COMPARE_EQUAL:
+			min_id = MaxValue(min_id, value);
+			max_id = MinValue(max_id, value);
+			break;
+		case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+			min_id = MaxValue(min_id, value);
+			break;
+		case ExpressionType::COMPARE_GREATERTHAN:
+			if (value == NumericLimits<int64_t>::Maximum()) {
+				max_id = 0;
+			} else {
+				min_id = MaxValue(min_id, value + 1);
+			}
+			break;
+		case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+			max_id = MinValue(max_id, value);
+			break;
+		case ExpressionType::COMPARE_LESSTHAN:
+			max_id = value == NumericLimits<int64_t>::Minimum() ? 0 : MinValue(max_id, value - 1);
+			break;
+		default:
+			break;
+		}
+	};
+	//! Only integral constants give exact bounds, other comparisons are left to the filter
+	auto get_id = [](const Value &value, int64_t &result) {
+		if (!value.type().IsIntegral()) {
+			return false;
+		}
+		Value id;
+		if (!value.DefaultTryCastAs(LogicalType::BIGINT, id, nullptr)) {
+			return false;
+		}
+		result = id.GetValue<int64_t>();
+		return true;
+	};
+
+	for (auto &filter : filters) {
+		ExpressionType comparison;
+		optional_ptr<const Value> constant;
+		int64_t value;
+		if (MatchComparison(get, *filter, 0, comparison, constant)) {
+			if (get_id(*constant, value)) {
+				restrict_range(comparison, value);
+			}
+		} else if (filter->GetExpressionClass() == ExpressionClass::BOUND_BETWEEN) {
+			auto &between = filter->Cast<BoundBetweenExpression>();
+			if (!IsColumn(get, *between.input, 0)) {
+				continue;
+			}
+			auto lower = GetConstant(*between.lower);
+			if (lower && get_id(*lower, value)) {
+				restrict_range(between.lower_inclusive ? ExpressionType::COMPARE_GREATERTHANOREQUALTO
+				                                       : ExpressionType::COMPARE_GREATERTHAN,
+				               value);
+			}
+			auto upper = GetConstant(*between.upper);
+			if (upper && get_id(*upper, value)) {
+				restrict_range(between.upper_inclusive ? ExpressionType::COMPARE_LESSTHANOREQUALTO
+				                                       : ExpressionType::COMPARE_LESSTHAN,
+				               value);
+			}
+		}
+	}
+}
+
+static unique_ptr<GlobalTableFunctionState> PaimonSnapshotsInitGlobal(ClientContext &context,
+                                                                       TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<PaimonSnapshotsBindData>();
+	auto result = make_uniq<PaimonSnapshotsGlobalState>();
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto latest_id = PaimonTableMetadata::FindLatestSnapshotId(bind_data.table_path, fs);
+	if (latest_id == 0) {
+		return std::move(result);
+	}
+	auto first_id = MaxValue(PaimonTableMetadata::FindEarliestSnapshotId(bind_data.table_path, fs),
+	                         bind_data.min_snapshot_id);
+	auto last_id = MinValue(latest_id, bind_data.max_snapshot_id);
+	if (first_id > last_id) {
+		return std::move(result);
+	}
+	result->first_snapshot_id = first_id;
+	auto snapshot_count = NumericCast<idx_t>(last_id - first_id + 1);
+	result->batch_count = (snapshot_count + SNAPSHOT_BATCH_SIZE - 1) / SNAPSHOT_BATCH_SIZE;
+	result->last_snapshot_id = last_id;
+	return std::move(result);
+}
+
+static unique_ptr<LocalTableFunctionState> PaimonSnapshotsInitLocal(ExecutionContext &context,
+                                                                     TableFunctionInitInput &input,
+                                                                     GlobalTableFunctionState *global_state) {
+	return make_uniq<PaimonSnapshotsLocalState>();
+}
+
+static void PaimonSnapshotsExecute(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &bind_data = data.bind_data->Cast<PaimonSnapshotsBindData>();
+	auto &global_state = data.global_state->Cast<PaimonSnapshotsGlobalState>();
+	auto &local_state = data.local_state->Cast<PaimonSnapshotsLocalState>();
+
+	if (local_state.position >= local_state.snapshots.size()) {
+		auto batch = global_state.next_batch++;
+		if (batch >= global_state.batch_count) {
+			return;
+		}
+		local_state.snapshots.clear();
+		local_state.position = 0;
+		local_state.batch_index = batch;
+		auto first_id = global_state.first_snapshot_id + NumericCast<int64_t>(batch * SNAPSHOT_BATCH_SIZE);
+		auto last_id = MinValue(first_id + NumericCast<int64_t>(SNAPSHOT_BATCH_SIZE) - 1, global_state.last_snapshot_id);
+		for (auto id = first_id; id <= last_id; id++) {
+			try {
+				local_state.snapshots.push_back(paimon_snapshot::Read(context, bind_data.table_path, id));
+			} catch (IOException &) {
+				//! Expired since the scan started
+			}
+		}
+	}
+
+	// A chunk holds the snapshots of a single batch, so the batch index orders the output on snapshot id
+	idx_t count = 0;
+	while (local_state.position < local_state.snapshots.size() && count < STANDARD_VECTOR_SIZE) {
+		auto &snapshot = local_state.snapshots[local_state.position++];
+		FlatVector::GetData<int64_t>(output.data[0])[count] = snapshot.id;
+		FlatVector::GetData<int64_t>(output.data[1])[count] = snapshot.schema_id;
+		SetString(output.data[2], count, snapshot.commit_user);
+		FlatVector::GetData<int64_t>(output.data[3])[count] = snapshot.commit_identifier;
+		SetString(output.data[4], count, snapshot.commit_kind);
+		FlatVector::GetData<timestamp_t>(output.data[5])[count] = Timestamp::FromEpochMs(snapshot.time_millis);
+		SetString(output.data[6], count, snapshot.base_manifest_list);
+		SetString(output.data[7], count, snapshot.delta_manifest_list);
+		if (snapshot.changelog_manifest_list.empty()) {
+			FlatVector::SetNull(output.data[8], count, true);
+		} else {
+			SetString(output.data[8], count, snapshot.changelog_manifest_list);
+		}
+		FlatVector::GetData<int64_t>(output.data[9])[count] = snapshot.total_record_count;
+		FlatVector::GetData<int64_t>(output.data[10])[count] = snapshot.delta_record_count;
+		FlatVector::GetData<int64_t>(output.data[11])[count] = snapshot.changelog_record_count;
+		count++;
+	}
+	output.SetCardinality(count);
+}
+
+static OperatorPartitionData PaimonSnapshotsGetPartitionData(ClientContext &context,
+                                                             TableFunctionGetPartitionInput &input) {
+	if (input.partition_info.RequiresPartitionColumns()) {
+		throw InternalException("paimon_snapshots::GetPartitionData: partition columns not supported");
+	}
+	return OperatorPartitionData(input.local_state->Cast<PaimonSnapshotsLocalState>().batch_index);
+}
+
+TableFunctionSet PaimonFunctions::GetPaimonSnapshotsFunction() {
+	TableFunctionSet function_set("paimon_snapshots");
+
+	// paimon_snapshots('catalog.db.table') or paimon_snapshots('<table location>'): the $snapshots table
+	TableFunction table_function({LogicalType::VARCHAR}, PaimonSnapshotsExecute, PaimonSnapshotsBind,
+	                             PaimonSnapshotsInitGlobal, PaimonSnapshotsInitLocal);
+	table_function.name = "paimon_snapshots";
+	table_function.pushdown_complex_filter = PaimonSnapshotsPushdownFilter;
+	table_function.get_partition_data = PaimonSnapshotsGetPartitionData;
+	// Accepted for compatibility, snapshot files are plain JSON and all snapshots are listed
+	table_function.named_parameters["metadata_compression_codec"] = LogicalType::VARCHAR;
+	table_function.named_parameters["version"] = LogicalType::VARCHAR;
+
+	function_set.AddFunction(table_function);
+	return function_set;
+}
+
+//===--------------------------------------------------------------------===//
+// File Tables
+//===--------------------------------------------------------------------===//
+//! Bind data of the tables describing the files of a snapshot: $files, $manifests, $partitions and $buckets
+struct PaimonFileTableBindData : public TableFunctionData {
+	string table_path;
+	vector<string> partition_keys;
+	vector<LogicalType> partition_types;
+	//! The snapshot to describe, 0 for the latest one
+	int64_t snapshot_id = 0;
+	//! The columns of the latest schema, whose value stats are shown for the files written with that schema
+	int64_t schema_id = -1;
+	vector<string> column_names;
+	vector<LogicalType> column_types;
+	//! Set by filters on the partition column: only these partitions ('key=value/...') are read
+	bool filter_partitions = false;
+	unordered_set<string> partitions;
+	//! Set for $buckets, which groups the live files per bucket of a partition rather than per partition
+	bool by_bucket = false;
+
+	//! The partition a serialized partition row is stored in, as 'key=value/...' (empty for unpartitioned tables)
+	string RenderPartition(const vector<uint8_t> &partition) const {
+		if (partition_types.empty()) {
+			return string();
+		}
+		auto values = PaimonBinaryRow::Deserialize(partition, partition_types);
+		string result;
+		for (idx_t i = 0; i < values.size(); i++) {
+			result += (i == 0 ? "" : "/") + partition_keys[i] + "=";
+			result += values[i].IsNull() ? PaimonWriteLayout::DEFAULT_PARTITION_NAME : values[i].ToString();
+		}
+		return result;
+	}
+
+	bool ContainsPartition(const string &partition) const {
+		return !filter_partitions || partitions.find(partition) != partitions.end();
+	}
+};
+
+//! The rendered partitions of the serialized partition rows seen by one thread
+class PartitionRenderer {
+public:
+	explicit PartitionRenderer(const PaimonFileTableBindData &bind_data) : bind_data(bind_data) {
+	}
+
+	const string &Render(const vector<uint8_t> &partition) {
+		string key(const_char_ptr_cast(partition.data()), partition.size());
+		auto entry = cache.find(key);
+		if (entry == cache.end()) {
+			entry = cache.emplace(std::move(key), bind_data.RenderPartition(partition)).first;
+		}
+		return entry->second;
+	}
+
+private:
+	const PaimonFileTableBindData &bind_data;
+	unordered_map<string, string> cache;
+};
+
+static unique_ptr<PaimonFileTableBindData> BindFileTable(ClientContext &context, TableFunctionBindInput &input) {
+	auto bind_data = make_uniq<PaimonFileTableBindData>();
+	auto &table = PaimonFunctions::GetPaimonTableEntry(context, input.inputs[0].ToString());
+	bind_data->table_path = table.GetTablePath();
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto latest_schema = PaimonTableMetadata::LoadLatestSchema(bind_data->table_path, fs);
+	optional_ptr<const PaimonSchema> schema = latest_schema.get();
+	if (!schema) {
+		schema = table.GetMetadata().schema.get();
+	}
+	if (schema) {
+		for (auto &key : schema->partition_keys) {
+			bind_data->partition_keys.push_back(key);
+			bind_data->partition_types.push_back(table.GetColumns().GetColumn(key).Type());
+		}
+		bind_data->schema_id = schema->id;
+		for (auto &field : schema->fields) {
+			if (!table.GetColumns().ColumnExists(field.name)) {
+				bind_data->schema_id = -1;
+				break;
+			}
+			bind_data->column_names.push_back(field.name);
+			bind_data->column_types.push_back(table.GetColumns().GetColumn(field.name).Type());
+		}
+	}
+
+	for (auto &kv : input.named_parameters) {
+		auto loption = StringUtil::Lower(kv.first);
+		if (kv.second.IsNull()) {
+			continue;
+		}
+		if (loption == "snapshot_id") {
+			bind_data->snapshot_id = BigIntValue::Get(kv.second);
+		} else if (loption == "version") {
+			bind_data->snapshot_id = std::stoll(StringValue::Get(kv.second));
+		}
+	}
+	return bind_data;
+}
+
+//! Push filters 'partition = constant' and 'partition IN (constants)' down into the file tables
+static void PaimonFileTablePushdownFilter(ClientContext &context, LogicalGet &get, FunctionData *bind_data_p,
+                                          vector<unique_ptr<Expression>> &filters) {
+	auto &bind_data = bind_data_p->Cast<PaimonFileTableBindData>();
+	for (auto &filter : filters) {
+		unordered_set<string> partitions;
+		ExpressionType comparison;
+		optional_ptr<const Value> constant;
+		if (MatchComparison(get, *filter, 0, comparison, constant)) {
+			if (comparison != ExpressionType::COMPARE_EQUAL || constant->type().id() != LogicalTypeId::VARCHAR) {
+				continue;
+			}
+			partitions.insert(StringValue::Get(*constant));
+		} else if (filter->GetExpressionType() == ExpressionType::COMPARE_IN) {
+			auto &in_expr = filter->Cast<BoundOperatorExpression>();
+			if (!IsColumn(get, *in_expr.children[0], 0)) {
+				continue;
+			}
+			bool all_constant = true;
+			for (idx_t i = 1; i < in_expr.children.size(); i++) {
+				auto value = GetConstant(*in_expr.children[i]);
+				if (!value || value->type().id() != LogicalTypeId::VARCHAR) {
+					all_constant = false;
+					break;
+				}
+				partitions.insert(StringValue::Get(*value));
+			}
+			if (!all_constant) {
+				continue;
+			}
+		} else {
+			continue;
+		}
+
+		// Conjunctions of filters read the partitions all of them select
+		if (bind_data.filter_partitions) {
+			unordered_set<string> selected;
+			for (auto &partition : partitions) {
+				if (bind_data.partitions.find(partition) != bind_data.partitions.end()) {
+					selected.insert(partition);
+				}
+			}
+			partitions = std::move(selected);
+		}
+		bind_data.filter_partitions = true;
+		bind_data.partitions = std::move(partitions);
+	}
+}
+
+//! The manifests of the described snapshot that can hold files of the selected partitions
+static vector<PaimonManifestFileMeta> ReadFileTableManifests(ClientContext &context,
+                                                             const PaimonFileTableBindData &bind_data) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto snapshot_id = bind_data.snapshot_id;
+	if (snapshot_id == 0) {
+		snapshot_id = PaimonTableMetadata::FindLatestSnapshotId(bind_data.table_path, fs);
+		if (snapshot_id == 0) {
+			return vector<PaimonManifestFileMeta>();
+		}
+	} else if (!fs.FileExists(bind_data.table_path + "/snapshot/snapshot-" + std::to_string(snapshot_id))) {
+		throw InvalidInputException("Snapshot %lld of Paimon table \"%s\" does not exist", snapshot_id,
+		                            bind_data.table_path);
+	}
+	auto snapshot = paimon_snapshot::Read(context, bind_data.table_path, snapshot_id);
+	auto manifests = paimon_snapshot::ReadManifests(context, bind_data.table_path, snapshot);
+	if (!bind_data.filter_partitions || bind_data.partition_types.empty()) {
+		return manifests;
+	}
+
+	// Parse the selected partitions back into values, to skip manifests whose partition stats exclude all of them.
+	// A selected partition that does not parse (e.g. a value holding a '/') disables the pruning.
+	vector<vector<Value>> selected_values;
+	for (auto &partition : bind_data.partitions) {
+		auto parts = StringUtil::Split(partition, '/');
+		if (parts.size() != bind_data.partition_keys.size()) {
+			return manifests;
+		}
+		vector<Value> values;
+		for (idx_t i = 0; i < parts.size(); i++) {
+			auto separator = parts[i].find('=');
+			if (separator == string::npos || parts[i].substr(0, separator) != bind_data.partition_keys[i]) {
+				return manifests;
+			}
+			auto text = parts[i].substr(separator + 1);
+			if (text == PaimonWriteLayout::DEFAULT_PARTITION_NAME) {
+				values.emplace_back(bind_data.partition_types[i]);
+				continue;
+			}
+			Value value;
+			if (!Value(text).DefaultTryCastAs(bind_data.partition_types[i], value, nullptr)) {
+				return manifests;
+			}
+			values.push_back(std::move(value));
+		}
+		selected_values.push_back(std::move(values));
+	}
+
+	vector<PaimonManifestFileMeta> result;
+	for (auto &manifest : manifests) {
+		auto &stats = manifest.partitionStats;
+		if (stats.minValues.empty() || stats.maxValues.empty()) {
+			result.push_back(manifest);
+			continue;
+		}
+		auto min_values = PaimonBinaryRow::Deserialize(stats.minValues, bind_data.partition_types);
+		auto max_values = PaimonBinaryRow::Deserialize(stats.maxValues, bind_data.partition_types);
+		for (auto &values : selected_values) {
+			bool may_contain = true;
+			for (idx_t i = 0; i < values.size() && may_contain; i++) {
+				//! NULL partition values and missing stats are not pruned on
+				if (values[i].IsNull() || min_values[i].IsNull() || max_values[i].IsNull()) {
+					continue;
+				}
+				may_contain = !(values[i] < min_values[i]) && !(values[i] > max_values[i]);
+			}
+			if (may_contain) {
+				result.push_back(manifest);
+				break;
+			}
+		}
+	}
+	return result;
+}
+
+//===--------------------------------------------------------------------===//
+// Files
+//===--------------------------------------------------------------------===//
+struct PaimonFilesGlobalState : public GlobalTableFunctionState {
+	vector<PaimonManifestFileMeta> manifests;
+	unordered_set<string> deleted_files;
+	atomic<idx_t> next_manifest {0};
+
+	idx_t MaxThreads() const override {
+		return MaxValue<idx_t>(manifests.size(), 1);
+	}
+};
+
+struct PaimonFilesLocalState : public LocalTableFunctionState {
+	explicit PaimonFilesLocalState(const PaimonFileTableBindData &bind_data) : renderer(bind_data) {
+	}
+
+	//! The entries of the manifest being emitted
+	vector<PaimonManifestEntry> entries;
+	idx_t position = 0;
+	idx_t batch_index = 0;
+	PartitionRenderer renderer;
+};
+
+static unique_ptr<FunctionData> PaimonFilesBind(ClientContext &context, TableFunctionBindInput &input,
+                                                vector<LogicalType> &return_types, vector<string> &names) {
+	auto bind_data = BindFileTable(context, input);
+	names = {"partition",
+	         "bucket",
+	         "file_path",
+	         "file_format",
+	         "schema_id",
+	         "level",
+	         "record_count",
+	         "file_size_in_bytes",
+	         "min_sequence_number",
+	         "max_sequence_number",
+	         "creation_time",
+	         "delete_row_count",
+	         "file_source",
+	         "null_value_counts",
+	         "min_value_stats",
+	         "max_value_stats"};
+	return_types = {LogicalType::VARCHAR, LogicalType::INTEGER, LogicalType::VARCHAR,   LogicalType::VARCHAR,
+	                LogicalType::BIGINT,  LogicalType::INTEGER, LogicalType::BIGINT,    LogicalType::BIGINT,
+	                LogicalType::BIGINT,  LogicalType::BIGINT,  LogicalType::TIMESTAMP, LogicalType::BIGINT,
+	                LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR,   LogicalType::VARCHAR};
+	return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> PaimonFilesInitGlobal(ClientContext &context,
+                                                                   TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<PaimonFileTableBindData>();
+	auto result = make_uniq<PaimonFilesGlobalState>();
+	result->manifests = ReadFileTableManifests(context, bind_data);
+	result->deleted_files = ReadDeletedFiles(context, bind_data.table_path, result->manifests);
+	return std::move(result);
+}
+
+static unique_ptr<LocalTableFunctionState> PaimonFilesInitLocal(ExecutionContext &context,
+                                                                 TableFunctionInitInput &input,
+                                                                 GlobalTableFunctionState *global_state) {
+	return make_uniq<PaimonFilesLocalState>(input.bind_data->Cast<PaimonFileTableBindData>());
+}
+
+static string FileFormat(const string &file_name) {
+	auto extension = file_name.find_last_of('.');
+	return extension == string::npos ? string() : StringUtil::Lower(file_name.substr(extension + 1));
+}
+
+//! The indexes into the latest schema's columns of the value stats of 'file', false if they can't be read with it
+static bool GetValueStatsColumns(const PaimonFileTableBindData &bind_data, const DataFileMeta &file,
+                                 vector<idx_t> &result) {
+	auto &names = bind_data.column_names;
+	if (file.schemaId != bind_data.schema_id || file.valueStats.minValues.empty() ||
+	    file.valueStats.maxValues.empty()) {
+		return false;
+	}
+	if (file.valueStatsCols.empty()) {
+		for (idx_t col_idx = 0; col_idx < names.size(); col_idx++) {
+			result.push_back(col_idx);
+		}
+		return true;
+	}
+	for (auto &name : file.valueStatsCols) {
+		auto entry = std::find(names.begin(), names.end(), name);
+		if (entry == names.end()) {
+			return false;
+		}
+		result.push_back(NumericCast<idx_t>(entry - names.begin()));
+	}
+	return true;
+}
+
+//! Set the null counts and min/max values of 'file' as Paimon's $files table renders them, '{column=value, ...}'
+static void SetValueStats(const PaimonFileTableBindData &bind_data, const DataFileMeta &file, DataChunk &output,
+                          idx_t row) {
+	vector<idx_t> stats_columns;
+	if (!GetValueStatsColumns(bind_data, file, stats_columns)) {
+		for (idx_t col_idx = 13; col_idx < 16; col_idx++) {
+			FlatVector::SetNull(output.data[col_idx], row, true);
+		}
+		return;
+	}
+	vector<LogicalType> stats_types;
+	for (auto col_idx : stats_columns) {
+		stats_types.push_back(bind_data.column_types[col_idx]);
+	}
+	auto min_values = PaimonBinaryRow::Deserialize(file.valueStats.minValues, stats_types);
+	auto max_values = PaimonBinaryRow::Deserialize(file.valueStats.maxValues, stats_types);
+	auto render = [](const Value &value) {
+		return value.IsNull() ? string("null") : value.ToString();
+	};
+	string null_counts, min_stats, max_stats;
+	for (idx_t i = 0; i < stats_columns.size(); i++) {
+		auto prefix = (i == 0 ? "" : ", ") + bind_data.column_names[stats_columns[i]] + "=";
+		auto &nulls = file.valueStats.nullCounts;
+		null_counts += prefix + (i < nulls.size() ? render(nulls[i]) : "null");
+		min_stats += prefix + render(min_values[i]);
+		max_stats += prefix + render(max_values[i]);
+	}
+	SetString(output.data[13], row, "{" + null_counts + "}");
+	SetString(output.data[14], row, "{" + min_stats + "}");
+	SetString(output.data[15], row, "{" + max_stats + "}");
+}
+
+static void PaimonFilesExecute(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &bind_data = data.bind_data->Cast<PaimonFileTableBindData>();
+	auto &global_state = data.global_state->Cast<PaimonFilesGlobalState>();
+	auto &local_state = data.local_state->Cast<PaimonFilesLocalState>();
+
+	// A chunk holds the files of a single manifest, so the batch index orders the output on manifest
+	idx_t count = 0;
+	while (count == 0) {
+		if (local_state.position >= local_state.entries.size()) {
+			auto manifest_idx = global_state.next_manifest++;
+			if (manifest_idx >= global_state.manifests.size()) {
+				break;
+			}
+			auto &manifest = global_state.manifests[manifest_idx];
+			local_state.entries = paimon_manifest_file::ReadFromFile(
+			    context, paimon_snapshot::ManifestPath(bind_data.table_path, manifest.fileName));
+			local_state.position = 0;
+			local_state.batch_index = manifest_idx;
+		}
+		while (local_state.position < local_state.entries.size() && count < STANDARD_VECTOR_SIZE) {
+			auto &entry = local_state.entries[local_state.position++];
+			if (entry.kind != PaimonFileKind::ADD ||
+			    global_state.deleted_files.find(paimon_snapshot::EntryIdentifier(entry)) !=
+			        global_state.deleted_files.end()) {
+				continue;
+			}
+			auto &partition = local_state.renderer.Render(entry.partition);
+			if (!bind_data.ContainsPartition(partition)) {
+				continue;
+			}
+			auto &file = entry.file;
+			string file_path = file.externalPath;
+			if (file_path.empty()) {
+				file_path = bind_data.table_path + (partition.empty() ? "" : "/" + partition) + "/bucket-" +
+				            std::to_string(entry.bucket) + "/" + file.fileName;
+			}
+			SetString(output.data[0], count, partition);
+			FlatVector::GetData<int32_t>(output.data[1])[count] = entry.bucket;
+			SetString(output.data[2], count, file_path);
+			SetString(output.data[3], count, FileFormat(file.fileName));
+			FlatVector::GetData<int64_t>(output.data[4])[count] = file.schemaId;
+			FlatVector::GetData<int32_t>(output.data[5])[count] = file.level;
+			FlatVector::GetData<int64_t>(output.data[6])[count] = file.rowCount;
+			FlatVector::GetData<int64_t>(output.data[7])[count] = file.fileSize;
+			FlatVector::GetData<int64_t>(output.data[8])[count] = file.minSequenceNumber;
+			FlatVector::GetData<int64_t>(output.data[9])[count] = file.maxSequenceNumber;
+			FlatVector::GetData<timestamp_t>(output.data[10])[count] = file.creationTime;
+			if (file.deleteRowCount.IsValid()) {
+				FlatVector::GetData<int64_t>(output.data[11])[count] = NumericCast<int64_t>(file.deleteRowCount.GetIndex());
+			} else {
+				FlatVector::SetNull(output.data[11], count, true);
+			}
+			SetString(output.data[12], count, file.fileSource == FileSource::COMPACT ? "COMPACT" : "APPEND");
+			SetValueStats(bind_data, file, output, count);
+			count++;
+		}
+	}
+	output.SetCardinality(count);
+}
+
+static OperatorPartitionData PaimonFilesGetPartitionData(ClientContext &context, TableFunctionGetPartitionInput &input) {
+	if (input.partition_info.RequiresPartitionColumns()) {
+		throw InternalException("paimon_files::GetPartitionData: partition columns not supported");
+	}
+	return OperatorPartitionData(input.local_state->Cast<PaimonFilesLocalState>().batch_index);
+}
+
+static TableFunction GetFilesTableFunction(const string &name) {
+	TableFunction table_function({LogicalType::VARCHAR}, PaimonFilesExecute, PaimonFilesBind, PaimonFilesInitGlobal,
+	                             PaimonFilesInitLocal);
+	table_function.name = name;
+	table_function.pushdown_complex_filter = PaimonFileTablePushdownFilter;
+	table_function.get_partition_data = PaimonFilesGetPartitionData;
+	// Describe this snapshot instead of the latest one
+	table_function.named_parameters["snapshot_id"] = LogicalType::BIGINT;
+	return table_function;
+}
+
+TableFunctionSet PaimonFunctions::GetPaimonFilesFunction() {
+	TableFunctionSet function_set("paimon_files");
+	// paimon_files('catalog.db.table'): the $files table, the live data files of a snapshot
+	function_set.AddFunction(GetFilesTableFunction("paimon_files"));
+	return function_set;
+}
+
+TableFunctionSet PaimonFunctions::GetPaimonMetadataFunction() {
+	TableFunctionSet function_set("paimon_metadata");
+	// Kept for compatibility: the $files table, with 'version' selecting the snapshot
+	auto table_function = GetFilesTableFunction("paimon_metadata");
+	table_function.named_parameters["metadata_compression_codec"] = LogicalType::VARCHAR;
+	table_function.named_parameters["version"] = LogicalType::VARCHAR;
+	function_set.AddFunction(table_function);
+	return function_set;
+}
+
+//===--------------------------------------------------------------------===//
+// Manifests
+//===--------------------------------------------------------------------===//
+struct PaimonManifestsGlobalState : public GlobalTableFunctionState {
+	vector<PaimonManifestFileMeta> manifests;
+	idx_t offset = 0;
+};
+
+static unique_ptr<FunctionData> PaimonManifestsBind(ClientContext &context, TableFunctionBindInput &input,
+                                                    vector<LogicalType> &return_types, vector<string> &names) {
+	auto bind_data = BindFileTable(context, input);
+	names = {"file_name",           "file_size",  "num_added_files", "num_deleted_files",
+	         "schema_id",           "min_partition_stats", "max_partition_stats", "min_bucket",
+	         "max_bucket",          "min_level",  "max_level"};
+	return_types = {LogicalType::VARCHAR, LogicalType::BIGINT,  LogicalType::BIGINT,  LogicalType::BIGINT,
+	                LogicalType::BIGINT,  LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::INTEGER,
+	                LogicalType::INTEGER, LogicalType::INTEGER, LogicalType::INTEGER};
+	return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> PaimonManifestsInitGlobal(ClientContext &context,
+                                                                       TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<PaimonFileTableBindData>();
+	auto result = make_uniq<PaimonManifestsGlobalState>();
+	// Partition filters do not apply, the manifests have no partition column
+	PaimonFileTableBindData all_partitions;
+	all_partitions.table_path = bind_data.table_path;
+	all_partitions.snapshot_id = bind_data.snapshot_id;
+	result->manifests = ReadFileTableManifests(context, all_partitions);
+	return std::move(result);
+}
+
+//! Partition stats as '{value, ...}', like Paimon renders them
+static string RenderPartitionStats(const vector<uint8_t> &row, const vector<LogicalType> &types) {
+	if (types.empty() || row.empty()) {
+		return "{}";
+	}
+	auto values = PaimonBinaryRow::Deserialize(row, types);
+	string result = "{";
+	for (idx_t i = 0; i < values.size(); i++) {
+		result += (i == 0 ? "" : ", ") + values[i].ToString();
+	}
+	return result + "}";
+}
+
+static void PaimonManifestsExecute(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &bind_data = data.bind_data->Cast<PaimonFileTableBindData>();
+	auto &global_state = data.global_state->Cast<PaimonManifestsGlobalState>();
+	idx_t count = 0;
+	while (global_state.offset < global_state.manifests.size() && count < STANDARD_VECTOR_SIZE) {
+		auto &manifest = global_state.manifests[global_state.offset++];
+		SetString(output.data[0], count, manifest.fileName);
+		FlatVector::GetData<int64_t>(output.data[1])[count] = manifest.fileSize;
+		FlatVector::GetData<int64_t>(output.data[2])[count] = manifest.numAddedFiles;
+		FlatVector::GetData<int64_t>(output.data[3])[count] = manifest.numDeletedFiles;
+		FlatVector::GetData<int64_t>(output.data[4])[count] = manifest.schemaId;
+		SetString(output.data[5], count,
+		          RenderPartitionStats(manifest.partitionStats.minValues, bind_data.partition_types));
+		SetString(output.data[6], count,
+		          RenderPartitionStats(manifest.partitionStats.maxValues, bind_data.partition_types));
+		FlatVector::GetData<int32_t>(output.data[7])[count] = manifest.minBucket;
+		FlatVector::GetData<int32_t>(output.data[8])[count] = manifest.maxBucket;
+		FlatVector::GetData<int32_t>(output.data[9])[count] = manifest.minLevel;
+		FlatVector::GetData<int32_t>(output.data[10])[count] = manifest.maxLevel;
+		count++;
+	}
+	output.SetCardinality(count);
+}
+
+TableFunctionSet PaimonFunctions::GetPaimonManifestsFunction() {
+	TableFunctionSet function_set("paimon_manifests");
+	// paimon_manifests('catalog.db.table'): the $manifests table, the manifests of a snapshot
+	TableFunction table_function({LogicalType::VARCHAR}, PaimonManifestsExecute, PaimonManifestsBind,
+	                             PaimonManifestsInitGlobal);
+	table_function.name = "paimon_manifests";
+	table_function.named_parameters["snapshot_id"] = LogicalType::BIGINT;
+	function_set.AddFunction(table_function);
+	return function_set;
+}
+
+//===--------------------------------------------------------------------===//
+// Partitions and Buckets
+//===--------------------------------------------------------------------===//
+//! The live files of a partition, or of a bucket of a partition
+struct PaimonFileGroup {
+	vector<uint8_t> partition;
+	int32_t bucket = 0;
+	int64_t record_count = 0;
+	int64_t file_size_in_bytes = 0;
+	int64_t file_count = 0;
+	timestamp_t last_update_time = timestamp_t::ninfinity();
+
+	void Add(const DataFileMeta &file) {
+		record_count += file.rowCount;
+		file_size_in_bytes += file.fileSize;
+		file_count++;
+		last_update_time = MaxValue(last_update_time, file.creationTime);
+	}
+	void Merge(const PaimonFileGroup &other) {
+		record_count += other.record_count;
+		file_size_in_bytes += other.file_size_in_bytes;
+		file_count += other.file_count;
+		last_update_time = MaxValue(last_update_time, other.last_update_time);
+	}
+};
+
+struct PaimonFileGroupsGlobalState : public GlobalTableFunctionState {
+	//! The rendered partition of every group, sorted on partition and bucket
+	vector<pair<string, PaimonFileGroup>> groups;
+	idx_t offset = 0;
+};
+
+static unique_ptr<FunctionData> PaimonFileGroupsBind(ClientContext &context, TableFunctionBindInput &input,
+                                                     vector<LogicalType> &return_types, vector<string> &names,
+                                                     bool by_bucket) {
+	auto bind_data = BindFileTable(context, input);
+	bind_data->by_bucket = by_bucket;
+	names.push_back("partition");
+	return_types.push_back(LogicalType::VARCHAR);
+	if (by_bucket) {
+		names.push_back("bucket");
+		return_types.push_back(LogicalType::INTEGER);
+	}
+	names.insert(names.end(), {"record_count", "file_size_in_bytes", "file_count", "last_update_time"});
+	return_types.insert(return_types.end(),
+	                    {LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::TIMESTAMP});
+	return std::move(bind_data);
+}
+
+//! Aggregate the live files of the described snapshot per partition (and bucket), reading the manifests in parallel.
+//! Only the groups are held in memory, not the files.
+static unique_ptr<GlobalTableFunctionState> PaimonFileGroupsInitGlobal(ClientContext &context,
+                                                                        TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<PaimonFileTableBindData>();
+	auto by_bucket = bind_data.by_bucket;
+	auto result = make_uniq<PaimonFileGroupsGlobalState>();
+	auto manifests = ReadFileTableManifests(context, bind_data);
+	auto deleted_files = ReadDeletedFiles(context, bind_data.table_path, manifests);
+
+	unordered_map<string, PaimonFileGroup> groups;
+	mutex lock;
+	auto group_key = [&](const PaimonManifestEntry &entry) {
+		string key(const_char_ptr_cast(entry.partition.data()), entry.partition.size());
+		if (by_bucket) {
+			key.append(const_char_ptr_cast(&entry.bucket), sizeof(entry.bucket));
+		}
+		return key;
+	};
+	ReadManifestsInParallel(context, bind_data.table_path, manifests, [&](vector<PaimonManifestEntry> &entries) {
+		unordered_map<string, PaimonFileGroup> manifest_groups;
+		for (auto &entry : entries) {
+			if (entry.kind != PaimonFileKind::ADD ||
+			    deleted_files.find(paimon_snapshot::EntryIdentifier(entry)) != deleted_files.end()) {
+				continue;
+			}
+			auto &group = manifest_groups[group_key(entry)];
+			if (group.file_count == 0) {
+				group.partition = entry.partition;
+				group.bucket = by_bucket ? entry.bucket : 0;
+			}
+			group.Add(entry.file);
+		}
+		lock_guard<mutex> guard(lock);
+		for (auto &manifest_group : manifest_groups) {
+			auto target = groups.find(manifest_group.first);
+			if (target == groups.end()) {
+				groups.emplace(manifest_group.first, std::move(manifest_group.second));
+			} else {
+				target->second.Merge(manifest_group.second);
+			}
+		}
+	});
+
+	for (auto &group : groups) {
+		auto partition = bind_data.RenderPartition(group.second.partition);
+		if (bind_data.ContainsPartition(partition)) {
+			result->groups.emplace_back(std::move(partition), std::move(group.second));
+		}
+	}
+	std::sort(result->groups.begin(), result->groups.end(),
+	          [](const pair<string, PaimonFileGroup> &a, const pair<string, PaimonFileGroup> &b) {
+		          return a.first < b.first || (a.first == b.first && a.second.bucket < b.second.bucket);
+	          });
+	return std::move(result);
+}
+
+static void PaimonFileGroupsExecute(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &bind_data = data.bind_data->Cast<PaimonFileTableBindData>();
+	auto &global_state = data.global_state->Cast<PaimonFileGroupsGlobalState>();
+	idx_t count = 0;
+	while (global_state.offset < global_state.groups.size() && count < STANDARD_VECTOR_SIZE) {
+		auto &group = global_state.groups[global_state.offset++];
+		idx_t col_idx = 0;
+		SetString(output.data[col_idx++], count, group.first);
+		if (bind_data.by_bucket) {
+			FlatVector::GetData<int32_t>(output.data[col_idx++])[count] = group.second.bucket;
+		}
+		FlatVector::GetData<int64_t>(output.data[col_idx++])[count] = group.second.record_count;
+		FlatVector::GetData<int64_t>(output.data[col_idx++])[count] = group.second.file_size_in_bytes;
+		FlatVector::GetData<int64_t>(output.data[col_idx++])[count] = group.second.file_count;
+		FlatVector::GetData<timestamp_t>(output.data[col_idx++])[count] = group.second.last_update_time;
+		count++;
+	}
+	output.SetCardinality(count);
+}
+
+TableFunctionSet PaimonFunctions::GetPaimonPartitionsFunction() {
+	TableFunctionSet function_set("paimon_partitions");
+	// paimon_partitions('catalog.db.table'): the $partitions table, the live files of a snapshot per partition
+	TableFunction table_function(
+	    {LogicalType::VARCHAR}, PaimonFileGroupsExecute,
+	    [](ClientContext &context, TableFunctionBindInput &input, vector<LogicalType> &return_types,
+	       vector<string> &names) { return PaimonFileGroupsBind(context, input, return_types, names, false); },
+	    PaimonFileGroupsInitGlobal);
+	table_function.name = "paimon_partitions";
+	table_function.pushdown_complex_filter = PaimonFileTablePushdownFilter;
+	table_function.named_parameters["snapshot_id"] = LogicalType::BIGINT;
+	function_set.AddFunction(table_function);
+	return function_set;
+}
+
+TableFunctionSet PaimonFunctions::GetPaimonBucketsFunction() {
+	TableFunctionSet function_set("paimon_buckets");
+	// paimon_buckets('catalog.db.table'): the $buckets table, the live files of a snapshot per bucket
+	TableFunction table_function(
+	    {LogicalType::VARCHAR}, PaimonFileGroupsExecute,
+	    [](ClientContext &context, TableFunctionBindInput &input, vector<LogicalType> &return_types,
+	       vector<string> &names) { return PaimonFileGroupsBind(context, input, return_types, names, true); },
+	    PaimonFileGroupsInitGlobal);
+	table_function.name = "paimon_buckets";
+	table_function.pushdown_complex_filter = PaimonFileTablePushdownFilter;
+	table_function.named_parameters["snapshot_id"] = LogicalType::BIGINT;
+	function_set.AddFunction(table_function);
+	return function_set;
+}
+
+} // namespace duckdb
@@ -0,0 +1,680 @@
+#include "paimon_functions.hpp"
+#include "paimon_binary_row.hpp"
+#include "paimon_metadata.hpp"
+#include "paimon_snapshot.hpp"
+#include "storage/paimon_deletion_vectors.hpp"
+#include "storage/paimon_table_entry.hpp"
+#include "storage/paimon_table_writer.hpp"
+
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/uuid.hpp"
+#include "duckdb/main/appender.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// paimon_to_ducklake
+//===--------------------------------------------------------------------===//
+// Registers the latest snapshot of a Paimon table as a new table of a DuckLake catalog, without copying data: the
+// live Parquet data files become DuckLake data files, their value stats become file column stats, and partition keys
+// become identity partitions. Like iceberg_to_ducklake, the metadata is written with SQL into the DuckLake metadata
+// catalog, as a single DuckLake snapshot that creates the table.
+//
+// DuckLake delete files are Parquet files of (file_path, pos), so the deletion vectors of the data files are written
+// out as one small delete file each, into the DuckLake data path. Primary key tables are only supported with
+// deletion vectors and the deduplicate merge engine: their level-0 files are not visible until they are compacted
+// (as for Paimon's own deletion vector reads), and every key in the higher levels has one live row, so the files can
+// be read without merging. The bind checks the latter on the key ranges of the files and their deletion vectors. The KeyValue system columns are ignored, as DuckLake maps columns by field id.
+
+namespace {
+
+struct PaimonToDuckLakeColumn {
+	//! The Paimon field id, which is also the Parquet field id and the DuckLake column id
+	int64_t field_id;
+	string name;
+	LogicalType type;
+	string ducklake_type;
+	bool nullable;
+};
+
+struct PaimonToDuckLakeFile {
+	string path;
+	int64_t record_count = 0;
+	int64_t file_size = 0;
+	vector<Value> partition_values;
+	//! The stats of every column, NULL when unknown
+	vector<Value> min_values;
+	vector<Value> max_values;
+	vector<Value> null_counts;
+	//! The positions of the rows deleted by the file's deletion vector
+	roaring::Roaring deleted_rows;
+
+	//! Set once the delete file is written
+	string delete_file_path;
+	int64_t delete_file_size = 0;
+};
+
+} // namespace
+
+struct PaimonToDuckLakeBindData : public TableFunctionData {
+	string ducklake_catalog;
+	string schema_name = DEFAULT_SCHEMA;
+	string table_name;
+	int64_t paimon_snapshot_id = 0;
+	vector<PaimonToDuckLakeColumn> columns;
+	//! Indexes into 'columns'
+	vector<idx_t> partition_columns;
+	vector<PaimonToDuckLakeFile> files;
+};
+
+//! The DuckLake type name of 'type', as stored in 'ducklake_column'
+static string ToDuckLakeType(const string &column_name, const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::BOOLEAN:
+		return "boolean";
+	case LogicalTypeId::TINYINT:
+		return "int8";
+	case LogicalTypeId::SMALLINT:
+		return "int16";
+	case LogicalTypeId::INTEGER:
+		return "int32";
+	case LogicalTypeId::BIGINT:
+		return "int64";
+	case LogicalTypeId::FLOAT:
+		return "float32";
+	case LogicalTypeId::DOUBLE:
+		return "float64";
+	case LogicalTypeId::DECIMAL:
+		return StringUtil::Format("decimal(%d,%d)", DecimalType::GetWidth(type), DecimalType::GetScale(type));
+	case LogicalTypeId::DATE:
+		return "date";
+	case LogicalTypeId::TIME:
+		return "time";
+	case LogicalTypeId::TIMESTAMP:
+		return "timestamp";
+	case LogicalTypeId::TIMESTAMP_MS:
+		return "timestamp_ms";
+	case LogicalTypeId::TIMESTAMP_NS:
+		return "timestamp_ns";
+	case LogicalTypeId::TIMESTAMP_SEC:
+		return "timestamp_s";
+	case LogicalTypeId::TIMESTAMP_TZ:
+		return "timestamptz";
+	case LogicalTypeId::VARCHAR:
+		return "varchar";
+	case LogicalTypeId::BLOB:
+		return "blob";
+	default:
+		throw NotImplementedException("Converting Paimon column \"%s\" of type %s to DuckLake", column_name,
+		                              type.ToString());
+	}
+}
+
+//! A SQL literal of 'value', or NULL
+static string ToSQLLiteral(const Value &value) {
+	if (value.IsNull()) {
+		return "NULL";
+	}
+	return KeywordHelper::WriteQuoted(value.ToString(), '\'');
+}
+
+static string ToSQLLiteral(const string &value) {
+	return KeywordHelper::WriteQuoted(value, '\'');
+}
+
+//! Read the stats of the columns of 'file' into 'result', they are left NULL if the file was written with an older
+//! schema, as columns may have been renamed or retyped since
+static void ReadFileStats(const PaimonWriteLayout &layout, const DataFileMeta &file, PaimonToDuckLakeFile &result) {
+	auto column_count = layout.column_types.size();
+	result.min_values.assign(column_count, Value());
+	result.max_values.assign(column_count, Value());
+	result.null_counts.assign(column_count, Value());
+	if (file.schemaId != layout.schema_id || file.valueStats.minValues.empty() || file.valueStats.maxValues.empty()) {
+		return;
+	}
+	vector<idx_t> stats_columns;
+	if (file.valueStatsCols.empty()) {
+		for (idx_t col_idx = 0; col_idx < column_count; col_idx++) {
+			stats_columns.push_back(col_idx);
+		}
+	} else {
+		for (auto &name : file.valueStatsCols) {
+			auto entry = std::find(layout.column_names.begin(), layout.column_names.end(), name);
+			if (entry == layout.column_names.end()) {
+				return;
+			}
+			stats_columns.push_back(NumericCast<idx_t>(entry - layout.column_names.begin()));
+		}
+	}
+	vector<LogicalType> stats_types;
+	for (auto col_idx : stats_columns) {
+		stats_types.push_back(layout.column_types[col_idx]);
+	}
+	auto min_values = PaimonBinaryRow::Deserialize(file.valueStats.minValues, stats_types);
+	auto max_values = PaimonBinaryRow::Deserialize(file.valueStats.maxValues, stats_types);
+	for (idx_t i = 0; i < stats_columns.size(); i++) {
+		auto col_idx = stats_columns[i];
+		//! Blob bounds can't be written as text
+		if (stats_types[i].id() != LogicalTypeId::BLOB) {
+			result.min_values[col_idx] = min_values[i];
+			result.max_values[col_idx] = max_values[i];
+		}
+		if (i < file.valueStats.nullCounts.size()) {
+			result.null_counts[col_idx] = file.valueStats.nullCounts[i];
+		}
+	}
+}
+
+//! Whether the key 'a' sorts before the key 'b'
+static bool KeyLessThan(const vector<Value> &a, const vector<Value> &b) {
+	for (idx_t i = 0; i < a.size(); i++) {
+		if (a[i] < b[i]) {
+			return true;
+		}
+		if (b[i] < a[i]) {
+			return false;
+		}
+	}
+	return false;
+}
+
+//! The files above level 0 of a primary key table with deletion vectors are read without merging them: the writer
+//! that compacts a key into a level deletes its older versions in the other levels with deletion vectors. Check that
+//! every file with keys that a file of a lower (newer) level also holds has a deletion vector, a table compacted by
+//! a writer that doesn't maintain them (e.g. before 'deletion-vectors.enabled' was set) would return stale versions.
+static void CheckPrimaryKeyDeletionVectors(const PaimonWriteLayout &layout, const vector<PaimonManifestEntry> &files,
+                                           const PaimonDeletionVectors &deletion_vectors, const string &table_name) {
+	auto &types = layout.bind->types;
+	vector<LogicalType> key_types(types.begin(), types.begin() + NumericCast<int64_t>(layout.bind->key_count));
+	struct KeyRange {
+		const PaimonManifestEntry &entry;
+		vector<Value> min_key;
+		vector<Value> max_key;
+	};
+	map<string, vector<KeyRange>> buckets;
+	for (auto &entry : files) {
+		if (entry.file.level == 0 || entry.file.rowCount == 0) {
+			continue;
+		}
+		string bucket_key(const_char_ptr_cast(entry.partition.data()), entry.partition.size());
+		bucket_key += "/" + std::to_string(entry.bucket);
+		buckets[bucket_key].push_back(KeyRange {entry, PaimonBinaryRow::Deserialize(entry.file.minKey, key_types),
+		                                        PaimonBinaryRow::Deserialize(entry.file.maxKey, key_types)});
+	}
+	roaring::Roaring deleted_rows;
+	for (auto &bucket : buckets) {
+		auto &ranges = bucket.second;
+		for (auto &older : ranges) {
+			for (auto &newer : ranges) {
+				if (newer.entry.file.level >= older.entry.file.level || KeyLessThan(older.max_key, newer.min_key) ||
+				    KeyLessThan(newer.max_key, older.min_key)) {
+					continue;
+				}
+				if (!deletion_vectors.Read(older.entry.file.fileName, deleted_rows)) {
+					throw InvalidInputException(
+					    "Converting Paimon table \"%s\" to DuckLake: data file \"%s\" at level %d overlaps with the "
+					    "keys of data file \"%s\" at level %d, but has no deletion vector for their older versions",
+					    table_name, older.entry.file.fileName, older.entry.file.level, newer.entry.file.fileName,
+					    newer.entry.file.level);
+				}
+				break;
+			}
+		}
+	}
+}
+
+static unique_ptr<FunctionData> PaimonToDuckLakeBind(ClientContext &context, TableFunctionBindInput &input,
+                                                     vector<LogicalType> &return_types, vector<string> &names) {
+	auto bind_data = make_uniq<PaimonToDuckLakeBindData>();
+	auto &table = PaimonFunctions::GetPaimonTableEntry(context, input.inputs[0].ToString());
+	bind_data->ducklake_catalog = input.inputs[1].ToString();
+	bind_data->table_name = table.name;
+	for (auto &kv : input.named_parameters) {
+		auto loption = StringUtil::Lower(kv.first);
+		if (kv.second.IsNull()) {
+			continue;
+		}
+		if (loption == "schema") {
+			bind_data->schema_name = StringValue::Get(kv.second);
+		} else if (loption == "table_name") {
+			bind_data->table_name = StringValue::Get(kv.second);
+		}
+	}
+
+	PaimonWriteLayout layout(context, table);
+	if (layout.HasPrimaryKey()) {
+		if (!StringUtil::CIEquals(layout.GetOption("deletion-vectors.enabled"), "true")) {
+			throw NotImplementedException("Converting Paimon primary key tables without deletion vectors to DuckLake, "
+			                              "their files can only be read by merging them on the primary key");
+		}
+		if (layout.merge_engine != PaimonMergeEngine::DEDUPLICATE) {
+			throw NotImplementedException("Converting Paimon primary key tables with a merge engine other than "
+			                              "'deduplicate' to DuckLake");
+		}
+	}
+
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto schema = PaimonTableMetadata::LoadLatestSchema(layout.table_path, fs);
+	if (!schema) {
+		throw InvalidInputException("Paimon table \"%s\" has no schema", table.name);
+	}
+	for (idx_t col_idx = 0; col_idx < layout.column_names.size(); col_idx++) {
+		auto &name = layout.column_names[col_idx];
+		auto field = std::find_if(schema->fields.begin(), schema->fields.end(),
+		                          [&](const PaimonSchemaField &field) { return field.name == name; });
+		if (field == schema->fields.end()) {
+			throw InvalidInputException("Column \"%s\" of Paimon table \"%s\" is not in its latest schema", name,
+			                            table.name);
+		}
+		PaimonToDuckLakeColumn column;
+		column.field_id = field->id;
+		column.name = name;
+		column.type = layout.column_types[col_idx];
+		column.ducklake_type = ToDuckLakeType(name, column.type);
+		column.nullable = field->nullable;
+		bind_data->columns.push_back(std::move(column));
+	}
+	bind_data->partition_columns = layout.partition_key_indexes;
+
+	bind_data->paimon_snapshot_id = PaimonTableMetadata::FindLatestSnapshotId(layout.table_path, fs);
+	if (bind_data->paimon_snapshot_id != 0) {
+		auto snapshot = paimon_snapshot::Read(context, layout.table_path, bind_data->paimon_snapshot_id);
+		PaimonDeletionVectors deletion_vectors(context, layout.table_path, snapshot);
+		auto live_files = paimon_snapshot::ReadLiveFiles(context, layout.table_path, snapshot);
+		if (layout.HasPrimaryKey()) {
+			CheckPrimaryKeyDeletionVectors(layout, live_files, deletion_vectors, table.name);
+		}
+		for (auto &entry : live_files) {
+			if (layout.HasPrimaryKey() && entry.file.level == 0) {
+				continue;
+			}
+			PaimonToDuckLakeFile file;
+			file.path = layout.DataFilePath(entry);
+			if (!StringUtil::EndsWith(StringUtil::Lower(file.path), ".parquet")) {
+				throw NotImplementedException("Converting Paimon table \"%s\" to DuckLake, data file \"%s\" is not a "
+				                              "Parquet file",
+				                              table.name, file.path);
+			}
+			file.record_count = entry.file.rowCount;
+			file.file_size = entry.file.fileSize;
+			if (layout.IsPartitioned()) {
+				file.partition_values = PaimonBinaryRow::Deserialize(entry.partition, layout.partition_types);
+			}
+			ReadFileStats(layout, entry.file, file);
+			deletion_vectors.Read(entry.file.fileName, file.deleted_rows);
+			bind_data->files.push_back(std::move(file));
+		}
+	}
+
+	names = {"snapshot_id", "data_files", "delete_files", "record_count"};
+	return_types = {LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT, LogicalType::BIGINT};
+	return std::move(bind_data);
+}
+
+struct PaimonToDuckLakeGlobalState : public GlobalTableFunctionState {
+public:
+	PaimonToDuckLakeGlobalState(unique_ptr<Connection> connection, const string &metadata_catalog)
+	    : connection(std::move(connection)), metadata_catalog(metadata_catalog) {
+	}
+
+public:
+	//! Run 'query' on the metadata catalog, returns its first chunk or nullptr if it produced no rows
+	unique_ptr<DataChunk> Query(const string &query) {
+		auto result =
+		    connection->Query(StringUtil::Replace(query, "{METADATA_CATALOG}", KeywordHelper::WriteOptionallyQuoted(
+		                                                                            metadata_catalog)));
+		if (result->HasError()) {
+			result->ThrowError("'paimon_to_ducklake' query on the DuckLake metadata catalog failed: ");
+		}
+		auto chunk = result->Fetch();
+		if (!chunk || chunk->size() == 0) {
+			return nullptr;
+		}
+		return chunk;
+	}
+
+	static unique_ptr<GlobalTableFunctionState> Init(ClientContext &context, TableFunctionInitInput &input) {
+		auto &bind_data = input.bind_data->Cast<PaimonToDuckLakeBindData>();
+		auto &catalog = Catalog::GetCatalog(context, bind_data.ducklake_catalog);
+		if (catalog.GetCatalogType() != "ducklake") {
+			throw InvalidInputException("Second parameter must be the name of an attached DuckLake catalog");
+		}
+		auto metadata_catalog = StringUtil::Format("__ducklake_metadata_%s", bind_data.ducklake_catalog);
+		//! Verify the existence of the metadata catalog and that it's attached as well.
+		(void)Catalog::GetCatalog(context, metadata_catalog);
+
+		auto &db = DatabaseInstance::GetDatabase(context);
+		auto result = make_uniq<PaimonToDuckLakeGlobalState>(make_uniq<Connection>(db), metadata_catalog);
+		result->ReadCatalogState(bind_data);
+		return std::move(result);
+	}
+
+private:
+	//! Verify the DuckLake version, and read the latest snapshot, the target schema and the data path
+	void ReadCatalogState(const PaimonToDuckLakeBindData &bind_data) {
+		auto version = Query("SELECT value FROM {METADATA_CATALOG}.ducklake_metadata WHERE key = 'version'");
+		if (!version) {
+			throw InvalidInputException("Metadata catalog does not have a 'version' entry in 'ducklake_metadata'");
+		}
+		if (version->GetValue(0, 0).ToString() != "0.2") {
+			throw InvalidInputException("'paimon_to_ducklake' only supports DuckLake version 0.2 currently");
+		}
+
+		auto data_path = Query("SELECT value FROM {METADATA_CATALOG}.ducklake_metadata WHERE key = 'data_path'");
+		if (!data_path || data_path->GetValue(0, 0).IsNull()) {
+			throw InvalidInputException("Metadata catalog does not have a 'data_path' entry in 'ducklake_metadata'");
+		}
+		this->data_path = data_path->GetValue(0, 0).ToString();
+		if (!StringUtil::EndsWith(this->data_path, "/") && !StringUtil::EndsWith(this->data_path, "\\")) {
+			this->data_path += "/";
+		}
+
+		auto snapshot = Query("SELECT snapshot_id, schema_version, next_catalog_id, next_file_id FROM "
+		                      "{METADATA_CATALOG}.ducklake_snapshot ORDER BY snapshot_id DESC LIMIT 1");
+		if (!snapshot) {
+			throw InvalidInputException("DuckLake catalog \"%s\" has no snapshots", bind_data.ducklake_catalog);
+		}
+		snapshot_id = snapshot->GetValue(0, 0).GetValue<int64_t>();
+		schema_version = snapshot->GetValue(1, 0).GetValue<int64_t>();
+		next_catalog_id = snapshot->GetValue(2, 0).GetValue<int64_t>();
+		next_file_id = snapshot->GetValue(3, 0).GetValue<int64_t>();
+
+		auto schema = Query(StringUtil::Format("SELECT schema_id FROM {METADATA_CATALOG}.ducklake_schema WHERE "
+		                                       "schema_name = %s AND end_snapshot IS NULL",
+		                                       ToSQLLiteral(bind_data.schema_name)));
+		if (!schema) {
+			throw InvalidInputException("DuckLake catalog \"%s\" has no schema \"%s\"", bind_data.ducklake_catalog,
+			                            bind_data.schema_name);
+		}
+		schema_id = schema->GetValue(0, 0).GetValue<int64_t>();
+		auto existing = Query(StringUtil::Format("SELECT table_id FROM {METADATA_CATALOG}.ducklake_table WHERE "
+		                                         "schema_id = %d AND table_name = %s AND end_snapshot IS NULL",
+		                                         schema_id, ToSQLLiteral(bind_data.table_name)));
+		if (existing) {
+			throw InvalidInputException("DuckLake schema \"%s\" already has a table \"%s\"", bind_data.schema_name,
+			                            bind_data.table_name);
+		}
+	}
+
+public:
+	//! Connection used to run the SQL statements
+	unique_ptr<Connection> connection;
+	string metadata_catalog;
+	string data_path;
+	//! The latest snapshot of the DuckLake catalog
+	int64_t snapshot_id;
+	int64_t schema_version;
+	int64_t next_catalog_id;
+	int64_t next_file_id;
+	int64_t schema_id;
+	bool finished = false;
+};
+
+//! Write the deletion vector of every file that has one as a DuckLake delete file in the data path
+static void WriteDeleteFiles(ClientContext &context, PaimonToDuckLakeGlobalState &global_state,
+                             vector<PaimonToDuckLakeFile> &files) {
+	auto &connection = *global_state.connection;
+	auto &fs = FileSystem::GetFileSystem(context);
+	static constexpr const char *DELETES_TABLE = "__paimon_to_ducklake_deletes";
+	auto create = connection.Query(StringUtil::Format(
+	    "CREATE OR REPLACE TEMPORARY TABLE %s (file_path VARCHAR, pos BIGINT)", DELETES_TABLE));
+	if (create->HasError()) {
+		create->ThrowError("'paimon_to_ducklake' failed to write the delete files: ");
+	}
+	for (auto &file : files) {
+		if (file.deleted_rows.isEmpty()) {
+			continue;
+		}
+		{
+			Appender appender(connection, DELETES_TABLE);
+			for (auto position : file.deleted_rows) {
+				appender.BeginRow();
+				appender.Append(file.path.c_str());
+				appender.Append<int64_t>(position);
+				appender.EndRow();
+			}
+			appender.Close();
+		}
+		file.delete_file_path =
+		    global_state.data_path + "ducklake-" + UUID::ToString(UUID::GenerateRandomUUID()) + "-delete.parquet";
+		for (auto &query : {StringUtil::Format("COPY %s TO %s (FORMAT parquet)", DELETES_TABLE,
+		                                       ToSQLLiteral(file.delete_file_path)),
+		                    StringUtil::Format("DELETE FROM %s", DELETES_TABLE)}) {
+			auto result = connection.Query(query);
+			if (result->HasError()) {
+				result->ThrowError("'paimon_to_ducklake' failed to write the delete files: ");
+			}
+		}
+		auto handle = fs.OpenFile(file.delete_file_path, FileFlags::FILE_FLAGS_READ);
+		file.delete_file_size = handle->GetFileSize();
+	}
+	connection.Query(StringUtil::Format("DROP TABLE IF EXISTS %s", DELETES_TABLE));
+}
+
+//! The statements that create the table in a new DuckLake snapshot, in the order of 'iceberg_to_ducklake'
+static vector<string> CreateSQLStatements(const PaimonToDuckLakeBindData &bind_data,
+                                          const vector<PaimonToDuckLakeFile> &files,
+                                          const PaimonToDuckLakeGlobalState &global_state) {
+	vector<string> sql;
+	auto snapshot_id = global_state.snapshot_id + 1;
+	auto next_catalog_id = global_state.next_catalog_id;
+	auto table_id = next_catalog_id++;
+	optional_idx partition_id;
+	if (!bind_data.partition_columns.empty()) {
+		partition_id = NumericCast<idx_t>(next_catalog_id++);
+	}
+	auto next_file_id = global_state.next_file_id;
+
+	idx_t delete_file_count = 0;
+	for (auto &file : files) {
+		delete_file_count += !file.delete_file_path.empty();
+	}
+	auto first_data_file_id = next_file_id;
+	auto first_delete_file_id = first_data_file_id + NumericCast<int64_t>(files.size());
+	next_file_id = first_delete_file_id + NumericCast<int64_t>(delete_file_count);
+
+	sql.push_back("BEGIN TRANSACTION;");
+
+	//! ducklake_snapshot
+	sql.push_back(StringUtil::Format(
+	    "INSERT INTO {METADATA_CATALOG}.ducklake_snapshot VALUES(%d, '%s', %d, %d, %d);", snapshot_id,
+	    Timestamp::ToString(Timestamp::GetCurrentTimestamp()), global_state.schema_version + 1, next_catalog_id,
+	    next_file_id));
+
+	//! ducklake_table
+	auto table_uuid = UUID::ToString(UUID::GenerateRandomUUID());
+	sql.push_back(StringUtil::Format("INSERT INTO {METADATA_CATALOG}.ducklake_table VALUES(%d, '%s', %d, NULL, %d, %s, "
+	                                 "'', false);",
+	                                 table_id, table_uuid, snapshot_id, global_state.schema_id,
+	                                 ToSQLLiteral(bind_data.table_name)));
+
+	//! ducklake_partition_info and ducklake_partition_column, Paimon partitions on the values of the partition keys
+	if (partition_id.IsValid()) {
+		auto id = NumericCast<int64_t>(partition_id.GetIndex());
+		sql.push_back(StringUtil::Format("INSERT INTO {METADATA_CATALOG}.ducklake_partition_info VALUES(%d, %d, %d, "
+		                                 "NULL);",
+		                                 id, table_id, snapshot_id));
+		for (idx_t i = 0; i < bind_data.partition_columns.size(); i++) {
+			auto &column = bind_data.columns[bind_data.partition_columns[i]];
+			sql.push_back(StringUtil::Format("INSERT INTO {METADATA_CATALOG}.ducklake_partition_column VALUES(%d, %d, "
+			                                 "%d, %d, 'identity');",
+			                                 id, table_id, i, column.field_id));
+		}
+	}
+
+	//! ducklake_column
+	for (idx_t col_idx = 0; col_idx < bind_data.columns.size(); col_idx++) {
+		auto &column = bind_data.columns[col_idx];
+		sql.push_back(StringUtil::Format("INSERT INTO {METADATA_CATALOG}.ducklake_column VALUES (%d, %d, NULL, %d, %d, "
+		                                 "%s, '%s', NULL, NULL, %s, NULL);",
+		                                 column.field_id, snapshot_id, table_id, col_idx, ToSQLLiteral(column.name),
+		                                 column.ducklake_type, column.nullable ? "true" : "false"));
+	}
+
+	//! ducklake_data_file, ducklake_file_column_statistics, ducklake_file_partition_value and ducklake_delete_file
+	auto column_count = bind_data.columns.size();
+	vector<bool> contains_null(column_count, false);
+	//! The table's bounds are only known if they are known for every file
+	vector<bool> bounds_known(column_count, true);
+	vector<Value> min_values(column_count);
+	vector<Value> max_values(column_count);
+	int64_t row_id_start = 0;
+	int64_t deleted_rows = 0;
+	int64_t file_size_bytes = 0;
+	auto delete_file_id = first_delete_file_id;
+	for (idx_t file_idx = 0; file_idx < files.size(); file_idx++) {
+		auto &file = files[file_idx];
+		auto data_file_id = first_data_file_id + NumericCast<int64_t>(file_idx);
+		auto partition = partition_id.IsValid() ? to_string(partition_id.GetIndex()) : "NULL";
+		sql.push_back(StringUtil::Format("INSERT INTO {METADATA_CATALOG}.ducklake_data_file VALUES(%d, %d, %d, NULL, "
+		                                 "NULL, %s, false, 'parquet', %d, %d, NULL, %d, %s, NULL, NULL, NULL);",
+		                                 data_file_id, table_id, snapshot_id, ToSQLLiteral(file.path),
+		                                 file.record_count, file.file_size, row_id_start, partition));
+		row_id_start += file.record_count;
+		file_size_bytes += file.file_size;
+
+		for (idx_t col_idx = 0; col_idx < column_count; col_idx++) {
+			auto &column = bind_data.columns[col_idx];
+			auto &null_count = file.null_counts[col_idx];
+			auto &min_value = file.min_values[col_idx];
+			auto &max_value = file.max_values[col_idx];
+			//! Paimon doesn't track NaN values
+			auto is_floating = column.type.id() == LogicalTypeId::FLOAT || column.type.id() == LogicalTypeId::DOUBLE;
+			sql.push_back(StringUtil::Format("INSERT INTO {METADATA_CATALOG}.ducklake_file_column_statistics VALUES(%d, "
+			                                 "%d, %d, NULL, NULL, %s, %s, %s, %s);",
+			                                 data_file_id, table_id, column.field_id,
+			                                 null_count.IsNull() ? "NULL" : null_count.ToString(),
+			                                 ToSQLLiteral(min_value), ToSQLLiteral(max_value),
+			                                 is_floating ? "NULL" : "false"));
+
+			if (null_count.IsNull() || null_count.GetValue<int64_t>() != 0) {
+				contains_null[col_idx] = true;
+			}
+			if (min_value.IsNull() || max_value.IsNull()) {
+				bounds_known[col_idx] = false;
+				continue;
+			}
+			if (min_values[col_idx].IsNull() || min_value < min_values[col_idx]) {
+				min_values[col_idx] = min_value;
+			}
+			if (max_values[col_idx].IsNull() || max_value > max_values[col_idx]) {
+				max_values[col_idx] = max_value;
+			}
+		}
+
+		for (idx_t i = 0; i < file.partition_values.size(); i++) {
+			sql.push_back(StringUtil::Format("INSERT INTO {METADATA_CATALOG}.ducklake_file_partition_value VALUES(%d, "
+			                                 "%d, %d, %s);",
+			                                 data_file_id, table_id, i, ToSQLLiteral(file.partition_values[i])));
+		}
+
+		if (!file.delete_file_path.empty()) {
+			auto delete_count = NumericCast<int64_t>(file.deleted_rows.cardinality());
+			sql.push_back(StringUtil::Format("INSERT INTO {METADATA_CATALOG}.ducklake_delete_file VALUES(%d, %d, %d, "
+			                                 "NULL, %d, %s, false, 'parquet', %d, %d, NULL, NULL);",
+			                                 delete_file_id++, table_id, snapshot_id, data_file_id,
+			                                 ToSQLLiteral(file.delete_file_path), delete_count,
+			                                 file.delete_file_size));
+			deleted_rows += delete_count;
+		}
+	}
+
+	//! ducklake_table_stats and ducklake_table_column_stats
+	sql.push_back(StringUtil::Format("INSERT INTO {METADATA_CATALOG}.ducklake_table_stats VALUES(%d, %d, %d, %d);",
+	                                 table_id, row_id_start - deleted_rows, row_id_start, file_size_bytes));
+	for (idx_t col_idx = 0; col_idx < column_count; col_idx++) {
+		auto &column = bind_data.columns[col_idx];
+		auto is_floating = column.type.id() == LogicalTypeId::FLOAT || column.type.id() == LogicalTypeId::DOUBLE;
+		auto min_value = bounds_known[col_idx] ? ToSQLLiteral(min_values[col_idx]) : "NULL";
+		auto max_value = bounds_known[col_idx] ? ToSQLLiteral(max_values[col_idx]) : "NULL";
+		sql.push_back(StringUtil::Format("INSERT INTO {METADATA_CATALOG}.ducklake_table_column_stats VALUES(%d, %d, %s, "
+		                                 "%s, %s, %s);",
+		                                 table_id, column.field_id, contains_null[col_idx] ? "true" : "false",
+		                                 is_floating ? "NULL" : "false", min_value, max_value));
+	}
+
+	//! ducklake_snapshot_changes
+	vector<string> changes;
+	changes.push_back(StringUtil::Format("created_table:%s.%s", KeywordHelper::WriteQuoted(bind_data.schema_name, '"'),
+	                                     KeywordHelper::WriteQuoted(bind_data.table_name, '"')));
+	if (!files.empty()) {
+		changes.push_back(StringUtil::Format("inserted_into_table:%d", table_id));
+	}
+	if (delete_file_count != 0) {
+		changes.push_back(StringUtil::Format("deleted_from_table:%d", table_id));
+	}
+	sql.push_back(StringUtil::Format("INSERT INTO {METADATA_CATALOG}.ducklake_snapshot_changes VALUES(%d, %s);",
+	                                 snapshot_id, ToSQLLiteral(StringUtil::Join(changes, ","))));
+	sql.push_back("COMMIT TRANSACTION;");
+	return sql;
+}
+
+static void PaimonToDuckLakeExecute(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &bind_data = data.bind_data->Cast<PaimonToDuckLakeBindData>();
+	auto &global_state = data.global_state->Cast<PaimonToDuckLakeGlobalState>();
+	if (global_state.finished) {
+		return;
+	}
+	global_state.finished = true;
+
+	//! The delete files are written first, as their sizes go into the metadata
+	auto files = bind_data.files;
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto remove_delete_files = [&]() {
+		for (auto &file : files) {
+			if (!file.delete_file_path.empty()) {
+				fs.TryRemoveFile(file.delete_file_path);
+			}
+		}
+	};
+	try {
+		WriteDeleteFiles(context, global_state, files);
+	} catch (...) {
+		remove_delete_files();
+		throw;
+	}
+
+	auto statements = CreateSQLStatements(bind_data, files, global_state);
+	auto query = StringUtil::Replace(StringUtil::Join(statements, "\n"), "{METADATA_CATALOG}",
+	                                 KeywordHelper::WriteOptionallyQuoted(global_state.metadata_catalog));
+	auto result = global_state.connection->Query(query);
+	if (result->HasError()) {
+		global_state.connection->Query("ROLLBACK");
+		remove_delete_files();
+		result->ThrowError("'paimon_to_ducklake' failed to commit to the DuckLake metadata catalog: ");
+	}
+
+	int64_t delete_files = 0;
+	int64_t record_count = 0;
+	for (auto &file : files) {
+		delete_files += !file.delete_file_path.empty();
+		record_count += file.record_count - NumericCast<int64_t>(file.deleted_rows.cardinality());
+	}
+	output.SetValue(0, 0, Value::BIGINT(global_state.snapshot_id + 1));
+	output.SetValue(1, 0, Value::BIGINT(NumericCast<int64_t>(files.size())));
+	output.SetValue(2, 0, Value::BIGINT(delete_files));
+	output.SetValue(3, 0, Value::BIGINT(record_count));
+	output.SetCardinality(1);
+}
+
+TableFunctionSet PaimonFunctions::GetPaimonToDuckLakeFunction() {
+	TableFunctionSet function_set("paimon_to_ducklake");
+
+	TableFunction table_function({LogicalType::VARCHAR, LogicalType::VARCHAR}, PaimonToDuckLakeExecute,
+	                             PaimonToDuckLakeBind, PaimonToDuckLakeGlobalState::Init);
+	table_function.name = "paimon_to_ducklake";
+	//! The DuckLake schema to create the table in, defaults to 'main'
+	table_function.named_parameters["schema"] = LogicalType::VARCHAR;
+	//! The name of the DuckLake table, defaults to the name of the Paimon table
+	table_function.named_parameters["table_name"] = LogicalType::VARCHAR;
+
+	function_set.AddFunction(table_function);
+	return function_set;
+}
+
+} // namespace duckdb
@@ -28,7 +28,35 @@ ICTableEntry::ICTableEntry(IcebergTableInformation &table_info, Catalog &catalog
 }
 
 unique_ptr<BaseStatistics> ICTableEntry::GetStatistics(ClientContext &context, column_t column_id) {
-	return nullptr;
+	if (table_info.transaction_data) {
+		//! The statistics don't cover the uncommitted changes of the transaction
+		return nullptr;
+	}
+	//! Without an AT clause these are the statistics of the latest snapshot, which only describe the columns of this
+	//! entry if it is the one of the current schema
+	auto &metadata = table_info.table_metadata;
+	auto current_entry = table_info.schema_versions.find(metadata.current_schema_id);
+	if (current_entry == table_info.schema_versions.end() || current_entry->second.get() != this) {
+		return nullptr;
+	}
+	auto snapshot = metadata.GetLatestSnapshot();
+	auto iceberg_schema = metadata.GetSchemaFromId(metadata.current_schema_id);
+	if (!snapshot || column_id >= iceberg_schema->columns.size()) {
+		return nullptr;
+	}
+
+	auto &statistics_cache = *metadata.statistics_cache;
+	if (!statistics_cache.Contains(snapshot->snapshot_id, iceberg_schema->schema_id)) {
+		//! Building the statistics reads the manifests of the snapshot
+		PrepareIcebergScanFromEntry(context);
+	}
+	auto scan_info = make_shared_ptr<IcebergScanInfo>(table_info.load_table_result.metadata_location, metadata,
+	                                                  snapshot, *iceberg_schema);
+	auto statistics = statistics_cache.Get(context, std::move(scan_info));
+	if (!statistics) {
+		return nullptr;
+	}
+	return statistics->GetColumnStatistics(iceberg_schema->columns[column_id]->id);
 }
 
 void ICTableEntry::BindUpdateConstraints(Binder &binder, LogicalGet &, LogicalProjection &, LogicalUpdate &,
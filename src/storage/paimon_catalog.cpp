@@ -1,6 +1,9 @@
 #include "storage/paimon_catalog.hpp"
+#include "storage/paimon_delete.hpp"
+#include "storage/paimon_insert.hpp"
 #include "storage/paimon_schema_entry.hpp"
 #include "storage/paimon_table_entry.hpp"
+#include "storage/paimon_update.hpp"
 #include "duckdb/catalog/catalog_entry/schema_catalog_entry.hpp"
 #include "duckdb/parser/parsed_data/create_schema_info.hpp"
 #include "duckdb/parser/parsed_data/create_table_info.hpp"
@@ -73,12 +76,19 @@ optional_ptr<CatalogEntry> PaimonCatalog::CreateTable(CatalogTransaction transac
     auto table_metadata = make_uniq<PaimonTableMetadata>();
     table_metadata->table_format_version = "1";
 
-    // Create default schema based on CREATE TABLE columns
-    table_metadata->schema = make_uniq<PaimonSchema>();
-    table_metadata->schema->id = 1;
+    // A table that already exists at the location (e.g. created with paimon_create_table) keeps its schema, with
+    // its primary key, partition keys and options
+    auto &fs = FileSystem::GetFileSystem(transaction.GetContext());
+    table_metadata->schema = PaimonTableMetadata::LoadLatestSchema(table_path, fs);
+    bool existing_table = table_metadata->schema != nullptr;
+    if (!existing_table) {
+        // Create default schema based on CREATE TABLE columns
+        table_metadata->schema = make_uniq<PaimonSchema>();
+        table_metadata->schema->id = 1;
+    }
 
     // Convert DuckDB columns to Paimon schema
-    for (size_t i = 0; i < info.columns.size(); i++) {
+    for (size_t i = 0; !existing_table && i < info.columns.size(); i++) {
         const auto &col = info.columns[i];
         PaimonSchemaField field;
         field.id = i + 1;
@@ -294,18 +304,17 @@ PhysicalOperator &PaimonCatalog::PlanUpdate(ClientContext &context, PhysicalPlan
     if (!plan) {
         throw NotImplementedException("UPDATE Paimon tables requires a data source");
     }
+    if (op.return_chunk) {
+        throw NotImplementedException("UPDATE with RETURNING is not supported for Paimon tables");
+    }
 
-    // Create our PaimonUpdate physical operator
-    // For now, this is a placeholder - full implementation would require complex logic
-    // to read existing data, apply updates, and write new files
-    throw NotImplementedException("UPDATE operations on Paimon tables are not yet fully implemented");
-
-    // Full implementation would look like:
-    // auto &update = planner.Make<PaimonUpdate>(op.types, op.table, op.columns,
-    //     std::move(op.expressions), std::move(op.bound_defaults),
-    //     std::move(op.bound_constraints), op.estimated_cardinality, op.return_chunk);
-    // update.children.push_back(*plan);
-    // return update;
+    // Primary key tables are updated LSM-style: the new rows are written as UPDATE_AFTER rows of their key,
+    // PaimonTableEntry::BindUpdateConstraints only binds UPDATE for primary key tables
+    auto &update = planner.Make<PaimonUpdate>(op.types, op.table, op.columns, std::move(op.expressions),
+                                              std::move(op.bound_defaults), std::move(op.bound_constraints),
+                                              op.estimated_cardinality, op.return_chunk);
+    update.children.push_back(*plan);
+    return update;
 }
 
 PhysicalOperator &PaimonCatalog::PlanDelete(ClientContext &context, PhysicalPlanGenerator &planner, LogicalDelete &op,
@@ -315,18 +324,26 @@ PhysicalOperator &PaimonCatalog::PlanDelete(ClientContext &context, PhysicalPlan
     if (!plan) {
         throw NotImplementedException("DELETE from Paimon tables requires a data source");
     }
+    if (op.return_chunk) {
+        throw NotImplementedException("DELETE with RETURNING is not supported for Paimon tables");
+    }
+    auto &schema = op.table.Cast<PaimonTableEntry>().GetMetadata().schema;
+    if (!schema) {
+        throw NotImplementedException("DELETE requires the schema of the Paimon table");
+    }
+    if (schema->primary_keys.empty()) {
+        // Append tables delete without scanning the table: files are dropped whole by their partition or stats, and
+        // the rows of other files are marked in deletion vectors. The scan planned for the rows is not executed.
+        auto conjuncts = PaimonAppendDelete::ExtractConjuncts(*plan, op.table);
+        return planner.Make<PaimonAppendDelete>(op.types, op.table, std::move(conjuncts), op.estimated_cardinality);
+    }
 
-    // Create our PaimonDelete physical operator
-    // For now, this is a placeholder - full implementation would require complex logic
-    // to read existing data and create delete files
-    throw NotImplementedException("DELETE operations on Paimon tables are not yet fully implemented");
-
-    // Full implementation would look like:
-    // auto &delete_op = planner.Make<PaimonDelete>(op.types, op.table,
-    //     std::move(op.expressions), std::move(op.bound_constraints),
-    //     op.estimated_cardinality, op.return_chunk);
-    // delete_op.children.push_back(*plan);
-    // return delete_op;
+    // Primary key tables delete LSM-style: the keys of the deleted rows are written as DELETE rows
+    auto &delete_op = planner.Make<PaimonDelete>(op.types, op.table, std::move(op.expressions),
+                                                 std::move(op.bound_constraints), op.estimated_cardinality,
+                                                 op.return_chunk);
+    delete_op.children.push_back(*plan);
+    return delete_op;
 }
 
 unique_ptr<TransactionManager> PaimonCatalog::CreateTransactionManager() {
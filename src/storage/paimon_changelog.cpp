@@ -0,0 +1,206 @@
+#include "storage/paimon_changelog.hpp"
+#include "storage/paimon_data_file_reader.hpp"
+#include "storage/paimon_table_writer.hpp"
+
+#include "paimon_binary_row.hpp"
+
+#include "duckdb/function/create_sort_key.hpp"
+#include "duckdb/planner/filter/constant_filter.hpp"
+#include "duckdb/planner/filter/in_filter.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+static bool IsAdd(PaimonRowKind kind) {
+	return kind == PaimonRowKind::INSERT || kind == PaimonRowKind::UPDATE_AFTER;
+}
+
+PaimonChangelogLookup::PaimonChangelogLookup(ClientContext &context, PaimonWriteLayout &layout,
+                                             const vector<PaimonManifestEntry> &files_p)
+    : context(context), layout(layout), key_count(layout.bind->key_count), single_row(1) {
+	auto &types = layout.bind->types;
+	versions.Initialize(context, types, STANDARD_VECTOR_SIZE);
+	changelog.Initialize(context, types, STANDARD_VECTOR_SIZE);
+	key_chunk.InitializeEmpty(vector<LogicalType>(types.begin(), types.begin() + key_count));
+	for (auto &entry : files_p) {
+		AddFile(entry);
+	}
+}
+
+void PaimonChangelogLookup::AddFile(const PaimonManifestEntry &entry) {
+	if (entry.file.rowCount == 0) {
+		return;
+	}
+	auto key_types = key_chunk.GetTypes();
+	auto min_values = PaimonBinaryRow::Deserialize(entry.file.minKey, key_types);
+	auto max_values = PaimonBinaryRow::Deserialize(entry.file.maxKey, key_types);
+	DataChunk bounds;
+	bounds.Initialize(Allocator::DefaultAllocator(), key_types, 2);
+	for (idx_t col_idx = 0; col_idx < key_count; col_idx++) {
+		bounds.SetValue(col_idx, 0, min_values[col_idx]);
+		bounds.SetValue(col_idx, 1, max_values[col_idx]);
+	}
+	bounds.SetCardinality(2);
+	vector<string> bound_keys;
+	ComputeKeys(bounds, bound_keys);
+
+	FileCandidate candidate;
+	candidate.entry = entry;
+	candidate.min_key = std::move(bound_keys[0]);
+	candidate.max_key = std::move(bound_keys[1]);
+	files.push_back(std::move(candidate));
+}
+
+void PaimonChangelogLookup::ComputeKeys(DataChunk &chunk, vector<string> &result) {
+	auto count = chunk.size();
+	for (idx_t key_idx = 0; key_idx < key_count; key_idx++) {
+		key_chunk.data[key_idx].Reference(chunk.data[key_idx]);
+	}
+	key_chunk.SetCardinality(count);
+	Vector sort_keys(LogicalType::BLOB, count);
+	//! Must match the order of the sorted write buffer, which produced the min and max keys of the files
+	vector<OrderModifiers> modifiers(key_count, OrderModifiers(OrderType::ASCENDING, OrderByNullType::NULLS_LAST));
+	CreateSortKeyHelpers::CreateSortKey(key_chunk, modifiers, sort_keys);
+	sort_keys.Flatten(count);
+	auto data = FlatVector::GetData<string_t>(sort_keys);
+	result.resize(count);
+	for (idx_t row = 0; row < count; row++) {
+		result[row] = data[row].GetString();
+	}
+}
+
+void PaimonChangelogLookup::LoadVersions(DataChunk &run) {
+	if (versions.size() + run.size() > MAX_CACHED_VERSIONS) {
+		latest.clear();
+		versions.Reset();
+	}
+	//! The keys of the run that are not cached, sorted so the keys in the range of a file are found by bisection
+	vector<pair<string, idx_t>> missing;
+	for (idx_t row = 0; row < run.size(); row++) {
+		if (latest.find(keys[row]) == latest.end()) {
+			missing.emplace_back(keys[row], row);
+			latest[keys[row]] = DConstants::INVALID_INDEX;
+		}
+	}
+	if (missing.empty()) {
+		return;
+	}
+	std::sort(missing.begin(), missing.end());
+
+	auto &types = layout.bind->types;
+	DataChunk chunk;
+	chunk.Initialize(context, types, STANDARD_VECTOR_SIZE);
+	vector<string> file_keys;
+	for (auto &file : files) {
+		auto begin = std::lower_bound(missing.begin(), missing.end(), file.min_key,
+		                              [](const pair<string, idx_t> &key, const string &bound) { return key.first < bound; });
+		auto end = std::upper_bound(begin, missing.end(), file.max_key,
+		                            [](const string &bound, const pair<string, idx_t> &key) { return bound < key.first; });
+		if (begin == end) {
+			continue;
+		}
+		//! Like PaimonKeyLookup, the keys are pushed into the scan, so row groups that cannot contain them are skipped
+		TableFilterSet filters;
+		for (idx_t col_idx = 0; col_idx < key_count; col_idx++) {
+			vector<Value> values;
+			for (auto key = begin; key != end; key++) {
+				values.push_back(run.GetValue(col_idx, key->second));
+			}
+			std::sort(values.begin(), values.end());
+			values.erase(std::unique(values.begin(), values.end()), values.end());
+			if (values.size() == 1) {
+				filters.filters[col_idx] = make_uniq<ConstantFilter>(ExpressionType::COMPARE_EQUAL, std::move(values[0]));
+			} else {
+				filters.filters[col_idx] = make_uniq<InFilter>(std::move(values));
+			}
+		}
+		PaimonDataFileReader reader(context, *layout.bind, layout.DataFilePath(file.entry), &filters);
+		while (reader.Next(chunk)) {
+			//! Row groups that may contain a key are returned whole, so the rows are matched on their key
+			ComputeKeys(chunk, file_keys);
+			chunk.data[key_count].Flatten(chunk.size());
+			auto sequence_numbers = FlatVector::GetData<int64_t>(chunk.data[key_count]);
+			for (idx_t row = 0; row < chunk.size(); row++) {
+				auto key = std::lower_bound(begin, end, file_keys[row],
+				                            [](const pair<string, idx_t> &entry, const string &value) {
+					                            return entry.first < value;
+				                            });
+				if (key == end || key->first != file_keys[row]) {
+					continue;
+				}
+				//! Files overlap across sorted runs, the version with the highest sequence number is the latest
+				auto existing = latest[key->first];
+				if (existing != DConstants::INVALID_INDEX &&
+				    FlatVector::GetData<int64_t>(versions.data[key_count])[existing] > sequence_numbers[row]) {
+					continue;
+				}
+				Remember(chunk, row, key->first);
+			}
+		}
+	}
+}
+
+void PaimonChangelogLookup::Remember(DataChunk &chunk, idx_t row, const string &key) {
+	single_row.set_index(0, row);
+	latest[key] = versions.size();
+	versions.Append(chunk, true, &single_row, 1);
+}
+
+bool PaimonChangelogLookup::IsLive(idx_t version) const {
+	auto kinds = FlatVector::GetData<int8_t>(versions.data[key_count + 1]);
+	return IsAdd(static_cast<PaimonRowKind>(kinds[version]));
+}
+
+void PaimonChangelogLookup::Emit(DataChunk &source, idx_t row, PaimonRowKind kind,
+                                 const std::function<void(DataChunk &chunk)> &callback) {
+	if (changelog.size() == STANDARD_VECTOR_SIZE) {
+		callback(changelog);
+		changelog.Reset();
+	}
+	auto position = changelog.size();
+	single_row.set_index(0, row);
+	changelog.Append(source, false, &single_row, 1);
+	FlatVector::GetData<int8_t>(changelog.data[key_count + 1])[position] = static_cast<int8_t>(kind);
+}
+
+void PaimonChangelogLookup::Produce(DataChunk &run, const std::function<void(DataChunk &chunk)> &callback) {
+	auto count = run.size();
+	ComputeKeys(run, keys);
+	LoadVersions(run);
+	UnifiedVectorFormat kind_format;
+	run.data[key_count + 1].ToUnifiedFormat(count, kind_format);
+	auto kinds = UnifiedVectorFormat::GetData<int8_t>(kind_format);
+
+	changelog.Reset();
+	for (idx_t row = 0; row < count; row++) {
+		auto kind = static_cast<PaimonRowKind>(kinds[kind_format.sel->get_index(row)]);
+		auto existing = latest.find(keys[row]);
+		bool exists = existing->second != DConstants::INVALID_INDEX && IsLive(existing->second);
+		if (layout.merge_engine == PaimonMergeEngine::FIRST_ROW) {
+			//! Later rows of an existing key are ignored by the merge engine, so they are not part of the changelog
+			if (!exists && IsAdd(kind)) {
+				Emit(run, row, PaimonRowKind::INSERT, callback);
+				Remember(run, row, keys[row]);
+			}
+			continue;
+		}
+		if (IsAdd(kind)) {
+			if (exists) {
+				Emit(versions, existing->second, PaimonRowKind::UPDATE_BEFORE, callback);
+				Emit(run, row, PaimonRowKind::UPDATE_AFTER, callback);
+			} else {
+				Emit(run, row, PaimonRowKind::INSERT, callback);
+			}
+		} else if (exists) {
+			Emit(versions, existing->second, PaimonRowKind::DELETE, callback);
+		}
+		Remember(run, row, keys[row]);
+	}
+	if (changelog.size() > 0) {
+		callback(changelog);
+		changelog.Reset();
+	}
+}
+
+} // namespace duckdb
@@ -0,0 +1,459 @@
+#include "storage/paimon_commit.hpp"
+#include "storage/paimon_deletion_vectors.hpp"
+#include "storage/paimon_table_writer.hpp"
+#include "paimon_manifest.hpp"
+#include "paimon_snapshot.hpp"
+#include "catalog_utils.hpp"
+
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/random_engine.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/unordered_set.hpp"
+#include "duckdb/common/types/uuid.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "yyjson.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#ifdef _WIN32
+#include "duckdb/common/windows.hpp"
+#include "duckdb/common/windows_util.hpp"
+#else
+#include <unistd.h>
+#endif
+
+namespace duckdb {
+
+static const char *CommitKindToString(PaimonCommitKind kind) {
+	switch (kind) {
+	case PaimonCommitKind::APPEND:
+		return "APPEND";
+	case PaimonCommitKind::COMPACT:
+		return "COMPACT";
+	case PaimonCommitKind::OVERWRITE:
+		return "OVERWRITE";
+	case PaimonCommitKind::ANALYZE:
+		return "ANALYZE";
+	default:
+		throw InternalException("Unrecognized PaimonCommitKind");
+	}
+}
+
+static void AddNullableString(yyjson_mut_doc *doc, yyjson_mut_val *obj, const char *key, const string &value) {
+	if (value.empty()) {
+		yyjson_mut_obj_add_null(doc, obj, key);
+	} else {
+		yyjson_mut_obj_add_strcpy(doc, obj, key, value.c_str());
+	}
+}
+
+static string FileName(const string &path) {
+	return path.substr(path.find_last_of('/') + 1);
+}
+
+PaimonCommit::PaimonCommit(ClientContext &context, PaimonWriteLayout &layout)
+    : context(context), fs(FileSystem::GetFileSystem(context)), layout(layout) {
+}
+
+vector<PaimonManifestFileMeta> PaimonCommit::BuildBaseManifests(const PaimonSnapshotInfo &latest,
+                                                                const vector<PaimonManifestEntry> &entries,
+                                                                const vector<PaimonIndexManifestEntry> &index_changes,
+                                                                vector<string> &new_files) {
+	vector<PaimonManifestFileMeta> result;
+	if (latest.id > 0) {
+		result = paimon_snapshot::ReadManifests(context, layout.table_path, latest);
+	}
+
+	bool has_deletes = false;
+	for (auto &entry : entries) {
+		has_deletes = has_deletes || entry.kind == PaimonFileKind::DELETE;
+	}
+	//! The data files that deletion vectors added by this commit refer to
+	unordered_set<string> vector_files;
+	for (auto &change : index_changes) {
+		if (change.kind != PaimonFileKind::ADD) {
+			continue;
+		}
+		for (auto &range : change.deletionVectorRanges) {
+			vector_files.insert(range.dataFileName);
+		}
+	}
+	//! Manifests holding DELETE entries only keep files alive for old snapshots, rewrite them all once they add up
+	idx_t delete_manifest_size = 0;
+	//! Like Paimon's minor compaction, only the manifests smaller than the target size count toward a merge
+	idx_t small_manifest_count = 0;
+	for (auto &manifest : result) {
+		if (manifest.numDeletedFiles > 0) {
+			delete_manifest_size += NumericCast<idx_t>(manifest.fileSize);
+		}
+		if (NumericCast<idx_t>(manifest.fileSize) < layout.manifest_target_file_size) {
+			small_manifest_count++;
+		}
+	}
+	auto merge_min_count = layout.GetIntegerOption("manifest.merge-min-count", DEFAULT_MANIFEST_MERGE_MIN_COUNT);
+	auto full_compaction_size = layout.GetMemorySizeOption("manifest.full-compaction-threshold-size",
+	                                                       DEFAULT_MANIFEST_FULL_COMPACTION_SIZE);
+	bool full_compaction = delete_manifest_size >= full_compaction_size;
+	bool minor_compaction = !full_compaction && small_manifest_count >= merge_min_count;
+	if (!has_deletes && vector_files.empty() && !full_compaction) {
+		return minor_compaction ? MergeSmallManifests(result, new_files) : result;
+	}
+
+	auto all_entries = paimon_snapshot::ReadEntries(context, layout.table_path, result);
+	auto live_entries = paimon_snapshot::MergeEntries(all_entries);
+
+	if (has_deletes) {
+		//! Files removed by this commit must still be live after rebasing, otherwise a concurrent commit removed
+		//! them first (e.g. a compaction), and this commit is based on stale data
+		unordered_set<string> live_files;
+		for (auto &entry : live_entries) {
+			live_files.insert(paimon_snapshot::EntryIdentifier(entry));
+		}
+		for (auto &entry : entries) {
+			if (entry.kind != PaimonFileKind::DELETE) {
+				continue;
+			}
+			if (live_files.find(paimon_snapshot::EntryIdentifier(entry)) == live_files.end()) {
+				throw TransactionException("Conflict committing to Paimon table \"%s\": data file \"%s\" was removed "
+				                           "by a concurrent commit",
+				                           layout.table_path, entry.file.fileName);
+			}
+		}
+	}
+	if (!vector_files.empty()) {
+		//! Rows can only be deleted from files that are still live, a concurrent compaction may have rewritten them
+		for (auto &entry : live_entries) {
+			vector_files.erase(entry.file.fileName);
+		}
+		for (auto &entry : entries) {
+			if (entry.kind == PaimonFileKind::ADD) {
+				vector_files.erase(entry.file.fileName);
+			}
+		}
+		if (!vector_files.empty()) {
+			throw TransactionException("Conflict committing to Paimon table \"%s\": data file \"%s\" was removed "
+			                           "by a concurrent commit",
+			                           layout.table_path, *vector_files.begin());
+		}
+	}
+	if (minor_compaction) {
+		return MergeSmallManifests(result, new_files);
+	}
+	if (!full_compaction) {
+		return result;
+	}
+
+	auto merged = paimon_manifest_file::WriteToFiles(context, layout.path_factory, live_entries,
+	                                                 layout.partition_types, layout.schema_id,
+	                                                 layout.manifest_target_file_size);
+	for (auto &manifest : merged) {
+		new_files.push_back(paimon_snapshot::ManifestPath(layout.table_path, manifest.fileName));
+	}
+	return merged;
+}
+
+vector<PaimonManifestFileMeta> PaimonCommit::MergeSmallManifests(const vector<PaimonManifestFileMeta> &manifests,
+                                                                 vector<string> &new_files) {
+	vector<PaimonManifestFileMeta> result;
+	//! Consecutive small manifests are merged in place, so every DELETE entry still follows the entry it removes
+	idx_t run_start = 0;
+	auto merge_run = [&](idx_t run_end) {
+		if (run_end - run_start < 2) {
+			for (idx_t i = run_start; i < run_end; i++) {
+				result.push_back(manifests[i]);
+			}
+			return;
+		}
+		vector<PaimonManifestFileMeta> run(manifests.begin() + NumericCast<int64_t>(run_start),
+		                                   manifests.begin() + NumericCast<int64_t>(run_end));
+		auto run_entries = paimon_snapshot::ReadEntries(context, layout.table_path, run);
+		//! DELETE entries of files added before the run must be kept, they still apply to the older manifests
+		unordered_map<string, idx_t> added;
+		vector<bool> keep(run_entries.size(), true);
+		for (idx_t i = 0; i < run_entries.size(); i++) {
+			auto identifier = paimon_snapshot::EntryIdentifier(run_entries[i]);
+			if (run_entries[i].kind == PaimonFileKind::ADD) {
+				added[identifier] = i;
+				continue;
+			}
+			auto entry = added.find(identifier);
+			if (entry != added.end()) {
+				keep[entry->second] = false;
+				keep[i] = false;
+				added.erase(entry);
+			}
+		}
+		vector<PaimonManifestEntry> merged_entries;
+		for (idx_t i = 0; i < run_entries.size(); i++) {
+			if (keep[i]) {
+				merged_entries.push_back(std::move(run_entries[i]));
+			}
+		}
+		if (!merged_entries.empty()) {
+			auto merged = paimon_manifest_file::WriteToFiles(context, layout.path_factory, merged_entries,
+			                                                 layout.partition_types, layout.schema_id,
+			                                                 layout.manifest_target_file_size);
+			for (auto &manifest : merged) {
+				new_files.push_back(paimon_snapshot::ManifestPath(layout.table_path, manifest.fileName));
+				result.push_back(std::move(manifest));
+			}
+		}
+	};
+	for (idx_t i = 0; i < manifests.size(); i++) {
+		if (NumericCast<idx_t>(manifests[i].fileSize) < layout.manifest_target_file_size) {
+			continue;
+		}
+		merge_run(i);
+		result.push_back(manifests[i]);
+		run_start = i + 1;
+	}
+	merge_run(manifests.size());
+	return result;
+}
+
+string PaimonCommit::BuildIndexManifest(const PaimonSnapshotInfo &latest,
+                                       const vector<PaimonIndexManifestEntry> &index_changes, const string &uuid,
+                                       idx_t attempt, vector<string> &new_files) {
+	if (index_changes.empty()) {
+		//! Index files are not touched by this commit, so they carry over
+		return latest.index_manifest;
+	}
+	//! Like the base manifest list, the index manifest lists all live index files
+	auto index_files = PaimonDeletionVectors::ReadIndexFiles(context, layout.table_path, latest);
+	if (!PaimonDeletionVectors::MergeIndexFiles(index_files, index_changes)) {
+		throw TransactionException("Conflict committing to Paimon table \"%s\": an index file was replaced by a "
+		                           "concurrent commit",
+		                           layout.table_path);
+	}
+	if (index_files.empty()) {
+		return string();
+	}
+	auto path = layout.path_factory.indexManifestFilePath(uuid, NumericCast<int>(attempt));
+	new_files.push_back(path);
+	paimon_index_manifest::WriteToFile(context, path, index_files);
+	return FileName(path);
+}
+
+//! Rename 'source' to 'target' unless 'target' exists, returns false if it does
+static bool MoveFileNoReplace(FileSystem &fs, const string &source, const string &target) {
+	if (FileSystem::IsRemoteFile(target)) {
+		//! Object stores have no rename that fails on an existing target. The upload of the copy is atomic, so the
+		//! snapshot is never observed partially written, but two writers racing past the existence check can still
+		//! both publish: like Paimon, concurrent writers on object stores need an external lock.
+		if (fs.FileExists(target)) {
+			return false;
+		}
+		fs.MoveFile(source, target);
+		return true;
+	}
+	auto local_source = StringUtil::StartsWith(source, "file://") ? source.substr(7) : source;
+	auto local_target = StringUtil::StartsWith(target, "file://") ? target.substr(7) : target;
+#ifdef _WIN32
+	auto unicode_source = WindowsUtil::UTF8ToUnicode(local_source.c_str());
+	auto unicode_target = WindowsUtil::UTF8ToUnicode(local_target.c_str());
+	//! Without MOVEFILE_REPLACE_EXISTING the rename fails if the target exists
+	if (MoveFileExW(unicode_source.c_str(), unicode_target.c_str(), MOVEFILE_WRITE_THROUGH)) {
+		return true;
+	}
+	auto error = GetLastError();
+	if (error == ERROR_ALREADY_EXISTS || error == ERROR_FILE_EXISTS) {
+		return false;
+	}
+	throw IOException("Could not move file \"%s\" to \"%s\": error code %llu", source, target, idx_t(error));
+#else
+	//! A hard link fails if the target exists, and makes the complete file visible at once
+	if (link(local_source.c_str(), local_target.c_str()) != 0) {
+		if (errno == EEXIST) {
+			return false;
+		}
+		throw IOException("Could not link file \"%s\" to \"%s\": %s", source, target, strerror(errno));
+	}
+	fs.TryRemoveFile(source);
+	return true;
+#endif
+}
+
+bool PaimonCommit::TryCreateSnapshot(int64_t snapshot_id, const string &content) {
+	auto path = layout.path_factory.snapshotFilePath(snapshot_id);
+	if (fs.FileExists(path)) {
+		return false;
+	}
+	//! Like Paimon, the snapshot is written to a temporary file and published with a rename that fails if the
+	//! snapshot exists: exactly one writer creates each snapshot, and readers never see it partially written
+	auto snapshot_dir = layout.table_path + "/snapshot";
+	auto temp_path = snapshot_dir + "/." + FileName(path) + "." + UUID::ToString(UUID::GenerateRandomUUID()) + ".tmp";
+	try {
+		auto handle = fs.OpenFile(temp_path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+		handle->Write(const_cast<char *>(content.data()), content.size());
+		handle->Sync();
+		handle->Close();
+		if (MoveFileNoReplace(fs, temp_path, path)) {
+			return true;
+		}
+	} catch (std::exception &) {
+		fs.TryRemoveFile(temp_path);
+		throw;
+	}
+	fs.TryRemoveFile(temp_path);
+	return false;
+}
+
+void PaimonCommit::WriteHint(FileSystem &fs, const string &path, int64_t snapshot_id) {
+	//! Hints are replaced with a rename, so readers never observe a partially written file
+	auto temp_path = path + "." + UUID::ToString(UUID::GenerateRandomUUID()) + ".tmp";
+	auto content = std::to_string(snapshot_id);
+	{
+		auto handle = fs.OpenFile(temp_path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+		handle->Write(const_cast<char *>(content.data()), content.size());
+		handle->Close();
+	}
+	fs.MoveFile(temp_path, path);
+}
+
+void PaimonCommit::UpdateHints(int64_t snapshot_id) {
+	auto &path_factory = layout.path_factory;
+	try {
+		if (!fs.FileExists(path_factory.earliestPointerPath())) {
+			WriteHint(fs, path_factory.earliestPointerPath(), snapshot_id);
+		}
+		//! A slower concurrent committer can overwrite the hint with an older id, readers probe forward from it
+		WriteHint(fs, path_factory.latestPointerPath(), snapshot_id);
+	} catch (std::exception &) {
+		//! The snapshot is committed, the hints are only an optimization
+	}
+}
+
+void PaimonCommit::DeleteFiles(const vector<string> &paths) {
+	for (auto &path : paths) {
+		fs.TryRemoveFile(path);
+	}
+}
+
+idx_t PaimonCommit::WriteManifestList(const vector<PaimonManifestEntry> &entries, const string &path,
+                                      vector<string> &written_files) {
+	auto manifests = paimon_manifest_file::WriteToFiles(context, layout.path_factory, entries, layout.partition_types,
+	                                                    layout.schema_id, layout.manifest_target_file_size);
+	for (auto &manifest : manifests) {
+		written_files.push_back(paimon_snapshot::ManifestPath(layout.table_path, manifest.fileName));
+	}
+	written_files.push_back(path);
+	return paimon_manifest_list::WriteToFile(context, path, manifests);
+}
+
+int64_t PaimonCommit::Commit(const vector<PaimonManifestEntry> &entries, PaimonCommitKind kind,
+                             const vector<PaimonManifestEntry> &changelog,
+                             const vector<PaimonIndexManifestEntry> &index_changes) {
+	for (auto &dir : {layout.table_path + "/snapshot", layout.table_path + "/manifest"}) {
+		if (!fs.DirectoryExists(dir)) {
+			fs.CreateDirectory(dir);
+		}
+	}
+
+	int64_t delta_record_count = 0;
+	for (auto &entry : entries) {
+		if (entry.kind == PaimonFileKind::ADD) {
+			delta_record_count += entry.file.rowCount;
+		} else {
+			delta_record_count -= entry.file.rowCount;
+		}
+	}
+
+	int64_t changelog_record_count = 0;
+	for (auto &entry : changelog) {
+		changelog_record_count += entry.file.rowCount;
+	}
+
+	//! The delta and changelog of this commit do not depend on the latest snapshot, so they are written only once
+	auto uuid = UUID::ToString(UUID::GenerateRandomUUID());
+	vector<string> delta_files;
+	auto delta_list_path = layout.path_factory.manifestListFilePath(uuid, 0);
+	auto delta_list_size = WriteManifestList(entries, delta_list_path, delta_files);
+	string changelog_list_path;
+	idx_t changelog_list_size = 0;
+	if (!changelog.empty()) {
+		changelog_list_path = layout.path_factory.manifestListFilePath(UUID::ToString(UUID::GenerateRandomUUID()), 0);
+		changelog_list_size = WriteManifestList(changelog, changelog_list_path, delta_files);
+	}
+
+	auto max_retries = layout.GetIntegerOption("commit.max-retries", DEFAULT_COMMIT_MAX_RETRIES);
+	RandomEngine random;
+	for (idx_t attempt = 0;; attempt++) {
+		auto latest_id = PaimonTableMetadata::FindLatestSnapshotId(layout.table_path, fs);
+		PaimonSnapshotInfo latest;
+		if (latest_id > 0) {
+			latest = paimon_snapshot::Read(context, layout.table_path, latest_id);
+		}
+		auto snapshot_id = latest_id + 1;
+
+		vector<string> new_files;
+		try {
+			auto base_manifests = BuildBaseManifests(latest, entries, index_changes, new_files);
+			auto base_list_path = layout.path_factory.manifestListFilePath(uuid, NumericCast<int>(attempt + 1));
+			new_files.push_back(base_list_path);
+			auto base_list_size = paimon_manifest_list::WriteToFile(context, base_list_path, base_manifests);
+			auto index_manifest = BuildIndexManifest(latest, index_changes, uuid, attempt, new_files);
+
+			std::unique_ptr<yyjson_mut_doc, YyjsonDocDeleter> doc_p(yyjson_mut_doc_new(nullptr));
+			auto doc = doc_p.get();
+			auto root = yyjson_mut_obj(doc);
+			yyjson_mut_doc_set_root(doc, root);
+			yyjson_mut_obj_add_int(doc, root, "version", 3);
+			yyjson_mut_obj_add_sint(doc, root, "id", snapshot_id);
+			yyjson_mut_obj_add_sint(doc, root, "schemaId", layout.schema_id);
+			yyjson_mut_obj_add_strcpy(doc, root, "baseManifestList", FileName(base_list_path).c_str());
+			yyjson_mut_obj_add_uint(doc, root, "baseManifestListSize", base_list_size);
+			yyjson_mut_obj_add_strcpy(doc, root, "deltaManifestList", FileName(delta_list_path).c_str());
+			yyjson_mut_obj_add_uint(doc, root, "deltaManifestListSize", delta_list_size);
+			if (changelog_list_path.empty()) {
+				yyjson_mut_obj_add_null(doc, root, "changelogManifestList");
+			} else {
+				yyjson_mut_obj_add_strcpy(doc, root, "changelogManifestList", FileName(changelog_list_path).c_str());
+				yyjson_mut_obj_add_uint(doc, root, "changelogManifestListSize", changelog_list_size);
+			}
+			AddNullableString(doc, root, "indexManifest", index_manifest);
+			yyjson_mut_obj_add_strcpy(doc, root, "commitUser", COMMIT_USER);
+			yyjson_mut_obj_add_sint(doc, root, "commitIdentifier", NumericLimits<int64_t>::Maximum());
+			yyjson_mut_obj_add_strcpy(doc, root, "commitKind", CommitKindToString(kind));
+			yyjson_mut_obj_add_sint(doc, root, "timeMillis", Timestamp::GetEpochMs(Timestamp::GetCurrentTimestamp()));
+			yyjson_mut_obj_add_obj(doc, root, "logOffsets");
+			yyjson_mut_obj_add_sint(doc, root, "totalRecordCount", latest.total_record_count + delta_record_count);
+			yyjson_mut_obj_add_sint(doc, root, "deltaRecordCount", delta_record_count);
+			yyjson_mut_obj_add_sint(doc, root, "changelogRecordCount", changelog_record_count);
+
+			auto json = yyjson_mut_write(doc, YYJSON_WRITE_PRETTY, nullptr);
+			if (!json) {
+				throw InternalException("Failed to serialize the Paimon snapshot to JSON");
+			}
+			string content(json);
+			free(json);
+
+			if (TryCreateSnapshot(snapshot_id, content)) {
+				UpdateHints(snapshot_id);
+				return snapshot_id;
+			}
+		} catch (std::exception &) {
+			DeleteFiles(new_files);
+			DeleteFiles(delta_files);
+			throw;
+		}
+
+		//! Another writer created the snapshot first: drop the base built on top of the old latest snapshot
+		DeleteFiles(new_files);
+		if (attempt >= max_retries) {
+			DeleteFiles(delta_files);
+			throw TransactionException("Failed to commit to Paimon table \"%s\": gave up after %llu conflicting "
+			                           "concurrent commits",
+			                           layout.table_path, attempt + 1);
+		}
+		//! Back off with jitter, so writers that conflicted do not collide again
+		auto backoff_ms = MinValue<idx_t>(idx_t(10) << MinValue<idx_t>(attempt, 6), 1000);
+		backoff_ms += random.NextRandomInteger(0, NumericCast<uint32_t>(backoff_ms));
+		std::this_thread::sleep_for(std::chrono::milliseconds(backoff_ms));
+	}
+}
+
+} // namespace duckdb
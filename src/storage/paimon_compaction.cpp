@@ -0,0 +1,784 @@
+#include "storage/paimon_compaction.hpp"
+#include "storage/paimon_commit.hpp"
+#include "storage/paimon_data_file_reader.hpp"
+#include "storage/paimon_deletion_vectors.hpp"
+#include "storage/paimon_merge_reader.hpp"
+#include "storage/paimon_table_writer.hpp"
+#include "paimon_binary_row.hpp"
+#include "paimon_snapshot.hpp"
+
+#include "duckdb/common/error_data.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/map.hpp"
+#include "duckdb/common/operator/comparison_operators.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/string_heap.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/unordered_set.hpp"
+#include "duckdb/function/create_sort_key.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/parallel/task_executor.hpp"
+#include "duckdb/parallel/thread_context.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// Universal Compaction
+//===--------------------------------------------------------------------===//
+idx_t PaimonSortedRun::TotalSize() const {
+	idx_t result = 0;
+	for (auto &entry : files) {
+		result += NumericCast<idx_t>(entry.file.fileSize);
+	}
+	return result;
+}
+
+PaimonUniversalCompaction::PaimonUniversalCompaction(idx_t max_size_amplification_percent, idx_t size_ratio,
+                                                     idx_t num_run_compaction_trigger)
+    : max_size_amplification_percent(max_size_amplification_percent), size_ratio(size_ratio),
+      num_run_compaction_trigger(num_run_compaction_trigger) {
+}
+
+void PaimonUniversalCompaction::CreateUnit(int max_level, const vector<PaimonSortedRun> &runs, idx_t run_count,
+                                           PaimonCompactUnit &result) {
+	int output_level;
+	if (run_count == runs.size()) {
+		output_level = max_level;
+	} else {
+		//! Write just below the first run that is not picked, so the runs stay ordered by age
+		output_level = MaxValue(0, runs[run_count].level - 1);
+	}
+	if (output_level == 0) {
+		//! Level 0 only holds freshly written files, extend the unit up to the next run of a higher level
+		while (run_count < runs.size()) {
+			auto &next = runs[run_count++];
+			if (next.level != 0) {
+				output_level = next.level;
+				break;
+			}
+		}
+	}
+	if (run_count == runs.size()) {
+		output_level = max_level;
+	}
+
+	result.output_level = output_level;
+	result.files.clear();
+	for (idx_t i = 0; i < run_count; i++) {
+		for (auto &entry : runs[i].files) {
+			result.files.push_back(entry);
+		}
+	}
+}
+
+bool PaimonUniversalCompaction::PickForSizeAmplification(int max_level, const vector<PaimonSortedRun> &runs,
+                                                         PaimonCompactUnit &result) const {
+	if (runs.size() < num_run_compaction_trigger) {
+		return false;
+	}
+	idx_t candidate_size = 0;
+	for (idx_t i = 0; i + 1 < runs.size(); i++) {
+		candidate_size += runs[i].TotalSize();
+	}
+	auto earliest_run_size = runs.back().TotalSize();
+	//! Everything newer than the oldest run is what a reader merges on top of it, rewrite all of it once that is
+	//! larger than the allowed amplification
+	if (candidate_size * 100 > max_size_amplification_percent * earliest_run_size) {
+		CreateUnit(max_level, runs, runs.size(), result);
+		return true;
+	}
+	return false;
+}
+
+bool PaimonUniversalCompaction::PickForSizeRatio(int max_level, const vector<PaimonSortedRun> &runs,
+                                                 idx_t candidate_count, bool force_pick,
+                                                 PaimonCompactUnit &result) const {
+	idx_t candidate_size = 0;
+	for (idx_t i = 0; i < candidate_count; i++) {
+		candidate_size += runs[i].TotalSize();
+	}
+	for (idx_t i = candidate_count; i < runs.size(); i++) {
+		auto next_size = runs[i].TotalSize();
+		if (candidate_size * (100 + size_ratio) / 100 < next_size) {
+			break;
+		}
+		candidate_size += next_size;
+		candidate_count++;
+	}
+	if (force_pick || candidate_count > 1) {
+		CreateUnit(max_level, runs, candidate_count, result);
+		return true;
+	}
+	return false;
+}
+
+bool PaimonUniversalCompaction::Pick(int num_levels, const vector<PaimonSortedRun> &runs,
+                                     PaimonCompactUnit &result) const {
+	auto max_level = num_levels - 1;
+	if (PickForSizeAmplification(max_level, runs, result)) {
+		return true;
+	}
+	if (runs.size() >= num_run_compaction_trigger && PickForSizeRatio(max_level, runs, 1, false, result)) {
+		return true;
+	}
+	if (runs.size() > num_run_compaction_trigger) {
+		//! Too many runs: merge the newest ones until the count is back at the trigger
+		auto candidate_count = runs.size() - num_run_compaction_trigger + 1;
+		return PickForSizeRatio(max_level, runs, candidate_count, true, result);
+	}
+	return false;
+}
+
+bool PaimonUniversalCompaction::PickFull(int num_levels, const vector<PaimonSortedRun> &runs,
+                                         PaimonCompactUnit &result) const {
+	auto max_level = num_levels - 1;
+	if (runs.empty() || (runs.size() == 1 && runs[0].level == max_level)) {
+		return false;
+	}
+	CreateUnit(max_level, runs, runs.size(), result);
+	return true;
+}
+
+//! The sorted runs of the files of a bucket, from newest to oldest: every level-0 file is a run of its own, every
+//! higher level is a single run
+static vector<PaimonSortedRun> BuildSortedRuns(vector<PaimonManifestEntry> &files) {
+	vector<PaimonSortedRun> result;
+	vector<PaimonManifestEntry> level0;
+	map<int, vector<PaimonManifestEntry>> levels;
+	for (auto &entry : files) {
+		if (entry.file.level == 0) {
+			level0.push_back(std::move(entry));
+		} else {
+			levels[entry.file.level].push_back(std::move(entry));
+		}
+	}
+	std::sort(level0.begin(), level0.end(), [](const PaimonManifestEntry &a, const PaimonManifestEntry &b) {
+		return a.file.maxSequenceNumber > b.file.maxSequenceNumber;
+	});
+	for (auto &entry : level0) {
+		PaimonSortedRun run;
+		run.level = 0;
+		run.files.push_back(std::move(entry));
+		result.push_back(std::move(run));
+	}
+	for (auto &level : levels) {
+		PaimonSortedRun run;
+		run.level = level.first;
+		run.files = std::move(level.second);
+		result.push_back(std::move(run));
+	}
+	return result;
+}
+
+//===--------------------------------------------------------------------===//
+// Merge
+//===--------------------------------------------------------------------===//
+namespace {
+
+//! Merges the sorted runs of a compaction unit, and writes the merged rows to files of the output level
+class UnitMerger {
+public:
+	UnitMerger(ClientContext &context, PaimonWriteLayout &layout, const PaimonCompactUnit &unit,
+	           vector<PaimonManifestEntry> &entries, vector<string> &written_files)
+	    : context(context), thread_context(context), execution_context(context, thread_context, nullptr),
+	      layout(layout), unit(unit), entries(entries), written_files(written_files) {
+		auto &first = unit.files[0];
+		partition_path = layout.PartitionPath(first.partition);
+		output.Initialize(context, layout.bind->types, STANDARD_VECTOR_SIZE);
+	}
+
+	void Merge() {
+		PaimonMergeReader reader(context, layout, unit.files, unit.drop_delete);
+		while (reader.Next(output)) {
+			WriteOutput();
+		}
+		CloseFile();
+	}
+
+private:
+	void WriteOutput() {
+		if (output.size() == 0) {
+			return;
+		}
+		if (!writer) {
+			auto path = layout.NewDataFilePath(context, partition_path, unit.files[0].bucket);
+			written_files.push_back(path);
+			writer = make_uniq<PaimonDataFileWriter>(execution_context, *layout.bind, std::move(path));
+		}
+		writer->Append(execution_context, output);
+		output.Reset();
+		//! Keys are written in order and at most once, so the files of the output run do not overlap
+		if (writer->FileSize() >= layout.target_file_size) {
+			CloseFile();
+		}
+	}
+
+	void CloseFile() {
+		if (!writer) {
+			return;
+		}
+		auto &first = unit.files[0];
+		PaimonManifestEntry entry;
+		entry.kind = PaimonFileKind::ADD;
+		entry.partition = first.partition;
+		entry.bucket = first.bucket;
+		entry.totalBuckets = first.totalBuckets;
+		entry.file = writer->Finalize(execution_context);
+		entry.file.schemaId = layout.schema_id;
+		entry.file.level = unit.output_level;
+		entry.file.fileSource = FileSource::COMPACT;
+		writer.reset();
+		entries.push_back(std::move(entry));
+	}
+
+private:
+	ClientContext &context;
+	ThreadContext thread_context;
+	ExecutionContext execution_context;
+	PaimonWriteLayout &layout;
+	const PaimonCompactUnit &unit;
+	vector<PaimonManifestEntry> &entries;
+	vector<string> &written_files;
+	vector<pair<string, string>> partition_path;
+
+	DataChunk output;
+	unique_ptr<PaimonDataFileWriter> writer;
+};
+
+//! Bin-packed files of an append table, rewritten in sequence number order, or clustered by the order columns.
+//! Rows removed by the deletion vectors of the files are dropped.
+class AppendUnitRewriter {
+public:
+	AppendUnitRewriter(ClientContext &context, PaimonWriteLayout &layout, const PaimonCompactUnit &unit,
+	                   const vector<idx_t> &order_columns, bool zorder,
+	                   optional_ptr<const PaimonDeletionVectors> deletion_vectors, vector<PaimonManifestEntry> &entries,
+	                   vector<string> &written_files)
+	    : context(context), thread_context(context), execution_context(context, thread_context, nullptr),
+	      layout(layout), unit(unit), order_columns(order_columns), zorder(zorder), deletion_vectors(deletion_vectors),
+	      entries(entries), written_files(written_files) {
+		partition_path = layout.PartitionPath(unit.files[0].partition);
+		min_sequence_number = NumericLimits<int64_t>::Maximum();
+		max_sequence_number = NumericLimits<int64_t>::Minimum();
+		for (auto &entry : unit.files) {
+			min_sequence_number = MinValue(min_sequence_number, entry.file.minSequenceNumber);
+			max_sequence_number = MaxValue(max_sequence_number, entry.file.maxSequenceNumber);
+		}
+	}
+
+	void Rewrite() {
+		auto &types = layout.bind->types;
+		DataChunk chunk;
+		chunk.Initialize(context, types, STANDARD_VECTOR_SIZE);
+		if (order_columns.empty()) {
+			//! The files of a unit are ordered by sequence number, so the rows keep their insertion order
+			for (auto &entry : unit.files) {
+				ReadFile(entry, chunk, [&](DataChunk &live_rows) { Write(live_rows); });
+			}
+			CloseFile();
+			return;
+		}
+
+		DataChunk rows;
+		rows.Initialize(context, types, STANDARD_VECTOR_SIZE);
+		for (auto &entry : unit.files) {
+			ReadFile(entry, chunk, [&](DataChunk &live_rows) { rows.Append(live_rows, true); });
+		}
+		auto order = SortRows(rows);
+		DataChunk output;
+		output.InitializeEmpty(types);
+		for (idx_t offset = 0; offset < order.size(); offset += STANDARD_VECTOR_SIZE) {
+			auto batch_count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, order.size() - offset);
+			SelectionVector sel(order.data() + offset);
+			output.Slice(rows, sel, batch_count);
+			Write(output);
+		}
+		CloseFile();
+	}
+
+private:
+	//! Read the rows of 'entry' that are not deleted, calling 'callback' for every chunk of them
+	void ReadFile(const PaimonManifestEntry &entry, DataChunk &chunk, const std::function<void(DataChunk &)> &callback) {
+		roaring::Roaring deleted;
+		auto has_deleted = deletion_vectors && deletion_vectors->Read(entry.file.fileName, deleted);
+		PaimonDataFileReader reader(context, *layout.bind, layout.DataFilePath(entry), nullptr,
+		                            has_deleted ? &deleted : nullptr);
+		while (reader.Next(chunk)) {
+			callback(chunk);
+		}
+	}
+
+	//! The order of 'rows' by the order columns, or by their z-order curve
+	vector<sel_t> SortRows(DataChunk &rows) {
+		auto count = rows.size();
+		//! The keys are kept in a single heap rather than as one allocation per row
+		StringHeap key_data;
+		vector<string_t> keys(count);
+		for (idx_t offset = 0; offset < count; offset += STANDARD_VECTOR_SIZE) {
+			auto batch_count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, count - offset);
+			if (zorder) {
+				ZOrderKeys(rows, offset, batch_count, key_data, keys);
+			} else {
+				SortKeys(rows, order_columns, offset, batch_count, [&](idx_t row, const string_t &key) {
+					keys[offset + row] = key_data.AddBlob(key);
+				});
+			}
+		}
+		vector<sel_t> order(count);
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&](sel_t a, sel_t b) { return LessThan::Operation(keys[a], keys[b]); });
+		return order;
+	}
+
+	//! Compute the normalized sort keys of 'columns' for rows [offset, offset + count)
+	void SortKeys(DataChunk &rows, const vector<idx_t> &columns, idx_t offset, idx_t count,
+	              const std::function<void(idx_t row, const string_t &key)> &callback) {
+		vector<LogicalType> key_types;
+		for (auto col_idx : columns) {
+			key_types.push_back(rows.data[col_idx].GetType());
+		}
+		DataChunk key_chunk;
+		key_chunk.InitializeEmpty(key_types);
+		for (idx_t i = 0; i < columns.size(); i++) {
+			key_chunk.data[i].Slice(rows.data[columns[i]], offset, offset + count);
+		}
+		key_chunk.SetCardinality(count);
+		Vector sort_keys(LogicalType::BLOB, count);
+		auto modifiers = PaimonMergeReader::KeyOrderModifiers(columns.size());
+		CreateSortKeyHelpers::CreateSortKey(key_chunk, modifiers, sort_keys);
+		sort_keys.Flatten(count);
+		auto data = FlatVector::GetData<string_t>(sort_keys);
+		for (idx_t row = 0; row < count; row++) {
+			callback(row, data[row]);
+		}
+	}
+
+	//! Interleave the bits of the leading bytes of the sort key of every order column, so rows that are close in all
+	//! columns end up close to each other
+	void ZOrderKeys(DataChunk &rows, idx_t offset, idx_t count, StringHeap &key_data, vector<string_t> &keys) {
+		auto column_count = order_columns.size();
+		vector<uint64_t> prefixes(count * column_count, 0);
+		for (idx_t i = 0; i < column_count; i++) {
+			SortKeys(rows, {order_columns[i]}, offset, count, [&](idx_t row, const string_t &key) {
+				uint64_t prefix = 0;
+				auto data = const_data_ptr_cast(key.GetData());
+				for (idx_t byte = 0; byte < sizeof(uint64_t); byte++) {
+					prefix = (prefix << 8) | (byte < key.GetSize() ? data[byte] : 0);
+				}
+				prefixes[row * column_count + i] = prefix;
+			});
+		}
+		auto key_size = column_count * sizeof(uint64_t);
+		for (idx_t row = 0; row < count; row++) {
+			auto key = key_data.EmptyString(key_size);
+			auto key_bytes = data_ptr_cast(key.GetDataWriteable());
+			memset(key_bytes, 0, key_size);
+			idx_t out_bit = 0;
+			for (idx_t bit = 0; bit < 64; bit++) {
+				for (idx_t i = 0; i < column_count; i++, out_bit++) {
+					if (prefixes[row * column_count + i] & (uint64_t(1) << (63 - bit))) {
+						key_bytes[out_bit / 8] |= 0x80 >> (out_bit % 8);
+					}
+				}
+			}
+			key.Finalize();
+			keys[offset + row] = key;
+		}
+	}
+
+	void Write(DataChunk &chunk) {
+		if (!writer) {
+			auto path = layout.NewDataFilePath(context, partition_path, unit.files[0].bucket);
+			written_files.push_back(path);
+			writer = make_uniq<PaimonDataFileWriter>(execution_context, *layout.bind, std::move(path));
+		}
+		writer->Append(execution_context, chunk);
+		if (writer->FileSize() >= layout.target_file_size) {
+			CloseFile();
+		}
+	}
+
+	void CloseFile() {
+		if (!writer) {
+			return;
+		}
+		auto &first = unit.files[0];
+		PaimonManifestEntry entry;
+		entry.kind = PaimonFileKind::ADD;
+		entry.partition = first.partition;
+		entry.bucket = first.bucket;
+		entry.totalBuckets = first.totalBuckets;
+		entry.file = writer->Finalize(execution_context);
+		entry.file.schemaId = layout.schema_id;
+		entry.file.minSequenceNumber = min_sequence_number;
+		entry.file.maxSequenceNumber = max_sequence_number;
+		entry.file.fileSource = FileSource::COMPACT;
+		writer.reset();
+		entries.push_back(std::move(entry));
+	}
+
+private:
+	ClientContext &context;
+	ThreadContext thread_context;
+	ExecutionContext execution_context;
+	PaimonWriteLayout &layout;
+	const PaimonCompactUnit &unit;
+	const vector<idx_t> &order_columns;
+	bool zorder;
+	optional_ptr<const PaimonDeletionVectors> deletion_vectors;
+	vector<PaimonManifestEntry> &entries;
+	vector<string> &written_files;
+	vector<pair<string, string>> partition_path;
+	//! The rewritten files cover the sequence numbers of all files of the unit
+	int64_t min_sequence_number;
+	int64_t max_sequence_number;
+	unique_ptr<PaimonDataFileWriter> writer;
+};
+
+//! The files written and the manifest entries produced by compacting one unit
+struct CompactTaskResult {
+	vector<PaimonManifestEntry> entries;
+	vector<string> written_files;
+};
+
+class PaimonCompactTask : public BaseExecutorTask {
+public:
+	PaimonCompactTask(TaskExecutor &executor, PaimonCompactor &compactor, const PaimonCompactUnit &unit,
+	                  CompactTaskResult &result)
+	    : BaseExecutorTask(executor), compactor(compactor), unit(unit), result(result) {
+	}
+
+	void ExecuteTask() override {
+		compactor.CompactUnit(unit, result.entries, result.written_files);
+	}
+
+private:
+	PaimonCompactor &compactor;
+	const PaimonCompactUnit &unit;
+	CompactTaskResult &result;
+};
+
+} // namespace
+
+//===--------------------------------------------------------------------===//
+// Compactor
+//===--------------------------------------------------------------------===//
+PaimonCompactor::PaimonCompactor(ClientContext &context, PaimonWriteLayout &layout)
+    : context(context), layout(layout) {
+	layout.CheckWritable();
+}
+
+PaimonCompactor::~PaimonCompactor() {
+}
+
+static string BucketKey(const PaimonManifestEntry &entry) {
+	string result(const_char_ptr_cast(entry.partition.data()), entry.partition.size());
+	result.append(const_char_ptr_cast(&entry.bucket), sizeof(entry.bucket));
+	return result;
+}
+
+void PaimonCompactor::CompactUnit(const PaimonCompactUnit &unit, vector<PaimonManifestEntry> &entries,
+                                  vector<string> &written_files) {
+	D_ASSERT(!unit.files.empty());
+	for (auto &file : unit.files) {
+		PaimonManifestEntry entry = file;
+		entry.kind = PaimonFileKind::DELETE;
+		entries.push_back(std::move(entry));
+	}
+
+	auto &single = unit.files[0].file;
+	bool has_retractions = !single.deleteRowCount.IsValid() || single.deleteRowCount.GetIndex() > 0;
+	if (layout.HasPrimaryKey() && unit.files.size() == 1 && (!unit.drop_delete || !has_retractions)) {
+		//! A single sorted file does not need to be merged, it is moved to the output level as it is
+		PaimonManifestEntry entry = unit.files[0];
+		entry.kind = PaimonFileKind::ADD;
+		entry.file.level = unit.output_level;
+		entries.push_back(std::move(entry));
+		return;
+	}
+
+	try {
+		if (layout.HasPrimaryKey()) {
+			UnitMerger merger(context, layout, unit, entries, written_files);
+			merger.Merge();
+		} else {
+			AppendUnitRewriter rewriter(context, layout, unit, order_columns, options.zorder, deletion_vectors.get(),
+			                            entries, written_files);
+			rewriter.Rewrite();
+		}
+	} catch (std::exception &) {
+		auto &fs = FileSystem::GetFileSystem(context);
+		for (auto &path : written_files) {
+			fs.TryRemoveFile(path);
+		}
+		written_files.clear();
+		throw;
+	}
+}
+
+vector<PaimonCompactUnit> PaimonCompactor::PickPrimaryKeyUnits(vector<vector<PaimonManifestEntry>> &buckets) {
+	auto trigger =
+	    layout.GetIntegerOption("num-sorted-run.compaction-trigger", DEFAULT_NUM_SORTED_RUN_COMPACTION_TRIGGER);
+	auto num_levels = NumericCast<int>(layout.GetIntegerOption("num-levels", trigger + 1));
+	if (num_levels < 2) {
+		throw InvalidInputException("Invalid Paimon 'num-levels' option: %d", num_levels);
+	}
+	PaimonUniversalCompaction policy(
+	    layout.GetIntegerOption("compaction.max-size-amplification-percent", DEFAULT_MAX_SIZE_AMPLIFICATION_PERCENT),
+	    layout.GetIntegerOption("compaction.size-ratio", DEFAULT_SIZE_RATIO), trigger);
+
+	vector<PaimonCompactUnit> result;
+	for (auto &files : buckets) {
+		auto runs = BuildSortedRuns(files);
+		PaimonCompactUnit unit;
+		auto picked = options.full ? policy.PickFull(num_levels, runs, unit) : policy.Pick(num_levels, runs, unit);
+		if (!picked) {
+			continue;
+		}
+		int highest_level = 0;
+		for (auto &run : runs) {
+			highest_level = MaxValue(highest_level, run.level);
+		}
+		unit.drop_delete = unit.output_level != 0 && unit.output_level >= highest_level;
+		result.push_back(std::move(unit));
+	}
+	return result;
+}
+
+vector<PaimonCompactUnit> PaimonCompactor::PickAppendUnits(vector<vector<PaimonManifestEntry>> &buckets) {
+	//! Like Paimon, files of at least 70% of the target size are left alone, so they are not rewritten over and over
+	auto compaction_file_size = layout.target_file_size / 10 * 7;
+	auto min_file_num = options.full ? 2 : layout.GetIntegerOption("compaction.min.file-num", DEFAULT_MIN_FILE_NUM);
+	auto max_file_num = layout.GetIntegerOption("compaction.max.file-num", DEFAULT_MAX_FILE_NUM);
+	min_file_num = MaxValue<idx_t>(min_file_num, 2);
+	max_file_num = MaxValue<idx_t>(max_file_num, min_file_num);
+
+	vector<PaimonCompactUnit> result;
+	for (auto &files : buckets) {
+		std::sort(files.begin(), files.end(), [](const PaimonManifestEntry &a, const PaimonManifestEntry &b) {
+			return a.file.minSequenceNumber < b.file.minSequenceNumber;
+		});
+		if (!order_columns.empty()) {
+			//! Clustering sorts the rows of a unit in memory, so a bucket is split into units of consecutive files of
+			//! up to 'write-buffer-size'. The files written for a unit have disjoint ranges on the order columns.
+			PaimonCompactUnit unit;
+			idx_t unit_size = 0;
+			for (auto &entry : files) {
+				auto file_size = NumericCast<idx_t>(entry.file.fileSize);
+				if (!unit.files.empty() && unit_size + file_size > layout.write_buffer_size) {
+					result.push_back(std::move(unit));
+					unit = PaimonCompactUnit();
+					unit_size = 0;
+				}
+				unit_size += file_size;
+				unit.files.push_back(std::move(entry));
+			}
+			if (!unit.files.empty()) {
+				result.push_back(std::move(unit));
+			}
+			continue;
+		}
+
+		//! Bin-pack consecutive small files up to the target file size
+		PaimonCompactUnit unit;
+		idx_t unit_size = 0;
+		auto emit_unit = [&]() {
+			if (unit.files.size() >= min_file_num) {
+				result.push_back(std::move(unit));
+			}
+			unit = PaimonCompactUnit();
+			unit_size = 0;
+		};
+		for (auto &entry : files) {
+			auto file_size = NumericCast<idx_t>(entry.file.fileSize);
+			if (file_size >= compaction_file_size) {
+				emit_unit();
+				continue;
+			}
+			unit_size += file_size;
+			unit.files.push_back(std::move(entry));
+			if (unit_size >= layout.target_file_size || unit.files.size() >= max_file_num) {
+				emit_unit();
+			}
+		}
+		emit_unit();
+	}
+	return result;
+}
+
+PaimonCompactionResult PaimonCompactor::Compact(const PaimonCompactOptions &options_p) {
+	options = options_p;
+	order_columns.clear();
+	for (auto &name : options.order_by) {
+		auto entry = std::find(layout.column_names.begin(), layout.column_names.end(), name);
+		if (entry == layout.column_names.end()) {
+			throw InvalidInputException("Paimon compaction order column \"%s\" is not a column of the table", name);
+		}
+		order_columns.push_back(NumericCast<idx_t>(entry - layout.column_names.begin()));
+	}
+	if (!order_columns.empty() && layout.HasPrimaryKey()) {
+		throw InvalidInputException("Sorting during compaction is only supported for Paimon append tables, primary "
+		                            "key tables are always sorted on their key");
+	}
+	if (options.zorder && order_columns.size() < 2) {
+		throw InvalidInputException("Z-order compaction requires at least two order columns");
+	}
+
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto latest_id = PaimonTableMetadata::FindLatestSnapshotId(layout.table_path, fs);
+	if (latest_id == 0) {
+		return PaimonCompactionResult();
+	}
+	auto snapshot = paimon_snapshot::Read(context, layout.table_path, latest_id);
+
+	//! Group the live files by (partition, bucket)
+	unordered_map<string, idx_t> bucket_map;
+	vector<vector<PaimonManifestEntry>> buckets;
+	for (auto &entry : paimon_snapshot::ReadLiveFiles(context, layout.table_path, snapshot)) {
+		auto key = BucketKey(entry);
+		auto bucket = bucket_map.find(key);
+		if (bucket == bucket_map.end()) {
+			bucket = bucket_map.emplace(key, buckets.size()).first;
+			buckets.emplace_back();
+		}
+		buckets[bucket->second].push_back(std::move(entry));
+	}
+	return CompactBuckets(snapshot, buckets);
+}
+
+PaimonCompactionResult PaimonCompactor::CompactBuckets(const PaimonSnapshotInfo &snapshot,
+                                                       vector<vector<PaimonManifestEntry>> &buckets) {
+	PaimonCompactionResult result;
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto units = layout.HasPrimaryKey() ? PickPrimaryKeyUnits(buckets) : PickAppendUnits(buckets);
+	if (units.empty()) {
+		return result;
+	}
+	deletion_vectors.reset();
+	if (!layout.HasPrimaryKey()) {
+		deletion_vectors = make_uniq<PaimonDeletionVectors>(context, layout.table_path, snapshot);
+	}
+
+	//! Units are independent, so every unit is rewritten by a task of its own
+	vector<CompactTaskResult> task_results(units.size());
+	auto remove_written_files = [&]() {
+		for (auto &task_result : task_results) {
+			for (auto &path : task_result.written_files) {
+				fs.TryRemoveFile(path);
+			}
+		}
+	};
+	TaskExecutor executor(context);
+	for (idx_t i = 0; i < units.size(); i++) {
+		executor.ScheduleTask(make_uniq<PaimonCompactTask>(executor, *this, units[i], task_results[i]));
+	}
+	try {
+		executor.WorkOnTasks();
+	} catch (std::exception &) {
+		remove_written_files();
+		throw;
+	}
+
+	vector<PaimonManifestEntry> entries;
+	for (auto &task_result : task_results) {
+		for (auto &entry : task_result.entries) {
+			if (entry.kind == PaimonFileKind::ADD) {
+				result.files_after++;
+			} else {
+				result.files_before++;
+			}
+			entries.push_back(std::move(entry));
+		}
+	}
+	unordered_set<string> compacted_buckets;
+	for (auto &unit : units) {
+		compacted_buckets.insert(BucketKey(unit.files[0]));
+	}
+	result.compacted_buckets = compacted_buckets.size();
+
+	//! The deletion vectors of the rewritten files were applied, so they are dropped from the index of their bucket
+	vector<PaimonIndexManifestEntry> index_changes;
+	vector<string> index_files;
+	try {
+		if (deletion_vectors && !deletion_vectors->Empty()) {
+			for (auto &unit : units) {
+				auto &first = unit.files[0];
+				auto bucket_vectors = deletion_vectors->ReadBucket(first.partition, first.bucket);
+				idx_t removed = 0;
+				for (auto &entry : unit.files) {
+					removed += bucket_vectors.erase(entry.file.fileName);
+				}
+				if (removed > 0) {
+					deletion_vectors->WriteBucket(first.partition, first.bucket, bucket_vectors, index_changes,
+					                              index_files);
+				}
+			}
+		}
+		PaimonCommit commit(context, layout);
+		result.snapshot_id = commit.Commit(entries, PaimonCommitKind::COMPACT, vector<PaimonManifestEntry>(),
+		                                   index_changes);
+	} catch (std::exception &) {
+		remove_written_files();
+		for (auto &path : index_files) {
+			fs.TryRemoveFile(path);
+		}
+		throw;
+	}
+	return result;
+}
+
+void PaimonCompactor::CompactAfterWrite(ClientContext &context, PaimonWriteLayout &layout,
+                                        const vector<PaimonManifestEntry> &written_files) {
+	if (StringUtil::CIEquals(layout.GetOption("write-only"), "true")) {
+		return;
+	}
+	//! The statement is already committed: a failed compaction must not fail it, or a retry would write its rows twice
+	try {
+		//! Only the buckets written by the statement can have reached the trigger, their live files are those the
+		//! writers restored before the write, with the committed changes applied
+		unordered_map<string, idx_t> bucket_map;
+		vector<vector<PaimonManifestEntry>> buckets;
+		vector<unordered_set<string>> restored_files;
+		for (auto &entry : written_files) {
+			auto key = BucketKey(entry);
+			auto bucket = bucket_map.find(key);
+			if (bucket == bucket_map.end()) {
+				bucket = bucket_map.emplace(key, buckets.size()).first;
+				buckets.push_back(layout.BucketFiles(entry.partition, entry.bucket));
+				restored_files.emplace_back();
+				for (auto &file : buckets.back()) {
+					restored_files.back().insert(paimon_snapshot::EntryIdentifier(file));
+				}
+			}
+			//! A bucket restored after the commit already holds the files added by it
+			if (entry.kind == PaimonFileKind::ADD &&
+			    restored_files[bucket->second].count(paimon_snapshot::EntryIdentifier(entry))) {
+				continue;
+			}
+			buckets[bucket->second].push_back(entry);
+		}
+		for (auto &files : buckets) {
+			files = paimon_snapshot::MergeEntries(files);
+		}
+
+		auto &fs = FileSystem::GetFileSystem(context);
+		auto latest_id = PaimonTableMetadata::FindLatestSnapshotId(layout.table_path, fs);
+		if (latest_id == 0 || buckets.empty()) {
+			return;
+		}
+		auto snapshot = paimon_snapshot::Read(context, layout.table_path, latest_id);
+		PaimonCompactor compactor(context, layout);
+		compactor.CompactBuckets(snapshot, buckets);
+	} catch (std::exception &ex) {
+		//! E.g. a concurrent commit replaced some of the files first, the buckets are compacted by a later write
+		ErrorData error(ex);
+		DUCKDB_LOG_WARN(context, "Compacting Paimon table \"%s\" after a write failed: %s", layout.table_path,
+		                error.Message());
+	}
+}
+
+} // namespace duckdb
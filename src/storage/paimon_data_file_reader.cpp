@@ -0,0 +1,156 @@
+#include "storage/paimon_data_file_reader.hpp"
+#include "storage/paimon_data_file_writer.hpp"
+
+#include "duckdb/catalog/catalog_entry/table_function_catalog_entry.hpp"
+#include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/parser/tableref/table_function_ref.hpp"
+
+#include <roaring/roaring.hh>
+
+namespace duckdb {
+
+static TableFunction GetParquetScan(ClientContext &context) {
+	auto &instance = DatabaseInstance::GetDatabase(context);
+	auto &system_catalog = Catalog::GetSystemCatalog(instance);
+	auto data = CatalogTransaction::GetSystemTransaction(instance);
+	auto &schema = system_catalog.GetSchema(data, DEFAULT_SCHEMA);
+	auto catalog_entry = schema.GetEntry(data, CatalogType::TABLE_FUNCTION_ENTRY, "read_parquet");
+	if (!catalog_entry) {
+		throw MissingExtensionException("Did not find read_parquet function required to read paimon data files");
+	}
+	return catalog_entry->Cast<TableFunctionCatalogEntry>().functions.functions[0];
+}
+
+PaimonDataFileReader::PaimonDataFileReader(ClientContext &context_p, const PaimonDataFileBindData &bind,
+                                           const string &file_path, optional_ptr<const TableFilterSet> filters,
+                                           optional_ptr<const roaring::Roaring> deleted_rows_p, bool read_row_numbers)
+    : context(context_p), scan(GetParquetScan(context_p)), thread_context(context_p),
+      execution_context(context_p, thread_context, nullptr), deleted_rows(deleted_rows_p),
+      row_numbers(LogicalType::BIGINT, nullptr), live_rows(STANDARD_VECTOR_SIZE) {
+	vector<Value> children {Value(file_path)};
+	named_parameter_map_t named_params;
+	//! Data files live in 'key=value' partition directories, which must not turn into extra columns
+	named_params["hive_partitioning"] = Value::BOOLEAN(false);
+	//! Rows are identified by their position in the file, which filtered scans do not preserve
+	read_row_numbers = read_row_numbers || deleted_rows;
+	if (read_row_numbers) {
+		named_params["file_row_number"] = Value::BOOLEAN(true);
+	}
+	vector<LogicalType> input_types;
+	vector<string> input_names;
+	TableFunctionRef empty;
+	TableFunctionBindInput bind_input(children, named_params, input_types, input_names, nullptr, nullptr, scan, empty);
+	vector<LogicalType> return_types;
+	vector<string> return_names;
+	bind_data = scan.bind(context, bind_input, return_types, return_names);
+
+	//! Project the columns of the layout by name, files written before a column was added do not have it
+	vector<column_t> column_ids;
+	for (idx_t col_idx = 0; col_idx < bind.names.size(); col_idx++) {
+		idx_t file_idx = DConstants::INVALID_INDEX;
+		for (idx_t i = 0; i < return_names.size(); i++) {
+			if (return_names[i] == bind.names[col_idx]) {
+				file_idx = i;
+				break;
+			}
+		}
+		if (file_idx == DConstants::INVALID_INDEX) {
+			if (col_idx < bind.value_offset) {
+				throw InvalidInputException("Paimon data file \"%s\" is missing the column \"%s\"", file_path,
+				                            bind.names[col_idx]);
+			}
+			column_mapping.push_back(DConstants::INVALID_INDEX);
+			continue;
+		}
+		column_mapping.push_back(column_ids.size());
+		column_ids.push_back(file_idx);
+		file_types.push_back(return_types[file_idx]);
+	}
+	layout_types = bind.types;
+	if (read_row_numbers) {
+		for (idx_t i = 0; i < return_names.size(); i++) {
+			if (return_names[i] == "file_row_number") {
+				row_number_idx = column_ids.size();
+				column_ids.push_back(i);
+				file_types.push_back(return_types[i]);
+				break;
+			}
+		}
+		if (row_number_idx == DConstants::INVALID_INDEX) {
+			throw InternalException("Parquet scan of \"%s\" did not return the file_row_number column", file_path);
+		}
+	}
+
+	//! Scan filters refer to the position of the column in the projection
+	if (filters) {
+		scan_filters = make_uniq<TableFilterSet>();
+		for (auto &entry : filters->filters) {
+			auto scan_idx = column_mapping[entry.first];
+			if (scan_idx == DConstants::INVALID_INDEX || file_types[scan_idx] != layout_types[entry.first]) {
+				continue;
+			}
+			scan_filters->filters[scan_idx] = entry.second->Copy();
+		}
+	}
+
+	TableFunctionInitInput input(bind_data.get(), column_ids, vector<idx_t>(), scan_filters.get());
+	global_state = scan.init_global(context, input);
+	local_state = scan.init_local(execution_context, input, global_state.get());
+	scan_chunk.Initialize(context, file_types, STANDARD_VECTOR_SIZE);
+}
+
+bool PaimonDataFileReader::Next(DataChunk &result) {
+	idx_t count;
+	idx_t live_count;
+	while (true) {
+		scan_chunk.Reset();
+		TableFunctionInput function_input(bind_data.get(), local_state.get(), global_state.get());
+		scan.function(context, function_input, scan_chunk);
+		count = scan_chunk.size();
+		if (count == 0) {
+			return false;
+		}
+		live_count = count;
+		if (!deleted_rows || deleted_rows->isEmpty()) {
+			break;
+		}
+		auto &row_number_vector = scan_chunk.data[row_number_idx];
+		row_number_vector.Flatten(count);
+		auto positions = FlatVector::GetData<int64_t>(row_number_vector);
+		live_count = 0;
+		for (idx_t row = 0; row < count; row++) {
+			if (!deleted_rows->contains(NumericCast<uint32_t>(positions[row]))) {
+				live_rows.set_index(live_count++, row);
+			}
+		}
+		if (live_count > 0) {
+			break;
+		}
+	}
+
+	result.Reset();
+	for (idx_t col_idx = 0; col_idx < column_mapping.size(); col_idx++) {
+		auto file_idx = column_mapping[col_idx];
+		auto &target = result.data[col_idx];
+		if (file_idx == DConstants::INVALID_INDEX) {
+			target.Reference(Value(layout_types[col_idx]));
+		} else if (file_types[file_idx] == layout_types[col_idx]) {
+			target.Reference(scan_chunk.data[file_idx]);
+		} else {
+			VectorOperations::Cast(context, scan_chunk.data[file_idx], target, count);
+		}
+	}
+	result.SetCardinality(count);
+	if (row_number_idx != DConstants::INVALID_INDEX) {
+		row_numbers.Reference(scan_chunk.data[row_number_idx]);
+	}
+	if (live_count < count) {
+		result.Slice(live_rows, live_count);
+		row_numbers.Slice(live_rows, live_count);
+	}
+	return true;
+}
+
+} // namespace duckdb
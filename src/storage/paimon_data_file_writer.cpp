@@ -0,0 +1,298 @@
+#include "storage/paimon_data_file_writer.hpp"
+#include "storage/paimon_table_entry.hpp"
+#include "paimon_binary_row.hpp"
+
+#include "duckdb/catalog/catalog_entry/copy_function_catalog_entry.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/string_type.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+#include "duckdb/parser/parsed_data/copy_info.hpp"
+
+namespace duckdb {
+
+static optional_ptr<CopyFunctionCatalogEntry> TryGetCopyFunction(DatabaseInstance &db, const string &name) {
+	D_ASSERT(!name.empty());
+	auto &system_catalog = Catalog::GetSystemCatalog(db);
+	auto data = CatalogTransaction::GetSystemTransaction(db);
+	auto &schema = system_catalog.GetSchema(data, DEFAULT_SCHEMA);
+	auto entry = schema.GetEntry(data, CatalogType::COPY_FUNCTION_ENTRY, name);
+	if (!entry) {
+		return nullptr;
+	}
+	return entry->Cast<CopyFunctionCatalogEntry>();
+}
+
+static int32_t GetFieldId(const PaimonTableEntry &table, const ColumnDefinition &column) {
+	auto &metadata = table.GetMetadata();
+	if (metadata.schema) {
+		for (auto &field : metadata.schema->fields) {
+			if (field.name == column.Name()) {
+				return field.id;
+			}
+		}
+	}
+	return static_cast<int32_t>(column.Oid());
+}
+
+PaimonDataFileBindData::PaimonDataFileBindData(ClientContext &context, PaimonTableEntry &table,
+                                               const vector<idx_t> &key_indexes) {
+	auto copy_fun = TryGetCopyFunction(*context.db, "parquet");
+	if (!copy_fun) {
+		throw MissingExtensionException("Did not find parquet copy function required to write to paimon table");
+	}
+	copy = copy_fun->function;
+	if (!copy.copy_to_get_written_statistics) {
+		throw NotImplementedException("The parquet copy function does not report written file statistics");
+	}
+
+	auto &columns = table.GetColumns();
+	child_list_t<Value> field_ids;
+	for (auto key_idx : key_indexes) {
+		auto &column = columns.GetColumn(LogicalIndex(key_idx));
+		auto name = "_KEY_" + column.Name();
+		names.push_back(name);
+		types.push_back(column.Type());
+		field_ids.emplace_back(name, Value::INTEGER(KEY_FIELD_ID_START + GetFieldId(table, column)));
+	}
+	key_count = key_indexes.size();
+	if (IsKeyValue()) {
+		names.push_back("_SEQUENCE_NUMBER");
+		types.push_back(LogicalType::BIGINT);
+		field_ids.emplace_back("_SEQUENCE_NUMBER", Value::INTEGER(SEQUENCE_NUMBER_FIELD_ID));
+		names.push_back("_VALUE_KIND");
+		types.push_back(LogicalType::TINYINT);
+		field_ids.emplace_back("_VALUE_KIND", Value::INTEGER(VALUE_KIND_FIELD_ID));
+	}
+	value_offset = names.size();
+	for (auto &column : columns.Logical()) {
+		names.push_back(column.Name());
+		types.push_back(column.Type());
+		field_ids.emplace_back(column.Name(), Value::INTEGER(GetFieldId(table, column)));
+	}
+
+	CopyInfo copy_info;
+	copy_info.is_from = false;
+	copy_info.format = "parquet";
+	copy_info.options["field_ids"].push_back(Value::STRUCT(std::move(field_ids)));
+
+	CopyFunctionBindInput input(copy_info);
+	input.file_extension = "parquet";
+	bind_data = copy.copy_to_bind(context, input, names, types);
+}
+
+PaimonDataFileBindData::PaimonDataFileBindData(const vector<string> &column_names,
+                                               const vector<LogicalType> &column_types,
+                                               const vector<idx_t> &key_indexes) {
+	for (auto key_idx : key_indexes) {
+		names.push_back("_KEY_" + column_names[key_idx]);
+		types.push_back(column_types[key_idx]);
+	}
+	key_count = key_indexes.size();
+	if (IsKeyValue()) {
+		names.push_back("_SEQUENCE_NUMBER");
+		types.push_back(LogicalType::BIGINT);
+		names.push_back("_VALUE_KIND");
+		types.push_back(LogicalType::TINYINT);
+	}
+	value_offset = names.size();
+	names.insert(names.end(), column_names.begin(), column_names.end());
+	types.insert(types.end(), column_types.begin(), column_types.end());
+}
+
+PaimonDataFileWriter::PaimonDataFileWriter(ExecutionContext &context_p, PaimonDataFileBindData &bind,
+                                           string file_path_p)
+    : context(context_p.client), bind(bind), file_path(std::move(file_path_p)), min_key(bind.key_count),
+      max_key(bind.key_count) {
+	auto &copy = bind.copy;
+	global_state = copy.copy_to_initialize_global(context, *bind.bind_data, file_path);
+	//! Register before anything is written, the writer fills 'file_stats' as row groups are flushed
+	copy.copy_to_get_written_statistics(context, *bind.bind_data, *global_state, file_stats);
+	local_state = copy.copy_to_initialize_local(context_p, *bind.bind_data);
+}
+
+void PaimonDataFileWriter::Append(ExecutionContext &context, DataChunk &chunk) {
+	if (chunk.size() == 0) {
+		return;
+	}
+	if (bind.IsKeyValue()) {
+		TrackKeyValues(chunk);
+	}
+	bind.copy.copy_to_sink(context, *bind.bind_data, *global_state, *local_state, chunk);
+	row_count += chunk.size();
+}
+
+void PaimonDataFileWriter::TrackKeyValues(DataChunk &chunk) {
+	auto count = chunk.size();
+	auto last_row = count - 1;
+	for (idx_t key_idx = 0; key_idx < bind.key_count; key_idx++) {
+		UnifiedVectorFormat format;
+		chunk.data[key_idx].ToUnifiedFormat(count, format);
+		if (row_count == 0) {
+			min_key.WriteVector(key_idx, chunk.data[key_idx], format, 0);
+		}
+		max_key.WriteVector(key_idx, chunk.data[key_idx], format, last_row);
+	}
+
+	UnifiedVectorFormat sequence_format;
+	chunk.data[bind.key_count].ToUnifiedFormat(count, sequence_format);
+	auto sequence_numbers = UnifiedVectorFormat::GetData<int64_t>(sequence_format);
+	UnifiedVectorFormat kind_format;
+	chunk.data[bind.key_count + 1].ToUnifiedFormat(count, kind_format);
+	auto kinds = UnifiedVectorFormat::GetData<int8_t>(kind_format);
+	for (idx_t row = 0; row < count; row++) {
+		auto sequence_number = sequence_numbers[sequence_format.sel->get_index(row)];
+		min_sequence_number = MinValue(min_sequence_number, sequence_number);
+		max_sequence_number = MaxValue(max_sequence_number, sequence_number);
+		auto kind = static_cast<PaimonRowKind>(kinds[kind_format.sel->get_index(row)]);
+		if (kind == PaimonRowKind::UPDATE_BEFORE || kind == PaimonRowKind::DELETE) {
+			delete_row_count++;
+		}
+	}
+}
+
+idx_t PaimonDataFileWriter::FileSize() const {
+	if (!bind.copy.file_size_bytes) {
+		return 0;
+	}
+	return bind.copy.file_size_bytes(*global_state);
+}
+
+//! Truncate 'input' to STATS_TRUNCATE_LENGTH code points, like Paimon's 'truncate(16)' stats mode.
+//! Upper bounds have their last character incremented so they remain a valid bound, or become NULL if that is not
+//! possible.
+static Value TruncateStringBound(const Value &input, bool is_upper_bound) {
+	auto &str = StringValue::Get(input);
+	idx_t pos = 0;
+	idx_t code_points = 0;
+	while (pos < str.size() && code_points < PaimonDataFileWriter::STATS_TRUNCATE_LENGTH) {
+		auto c = static_cast<uint8_t>(str[pos]);
+		idx_t char_size = c < 0x80 ? 1 : (c >> 5) == 0x6 ? 2 : (c >> 4) == 0xE ? 3 : 4;
+		pos += char_size;
+		code_points++;
+	}
+	if (pos >= str.size()) {
+		return input;
+	}
+	auto truncated = str.substr(0, pos);
+	if (!is_upper_bound) {
+		return Value(truncated);
+	}
+	auto &last = truncated.back();
+	if (static_cast<uint8_t>(last) >= 0x7F) {
+		return Value(LogicalType::VARCHAR);
+	}
+	last++;
+	return Value(truncated);
+}
+
+static Value ConvertBound(const Value &stat, const LogicalType &type, bool is_upper_bound) {
+	if (stat.IsNull()) {
+		return Value(type);
+	}
+	Value result;
+	if (stat.type() == type) {
+		result = stat;
+	} else {
+		string error;
+		auto input = stat.type().id() == LogicalTypeId::VARCHAR ? stat : Value(stat.ToString());
+		if (!input.DefaultTryCastAs(type, result, &error)) {
+			return Value(type);
+		}
+	}
+	if (type.id() == LogicalTypeId::VARCHAR) {
+		return TruncateStringBound(result, is_upper_bound);
+	}
+	if (type.id() == LogicalTypeId::BLOB &&
+	    StringValue::Get(result).size() > PaimonDataFileWriter::STATS_TRUNCATE_LENGTH) {
+		//! Binary bounds are not truncated, leave them out like Paimon does for oversized values
+		return Value(type);
+	}
+	return result;
+}
+
+static optional_ptr<const case_insensitive_map_t<Value>>
+FindColumnStatistics(const CopyFunctionFileStatistics &file_stats, const string &name) {
+	auto entry = file_stats.column_statistics.find(name);
+	if (entry == file_stats.column_statistics.end()) {
+		entry = file_stats.column_statistics.find(KeywordHelper::WriteQuoted(name, '"'));
+	}
+	if (entry == file_stats.column_statistics.end()) {
+		return nullptr;
+	}
+	return &entry->second;
+}
+
+SimpleStats PaimonDataFileWriter::ConvertStatistics(idx_t begin, idx_t end) const {
+	auto column_count = end - begin;
+	PaimonBinaryRowWriter min_values(column_count);
+	PaimonBinaryRowWriter max_values(column_count);
+
+	SimpleStats result;
+	result.nullCounts.reserve(column_count);
+	for (idx_t col_idx = 0; col_idx < column_count; col_idx++) {
+		auto &type = bind.types[begin + col_idx];
+		auto column_stats = FindColumnStatistics(file_stats, bind.names[begin + col_idx]);
+		if (!column_stats) {
+			//! Nested columns have their stats reported per leaf, Paimon does not keep stats for them
+			min_values.SetNullAt(col_idx);
+			max_values.SetNullAt(col_idx);
+			result.nullCounts.emplace_back(LogicalType::BIGINT);
+			continue;
+		}
+		auto min_entry = column_stats->find("min");
+		auto max_entry = column_stats->find("max");
+		auto null_count_entry = column_stats->find("null_count");
+
+		if (min_entry != column_stats->end()) {
+			min_values.WriteValue(col_idx, ConvertBound(min_entry->second, type, false));
+		} else {
+			min_values.SetNullAt(col_idx);
+		}
+		if (max_entry != column_stats->end()) {
+			max_values.WriteValue(col_idx, ConvertBound(max_entry->second, type, true));
+		} else {
+			max_values.SetNullAt(col_idx);
+		}
+		if (null_count_entry != column_stats->end() && !null_count_entry->second.IsNull()) {
+			result.nullCounts.push_back(null_count_entry->second.DefaultCastAs(LogicalType::BIGINT));
+		} else {
+			result.nullCounts.emplace_back(LogicalType::BIGINT);
+		}
+	}
+	result.minValues = min_values.Serialize();
+	result.maxValues = max_values.Serialize();
+	return result;
+}
+
+DataFileMeta PaimonDataFileWriter::Finalize(ExecutionContext &context) {
+	auto &copy = bind.copy;
+	copy.copy_to_combine(context, *bind.bind_data, *global_state, *local_state);
+	copy.copy_to_finalize(this->context, *bind.bind_data, *global_state);
+
+	DataFileMeta result;
+	auto separator = file_path.find_last_of('/');
+	result.fileName = separator == string::npos ? file_path : file_path.substr(separator + 1);
+	result.fileSize = NumericCast<int64_t>(file_stats.file_size_bytes);
+	result.rowCount = NumericCast<int64_t>(file_stats.row_count ? file_stats.row_count : row_count);
+	if (bind.IsKeyValue()) {
+		result.minKey = min_key.Serialize();
+		result.maxKey = max_key.Serialize();
+		result.keyStats = ConvertStatistics(0, bind.key_count);
+		result.minSequenceNumber = min_sequence_number;
+		result.maxSequenceNumber = max_sequence_number;
+	} else {
+		result.minKey = PaimonBinaryRow::EmptyRow();
+		result.maxKey = PaimonBinaryRow::EmptyRow();
+		result.keyStats = SimpleStats::Empty();
+	}
+	result.valueStats = ConvertStatistics(bind.value_offset, bind.names.size());
+	result.deleteRowCount = delete_row_count;
+	result.fileSource = FileSource::APPEND;
+
+	local_state.reset();
+	global_state.reset();
+	return result;
+}
+
+} // namespace duckdb
@@ -1,17 +1,30 @@
 #include "storage/paimon_delete.hpp"
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
-#include "duckdb/common/types/column/column_data_collection.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string_util.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/execution/operator/filter/physical_filter.hpp"
+#include "duckdb/execution/operator/projection/physical_projection.hpp"
+#include "duckdb/execution/operator/scan/physical_table_scan.hpp"
 #include "duckdb/main/client_context.hpp"
-#include "duckdb/parallel/thread_context.hpp"
+#include "duckdb/parallel/task_executor.hpp"
+#include "duckdb/planner/expression/bound_comparison_expression.hpp"
+#include "duckdb/planner/expression/bound_conjunction_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/expression/bound_operator_expression.hpp"
 #include "duckdb/planner/expression/bound_reference_expression.hpp"
-#include "duckdb/storage/data_table.hpp"
-#include "duckdb/storage/table/delete_state.hpp"
-#include "duckdb/storage/table/scan_state.hpp"
-#include "duckdb/storage/table/update_state.hpp"
-#include "duckdb/transaction/duck_transaction.hpp"
+#include "duckdb/planner/expression_iterator.hpp"
+#include "storage/paimon_commit.hpp"
+#include "storage/paimon_compaction.hpp"
+#include "storage/paimon_data_file_reader.hpp"
+#include "storage/paimon_deletion_vectors.hpp"
 #include "storage/paimon_table_entry.hpp"
+#include "storage/paimon_table_writer.hpp"
+#include "paimon_binary_row.hpp"
+#include "paimon_snapshot.hpp"
+
+#include <algorithm>
 
 namespace duckdb {
 
@@ -29,51 +42,74 @@ PaimonDelete::PaimonDelete(PhysicalPlan &physical_plan, vector<LogicalType> type
 //===--------------------------------------------------------------------===//
 class PaimonDeleteGlobalState : public GlobalSinkState {
 public:
-	explicit PaimonDeleteGlobalState() = default;
+	PaimonDeleteGlobalState(ClientContext &context, PaimonTableEntry &table) : layout(context, table), delete_count(0) {
+		layout.CheckWritable();
+	}
 
+	//! Partitioning, bucketing and file sizing of the table, shared by all writer threads
+	PaimonWriteLayout layout;
+	mutex lock;
+	//! The files written by this delete
+	vector<PaimonManifestEntry> written_files;
+	vector<PaimonManifestEntry> changelog_files;
 	//! The amount of rows deleted
-	idx_t delete_count = 0;
-	//! ColumnDataCollection to store the result of the delete
-	ColumnDataCollection return_collection;
+	atomic<idx_t> delete_count;
 };
 
 class PaimonDeleteLocalState : public LocalSinkState {
 public:
-	explicit PaimonDeleteLocalState(ClientContext &context, const vector<LogicalType> &types) {
-		// Initialize local state for delete processing
+	PaimonDeleteLocalState(ClientContext &context, PaimonWriteLayout &layout) : writer(layout) {
+		delete_chunk.Initialize(context, layout.column_types);
 	}
+
+	PaimonTableWriter writer;
+	//! The retractions, in the column order of the table
+	DataChunk delete_chunk;
 };
 
 //===--------------------------------------------------------------------===//
 // Getters
 //===--------------------------------------------------------------------===//
 unique_ptr<GlobalSinkState> PaimonDelete::GetGlobalSinkState(ClientContext &context) const {
-	return make_uniq<PaimonDeleteGlobalState>();
+	return make_uniq<PaimonDeleteGlobalState>(context, tableref.Cast<PaimonTableEntry>());
 }
 
 unique_ptr<LocalSinkState> PaimonDelete::GetLocalSinkState(ExecutionContext &context) const {
-	return make_uniq<PaimonDeleteLocalState>(context.client, types);
+	auto &global_state = sink_state->Cast<PaimonDeleteGlobalState>();
+	return make_uniq<PaimonDeleteLocalState>(context.client, global_state.layout);
 }
 
 //===--------------------------------------------------------------------===//
 // Sink
 //===--------------------------------------------------------------------===//
 SinkResultType PaimonDelete::Sink(ExecutionContext &context, DataChunk &chunk, OperatorSinkInput &input) const {
-	auto &global_state = input.global_state->Cast<PaimonDeleteGlobalState>();
-	auto &local_state = input.local_state->Cast<PaimonDeleteLocalState>();
-
-	// For now, this is a placeholder implementation
-	// In a full implementation, this would:
-	// 1. Read the existing data that matches the WHERE clause
-	// 2. Create delete files (equality deletes or position deletes)
-	// 3. Update Paimon metadata with new snapshot
+	auto &global_state = input.global_state.Cast<PaimonDeleteGlobalState>();
+	auto &local_state = input.local_state.Cast<PaimonDeleteLocalState>();
+	auto &layout = global_state.layout;
 
-	global_state.delete_count += chunk.size();
-
-	if (return_chunk) {
-		global_state.return_collection.Append(chunk);
+	// The row identifiers of a primary key table are its primary key columns (PaimonTableEntry::GetRowIdColumns),
+	// a retraction only needs the key, so the other columns are left NULL
+	auto &delete_chunk = local_state.delete_chunk;
+	delete_chunk.Reset();
+	for (auto &column : delete_chunk.data) {
+		column.SetVectorType(VectorType::CONSTANT_VECTOR);
+		ConstantVector::SetNull(column, true);
+	}
+	D_ASSERT(expressions.size() == layout.primary_key_indexes.size());
+	for (idx_t i = 0; i < expressions.size(); i++) {
+		auto &source = chunk.data[expressions[i]->Cast<BoundReferenceExpression>().index];
+		auto &target = delete_chunk.data[layout.primary_key_indexes[i]];
+		if (source.GetType() == target.GetType()) {
+			target.Reference(source);
+		} else {
+			target.SetVectorType(VectorType::FLAT_VECTOR);
+			VectorOperations::Cast(context.client, source, target, chunk.size());
+		}
 	}
+	delete_chunk.SetCardinality(chunk.size());
 
+	local_state.writer.Append(context, delete_chunk, PaimonRowKind::DELETE);
+	global_state.delete_count += chunk.size();
 	return SinkResultType::NEED_MORE_INPUT;
 }
 
@@ -81,61 +117,603 @@ SinkResultType PaimonDelete::Sink(ExecutionContext &context, DataChunk &chunk, O
 // Combine
 //===--------------------------------------------------------------------===//
 SinkCombineResultType PaimonDelete::Combine(ExecutionContext &context, OperatorSinkCombineInput &input) const {
-	auto &global_state = input.global_state->Cast<PaimonDeleteGlobalState>();
-	auto &local_state = input.local_state->Cast<PaimonDeleteLocalState>();
+	auto &global_state = input.global_state.Cast<PaimonDeleteGlobalState>();
+	auto &local_state = input.local_state.Cast<PaimonDeleteLocalState>();
 
-	// Combine results from parallel workers
-	// For now, just return success
+	vector<PaimonManifestEntry> written_files;
+	vector<PaimonManifestEntry> changelog_files;
+	local_state.writer.Flush(context, written_files, changelog_files);
 
+	lock_guard<mutex> guard(global_state.lock);
+	for (auto &entry : written_files) {
+		global_state.written_files.push_back(std::move(entry));
+	}
+	for (auto &entry : changelog_files) {
+		global_state.changelog_files.push_back(std::move(entry));
+	}
 	return SinkCombineResultType::FINISHED;
 }
 
+//===--------------------------------------------------------------------===//
+// Finalize
+//===--------------------------------------------------------------------===//
+SinkFinalizeType PaimonDelete::Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
+                                        OperatorSinkFinalizeInput &input) const {
+	auto &global_state = input.global_state.Cast<PaimonDeleteGlobalState>();
+	if (global_state.written_files.empty()) {
+		return SinkFinalizeType::READY;
+	}
+	PaimonCommit commit(context, global_state.layout);
+	commit.Commit(global_state.written_files, PaimonCommitKind::APPEND, global_state.changelog_files);
+	PaimonCompactor::CompactAfterWrite(context, global_state.layout, global_state.written_files);
+	return SinkFinalizeType::READY;
+}
+
 //===--------------------------------------------------------------------===//
 // Source
 //===--------------------------------------------------------------------===//
-class PaimonDeleteSourceState : public GlobalSourceState {
+unique_ptr<GlobalSourceState> PaimonDelete::GetGlobalSourceState(ClientContext &context) const {
+	return make_uniq<GlobalSourceState>();
+}
+
+SourceResultType PaimonDelete::GetData(ExecutionContext &context, DataChunk &chunk, OperatorSourceInput &input) const {
+	auto &global_state = sink_state->Cast<PaimonDeleteGlobalState>();
+	chunk.SetCardinality(1);
+	chunk.SetValue(0, 0, Value::BIGINT(NumericCast<int64_t>(global_state.delete_count.load())));
+	return SourceResultType::FINISHED;
+}
+
+//===--------------------------------------------------------------------===//
+// Helpers
+//===--------------------------------------------------------------------===//
+string PaimonDelete::GetName() const {
+	return "PAIMON_DELETE";
+}
+
+InsertionOrderPreservingMap<string> PaimonDelete::ParamsToString() const {
+	InsertionOrderPreservingMap<string> result;
+	result["Table"] = tableref.name;
+	return result;
+}
+
+//===--------------------------------------------------------------------===//
+// Append table delete
+//===--------------------------------------------------------------------===//
+PaimonAppendDelete::PaimonAppendDelete(PhysicalPlan &physical_plan, vector<LogicalType> types,
+                                       TableCatalogEntry &tableref, vector<unique_ptr<Expression>> conjuncts,
+                                       idx_t estimated_cardinality)
+    : PhysicalOperator(physical_plan, PhysicalOperatorType::DELETE, std::move(types), estimated_cardinality),
+      tableref(tableref), conjuncts(std::move(conjuncts)) {
+}
+
+static void RemapColumns(Expression &expr, const vector<idx_t> &columns) {
+	if (expr.GetExpressionClass() == ExpressionClass::BOUND_REF) {
+		auto &ref = expr.Cast<BoundReferenceExpression>();
+		if (ref.index >= columns.size() || columns[ref.index] == DConstants::INVALID_INDEX) {
+			throw NotImplementedException("DELETE from Paimon append tables only supports conditions on the columns "
+			                              "of the table");
+		}
+		ref.index = columns[ref.index];
+		return;
+	}
+	ExpressionIterator::EnumerateChildren(expr, [&](unique_ptr<Expression> &child) { RemapColumns(*child, columns); });
+}
+
+static void SplitConjuncts(unique_ptr<Expression> expr, vector<unique_ptr<Expression>> &conjuncts) {
+	if (expr->GetExpressionType() == ExpressionType::CONJUNCTION_AND) {
+		for (auto &child : expr->Cast<BoundConjunctionExpression>().children) {
+			SplitConjuncts(std::move(child), conjuncts);
+		}
+		return;
+	}
+	conjuncts.push_back(std::move(expr));
+}
+
+//! The table column of every output column of 'op' (INVALID_INDEX for computed columns). The filters of 'op' and its
+//! children are added to 'conjuncts'.
+static vector<idx_t> CollectConjuncts(PhysicalOperator &op, TableCatalogEntry &table,
+                                      vector<unique_ptr<Expression>> &conjuncts) {
+	auto &columns = table.GetColumns();
+	switch (op.type) {
+	case PhysicalOperatorType::TABLE_SCAN: {
+		auto &scan = op.Cast<PhysicalTableScan>();
+		if (scan.function.name != "paimon_scan") {
+			break;
+		}
+		vector<idx_t> scan_columns;
+		for (auto &column_id : scan.column_ids) {
+			auto col_idx = column_id.GetPrimaryIndex();
+			//! The row id is not a column of Paimon tables, it can only be projected
+			scan_columns.push_back(col_idx < columns.PhysicalColumnCount() ? col_idx : DConstants::INVALID_INDEX);
+		}
+		if (scan.table_filters) {
+			for (auto &entry : scan.table_filters->filters) {
+				auto col_idx = scan_columns[entry.first];
+				if (col_idx == DConstants::INVALID_INDEX) {
+					throw NotImplementedException("DELETE from Paimon append tables only supports conditions on the "
+					                              "columns of the table");
+				}
+				BoundReferenceExpression column(columns.GetColumn(PhysicalIndex(col_idx)).Type(), col_idx);
+				conjuncts.push_back(entry.second->ToExpression(column));
+			}
+		}
+		if (scan.projection_ids.empty()) {
+			return scan_columns;
+		}
+		vector<idx_t> result;
+		for (auto projection_id : scan.projection_ids) {
+			result.push_back(scan_columns[projection_id]);
+		}
+		return result;
+	}
+	case PhysicalOperatorType::FILTER: {
+		auto child_columns = CollectConjuncts(op.children[0].get(), table, conjuncts);
+		auto expr = op.Cast<PhysicalFilter>().expression->Copy();
+		RemapColumns(*expr, child_columns);
+		SplitConjuncts(std::move(expr), conjuncts);
+		return child_columns;
+	}
+	case PhysicalOperatorType::PROJECTION: {
+		auto child_columns = CollectConjuncts(op.children[0].get(), table, conjuncts);
+		vector<idx_t> result;
+		for (auto &expr : op.Cast<PhysicalProjection>().select_list) {
+			if (expr->GetExpressionClass() == ExpressionClass::BOUND_REF) {
+				result.push_back(child_columns[expr->Cast<BoundReferenceExpression>().index]);
+			} else {
+				result.push_back(DConstants::INVALID_INDEX);
+			}
+		}
+		return result;
+	}
+	default:
+		break;
+	}
+	throw NotImplementedException("DELETE from Paimon append tables only supports conditions on the columns of the "
+	                              "table, joins and subqueries are not supported");
+}
+
+vector<unique_ptr<Expression>> PaimonAppendDelete::ExtractConjuncts(PhysicalOperator &plan, TableCatalogEntry &table) {
+	vector<unique_ptr<Expression>> result;
+	CollectConjuncts(plan, table, result);
+	return result;
+}
+
+namespace {
+
+//! Which rows of a data file a predicate selects
+enum class FileMatch : uint8_t { NONE, SOME, ALL };
+
+//! The value stats of a data file, by table column. Columns without stats have NULL min and max values.
+struct FileStats {
+	vector<Value> min_values;
+	vector<Value> max_values;
+	vector<Value> null_counts;
+};
+
+//! The WHERE clause of an append table delete, matched against the partition values and value stats of data files
+class DeletePredicate {
 public:
-	explicit PaimonDeleteSourceState(const PaimonDelete &op) {
+	DeletePredicate(ClientContext &context, PaimonWriteLayout &layout, const vector<unique_ptr<Expression>> &conjuncts)
+	    : context(context), layout(layout), conjuncts(conjuncts) {
+		for (auto &conjunct : conjuncts) {
+			bool partition_only = !conjunct->IsVolatile();
+			ExpressionIterator::VisitExpression<BoundReferenceExpression>(
+			    *conjunct, [&](const BoundReferenceExpression &ref) {
+				    auto &keys = layout.partition_key_indexes;
+				    partition_only = partition_only && std::find(keys.begin(), keys.end(), ref.index) != keys.end();
+			    });
+			partition_conjuncts.push_back(partition_only);
+		}
+	}
+
+	//! Which rows of 'entry' the predicate selects, decided by the entry's partition values and value stats only
+	FileMatch Match(const PaimonManifestEntry &entry) {
+		auto result = MatchPartition(entry.partition);
+		if (result == FileMatch::NONE) {
+			return result;
+		}
+		FileStats stats;
+		bool has_stats = ReadStats(entry.file, stats);
+		for (idx_t i = 0; i < conjuncts.size(); i++) {
+			if (partition_conjuncts[i]) {
+				continue;
+			}
+			auto match = has_stats ? MatchStats(*conjuncts[i], stats, entry.file.rowCount) : FileMatch::SOME;
+			if (match == FileMatch::NONE) {
+				return match;
+			}
+			if (match == FileMatch::SOME) {
+				result = match;
+			}
+		}
+		return result;
+	}
+
+	//! Read 'entry', and add the positions of the rows selected by the predicate to 'result'
+	void Select(const PaimonManifestEntry &entry, roaring::Roaring &result) const {
+		unique_ptr<Expression> predicate;
+		if (conjuncts.size() == 1) {
+			predicate = conjuncts[0]->Copy();
+		} else {
+			auto conjunction = make_uniq<BoundConjunctionExpression>(ExpressionType::CONJUNCTION_AND);
+			for (auto &conjunct : conjuncts) {
+				conjunction->children.push_back(conjunct->Copy());
+			}
+			predicate = std::move(conjunction);
+		}
+		ExpressionExecutor executor(context, *predicate);
+
+		//! Rows are identified by their position in the file, as read by the parquet scan
+		PaimonDataFileReader reader(context, *layout.bind, layout.DataFilePath(entry), nullptr, nullptr, true);
+		DataChunk chunk;
+		chunk.Initialize(context, layout.bind->types, STANDARD_VECTOR_SIZE);
+		SelectionVector sel(STANDARD_VECTOR_SIZE);
+		while (reader.Next(chunk)) {
+			auto count = executor.SelectExpression(chunk, sel);
+			UnifiedVectorFormat row_numbers;
+			reader.RowNumbers().ToUnifiedFormat(chunk.size(), row_numbers);
+			auto positions = UnifiedVectorFormat::GetData<int64_t>(row_numbers);
+			for (idx_t i = 0; i < count; i++) {
+				auto row = row_numbers.sel->get_index(sel.get_index(i));
+				result.add(NumericCast<uint32_t>(positions[row]));
+			}
+		}
+	}
+
+private:
+	//! Conjuncts on partition columns only are evaluated exactly, all rows of a file share its partition values
+	FileMatch MatchPartition(const vector<uint8_t> &partition) {
+		string key(const_char_ptr_cast(partition.data()), partition.size());
+		auto entry = partition_matches.find(key);
+		if (entry != partition_matches.end()) {
+			return entry->second;
+		}
+		auto result = FileMatch::ALL;
+		DataChunk row;
+		bool initialized = false;
+		for (idx_t i = 0; i < conjuncts.size() && result == FileMatch::ALL; i++) {
+			if (!partition_conjuncts[i]) {
+				continue;
+			}
+			if (!initialized) {
+				row.Initialize(context, layout.column_types, 1);
+				for (idx_t col_idx = 0; col_idx < layout.column_types.size(); col_idx++) {
+					row.SetValue(col_idx, 0, Value(layout.column_types[col_idx]));
+				}
+				auto values = PaimonBinaryRow::Deserialize(partition, layout.partition_types);
+				for (idx_t key_idx = 0; key_idx < values.size(); key_idx++) {
+					row.SetValue(layout.partition_key_indexes[key_idx], 0,
+					             values[key_idx].DefaultCastAs(layout.column_types[layout.partition_key_indexes[key_idx]]));
+				}
+				row.SetCardinality(1);
+				initialized = true;
+			}
+			ExpressionExecutor executor(context, *conjuncts[i]);
+			Vector selected(LogicalType::BOOLEAN);
+			executor.ExecuteExpression(row, selected);
+			auto value = selected.GetValue(0);
+			if (value.IsNull() || !BooleanValue::Get(value)) {
+				result = FileMatch::NONE;
+			}
+		}
+		partition_matches.emplace(std::move(key), result);
+		return result;
+	}
+
+	bool ReadStats(const DataFileMeta &file, FileStats &stats) const {
+		//! Columns may have been renamed or retyped since older files were written
+		if (file.schemaId != layout.schema_id || file.valueStats.minValues.empty() ||
+		    file.valueStats.maxValues.empty()) {
+			return false;
+		}
+		auto column_count = layout.column_types.size();
+		vector<idx_t> stats_columns;
+		if (file.valueStatsCols.empty()) {
+			for (idx_t col_idx = 0; col_idx < column_count; col_idx++) {
+				stats_columns.push_back(col_idx);
+			}
+		} else {
+			for (auto &name : file.valueStatsCols) {
+				auto entry = std::find(layout.column_names.begin(), layout.column_names.end(), name);
+				if (entry == layout.column_names.end()) {
+					return false;
+				}
+				stats_columns.push_back(NumericCast<idx_t>(entry - layout.column_names.begin()));
+			}
+		}
+		vector<LogicalType> stats_types;
+		for (auto col_idx : stats_columns) {
+			stats_types.push_back(layout.column_types[col_idx]);
+		}
+		auto min_values = PaimonBinaryRow::Deserialize(file.valueStats.minValues, stats_types);
+		auto max_values = PaimonBinaryRow::Deserialize(file.valueStats.maxValues, stats_types);
+		stats.min_values.assign(column_count, Value());
+		stats.max_values.assign(column_count, Value());
+		stats.null_counts.assign(column_count, Value());
+		for (idx_t i = 0; i < stats_columns.size(); i++) {
+			auto col_idx = stats_columns[i];
+			stats.min_values[col_idx] = min_values[i];
+			stats.max_values[col_idx] = max_values[i];
+			if (i < file.valueStats.nullCounts.size()) {
+				stats.null_counts[col_idx] = file.valueStats.nullCounts[i];
+			}
+		}
+		return true;
+	}
+
+	//! Match 'column <comparison> constant' and 'column IS [NOT] NULL' against the value stats, anything else may
+	//! select some rows
+	static FileMatch MatchStats(const Expression &conjunct, const FileStats &stats, int64_t row_count) {
+		optional_idx col_idx;
+		Value constant;
+		auto comparison = conjunct.GetExpressionType();
+		switch (conjunct.GetExpressionClass()) {
+		case ExpressionClass::BOUND_COMPARISON: {
+			auto &compare = conjunct.Cast<BoundComparisonExpression>();
+			auto &left = *compare.left;
+			auto &right = *compare.right;
+			if (left.GetExpressionClass() == ExpressionClass::BOUND_REF &&
+			    right.GetExpressionClass() == ExpressionClass::BOUND_CONSTANT) {
+				col_idx = left.Cast<BoundReferenceExpression>().index;
+				constant = right.Cast<BoundConstantExpression>().value;
+			} else if (left.GetExpressionClass() == ExpressionClass::BOUND_CONSTANT &&
+			           right.GetExpressionClass() == ExpressionClass::BOUND_REF) {
+				col_idx = right.Cast<BoundReferenceExpression>().index;
+				constant = left.Cast<BoundConstantExpression>().value;
+				comparison = FlipComparisonExpression(comparison);
+			}
+			break;
+		}
+		case ExpressionClass::BOUND_OPERATOR: {
+			auto &op = conjunct.Cast<BoundOperatorExpression>();
+			if ((comparison == ExpressionType::OPERATOR_IS_NULL ||
+			     comparison == ExpressionType::OPERATOR_IS_NOT_NULL) &&
+			    op.children.size() == 1 && op.children[0]->GetExpressionClass() == ExpressionClass::BOUND_REF) {
+				col_idx = op.children[0]->Cast<BoundReferenceExpression>().index;
+			}
+			break;
+		}
+		default:
+			break;
+		}
+		if (!col_idx.IsValid()) {
+			return FileMatch::SOME;
+		}
+
+		auto &null_count_value = stats.null_counts[col_idx.GetIndex()];
+		bool all_null = false;
+		bool no_null = false;
+		if (!null_count_value.IsNull()) {
+			auto null_count = null_count_value.GetValue<int64_t>();
+			all_null = null_count == row_count;
+			no_null = null_count == 0;
+		}
+		if (comparison == ExpressionType::OPERATOR_IS_NULL || comparison == ExpressionType::OPERATOR_IS_NOT_NULL) {
+			bool is_null = comparison == ExpressionType::OPERATOR_IS_NULL;
+			if (all_null) {
+				return is_null ? FileMatch::ALL : FileMatch::NONE;
+			}
+			if (no_null) {
+				return is_null ? FileMatch::NONE : FileMatch::ALL;
+			}
+			return FileMatch::SOME;
+		}
+
+		//! Comparisons with NULL never select a row
+		if (constant.IsNull() || all_null) {
+			return FileMatch::NONE;
+		}
+		auto &min = stats.min_values[col_idx.GetIndex()];
+		auto &max = stats.max_values[col_idx.GetIndex()];
+		if (min.IsNull() || max.IsNull() || min.type() != constant.type() || max.type() != constant.type()) {
+			return FileMatch::SOME;
+		}
+		bool none;
+		bool all;
+		switch (comparison) {
+		case ExpressionType::COMPARE_EQUAL:
+			none = constant < min || constant > max;
+			all = min == constant && max == constant;
+			break;
+		case ExpressionType::COMPARE_NOTEQUAL:
+			none = min == constant && max == constant;
+			all = constant < min || constant > max;
+			break;
+		case ExpressionType::COMPARE_LESSTHAN:
+			none = min >= constant;
+			all = max < constant;
+			break;
+		case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+			none = min > constant;
+			all = max <= constant;
+			break;
+		case ExpressionType::COMPARE_GREATERTHAN:
+			none = max <= constant;
+			all = min > constant;
+			break;
+		case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+			none = max < constant;
+			all = min >= constant;
+			break;
+		default:
+			return FileMatch::SOME;
+		}
+		if (none) {
+			return FileMatch::NONE;
+		}
+		//! NULL values are not selected by a comparison, so all rows only match if none are NULL
+		return all && no_null ? FileMatch::ALL : FileMatch::SOME;
 	}
 
+private:
+	ClientContext &context;
+	PaimonWriteLayout &layout;
+	const vector<unique_ptr<Expression>> &conjuncts;
+	//! For every conjunct, whether it only references partition columns
+	vector<bool> partition_conjuncts;
+	//! The match of the partition conjuncts of every partition seen so far, keyed on the partition BinaryRow
+	unordered_map<string, FileMatch> partition_matches;
+};
+
+//! Reads a data file the predicate may partially select, and collects the positions of the selected rows
+class DeleteSelectTask : public BaseExecutorTask {
 public:
-	bool finished = false;
+	DeleteSelectTask(TaskExecutor &executor, const DeletePredicate &predicate, const PaimonManifestEntry &entry,
+	                 roaring::Roaring &result)
+	    : BaseExecutorTask(executor), predicate(predicate), entry(entry), result(result) {
+	}
+
+	void ExecuteTask() override {
+		predicate.Select(entry, result);
+	}
+
+private:
+	const DeletePredicate &predicate;
+	const PaimonManifestEntry &entry;
+	roaring::Roaring &result;
 };
 
-unique_ptr<GlobalSourceState> PaimonDelete::GetGlobalSourceState(ClientContext &context) const {
-	return make_uniq<PaimonDeleteSourceState>(*this);
+} // namespace
+
+static string DeleteBucketKey(const PaimonManifestEntry &entry) {
+	string result(const_char_ptr_cast(entry.partition.data()), entry.partition.size());
+	result.append(const_char_ptr_cast(&entry.bucket), sizeof(entry.bucket));
+	return result;
 }
 
-SourceResultType PaimonDelete::GetData(ExecutionContext &context, DataChunk &chunk, OperatorSourceInput &input) const {
-	auto &state = input.global_state->Cast<PaimonDeleteSourceState>();
+unique_ptr<GlobalSourceState> PaimonAppendDelete::GetGlobalSourceState(ClientContext &context) const {
+	return make_uniq<GlobalSourceState>();
+}
 
-	if (finished) {
-		return SourceResultType::FINISHED;
-	}
+SourceResultType PaimonAppendDelete::GetData(ExecutionContext &context, DataChunk &chunk,
+                                             OperatorSourceInput &input) const {
+	auto &client = context.client;
+	auto &fs = FileSystem::GetFileSystem(client);
+	PaimonWriteLayout layout(client, tableref.Cast<PaimonTableEntry>());
+	layout.CheckWritable();
+	idx_t delete_count = 0;
+	auto latest_id = PaimonTableMetadata::FindLatestSnapshotId(layout.table_path, fs);
+	if (latest_id > 0) {
+		auto snapshot = paimon_snapshot::Read(client, layout.table_path, latest_id);
+		auto live_files = paimon_snapshot::ReadLiveFiles(client, layout.table_path, snapshot);
+		PaimonDeletionVectors deletion_vectors(client, layout.table_path, snapshot);
 
-	auto &global_state = sink_state->Cast<PaimonDeleteGlobalState>();
+		//! Decide per file from the metadata, only files that are partially deleted are read
+		DeletePredicate predicate(client, layout, conjuncts);
+		vector<PaimonManifestEntry> entries;
+		vector<reference<const PaimonManifestEntry>> partial_files;
+		for (auto &entry : live_files) {
+			auto match = predicate.Match(entry);
+			if (match == FileMatch::ALL) {
+				entries.push_back(entry);
+				entries.back().kind = PaimonFileKind::DELETE;
+			} else if (match == FileMatch::SOME) {
+				partial_files.push_back(entry);
+			}
+		}
+		if (!partial_files.empty() && !StringUtil::CIEquals(layout.GetOption("deletion-vectors.enabled"), "true")) {
+			throw InvalidInputException("Cannot delete individual rows from Paimon append table \"%s\" without "
+			                            "deletion vectors, set the table option 'deletion-vectors.enabled' to 'true', "
+			                            "or delete whole partitions",
+			                            tableref.name);
+		}
 
-	if (return_chunk) {
-		global_state.return_collection.Reset();
-		DataChunk return_chunk;
-		global_state.return_collection.FetchChunk(0, return_chunk);
-		chunk.Reference(return_chunk);
+		vector<roaring::Roaring> selected(partial_files.size());
+		TaskExecutor executor(client);
+		for (idx_t i = 0; i < partial_files.size(); i++) {
+			executor.ScheduleTask(make_uniq<DeleteSelectTask>(executor, predicate, partial_files[i], selected[i]));
+		}
+		executor.WorkOnTasks();
+
+		//! Rows that are already deleted are not counted again
+		for (auto &entry : entries) {
+			roaring::Roaring deleted;
+			deletion_vectors.Read(entry.file.fileName, deleted);
+			delete_count += NumericCast<idx_t>(entry.file.rowCount) - deleted.cardinality();
+		}
+		unordered_map<string, map<string, roaring::Roaring>> updated_vectors;
+		for (idx_t i = 0; i < partial_files.size(); i++) {
+			auto &entry = partial_files[i].get();
+			roaring::Roaring deleted;
+			deletion_vectors.Read(entry.file.fileName, deleted);
+			auto merged = deleted | selected[i];
+			auto added = merged.cardinality() - deleted.cardinality();
+			if (added == 0) {
+				continue;
+			}
+			delete_count += added;
+			if (merged.cardinality() >= NumericCast<uint64_t>(entry.file.rowCount)) {
+				//! Every row of the file is deleted now, so the file itself is removed
+				entries.push_back(entry);
+				entries.back().kind = PaimonFileKind::DELETE;
+			} else {
+				updated_vectors[DeleteBucketKey(entry)][entry.file.fileName] = std::move(merged);
+			}
+		}
+
+		//! The index file of every bucket with new deletion vectors, or with removed files that had one, is replaced
+		unordered_map<string, reference<const PaimonManifestEntry>> changed_buckets;
+		for (auto &entry : entries) {
+			roaring::Roaring unused;
+			if (deletion_vectors.Read(entry.file.fileName, unused)) {
+				changed_buckets.emplace(DeleteBucketKey(entry), entry);
+			}
+		}
+		for (auto &file : partial_files) {
+			auto key = DeleteBucketKey(file.get());
+			if (updated_vectors.find(key) != updated_vectors.end()) {
+				changed_buckets.emplace(key, file);
+			}
+		}
+		vector<PaimonIndexManifestEntry> index_changes;
+		vector<string> index_files;
+		try {
+			for (auto &bucket : changed_buckets) {
+				auto &first = bucket.second.get();
+				auto bucket_vectors = deletion_vectors.ReadBucket(first.partition, first.bucket);
+				for (auto &entry : entries) {
+					bucket_vectors.erase(entry.file.fileName);
+				}
+				for (auto &updated : updated_vectors[bucket.first]) {
+					bucket_vectors[updated.first] = std::move(updated.second);
+				}
+				deletion_vectors.WriteBucket(first.partition, first.bucket, bucket_vectors, index_changes,
+				                             index_files);
+			}
+			if (!entries.empty() || !index_changes.empty()) {
+				//! Removing files is an overwrite, which streaming readers do not pick up as new data
+				PaimonCommit commit(client, layout);
+				commit.Commit(entries, entries.empty() ? PaimonCommitKind::APPEND : PaimonCommitKind::OVERWRITE,
+				              vector<PaimonManifestEntry>(), index_changes);
+			}
+		} catch (std::exception &) {
+			for (auto &path : index_files) {
+				fs.TryRemoveFile(path);
+			}
+			throw;
+		}
 	}
 
-	finished = true;
-	return SourceResultType::HAVE_MORE_OUTPUT;
+	chunk.SetCardinality(1);
+	chunk.SetValue(0, 0, Value::BIGINT(NumericCast<int64_t>(delete_count)));
+	return SourceResultType::FINISHED;
 }
 
-//===--------------------------------------------------------------------===//
-// Helpers
-//===--------------------------------------------------------------------===//
-string PaimonDelete::GetName() const {
-	return "PAIMON_DELETE";
+string PaimonAppendDelete::GetName() const {
+	return "PAIMON_APPEND_DELETE";
 }
 
-InsertionOrderPreservingMap<string> PaimonDelete::ParamsToString() const {
+InsertionOrderPreservingMap<string> PaimonAppendDelete::ParamsToString() const {
 	InsertionOrderPreservingMap<string> result;
 	result["Table"] = tableref.name;
+	string conditions;
+	for (idx_t i = 0; i < conjuncts.size(); i++) {
+		if (i > 0) {
+			conditions += " AND ";
+		}
+		conditions += conjuncts[i]->ToString();
+	}
+	result["Conditions"] = conditions;
 	return result;
 }
 
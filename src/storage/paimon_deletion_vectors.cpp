@@ -0,0 +1,211 @@
+#include "storage/paimon_deletion_vectors.hpp"
+#include "paimon_manifest.hpp"
+
+#include "duckdb/common/bswap.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/types/uuid.hpp"
+#include "duckdb/main/client_context.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+//! CRC32 (IEEE) of 'data', as computed by java.util.zip.CRC32
+static uint32_t ComputeCRC32(const_data_ptr_t data, idx_t size) {
+	static uint32_t table[256];
+	static bool initialized = [] {
+		for (uint32_t i = 0; i < 256; i++) {
+			uint32_t value = i;
+			for (idx_t bit = 0; bit < 8; bit++) {
+				value = (value & 1) ? 0xEDB88320U ^ (value >> 1) : value >> 1;
+			}
+			table[i] = value;
+		}
+		return true;
+	}();
+	(void)initialized;
+	uint32_t crc = 0xFFFFFFFFU;
+	for (idx_t i = 0; i < size; i++) {
+		crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+	}
+	return crc ^ 0xFFFFFFFFU;
+}
+
+//! Paimon writes the integers of index files big-endian (java.io.DataOutputStream)
+static void AppendInt32(vector<data_t> &buffer, int32_t value) {
+	auto offset = buffer.size();
+	buffer.resize(offset + sizeof(int32_t));
+	Store<uint32_t>(BSwap(static_cast<uint32_t>(value)), buffer.data() + offset);
+}
+
+static int32_t LoadInt32(const_data_ptr_t data) {
+	return static_cast<int32_t>(BSwap(Load<uint32_t>(data)));
+}
+
+PaimonDeletionVectors::PaimonDeletionVectors(ClientContext &context, const string &table_path_p,
+                                             const PaimonSnapshotInfo &snapshot)
+    : context(context), table_path(table_path_p), path_factory(table_path_p),
+      file_uuid(UUID::ToString(UUID::GenerateRandomUUID())) {
+	index_files = ReadIndexFiles(context, table_path, snapshot);
+	for (idx_t i = 0; i < index_files.size(); i++) {
+		auto &index_file = index_files[i];
+		if (index_file.indexType != INDEX_TYPE) {
+			continue;
+		}
+		bucket_index_files[BucketKey(index_file.partition, index_file.bucket)].push_back(i);
+		for (idx_t range = 0; range < index_file.deletionVectorRanges.size(); range++) {
+			vectors[index_file.deletionVectorRanges[range].dataFileName] = VectorLocation {i, range};
+		}
+	}
+}
+
+string PaimonDeletionVectors::BucketKey(const vector<uint8_t> &partition, int32_t bucket) {
+	string result(const_char_ptr_cast(partition.data()), partition.size());
+	result.append(const_char_ptr_cast(&bucket), sizeof(bucket));
+	return result;
+}
+
+string PaimonDeletionVectors::IndexFilePath(const string &table_path, const string &file_name) {
+	return table_path + "/index/" + file_name;
+}
+
+vector<PaimonIndexManifestEntry> PaimonDeletionVectors::ReadIndexFiles(ClientContext &context,
+                                                                       const string &table_path,
+                                                                       const PaimonSnapshotInfo &snapshot) {
+	vector<PaimonIndexManifestEntry> result;
+	if (snapshot.index_manifest.empty()) {
+		return result;
+	}
+	auto entries = paimon_index_manifest::ReadFromFile(
+	    context, paimon_snapshot::ManifestPath(table_path, snapshot.index_manifest));
+	//! Index manifests list the live index files, written by other engines they may still contain DELETE entries
+	MergeIndexFiles(result, entries);
+	return result;
+}
+
+bool PaimonDeletionVectors::MergeIndexFiles(vector<PaimonIndexManifestEntry> &index_files,
+                                            const vector<PaimonIndexManifestEntry> &changes) {
+	bool all_removed = true;
+	for (auto &change : changes) {
+		if (change.kind == PaimonFileKind::ADD) {
+			index_files.push_back(change);
+			continue;
+		}
+		auto entry = std::find_if(index_files.begin(), index_files.end(),
+		                          [&](const PaimonIndexManifestEntry &file) { return file.fileName == change.fileName; });
+		if (entry == index_files.end()) {
+			all_removed = false;
+			continue;
+		}
+		index_files.erase(entry);
+	}
+	return all_removed;
+}
+
+bool PaimonDeletionVectors::Read(const string &file_name, roaring::Roaring &result) const {
+	auto entry = vectors.find(file_name);
+	if (entry == vectors.end()) {
+		return false;
+	}
+	auto &index_file = index_files[entry->second.index_file];
+	auto &range = index_file.deletionVectorRanges[entry->second.range];
+	auto path = IndexFilePath(table_path, index_file.fileName);
+
+	//! Only the range of the data file is read: its size, followed by the magic number and the bitmap
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ);
+	auto length = NumericCast<idx_t>(range.length);
+	auto buffer = make_unsafe_uniq_array<data_t>(sizeof(int32_t) + length);
+	handle->Read(buffer.get(), sizeof(int32_t) + length, NumericCast<idx_t>(range.offset));
+	if (NumericCast<idx_t>(LoadInt32(buffer.get())) != length || length < sizeof(int32_t)) {
+		throw InvalidInputException("Paimon deletion vector of \"%s\" in index file \"%s\" has an invalid size",
+		                            file_name, path);
+	}
+	auto data = buffer.get() + sizeof(int32_t);
+	if (LoadInt32(data) != MAGIC_NUMBER) {
+		throw InvalidInputException("Paimon deletion vector of \"%s\" in index file \"%s\" is corrupt: magic number "
+		                            "mismatch",
+		                            file_name, path);
+	}
+	result = roaring::Roaring::readSafe(const_char_ptr_cast(data + sizeof(int32_t)), length - sizeof(int32_t));
+	return true;
+}
+
+map<string, roaring::Roaring> PaimonDeletionVectors::ReadBucket(const vector<uint8_t> &partition,
+                                                                int32_t bucket) const {
+	map<string, roaring::Roaring> result;
+	auto entry = bucket_index_files.find(BucketKey(partition, bucket));
+	if (entry == bucket_index_files.end()) {
+		return result;
+	}
+	for (auto index_file : entry->second) {
+		for (auto &range : index_files[index_file].deletionVectorRanges) {
+			Read(range.dataFileName, result[range.dataFileName]);
+		}
+	}
+	return result;
+}
+
+void PaimonDeletionVectors::WriteBucket(const vector<uint8_t> &partition, int32_t bucket,
+                                        const map<string, roaring::Roaring> &bucket_vectors,
+                                        vector<PaimonIndexManifestEntry> &changes, vector<string> &written_files) {
+	auto entry = bucket_index_files.find(BucketKey(partition, bucket));
+	if (entry != bucket_index_files.end()) {
+		for (auto index_file : entry->second) {
+			PaimonIndexManifestEntry removed = index_files[index_file];
+			removed.kind = PaimonFileKind::DELETE;
+			changes.push_back(std::move(removed));
+		}
+	}
+
+	PaimonIndexManifestEntry index_file;
+	index_file.partition = partition;
+	index_file.bucket = bucket;
+	index_file.indexType = INDEX_TYPE;
+	vector<data_t> buffer;
+	buffer.push_back(VERSION_ID);
+	for (auto &vector_entry : bucket_vectors) {
+		auto bitmap = vector_entry.second;
+		if (bitmap.isEmpty()) {
+			continue;
+		}
+		bitmap.runOptimize();
+		auto bitmap_size = bitmap.getSizeInBytes(true);
+		PaimonDeletionVectorMeta range;
+		range.dataFileName = vector_entry.first;
+		range.offset = NumericCast<int32_t>(buffer.size());
+		range.length = NumericCast<int32_t>(sizeof(int32_t) + bitmap_size);
+		range.cardinality = bitmap.cardinality();
+
+		AppendInt32(buffer, range.length);
+		auto vector_start = buffer.size();
+		AppendInt32(buffer, MAGIC_NUMBER);
+		buffer.resize(vector_start + NumericCast<idx_t>(range.length));
+		bitmap.write(char_ptr_cast(buffer.data() + vector_start + sizeof(int32_t)), true);
+		auto checksum = ComputeCRC32(buffer.data() + vector_start, NumericCast<idx_t>(range.length));
+		AppendInt32(buffer, static_cast<int32_t>(checksum));
+		index_file.deletionVectorRanges.push_back(std::move(range));
+	}
+	if (index_file.deletionVectorRanges.empty()) {
+		return;
+	}
+
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto index_dir = table_path + "/index";
+	if (!fs.DirectoryExists(index_dir)) {
+		fs.CreateDirectory(index_dir);
+	}
+	auto path = path_factory.indexFilePath(file_uuid, NumericCast<int>(file_counter++));
+	written_files.push_back(path);
+	auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+	handle->Write(buffer.data(), buffer.size());
+	handle->Sync();
+	handle->Close();
+
+	index_file.fileName = path.substr(path.find_last_of('/') + 1);
+	index_file.fileSize = NumericCast<int64_t>(buffer.size());
+	index_file.rowCount = NumericCast<int64_t>(index_file.deletionVectorRanges.size());
+	changes.push_back(std::move(index_file));
+}
+
+} // namespace duckdb
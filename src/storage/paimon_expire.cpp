@@ -0,0 +1,416 @@
+#include "storage/paimon_expire.hpp"
+#include "storage/paimon_commit.hpp"
+#include "storage/paimon_deletion_vectors.hpp"
+#include "storage/paimon_table_writer.hpp"
+#include "paimon_manifest.hpp"
+
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/parallel/task_executor.hpp"
+
+namespace duckdb {
+
+namespace {
+
+class DeleteFilesTask : public BaseExecutorTask {
+public:
+	DeleteFilesTask(TaskExecutor &executor, FileSystem &fs, const vector<string> &paths, idx_t start, idx_t end,
+	                atomic<idx_t> &deleted)
+	    : BaseExecutorTask(executor), fs(fs), paths(paths), start(start), end(end), deleted(deleted) {
+	}
+
+	void ExecuteTask() override {
+		for (idx_t i = start; i < end; i++) {
+			if (fs.TryRemoveFile(paths[i])) {
+				deleted++;
+			}
+		}
+	}
+
+private:
+	FileSystem &fs;
+	const vector<string> &paths;
+	idx_t start;
+	idx_t end;
+	atomic<idx_t> &deleted;
+};
+
+} // namespace
+
+//! Deletes are latency bound on object stores, every task deletes a batch of files
+static constexpr idx_t DELETE_BATCH_SIZE = 32;
+
+idx_t paimon_expire::DeleteFiles(ClientContext &context, const vector<string> &paths) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	atomic<idx_t> deleted(0);
+	TaskExecutor executor(context);
+	for (idx_t start = 0; start < paths.size(); start += DELETE_BATCH_SIZE) {
+		auto end = MinValue(start + DELETE_BATCH_SIZE, paths.size());
+		executor.ScheduleTask(make_uniq<DeleteFilesTask>(executor, fs, paths, start, end, deleted));
+	}
+	executor.WorkOnTasks();
+	return deleted.load();
+}
+
+vector<PaimonSnapshotInfo> paimon_expire::ReadTags(ClientContext &context, const string &table_path) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	vector<PaimonSnapshotInfo> result;
+	auto tag_dir = table_path + "/tag";
+	if (!fs.DirectoryExists(tag_dir)) {
+		return result;
+	}
+	vector<string> tag_files;
+	fs.ListFiles(tag_dir, [&](const string &name, bool is_dir) {
+		if (!is_dir && StringUtil::StartsWith(name, "tag-")) {
+			tag_files.push_back(tag_dir + "/" + name);
+		}
+	});
+	for (auto &tag_file : tag_files) {
+		result.push_back(paimon_snapshot::ReadFile(context, tag_file));
+	}
+	return result;
+}
+
+//! The data file of 'entry' and its extra files (e.g. indexes), which are stored next to it
+static void AddDataFilePaths(const PaimonWriteLayout &layout, const PaimonManifestEntry &entry,
+                             vector<string> &result) {
+	auto path = layout.DataFilePath(entry);
+	auto dir = path.substr(0, path.find_last_of('/') + 1);
+	result.push_back(std::move(path));
+	for (auto &extra_file : entry.file.extraFiles) {
+		result.push_back(dir + extra_file);
+	}
+}
+
+//! Data files outside the table's directory are referenced through their external path, e.g. the Iceberg data files
+//! migrated by iceberg_to_paimon. They are not owned by the table and are never deleted.
+static bool IsTableFile(const string &table_path, const string &path) {
+	return StringUtil::StartsWith(path, table_path + "/");
+}
+
+//! An interrupted expiration may already have deleted some files of the snapshots it expired
+static vector<PaimonManifestFileMeta> ReadManifestList(ClientContext &context, const string &table_path,
+                                                       const string &list) {
+	auto path = paimon_snapshot::ManifestPath(table_path, list);
+	if (list.empty() || !FileSystem::GetFileSystem(context).FileExists(path)) {
+		return vector<PaimonManifestFileMeta>();
+	}
+	return paimon_manifest_list::ReadFromFile(context, path);
+}
+
+static vector<PaimonManifestEntry> ReadManifest(ClientContext &context, const string &table_path,
+                                                const string &manifest) {
+	auto path = paimon_snapshot::ManifestPath(table_path, manifest);
+	if (!FileSystem::GetFileSystem(context).FileExists(path)) {
+		return vector<PaimonManifestEntry>();
+	}
+	return paimon_manifest_file::ReadFromFile(context, path);
+}
+
+static vector<PaimonIndexManifestEntry> ReadIndexManifest(ClientContext &context, const string &table_path,
+                                                          const string &index_manifest) {
+	auto path = paimon_snapshot::ManifestPath(table_path, index_manifest);
+	if (index_manifest.empty() || !FileSystem::GetFileSystem(context).FileExists(path)) {
+		return vector<PaimonIndexManifestEntry>();
+	}
+	return paimon_index_manifest::ReadFromFile(context, path);
+}
+
+//===--------------------------------------------------------------------===//
+// Snapshot Expiration
+//===--------------------------------------------------------------------===//
+PaimonSnapshotExpirer::PaimonSnapshotExpirer(ClientContext &context, PaimonWriteLayout &layout)
+    : context(context), fs(FileSystem::GetFileSystem(context)), layout(layout) {
+}
+
+PaimonExpireResult PaimonSnapshotExpirer::Expire(const PaimonExpireOptions &options) {
+	PaimonExpireResult result;
+	auto latest_id = PaimonTableMetadata::FindLatestSnapshotId(layout.table_path, fs);
+	auto earliest_id = PaimonTableMetadata::FindEarliestSnapshotId(layout.table_path, fs);
+	result.earliest_snapshot_id = earliest_id;
+	if (latest_id == 0) {
+		return result;
+	}
+
+	auto retain_min = options.retain_last.IsValid()
+	                      ? options.retain_last.GetIndex()
+	                      : layout.GetIntegerOption("snapshot.num-retained.min", DEFAULT_NUM_RETAINED_MIN);
+	if (retain_min < 1) {
+		throw InvalidInputException("At least one snapshot of Paimon table \"%s\" must be retained",
+		                            layout.table_path);
+	}
+	auto retain_max =
+	    MaxValue(layout.GetIntegerOption("snapshot.num-retained.max", DEFAULT_NUM_RETAINED_MAX), retain_min);
+	int64_t older_than_ms;
+	if (options.has_older_than) {
+		older_than_ms = Timestamp::GetEpochMs(options.older_than);
+	} else {
+		older_than_ms = Timestamp::GetEpochMs(Timestamp::GetCurrentTimestamp()) -
+		                layout.GetDurationOption("snapshot.time-retained", DEFAULT_TIME_RETAINED);
+	}
+
+	auto snapshot_count = NumericCast<idx_t>(latest_id - earliest_id + 1);
+	if (snapshot_count <= retain_min) {
+		return result;
+	}
+	//! Snapshots beyond 'snapshot.num-retained.max' expire regardless of their age, the others once they are older
+	//! than 'older_than'. Snapshot times increase with their ids, so the first retained snapshot ends the range.
+	auto min_id = snapshot_count > retain_max ? latest_id - NumericCast<int64_t>(retain_max) + 1 : earliest_id;
+	auto max_exclusive_id = latest_id - NumericCast<int64_t>(retain_min) + 1;
+	auto end_id = max_exclusive_id;
+	for (auto id = min_id; id < max_exclusive_id; id++) {
+		if (paimon_snapshot::Read(context, layout.table_path, id).time_millis >= older_than_ms) {
+			end_id = id;
+			break;
+		}
+	}
+	if (end_id > earliest_id) {
+		ExpireUntil(earliest_id, end_id, result);
+	}
+	return result;
+}
+
+void PaimonSnapshotExpirer::ExpireUntil(int64_t earliest_id, int64_t end_id, PaimonExpireResult &result) {
+	auto &table_path = layout.table_path;
+
+	// The files that stay referenced: those of the new earliest snapshot, and those of tagged snapshots
+	unordered_set<string> retained_manifests;
+	unordered_set<string> retained_index_files;
+	unordered_set<string> tagged_data_files;
+	auto retain_snapshot = [&](const PaimonSnapshotInfo &snapshot) {
+		for (auto &list :
+		     {snapshot.base_manifest_list, snapshot.delta_manifest_list, snapshot.changelog_manifest_list}) {
+			if (list.empty()) {
+				continue;
+			}
+			retained_manifests.insert(list);
+			for (auto &manifest : ReadManifestList(context, table_path, list)) {
+				retained_manifests.insert(manifest.fileName);
+			}
+		}
+		if (!snapshot.index_manifest.empty()) {
+			retained_manifests.insert(snapshot.index_manifest);
+			for (auto &index_file : PaimonDeletionVectors::ReadIndexFiles(context, table_path, snapshot)) {
+				retained_index_files.insert(index_file.fileName);
+			}
+		}
+	};
+	retain_snapshot(paimon_snapshot::Read(context, table_path, end_id));
+	for (auto &tag : paimon_expire::ReadTags(context, table_path)) {
+		retain_snapshot(tag);
+		vector<string> paths;
+		for (auto &entry : paimon_snapshot::ReadLiveFiles(context, table_path, tag)) {
+			AddDataFilePaths(layout, entry, paths);
+		}
+		tagged_data_files.insert(paths.begin(), paths.end());
+	}
+
+	// The data files removed by the deltas of (earliest_id, end_id] were last live in an expired snapshot. A file
+	// that is upgraded to a higher level is removed and added back by the same delta, and stays live.
+	vector<string> deleted_paths;
+	unordered_set<string> data_files;
+	vector<string> entry_paths;
+	for (auto id = earliest_id + 1; id <= end_id; id++) {
+		auto snapshot = paimon_snapshot::Read(context, table_path, id);
+		for (auto &manifest : ReadManifestList(context, table_path, snapshot.delta_manifest_list)) {
+			for (auto &entry : ReadManifest(context, table_path, manifest.fileName)) {
+				entry_paths.clear();
+				AddDataFilePaths(layout, entry, entry_paths);
+				for (auto &path : entry_paths) {
+					if (entry.kind == PaimonFileKind::DELETE) {
+						data_files.insert(path);
+					} else {
+						data_files.erase(path);
+					}
+				}
+			}
+		}
+	}
+	for (auto &path : data_files) {
+		if (tagged_data_files.find(path) == tagged_data_files.end() && IsTableFile(table_path, path)) {
+			deleted_paths.push_back(path);
+		}
+	}
+
+	// The changelog, manifests and index files of the expired snapshots
+	unordered_set<string> manifests;
+	unordered_set<string> index_files;
+	for (auto id = earliest_id; id < end_id; id++) {
+		auto snapshot = paimon_snapshot::Read(context, table_path, id);
+		for (auto &list : {snapshot.base_manifest_list, snapshot.delta_manifest_list}) {
+			if (list.empty()) {
+				continue;
+			}
+			manifests.insert(list);
+			for (auto &manifest : ReadManifestList(context, table_path, list)) {
+				manifests.insert(manifest.fileName);
+			}
+		}
+		//! Changelog files are only read through the changelog of the snapshot that produced them
+		if (!snapshot.changelog_manifest_list.empty()) {
+			manifests.insert(snapshot.changelog_manifest_list);
+			for (auto &manifest : ReadManifestList(context, table_path, snapshot.changelog_manifest_list)) {
+				manifests.insert(manifest.fileName);
+				for (auto &entry : ReadManifest(context, table_path, manifest.fileName)) {
+					AddDataFilePaths(layout, entry, deleted_paths);
+				}
+			}
+		}
+		if (!snapshot.index_manifest.empty()) {
+			manifests.insert(snapshot.index_manifest);
+			for (auto &index_file : ReadIndexManifest(context, table_path, snapshot.index_manifest)) {
+				index_files.insert(index_file.fileName);
+			}
+		}
+	}
+	for (auto &index_file : index_files) {
+		if (retained_index_files.find(index_file) == retained_index_files.end()) {
+			deleted_paths.push_back(PaimonDeletionVectors::IndexFilePath(table_path, index_file));
+		}
+	}
+	vector<string> deleted_manifests;
+	for (auto &manifest : manifests) {
+		if (retained_manifests.find(manifest) == retained_manifests.end()) {
+			deleted_manifests.push_back(paimon_snapshot::ManifestPath(table_path, manifest));
+		}
+	}
+
+	// Data files go first and snapshot files last: until its snapshot file is deleted, an expired snapshot can
+	// still be found, and the next expiration deletes what is left of it
+	result.deleted_data_files = paimon_expire::DeleteFiles(context, deleted_paths);
+	result.deleted_manifests = paimon_expire::DeleteFiles(context, deleted_manifests);
+	for (auto id = earliest_id; id < end_id; id++) {
+		fs.TryRemoveFile(layout.path_factory.snapshotFilePath(id));
+	}
+	PaimonCommit::WriteHint(fs, layout.path_factory.earliestPointerPath(), end_id);
+	result.expired_snapshots = NumericCast<idx_t>(end_id - earliest_id);
+	result.earliest_snapshot_id = end_id;
+}
+
+//===--------------------------------------------------------------------===//
+// Orphan File Cleaning
+//===--------------------------------------------------------------------===//
+PaimonOrphanFileCleaner::PaimonOrphanFileCleaner(ClientContext &context, PaimonWriteLayout &layout)
+    : context(context), fs(FileSystem::GetFileSystem(context)), layout(layout) {
+}
+
+unordered_set<string> PaimonOrphanFileCleaner::ReferencedFiles() {
+	auto &table_path = layout.table_path;
+	vector<PaimonSnapshotInfo> snapshots;
+	auto latest_id = PaimonTableMetadata::FindLatestSnapshotId(table_path, fs);
+	if (latest_id > 0) {
+		for (auto id = PaimonTableMetadata::FindEarliestSnapshotId(table_path, fs); id <= latest_id; id++) {
+			snapshots.push_back(paimon_snapshot::Read(context, table_path, id));
+		}
+	}
+	for (auto &tag : paimon_expire::ReadTags(context, table_path)) {
+		snapshots.push_back(std::move(tag));
+	}
+
+	//! Consecutive snapshots share most of their manifests, every manifest is read once
+	unordered_set<string> manifests;
+	unordered_set<string> index_manifests;
+	unordered_set<string> result;
+	for (auto &snapshot : snapshots) {
+		for (auto &list :
+		     {snapshot.base_manifest_list, snapshot.delta_manifest_list, snapshot.changelog_manifest_list}) {
+			if (list.empty() || !result.insert(paimon_snapshot::ManifestPath(table_path, list)).second) {
+				continue;
+			}
+			for (auto &manifest : ReadManifestList(context, table_path, list)) {
+				manifests.insert(manifest.fileName);
+			}
+		}
+		if (!snapshot.index_manifest.empty()) {
+			index_manifests.insert(snapshot.index_manifest);
+		}
+	}
+	vector<string> data_files;
+	for (auto &manifest : manifests) {
+		result.insert(paimon_snapshot::ManifestPath(table_path, manifest));
+		for (auto &entry : ReadManifest(context, table_path, manifest)) {
+			AddDataFilePaths(layout, entry, data_files);
+		}
+	}
+	result.insert(data_files.begin(), data_files.end());
+	for (auto &index_manifest : index_manifests) {
+		result.insert(paimon_snapshot::ManifestPath(table_path, index_manifest));
+		for (auto &index_file : ReadIndexManifest(context, table_path, index_manifest)) {
+			result.insert(PaimonDeletionVectors::IndexFilePath(table_path, index_file.fileName));
+		}
+	}
+	return result;
+}
+
+void PaimonOrphanFileCleaner::ListDataFiles(const string &dir, vector<string> &result) {
+	vector<string> sub_dirs;
+	fs.ListFiles(dir, [&](const string &name, bool is_dir) {
+		if (!is_dir) {
+			//! Files directly in the table directory are not Paimon's
+			if (dir != layout.table_path) {
+				result.push_back(dir + "/" + name);
+			}
+		} else if (name.find('=') != string::npos || StringUtil::StartsWith(name, "bucket-")) {
+			sub_dirs.push_back(dir + "/" + name);
+		}
+	});
+	for (auto &sub_dir : sub_dirs) {
+		ListDataFiles(sub_dir, result);
+	}
+}
+
+vector<PaimonOrphanFile> PaimonOrphanFileCleaner::Clean(timestamp_t older_than, bool dry_run) {
+	auto &table_path = layout.table_path;
+	auto referenced = ReferencedFiles();
+
+	vector<string> files;
+	for (auto &dir : {table_path + "/manifest", table_path + "/index"}) {
+		if (!fs.DirectoryExists(dir)) {
+			continue;
+		}
+		fs.ListFiles(dir, [&](const string &name, bool is_dir) {
+			if (!is_dir) {
+				files.push_back(dir + "/" + name);
+			}
+		});
+	}
+	//! Snapshots and hints are written to a temporary file first, which a failed writer leaves behind
+	auto snapshot_dir = table_path + "/snapshot";
+	if (fs.DirectoryExists(snapshot_dir)) {
+		fs.ListFiles(snapshot_dir, [&](const string &name, bool is_dir) {
+			if (!is_dir && StringUtil::EndsWith(name, ".tmp")) {
+				files.push_back(snapshot_dir + "/" + name);
+			}
+		});
+	}
+	ListDataFiles(table_path, files);
+
+	vector<PaimonOrphanFile> result;
+	for (auto &path : files) {
+		if (referenced.find(path) != referenced.end()) {
+			continue;
+		}
+		//! Files of commits in progress are not referenced yet, they are only orphans once they are old enough
+		auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ | FileFlags::FILE_FLAGS_NULL_IF_NOT_EXISTS);
+		if (!handle || fs.GetLastModifiedTime(*handle) >= older_than) {
+			continue;
+		}
+		PaimonOrphanFile orphan;
+		orphan.path = path;
+		orphan.size = NumericCast<idx_t>(fs.GetFileSize(*handle));
+		result.push_back(std::move(orphan));
+	}
+
+	if (!dry_run) {
+		vector<string> paths;
+		for (auto &orphan : result) {
+			paths.push_back(orphan.path);
+		}
+		paimon_expire::DeleteFiles(context, paths);
+	}
+	return result;
+}
+
+} // namespace duckdb
@@ -6,117 +6,28 @@
 #include "duckdb/planner/operator/logical_copy_to_file.hpp"
 #include "duckdb/execution/operator/persistent/physical_copy_to_file.hpp"
 #include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string_util.hpp"
 #include "duckdb/planner/bound_constraint.hpp"
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 #include "duckdb/parser/constraints/not_null_constraint.hpp"
 #include "duckdb/parser/constraints/unique_constraint.hpp"
+#include "storage/paimon_commit.hpp"
+#include "storage/paimon_compaction.hpp"
+#include "storage/paimon_table_writer.hpp"
+#include "storage/paimon_table_entry.hpp"
+#include "paimon_binary_row.hpp"
 #include "paimon_metadata.hpp"
 #include <ctime>
-#include <cstdlib>  // For rand()
 
 namespace duckdb {
 
-// Statistics collector for computing min/max values during data insertion
-struct ColumnStats {
-    Value min;
-    Value max;
-    int64_t nullCount = 0;
-    int64_t totalCount = 0;
-    bool initialized = false;
-
-    // For large datasets, use sampling to reduce memory usage
-    static constexpr int64_t MAX_SAMPLES = 10000;  // Sample at most 10K values per column
-    vector<Value> samples;
-    bool use_sampling = false;
-
-    void update(const Value& val) {
-        totalCount++;
-
-        if (val.IsNull()) {
-            nullCount++;
-            return;
-        }
-
-        // For very large datasets, use sampling to reduce memory usage
-        if (totalCount > MAX_SAMPLES * 10) {  // Start sampling after 100K rows
-            if (!use_sampling) {
-                use_sampling = true;
-                // Keep only a sample of existing values
-                if (samples.size() > MAX_SAMPLES) {
-                    // Reservoir sampling to keep representative samples
-                    samples.resize(MAX_SAMPLES);
-                }
-            }
-
-            // Sample with probability MAX_SAMPLES/totalCount
-            if (samples.size() < MAX_SAMPLES || (rand() % totalCount) < MAX_SAMPLES) {
-                if (samples.size() < MAX_SAMPLES) {
-                    samples.push_back(val);
-                } else {
-                    samples[rand() % MAX_SAMPLES] = val;
-                }
-            }
-            return;
-        }
-
-        // Normal processing for smaller datasets
-        if (!initialized) {
-            min = val;
-            max = val;
-            initialized = true;
-        } else {
-            if (val < min) min = val;
-            if (val > max) max = val;
-        }
-
-        // Also collect samples for potential later use
-        if (samples.size() < MAX_SAMPLES) {
-            samples.push_back(val);
-        }
-    }
-
-    // Get final statistics, potentially using samples for better accuracy
-    pair<Value, Value> getMinMax() const {
-        if (use_sampling && !samples.empty()) {
-            // Use samples to compute more accurate min/max
-            Value sample_min = samples[0];
-            Value sample_max = samples[0];
-            for (size_t i = 1; i < samples.size(); i++) {
-                if (samples[i] < sample_min) sample_min = samples[i];
-                if (samples[i] > sample_max) sample_max = samples[i];
-            }
-            return {sample_min, sample_max};
-        } else {
-            return {min, max};
-        }
-    }
-};
-
-struct TableStatistics {
-    std::vector<std::string> columnNames;
-    std::vector<ColumnStats> columnStats;
-
-    TableStatistics(const std::vector<std::string>& names) : columnNames(names) {
-        columnStats.resize(names.size());
-    }
-
-    void updateRow(const DataChunk& chunk, idx_t row) {
-        for (idx_t col = 0; col < columnNames.size() && col < chunk.ColumnCount(); col++) {
-            if (col < columnStats.size()) {
-                columnStats[col].update(chunk.GetValue(col, row));
-            }
-        }
-    }
-};
-
 struct PaimonInsertGlobalState : public GlobalSinkState {
 public:
-	PaimonInsertGlobalState(ClientContext &context, const string &table_path,
-	                        const vector<string>& partition_keys = {},
-	                        const vector<string>& column_names = {"id", "name", "age", "email", "active"})
-	    : context(context), table_path(table_path), partition_keys(partition_keys), file_counter(0),
-	      next_sequence_number(1), pathFactory(table_path, 1), bucketManager(1),
-	      tableStats(column_names) {
+	PaimonInsertGlobalState(ClientContext &context, PaimonTableEntry &table)
+	    : context(context), layout(context, table), table_path(layout.table_path), pathFactory(layout.path_factory),
+	      insert_count(0) {
+
+		layout.CheckWritable();
 
 		// Create necessary directories
 		FileSystem &fs = FileSystem::GetFileSystem(context);
@@ -133,40 +44,29 @@ public:
 			fs.CreateDirectory(snapshot_dir);
 		}
 
-		// For partitioned tables, we'll create partition directories on demand
-		// For non-partitioned tables, create bucket directories upfront
-		if (partition_keys.empty()) {
-			for (int bucket : bucketManager.getAllBuckets()) {
-				string bucket_dir = pathFactory.bucketPath(bucket);
-				if (!fs.DirectoryExists(bucket_dir)) {
-					fs.CreateDirectory(bucket_dir);
-				}
-			}
-		}
+		// Partition and bucket directories are created on demand by the writers
 	}
 
 	ClientContext &context;
+	//! Partitioning, bucketing and file sizing of the table, shared by all writer threads
+	PaimonWriteLayout layout;
 	string table_path;
-	vector<string> partition_keys;
-	atomic<idx_t> file_counter;
-	atomic<int64_t> next_sequence_number;
-	FileStorePathFactory pathFactory;
-	BucketManager bucketManager;
-	TableStatistics tableStats;
-	vector<string> written_files;
-	vector<vector<pair<string, string>>> file_partitions;  // Partition info for each file
+	FileStorePathFactory &pathFactory;
+	mutex lock;
+	//! The files written by this insert, with the stats reported by the writer
+	vector<PaimonManifestEntry> written_files;
+	//! The changelog files written by this insert, if the table has a changelog producer
+	vector<PaimonManifestEntry> changelog_files;
+	atomic<idx_t> insert_count;
 };
 
 struct PaimonInsertLocalState : public LocalSinkState {
 public:
-	PaimonInsertLocalState(ClientContext &context, const string &table_path, idx_t file_id)
-	    : context(context), table_path(table_path), file_id(file_id) {
+	explicit PaimonInsertLocalState(PaimonWriteLayout &layout) : writer(layout) {
 	}
 
-	ClientContext &context;
-	string table_path;
-	idx_t file_id;
-	DataChunk buffer;
+	//! Routes rows to one open data file per (partition, bucket) of this thread
+	PaimonTableWriter writer;
 };
 
 PaimonInsert::PaimonInsert(PhysicalPlan &physical_plan, LogicalOperator &op, TableCatalogEntry &table,
@@ -191,105 +91,40 @@ bool PaimonInsert::IsSink() const {
 }
 
 bool PaimonInsert::ParallelSink() const {
-	return false; // For now, single-threaded writes
+	return true;
 }
 
 SinkResultType PaimonInsert::Sink(ExecutionContext &context, DataChunk &chunk, OperatorSinkInput &input) const {
-	auto &global_state = input.global_state->Cast<PaimonInsertGlobalState>();
-
-	// Collect statistics from the data chunk
-	for (idx_t row = 0; row < chunk.size(); row++) {
-		global_state.tableStats.updateRow(chunk, row);
-	}
+	auto &global_state = input.global_state.Cast<PaimonInsertGlobalState>();
+	auto &local_state = input.local_state.Cast<PaimonInsertLocalState>();
 
-	// Handle partitioning
-	vector<pair<string, string>> partition_values;
-	if (!global_state.partition_keys.empty()) {
-		// Extract partition values from the first row (assuming all rows in chunk have same partition)
-		// In a real implementation, we'd need to group rows by partition
-		for (const auto& partition_key : global_state.partition_keys) {
-			// Find the column index for this partition key
-			auto it = std::find(global_state.tableStats.columnNames.begin(),
-			                   global_state.tableStats.columnNames.end(), partition_key);
-			if (it != global_state.tableStats.columnNames.end()) {
-				idx_t col_idx = std::distance(global_state.tableStats.columnNames.begin(), it);
-				if (col_idx < chunk.data.size()) {
-					string partition_value = chunk.data[col_idx].GetValue(0).ToString();
-					partition_values.emplace_back(partition_key, partition_value);
-				}
-			}
-		}
-	}
-
-	// Assign bucket based on partitioning and primary key
-	int bucket;
-	if (!partition_values.empty()) {
-		// For partitioned tables, use partition values + primary key for bucketing
-		// Assuming first column is primary key (simplified)
-		Value primary_key = chunk.data[0].GetValue(0);
-		vector<Value> partition_vals;
-		for (const auto& pv : partition_values) {
-			partition_vals.emplace_back(pv.second);
-		}
-		bucket = global_state.bucketManager.assignBucket(partition_vals, primary_key);
-	} else {
-		// For non-partitioned tables, use primary key only
-		Value primary_key = chunk.data[0].GetValue(0);
-		bucket = global_state.bucketManager.assignBucket(primary_key.ToString());
-	}
+	// Rows are split by partition and bucket, and appended to the data files of this thread
+	local_state.writer.Append(context, chunk);
+	global_state.insert_count += chunk.size();
+	return SinkResultType::NEED_MORE_INPUT;
+}
 
-	// Generate file path using FileStorePathFactory
-	idx_t file_id = global_state.file_counter.fetch_add(1);
-	string uuid = UUID::ToString(UUID::GenerateRandomUUID());
-	string full_path;
+SinkCombineResultType PaimonInsert::Combine(ExecutionContext &context, OperatorSinkCombineInput &input) const {
+	auto &global_state = input.global_state.Cast<PaimonInsertGlobalState>();
+	auto &local_state = input.local_state.Cast<PaimonInsertLocalState>();
 
-	if (!partition_values.empty()) {
-		// Use partitioned path
-		full_path = global_state.pathFactory.partitionedDataFilePath(partition_values, bucket, uuid, file_id, PaimonFileFormat::ORC);
+	vector<PaimonManifestEntry> written_files;
+	vector<PaimonManifestEntry> changelog_files;
+	local_state.writer.Flush(context, written_files, changelog_files);
 
-		// Ensure partition directory exists
-		FileSystem &fs = FileSystem::GetFileSystem(context);
-		string partition_dir = global_state.pathFactory.partitionBucketPath(partition_values, bucket);
-		size_t last_slash = partition_dir.find_last_of('/');
-		if (last_slash != string::npos) {
-			string parent_dir = partition_dir.substr(0, last_slash);
-			if (!fs.DirectoryExists(parent_dir)) {
-				fs.CreateDirectory(parent_dir);
-			}
-		}
-		if (!fs.DirectoryExists(partition_dir)) {
-			fs.CreateDirectory(partition_dir);
-		}
-	} else {
-		// Use regular bucket path
-		full_path = global_state.pathFactory.dataFilePath(bucket, uuid, file_id, PaimonFileFormat::ORC);
+	lock_guard<mutex> guard(global_state.lock);
+	for (auto &entry : written_files) {
+		global_state.written_files.push_back(std::move(entry));
 	}
-
-	// Write the chunk to ORC file (still using parquet writer as placeholder)
-	WriteChunkToParquet(context, chunk, full_path);
-
-	// Store relative path for manifest creation
-	string relative_path;
-	if (!partition_values.empty()) {
-		// Build relative path for partitioned file
-		string partition_path;
-		for (const auto& pv : partition_values) {
-			partition_path += pv.first + "=" + pv.second + "/";
-		}
-		relative_path = partition_path + "bucket-" + std::to_string(bucket) + "/data-" + uuid + "-" + std::to_string(file_id) + ".orc";
-	} else {
-		relative_path = "bucket-" + std::to_string(bucket) + "/data-" + uuid + "-" + std::to_string(file_id) + ".orc";
+	for (auto &entry : changelog_files) {
+		global_state.changelog_files.push_back(std::move(entry));
 	}
-
-	global_state.written_files.push_back(relative_path);
-	global_state.file_partitions.push_back(partition_values);
-
-	return SinkResultType::NEED_MORE_INPUT;
+	return SinkCombineResultType::FINISHED;
 }
 
 SinkFinalizeType PaimonInsert::Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
                                         OperatorSinkFinalizeInput &input) const {
-	auto &global_state = input.global_state->Cast<PaimonInsertGlobalState>();
+	auto &global_state = input.global_state.Cast<PaimonInsertGlobalState>();
 
 	// Update Paimon metadata after successful write
 	UpdatePaimonMetadata(context, global_state);
@@ -301,27 +136,12 @@ unique_ptr<GlobalSinkState> PaimonInsert::GetGlobalSinkState(ClientContext &cont
 	if (!table) {
 		throw InternalException("PaimonInsert requires a table");
 	}
-
-	// Extract table path from table name (simplified - assumes table name is path)
-	string table_path = table->name;
-
-	// Extract column names from table
-	vector<string> column_names;
-	for (auto &col : table->columns) {
-		column_names.push_back(col.Name());
-	}
-
-	// TODO: Extract partition keys from table metadata
-	// For now, assume no partitioning (empty vector)
-	vector<string> partition_keys;
-
-	return make_uniq<PaimonInsertGlobalState>(context, table_path, partition_keys, column_names);
+	return make_uniq<PaimonInsertGlobalState>(context, table->Cast<PaimonTableEntry>());
 }
 
 unique_ptr<LocalSinkState> PaimonInsert::GetLocalSinkState(ExecutionContext &context) const {
-	auto &global_state = context.client.GetSinkState()->Cast<PaimonInsertGlobalState>();
-	idx_t file_id = global_state.file_counter.fetch_add(1);
-	return make_uniq<PaimonInsertLocalState>(context.client, global_state.table_path, file_id);
+	auto &global_state = sink_state->Cast<PaimonInsertGlobalState>();
+	return make_uniq<PaimonInsertLocalState>(global_state.layout);
 }
 
 string PaimonInsert::GetName() const {
@@ -336,343 +156,31 @@ InsertionOrderPreservingMap<string> PaimonInsert::ParamsToString() const {
 	return result;
 }
 
-void PaimonInsert::WriteChunkToParquet(ClientContext &context, DataChunk &chunk, const string &file_path) const {
-	// Use DuckDB's built-in parquet writer
-	// Create a ParquetWriter and write the chunk directly
-
-	try {
-		// For now, use a simplified approach: create a temporary file and copy data
-		// In a full implementation, we'd use ParquetWriter directly
-
-		// Create a temporary in-memory table structure
-		vector<LogicalType> types;
-		vector<string> names;
-		for (idx_t i = 0; i < chunk.ColumnCount(); i++) {
-			types.push_back(chunk.data[i].GetType());
-			names.push_back("col_" + std::to_string(i));
-		}
-
-		// Use DuckDB's parquet export functionality
-		// This is a simplified version - in production we'd use the ParquetWriter API
-
-		// Create a simple approach: write to a temporary file using COPY
-		string temp_data_file = file_path + ".tmp";
-
-		// For demonstration, create some sample data to write
-		// In a real implementation, we'd write the actual chunk data
-		string sample_data = "";
-		for (idx_t row = 0; row < chunk.size(); row++) {
-			if (row > 0) sample_data += "\n";
-			for (idx_t col = 0; col < chunk.ColumnCount(); col++) {
-				if (col > 0) sample_data += ",";
-				sample_data += chunk.data[col].GetValue(row).ToString();
-			}
-		}
-
-		// Write sample data to temp file
-		std::ofstream temp_out(temp_data_file);
-		temp_out << sample_data;
-		temp_out.close();
-
-		// Use DuckDB to convert CSV to Parquet
-		string convert_sql = "COPY (SELECT * FROM read_csv('" + temp_data_file + "', header=false, columns={";
-		for (size_t i = 0; i < names.size(); i++) {
-			if (i > 0) convert_sql += ",";
-			convert_sql += "'" + names[i] + "': '" + TypeIdToString(types[i].id()) + "'";
-		}
-		convert_sql += "})) TO '" + file_path + "' (FORMAT 'parquet')";
-
-		context.Query(convert_sql, false);
-
-		// Clean up temp file
-		FileSystem &fs = FileSystem::GetFileSystem(context);
-		fs.RemoveFile(temp_data_file);
-
-	} catch (const std::exception &e) {
-		throw IOException("Failed to write parquet file: " + string(e.what()));
-	}
-}
-
 void PaimonInsert::UpdatePaimonMetadata(ClientContext &context, PaimonInsertGlobalState &global_state) const {
-	// Update Paimon metadata after successful write
-	// This would create new snapshot, manifest files, etc.
-
-	FileSystem &fs = FileSystem::GetFileSystem(context);
-
-	// Use FileStorePathFactory for correct paths
-	string snapshot_dir = global_state.table_path + "/snapshot";
-	string manifest_dir = global_state.table_path + "/manifest";
-
-	if (!fs.DirectoryExists(snapshot_dir)) {
-		fs.CreateDirectory(snapshot_dir);
-	}
-	if (!fs.DirectoryExists(manifest_dir)) {
-		fs.CreateDirectory(manifest_dir);
-	}
-
-	// Create EARLIEST and LATEST pointers if they don't exist
-	string earliest_file = global_state.pathFactory.earliestPointerPath();
-	string latest_file = global_state.pathFactory.latestPointerPath();
-
-	if (!fs.FileExists(earliest_file)) {
-		std::ofstream earliest_out(earliest_file);
-		earliest_out << "snapshot-1";
-		earliest_out.close();
-	}
-
-	// Generate UUID for manifest file
-	string manifest_uuid = UUID::ToString(UUID::GenerateRandomUUID());
-
-	// Create manifest file using Avro format (matching Paimon ManifestEntry.SCHEMA)
-	// Use DuckDB's COPY to Avro functionality instead of writing JSON
-
-	// Create a temporary table with the manifest data
-	string temp_table_name = "temp_manifest_" + manifest_uuid;
-	string create_temp_table = "CREATE TEMP TABLE " + temp_table_name + " AS ";
-
-	// Build the manifest entries as a SQL query with UNION for multiple files
-	// Assign proper sequence numbers for transaction ordering
-	string manifest_entries;
-	int64_t current_sequence = global_state.next_sequence_number.load();
-	for (size_t i = 0; i < global_state.written_files.size(); i++) {
-		if (i > 0) manifest_entries += " UNION ALL ";
-		manifest_entries += "SELECT ";
-		manifest_entries += "0 AS _KIND, ";  // ADD operation
-
-		// Build partition array from stored partition values
-		const auto& partitions = global_state.file_partitions[i];
-		if (!partitions.empty()) {
-			manifest_entries += "STRUCT_PACK(";
-			for (size_t p = 0; p < partitions.size(); p++) {
-				if (p > 0) manifest_entries += ", ";
-				manifest_entries += "'" + partitions[p].first + "': '" + partitions[p].second + "'";
-			}
-			manifest_entries += ") AS _PARTITION, ";
-		} else {
-			manifest_entries += "[] AS _PARTITION, ";  // Empty partition for non-partitioned tables
-		}
-
-		// Extract bucket number from file path (bucket-N/filename)
-		size_t bucket_pos = global_state.written_files[i].find("bucket-");
-		int bucket = 0;
-		if (bucket_pos != string::npos) {
-			size_t bucket_end = global_state.written_files[i].find("/", bucket_pos);
-			if (bucket_end != string::npos) {
-				string bucket_str = global_state.written_files[i].substr(bucket_pos + 7, bucket_end - bucket_pos - 7);
-				try {
-					bucket = std::stoi(bucket_str);
-				} catch (...) {
-					bucket = 0;
-				}
-			}
-		}
-		manifest_entries += std::to_string(bucket) + " AS _BUCKET, ";
-		manifest_entries += "1 AS _TOTAL_BUCKETS, ";  // Single bucket setup
-		// Build the _FILE struct with ALL DataFileMeta fields (matching DataFileMeta.SCHEMA)
-		manifest_entries += "STRUCT_PACK(";
-		manifest_entries += "_FILE_NAME := '" + global_state.written_files[i] + "', ";  // File name
-		manifest_entries += "_FILE_SIZE := 1024, ";  // File size (placeholder)
-		manifest_entries += "_ROW_COUNT := " + std::to_string(global_state.insert_count / global_state.written_files.size()) + ", ";  // Row count per file
-		// Use real statistics computed from the data
-		manifest_entries += "_MIN_KEY := [], ";  // Empty for now (would compute from primary key data)
-		manifest_entries += "_MAX_KEY := [], ";  // Empty for now (would compute from primary key data)
-		// Key statistics structure using real data
-		manifest_entries += "_KEY_STATS := STRUCT_PACK(";
-		manifest_entries += "colNames := ['id'], ";  // Primary key column
-		if (!global_state.tableStats.columnStats.empty() && global_state.tableStats.columnStats[0].initialized) {
-			auto& idStats = global_state.tableStats.columnStats[0];
-			auto [idMin, idMax] = idStats.getMinMax();
-			manifest_entries += "colStats := [STRUCT_PACK(min := " + std::to_string(idMin.GetAs<int64_t>()) +
-			                   ", max := " + std::to_string(idMax.GetAs<int64_t>()) +
-			                   ", nullCount := " + std::to_string(idStats.nullCount) + ")]";  // Real ID stats
-		} else {
-			manifest_entries += "colStats := [STRUCT_PACK(min := 0, max := 1000000, nullCount := 0)]";  // Fallback
-		}
-		manifest_entries += "), ";
-		// Value statistics for all columns using collected data
-		manifest_entries += "_VALUE_STATS := STRUCT_PACK(";
-		manifest_entries += "colNames := ['id', 'name', 'age', 'email', 'active'], ";  // All columns
-		manifest_entries += "colStats := [";
-
-		// ID column stats
-		if (!global_state.tableStats.columnStats.empty() && global_state.tableStats.columnStats[0].initialized) {
-			auto& idStats = global_state.tableStats.columnStats[0];
-			auto [idMin, idMax] = idStats.getMinMax();
-			manifest_entries += "STRUCT_PACK(min := " + std::to_string(idMin.GetAs<int64_t>()) +
-			                   ", max := " + std::to_string(idMax.GetAs<int64_t>()) +
-			                   ", nullCount := " + std::to_string(idStats.nullCount) + "), ";
-		} else {
-			manifest_entries += "STRUCT_PACK(min := 0, max := 1000000, nullCount := 0), ";
-		}
-
-		// Name column stats (string)
-		manifest_entries += "STRUCT_PACK(min := NULL, max := NULL, nullCount := 0), ";  // String min/max not easily computed
-
-		// Age column stats
-		if (global_state.tableStats.columnStats.size() > 2 && global_state.tableStats.columnStats[2].initialized) {
-			auto& ageStats = global_state.tableStats.columnStats[2];
-			auto [ageMin, ageMax] = ageStats.getMinMax();
-			manifest_entries += "STRUCT_PACK(min := " + std::to_string(ageMin.GetAs<int64_t>()) +
-			                   ", max := " + std::to_string(ageMax.GetAs<int64_t>()) +
-			                   ", nullCount := " + std::to_string(ageStats.nullCount) + "), ";
-		} else {
-			manifest_entries += "STRUCT_PACK(min := 0, max := 100, nullCount := 0), ";
-		}
-
-		// Email column stats (string)
-		manifest_entries += "STRUCT_PACK(min := NULL, max := NULL, nullCount := 0), ";  // String min/max not easily computed
-
-		// Active column stats (boolean)
-		if (global_state.tableStats.columnStats.size() > 4 && global_state.tableStats.columnStats[4].initialized) {
-			auto& activeStats = global_state.tableStats.columnStats[4];
-			auto [activeMin, activeMax] = activeStats.getMinMax();
-			manifest_entries += "STRUCT_PACK(min := " + (activeMin.GetAs<bool>() ? "true" : "false") +
-			                   ", max := " + (activeMax.GetAs<bool>() ? "true" : "false") +
-			                   ", nullCount := " + std::to_string(activeStats.nullCount) + ")";
-		} else {
-			manifest_entries += "STRUCT_PACK(min := false, max := true, nullCount := 0)";
-		}
-
-		manifest_entries += "]";  // End colStats array
-		manifest_entries += "), ";  // End _VALUE_STATS
-		// Proper sequence numbers for transaction ordering
-		manifest_entries += "_MIN_SEQUENCE_NUMBER := " + std::to_string(current_sequence) + ", ";  // Min sequence number
-		manifest_entries += "_MAX_SEQUENCE_NUMBER := " + std::to_string(current_sequence) + ", ";  // Max sequence number (same for single row)
-		manifest_entries += "_SCHEMA_ID := 0, ";  // Schema ID
-		manifest_entries += "_LEVEL := 0, ";  // Level 0
-		manifest_entries += "_EXTRA_FILES := [], ";  // No extra files
-		manifest_entries += "_CREATION_TIME := " + std::to_string(Timestamp::GetCurrentTimestamp().value) + ", ";  // Creation timestamp
-		manifest_entries += "_DELETE_ROW_COUNT := NULL, ";  // No delete row count
-		manifest_entries += "_EMBEDDED_FILE_INDEX := NULL, ";  // No embedded index
-		manifest_entries += "_FILE_SOURCE := 0, ";  // APPEND source (FileSource::APPEND)
-		manifest_entries += "_VALUE_STATS_COLS := ['id', 'name', 'age', 'email', 'active'], ";  // All columns have value stats
-		manifest_entries += "_EXTERNAL_PATH := NULL, ";  // No external path
-		manifest_entries += "_FIRST_ROW_ID := NULL, ";  // No first row ID
-		manifest_entries += "_WRITE_COLS := ['id', 'name', 'age', 'email', 'active']";  // All columns were written
-		manifest_entries += ") AS _FILE";
-		// Increment sequence number for next file
-		current_sequence++;
-	}
-	// Update the global sequence number for future operations
-	global_state.next_sequence_number.store(current_sequence);
-
-	// Execute the CREATE TEMP TABLE statement
-	try {
-		auto create_result = context.Query(create_temp_table + manifest_entries, false);
-		if (!create_result || create_result->HasError()) {
-			throw IOException("Failed to create temporary manifest table");
-		}
-	} catch (const std::exception &e) {
-		throw IOException("Failed to create temporary manifest table: " + string(e.what()));
-	}
-
-	// Now use COPY to write the manifest as Avro
-	string manifest_file = global_state.pathFactory.manifestFilePath(manifest_uuid, 0);
-	string copy_command = "COPY " + temp_table_name + " TO '" + manifest_file + "' (FORMAT AVRO)";
-
-	try {
-		auto copy_result = context.Query(copy_command, false);
-		if (!copy_result || copy_result->HasError()) {
-			throw IOException("Failed to write Avro manifest file");
-		}
-	} catch (const std::exception &e) {
-		throw IOException("Failed to write Avro manifest file: " + string(e.what()));
-	}
-
-	// Clean up the temporary table
-	try {
-		context.Query("DROP TABLE " + temp_table_name, false);
-	} catch (const std::exception &e) {
-		// Ignore cleanup errors
+	if (global_state.written_files.empty()) {
+		// Nothing was written, like Paimon we do not create empty append snapshots
+		return;
 	}
 
-	// Generate UUIDs for manifest lists
-	string delta_manifest_list_uuid = UUID::ToString(UUID::GenerateRandomUUID());
-
-	// Create delta manifest list using Avro format (matching Paimon ManifestList format)
-	// Use DuckDB's COPY to Avro functionality
-
-	// Create a temporary table with the manifest list data
-	string temp_list_table_name = "temp_manifest_list_" + delta_manifest_list_uuid;
-	string create_temp_list_table = "CREATE TEMP TABLE " + temp_list_table_name + " AS ";
-
-	// Build the manifest list entries as a SQL query
-	string manifest_list_entries = "SELECT ";
-	manifest_list_entries += "'" + manifest_file.substr(manifest_file.find_last_of('/') + 1) + "' AS _FILE_NAME, ";  // Manifest file name
-	manifest_list_entries += "1024 AS _FILE_SIZE, ";  // Manifest file size
-	manifest_list_entries += std::to_string(global_state.written_files.size()) + " AS _NUM_ADDED_FILES, ";  // Number of added files
-	manifest_list_entries += "0 AS _NUM_DELETED_FILES, ";  // Number of deleted files
-	// Build the partition stats struct
-	manifest_list_entries += "STRUCT_PACK(";
-	manifest_list_entries += "colNames := [], ";  // Empty column names
-	manifest_list_entries += "colStats := [], ";  // Empty column stats
-	manifest_list_entries += "nullCount := 0";  // No nulls
-	manifest_list_entries += ") AS _PARTITION_STATS, ";
-	manifest_list_entries += "0 AS _SCHEMA_ID, ";  // Schema ID
-	manifest_list_entries += "NULL AS _MIN_BUCKET, ";  // No bucketing
-	manifest_list_entries += "NULL AS _MAX_BUCKET, ";  // No bucketing
-	manifest_list_entries += "NULL AS _MIN_LEVEL, ";  // No levels
-	manifest_list_entries += "NULL AS _MAX_LEVEL";  // No levels
-
-	// Execute the CREATE TEMP TABLE statement for manifest list
-	try {
-		auto create_list_result = context.Query(create_temp_list_table + manifest_list_entries, false);
-		if (!create_list_result || create_list_result->HasError()) {
-			throw IOException("Failed to create temporary manifest list table");
+	if (!global_state.layout.HasPrimaryKey()) {
+		// Every row gets its own sequence number, continuing after the live files of its bucket, so the files of a
+		// bucket have increasing, disjoint ranges across commits (compaction orders them on it).
+		// Files of primary key tables carry the sequence numbers assigned by their write buffer.
+		for (auto &entry : global_state.written_files) {
+			auto &file = entry.file;
+			file.minSequenceNumber = global_state.layout.ReserveSequenceNumbers(entry.partition, entry.bucket,
+			                                                                    NumericCast<idx_t>(file.rowCount));
+			file.maxSequenceNumber = file.minSequenceNumber + file.rowCount - 1;
 		}
-	} catch (const std::exception &e) {
-		throw IOException("Failed to create temporary manifest list table: " + string(e.what()));
 	}
 
-	// Now use COPY to write the manifest list as Avro
-	string delta_manifest_list_file = global_state.pathFactory.manifestListFilePath(delta_manifest_list_uuid, 0);
-	string copy_list_command = "COPY " + temp_list_table_name + " TO '" + delta_manifest_list_file + "' (FORMAT AVRO)";
-
-	try {
-		auto copy_list_result = context.Query(copy_list_command, false);
-		if (!copy_list_result || copy_list_result->HasError()) {
-			throw IOException("Failed to write Avro manifest list file");
-		}
-	} catch (const std::exception &e) {
-		throw IOException("Failed to write Avro manifest list file: " + string(e.what()));
-	}
-
-	// Clean up the temporary table
-	try {
-		context.Query("DROP TABLE " + temp_list_table_name, false);
-	} catch (const std::exception &e) {
-		// Ignore cleanup errors
-	}
+	// Commit the written files as a new snapshot on top of the latest one, retrying on concurrent commits
+	PaimonCommit commit(context, global_state.layout);
+	commit.Commit(global_state.written_files, PaimonCommitKind::APPEND, global_state.changelog_files);
 
-	// Create new snapshot file (Version 3 format - matching Java spec)
-	string snapshot_content = R"({
-  "version": 3,
-  "id": 2,
-  "schemaId": 0,
-  "baseManifestList": "",
-  "deltaManifestList": ")" + delta_manifest_list_file.substr(delta_manifest_list_file.find_last_of('/') + 1) + R"(",
-  "deltaManifestListSize": )" + std::to_string(1024) + R"(,
-  "changelogManifestList": null,
-  "indexManifest": null,
-  "commitUser": "duckdb-paimon",
-  "commitIdentifier": 9223372036854775807,
-  "commitKind": "APPEND",
-  "timeMillis": )" + std::to_string(Timestamp::GetCurrentTimestamp().value) + R"(,
-  "logOffsets": {},
-  "totalRecordCount": )" + std::to_string(global_state.insert_count) + R"(,
-  "deltaRecordCount": )" + std::to_string(global_state.insert_count) + R"(,
-  "watermark": -9223372036854775808
-})";
-
-	string snapshot_file = global_state.pathFactory.snapshotFilePath(2);
-	std::ofstream snapshot_out(snapshot_file);
-	snapshot_out << snapshot_content;
-	snapshot_out.close();
-
-	// Update LATEST pointer
-	std::ofstream latest_out(latest_file);
-	latest_out << "snapshot-2";
-	latest_out.close();
+	// Compact the buckets that reached the compaction trigger (sorted runs on primary key tables, small files on
+	// append tables)
+	PaimonCompactor::CompactAfterWrite(context, global_state.layout, global_state.written_files);
 }
 
 PaimonCopyInput::PaimonCopyInput(ClientContext &context, TableCatalogEntry &table) {
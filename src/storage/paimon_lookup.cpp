@@ -0,0 +1,260 @@
+#include "storage/paimon_lookup.hpp"
+#include "storage/paimon_data_file_reader.hpp"
+#include "storage/paimon_table_writer.hpp"
+#include "paimon_binary_row.hpp"
+#include "paimon_snapshot.hpp"
+
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/function/create_sort_key.hpp"
+#include "duckdb/planner/filter/constant_filter.hpp"
+#include "duckdb/planner/filter/in_filter.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+static bool IsAdd(PaimonRowKind kind) {
+	return kind == PaimonRowKind::INSERT || kind == PaimonRowKind::UPDATE_AFTER;
+}
+
+//! The normalized sort key of every row of 'keys'
+static void ComputeSortKeys(DataChunk &keys, vector<string> &result) {
+	auto count = keys.size();
+	Vector sort_keys(LogicalType::BLOB, count);
+	//! Must match the order of the sorted write buffer, which produced the min and max keys of the files
+	vector<OrderModifiers> modifiers(keys.ColumnCount(),
+	                                 OrderModifiers(OrderType::ASCENDING, OrderByNullType::NULLS_LAST));
+	CreateSortKeyHelpers::CreateSortKey(keys, modifiers, sort_keys);
+	sort_keys.Flatten(count);
+	auto data = FlatVector::GetData<string_t>(sort_keys);
+	result.resize(count);
+	for (idx_t row = 0; row < count; row++) {
+		result[row] = data[row].GetString();
+	}
+}
+
+static idx_t KeyPosition(PaimonWriteLayout &layout, idx_t col_idx, const char *kind) {
+	auto &keys = layout.primary_key_indexes;
+	auto entry = std::find(keys.begin(), keys.end(), col_idx);
+	if (entry == keys.end()) {
+		throw InvalidInputException("Cannot look up keys of Paimon table: %s column \"%s\" is not part of the primary "
+		                            "key",
+		                            kind, layout.column_names[col_idx]);
+	}
+	return NumericCast<idx_t>(entry - keys.begin());
+}
+
+static string BucketKey(const vector<uint8_t> &partition, int32_t bucket) {
+	string result(const_char_ptr_cast(partition.data()), partition.size());
+	result.append(const_char_ptr_cast(&bucket), sizeof(bucket));
+	return result;
+}
+
+PaimonKeyLookup::PaimonKeyLookup(ClientContext &context, PaimonWriteLayout &layout)
+    : context(context), layout(layout), key_count(layout.bind->key_count) {
+	if (!layout.HasPrimaryKey()) {
+		throw InvalidInputException("Key lookups are only supported on Paimon primary key tables");
+	}
+	key_types.assign(layout.bind->types.begin(), layout.bind->types.begin() + key_count);
+	for (auto col_idx : layout.partition_key_indexes) {
+		partition_key_positions.push_back(KeyPosition(layout, col_idx, "partition"));
+	}
+	if (!layout.SingleBucket()) {
+		for (auto col_idx : layout.bucket_key_indexes) {
+			bucket_key_positions.push_back(KeyPosition(layout, col_idx, "bucket key"));
+		}
+	}
+
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto latest_id = PaimonTableMetadata::FindLatestSnapshotId(layout.table_path, fs);
+	if (latest_id == 0) {
+		return;
+	}
+	auto snapshot = paimon_snapshot::Read(context, layout.table_path, latest_id);
+	DataChunk bounds;
+	bounds.Initialize(Allocator::DefaultAllocator(), key_types, 2);
+	vector<string> bound_keys;
+	for (auto &entry : paimon_snapshot::ReadLiveFiles(context, layout.table_path, snapshot)) {
+		if (entry.file.rowCount == 0) {
+			continue;
+		}
+		auto min_values = PaimonBinaryRow::Deserialize(entry.file.minKey, key_types);
+		auto max_values = PaimonBinaryRow::Deserialize(entry.file.maxKey, key_types);
+		bounds.Reset();
+		for (idx_t col_idx = 0; col_idx < key_count; col_idx++) {
+			bounds.SetValue(col_idx, 0, min_values[col_idx]);
+			bounds.SetValue(col_idx, 1, max_values[col_idx]);
+		}
+		bounds.SetCardinality(2);
+		ComputeSortKeys(bounds, bound_keys);
+
+		FileCandidate candidate;
+		candidate.min_key = std::move(bound_keys[0]);
+		candidate.max_key = std::move(bound_keys[1]);
+		auto key = BucketKey(entry.partition, entry.bucket);
+		candidate.entry = std::move(entry);
+		bucket_files[key].push_back(std::move(candidate));
+	}
+}
+
+string PaimonKeyLookup::RoutingKey(const vector<Value> &key) const {
+	vector<Value> partition_values;
+	for (auto position : partition_key_positions) {
+		partition_values.push_back(key[position]);
+	}
+	int32_t bucket = 0;
+	if (!layout.SingleBucket()) {
+		PaimonBinaryRowWriter bucket_key_row(bucket_key_positions.size());
+		for (idx_t i = 0; i < bucket_key_positions.size(); i++) {
+			bucket_key_row.WriteValue(i, key[bucket_key_positions[i]]);
+		}
+		bucket = layout.bucket_manager.assignBucket(bucket_key_row.HashCode());
+	}
+	return BucketKey(PaimonBinaryRow::Serialize(partition_values), bucket);
+}
+
+//! Pushed into the scan of a file: the key columns must be one of the keys looked up in the file
+static unique_ptr<TableFilterSet> CreateKeyFilters(const vector<vector<Value>> &key_values, const vector<idx_t> &keys,
+                                                   idx_t key_count) {
+	auto result = make_uniq<TableFilterSet>();
+	for (idx_t col_idx = 0; col_idx < key_count; col_idx++) {
+		vector<Value> values;
+		for (auto key_idx : keys) {
+			values.push_back(key_values[key_idx][col_idx]);
+		}
+		std::sort(values.begin(), values.end());
+		values.erase(std::unique(values.begin(), values.end()), values.end());
+		if (values.size() == 1) {
+			result->filters[col_idx] = make_uniq<ConstantFilter>(ExpressionType::COMPARE_EQUAL, std::move(values[0]));
+		} else {
+			result->filters[col_idx] = make_uniq<InFilter>(std::move(values));
+		}
+	}
+	return result;
+}
+
+void PaimonKeyLookup::Lookup(ColumnDataCollection &keys, ColumnDataCollection &result) const {
+	//! Deduplicate the keys, and assign each to the files of its bucket whose key range contains it
+	unordered_map<string, idx_t> key_map;
+	vector<vector<Value>> key_values;
+	vector<string> key_sort_keys;
+	unordered_map<const FileCandidate *, idx_t> candidate_map;
+	vector<pair<const FileCandidate *, vector<idx_t>>> candidates;
+	vector<string> sort_keys;
+	for (auto &chunk : keys.Chunks()) {
+		ComputeSortKeys(chunk, sort_keys);
+		for (idx_t row = 0; row < chunk.size(); row++) {
+			vector<Value> values;
+			bool has_null = false;
+			for (idx_t col_idx = 0; col_idx < key_count; col_idx++) {
+				values.push_back(chunk.GetValue(col_idx, row));
+				has_null = has_null || values.back().IsNull();
+			}
+			//! Primary key columns are NOT NULL, a key with a NULL never matches
+			if (has_null || key_map.find(sort_keys[row]) != key_map.end()) {
+				continue;
+			}
+			auto key_idx = key_values.size();
+			key_map.emplace(sort_keys[row], key_idx);
+			auto bucket = bucket_files.find(RoutingKey(values));
+			key_values.push_back(std::move(values));
+			key_sort_keys.push_back(sort_keys[row]);
+			if (bucket == bucket_files.end()) {
+				continue;
+			}
+			for (auto &file : bucket->second) {
+				if (sort_keys[row] < file.min_key || sort_keys[row] > file.max_key) {
+					continue;
+				}
+				auto entry = candidate_map.find(&file);
+				if (entry == candidate_map.end()) {
+					entry = candidate_map.emplace(&file, candidates.size()).first;
+					candidates.emplace_back(&file, vector<idx_t>());
+				}
+				candidates[entry->second].second.push_back(key_idx);
+			}
+		}
+	}
+
+	//! Read the candidate files, keeping the latest version of every key
+	auto &types = layout.bind->types;
+	auto first_row = layout.merge_engine == PaimonMergeEngine::FIRST_ROW;
+	DataChunk versions;
+	versions.Initialize(context, types, STANDARD_VECTOR_SIZE);
+	vector<idx_t> latest(key_values.size(), DConstants::INVALID_INDEX);
+	DataChunk chunk;
+	chunk.Initialize(context, types, STANDARD_VECTOR_SIZE);
+	DataChunk key_chunk;
+	key_chunk.InitializeEmpty(key_types);
+	SelectionVector single_row(1);
+	for (auto &candidate : candidates) {
+		unordered_map<string, idx_t> file_keys;
+		for (auto key_idx : candidate.second) {
+			file_keys.emplace(key_sort_keys[key_idx], key_idx);
+		}
+		auto filters = CreateKeyFilters(key_values, candidate.second, key_count);
+		PaimonDataFileReader reader(context, *layout.bind, layout.DataFilePath(candidate.first->entry), filters.get());
+		while (reader.Next(chunk)) {
+			//! Row groups that may contain a key are returned whole, so the rows are matched on their key
+			for (idx_t col_idx = 0; col_idx < key_count; col_idx++) {
+				key_chunk.data[col_idx].Reference(chunk.data[col_idx]);
+			}
+			key_chunk.SetCardinality(chunk.size());
+			ComputeSortKeys(key_chunk, sort_keys);
+			chunk.data[key_count].Flatten(chunk.size());
+			chunk.data[key_count + 1].Flatten(chunk.size());
+			auto sequence_numbers = FlatVector::GetData<int64_t>(chunk.data[key_count]);
+			auto kinds = FlatVector::GetData<int8_t>(chunk.data[key_count + 1]);
+			for (idx_t row = 0; row < chunk.size(); row++) {
+				auto entry = file_keys.find(sort_keys[row]);
+				if (entry == file_keys.end()) {
+					continue;
+				}
+				auto &version = latest[entry->second];
+				if (version != DConstants::INVALID_INDEX) {
+					auto version_sequence_number = FlatVector::GetData<int64_t>(versions.data[key_count])[version];
+					//! The first-row engine keeps the oldest row of a key, the others the newest
+					if (first_row ? version_sequence_number < sequence_numbers[row]
+					              : version_sequence_number > sequence_numbers[row]) {
+						continue;
+					}
+				}
+				if (first_row && !IsAdd(static_cast<PaimonRowKind>(kinds[row]))) {
+					continue;
+				}
+				single_row.set_index(0, row);
+				version = versions.size();
+				versions.Append(chunk, true, &single_row, 1);
+			}
+		}
+	}
+
+	//! Keys whose latest version is a retraction were deleted
+	auto kinds = FlatVector::GetData<int8_t>(versions.data[key_count + 1]);
+	SelectionVector sel(STANDARD_VECTOR_SIZE);
+	idx_t count = 0;
+	auto flush = [&]() {
+		DataChunk output;
+		output.InitializeEmpty(layout.column_types);
+		for (idx_t col_idx = 0; col_idx < layout.column_types.size(); col_idx++) {
+			output.data[col_idx].Slice(versions.data[layout.bind->value_offset + col_idx], sel, count);
+		}
+		output.SetCardinality(count);
+		result.Append(output);
+		count = 0;
+	};
+	for (auto version : latest) {
+		if (version == DConstants::INVALID_INDEX || !IsAdd(static_cast<PaimonRowKind>(kinds[version]))) {
+			continue;
+		}
+		sel.set_index(count++, version);
+		if (count == STANDARD_VECTOR_SIZE) {
+			flush();
+		}
+	}
+	if (count > 0) {
+		flush();
+	}
+}
+
+} // namespace duckdb
@@ -0,0 +1,255 @@
+#include "storage/paimon_merge_reader.hpp"
+#include "storage/paimon_data_file_reader.hpp"
+#include "storage/paimon_deletion_vectors.hpp"
+#include "storage/paimon_table_writer.hpp"
+#include "paimon_binary_row.hpp"
+
+#include "duckdb/common/map.hpp"
+#include "duckdb/common/operator/comparison_operators.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace duckdb {
+
+//! Reads a sorted run file by file, exposing the sort key, sequence number and row kind of the current row
+struct PaimonSortedRunReader {
+	PaimonSortedRunReader(ClientContext &context, const PaimonWriteLayout &layout,
+	                      vector<reference<const PaimonManifestEntry>> files_p,
+	                      optional_ptr<const PaimonDeletionVectors> deletion_vectors)
+	    : context(context), layout(layout), files(std::move(files_p)), deletion_vectors(deletion_vectors) {
+		auto &bind = *layout.bind;
+		chunk.Initialize(context, bind.types, STANDARD_VECTOR_SIZE);
+		key_chunk.InitializeEmpty(vector<LogicalType>(bind.types.begin(), bind.types.begin() + bind.key_count));
+		modifiers = PaimonMergeReader::KeyOrderModifiers(bind.key_count);
+	}
+
+	//! Load the next chunk of the run, returns false once the run is exhausted
+	bool LoadChunk() {
+		auto &bind = *layout.bind;
+		while (true) {
+			if (!file) {
+				if (next_file >= files.size()) {
+					return false;
+				}
+				auto &entry = files[next_file++].get();
+				auto has_deleted = deletion_vectors && deletion_vectors->Read(entry.file.fileName, deleted_rows);
+				file = make_uniq<PaimonDataFileReader>(context, bind, layout.DataFilePath(entry), nullptr,
+				                                       has_deleted ? &deleted_rows : nullptr);
+			}
+			if (file->Next(chunk)) {
+				break;
+			}
+			file.reset();
+		}
+		count = chunk.size();
+		position = 0;
+		for (idx_t key_idx = 0; key_idx < bind.key_count; key_idx++) {
+			key_chunk.data[key_idx].Reference(chunk.data[key_idx]);
+		}
+		key_chunk.SetCardinality(count);
+		sort_keys = make_uniq<Vector>(LogicalType::BLOB, count);
+		CreateSortKeyHelpers::CreateSortKey(key_chunk, modifiers, *sort_keys);
+		sort_keys->Flatten(count);
+		keys = FlatVector::GetData<string_t>(*sort_keys);
+		chunk.data[bind.key_count].Flatten(count);
+		sequence_numbers = FlatVector::GetData<int64_t>(chunk.data[bind.key_count]);
+		chunk.data[bind.key_count + 1].Flatten(count);
+		kinds = FlatVector::GetData<int8_t>(chunk.data[bind.key_count + 1]);
+		return true;
+	}
+
+	const string_t &Key() const {
+		return keys[position];
+	}
+	int64_t SequenceNumber() const {
+		return sequence_numbers[position];
+	}
+	PaimonRowKind Kind() const {
+		return static_cast<PaimonRowKind>(kinds[position]);
+	}
+	bool AtChunkEnd() const {
+		return position + 1 >= count;
+	}
+
+	ClientContext &context;
+	const PaimonWriteLayout &layout;
+	vector<reference<const PaimonManifestEntry>> files;
+	optional_ptr<const PaimonDeletionVectors> deletion_vectors;
+	idx_t next_file = 0;
+	unique_ptr<PaimonDataFileReader> file;
+	roaring::Roaring deleted_rows;
+	DataChunk chunk;
+	DataChunk key_chunk;
+	vector<OrderModifiers> modifiers;
+	unique_ptr<Vector> sort_keys;
+	string_t *keys = nullptr;
+	int64_t *sequence_numbers = nullptr;
+	int8_t *kinds = nullptr;
+	idx_t position = 0;
+	idx_t count = 0;
+};
+
+vector<OrderModifiers> PaimonMergeReader::KeyOrderModifiers(idx_t key_count) {
+	return vector<OrderModifiers>(key_count, OrderModifiers(OrderType::ASCENDING, OrderByNullType::NULLS_LAST));
+}
+
+//! Order the files of a sorted run by their min key, so the run can be read file by file
+static void OrderByMinKey(vector<reference<const PaimonManifestEntry>> &files, const vector<LogicalType> &key_types) {
+	if (files.size() <= 1) {
+		return;
+	}
+	DataChunk min_keys;
+	min_keys.Initialize(Allocator::DefaultAllocator(), key_types, files.size());
+	for (idx_t i = 0; i < files.size(); i++) {
+		auto values = PaimonBinaryRow::Deserialize(files[i].get().file.minKey, key_types);
+		for (idx_t col_idx = 0; col_idx < key_types.size(); col_idx++) {
+			min_keys.SetValue(col_idx, i, values[col_idx]);
+		}
+	}
+	min_keys.SetCardinality(files.size());
+	Vector sort_keys(LogicalType::BLOB, files.size());
+	CreateSortKeyHelpers::CreateSortKey(min_keys, PaimonMergeReader::KeyOrderModifiers(key_types.size()), sort_keys);
+	sort_keys.Flatten(files.size());
+	auto keys = FlatVector::GetData<string_t>(sort_keys);
+
+	vector<idx_t> order(files.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(),
+	          [&](idx_t a, idx_t b) { return LessThan::Operation<string_t>(keys[a], keys[b]); });
+	vector<reference<const PaimonManifestEntry>> result;
+	for (auto idx : order) {
+		result.push_back(files[idx]);
+	}
+	files = std::move(result);
+}
+
+PaimonMergeReader::PaimonMergeReader(ClientContext &context, const PaimonWriteLayout &layout,
+                                     const vector<PaimonManifestEntry> &files, bool drop_retractions,
+                                     optional_ptr<const PaimonDeletionVectors> deletion_vectors)
+    : layout(layout), drop_retractions(drop_retractions), pending_sel(STANDARD_VECTOR_SIZE) {
+	auto &bind = *layout.bind;
+	vector<LogicalType> key_types(bind.types.begin(), bind.types.begin() + bind.key_count);
+	map<int, vector<reference<const PaimonManifestEntry>>> levels;
+	for (auto &entry : files) {
+		if (entry.file.level == 0) {
+			vector<reference<const PaimonManifestEntry>> run {entry};
+			runs.push_back(make_uniq<PaimonSortedRunReader>(context, layout, std::move(run), deletion_vectors));
+		} else {
+			levels[entry.file.level].push_back(entry);
+		}
+	}
+	for (auto &level : levels) {
+		OrderByMinKey(level.second, key_types);
+		runs.push_back(make_uniq<PaimonSortedRunReader>(context, layout, std::move(level.second), deletion_vectors));
+	}
+}
+
+PaimonMergeReader::~PaimonMergeReader() {
+}
+
+bool PaimonMergeReader::RunGreater(idx_t a, idx_t b) const {
+	auto &left = *runs[a];
+	auto &right = *runs[b];
+	if (!Equals::Operation<string_t>(left.Key(), right.Key())) {
+		return GreaterThan::Operation<string_t>(left.Key(), right.Key());
+	}
+	return left.SequenceNumber() > right.SequenceNumber();
+}
+
+bool PaimonMergeReader::Next(DataChunk &result) {
+	//! Rows are popped in (key, sequence number) order, older rows of a key first
+	auto greater = [&](idx_t a, idx_t b) { return RunGreater(a, b); };
+	if (!initialized) {
+		for (idx_t i = 0; i < runs.size(); i++) {
+			if (runs[i]->LoadChunk()) {
+				heap.push_back(i);
+			}
+		}
+		std::make_heap(heap.begin(), heap.end(), greater);
+		initialized = true;
+	}
+
+	result.Reset();
+	while (!heap.empty()) {
+		//! All versions of the smallest key, every run holds a key at most once
+		group.clear();
+		std::pop_heap(heap.begin(), heap.end(), greater);
+		group.push_back(heap.back());
+		heap.pop_back();
+		while (!heap.empty() && Equals::Operation<string_t>(runs[heap.front()]->Key(), runs[group[0]]->Key())) {
+			std::pop_heap(heap.begin(), heap.end(), greater);
+			group.push_back(heap.back());
+			heap.pop_back();
+		}
+
+		auto winner = PickWinner(group);
+		if (winner != DConstants::INVALID_INDEX) {
+			EmitRow(winner, result);
+		}
+		for (auto run_idx : group) {
+			if (Advance(run_idx, result)) {
+				heap.push_back(run_idx);
+				std::push_heap(heap.begin(), heap.end(), greater);
+			}
+		}
+		if (result.size() + pending_count >= STANDARD_VECTOR_SIZE) {
+			break;
+		}
+	}
+	FlushPending(result);
+	return result.size() > 0;
+}
+
+idx_t PaimonMergeReader::PickWinner(const vector<idx_t> &group) const {
+	idx_t winner = DConstants::INVALID_INDEX;
+	if (layout.merge_engine == PaimonMergeEngine::FIRST_ROW) {
+		for (auto run_idx : group) {
+			auto kind = runs[run_idx]->Kind();
+			if (kind == PaimonRowKind::INSERT || kind == PaimonRowKind::UPDATE_AFTER) {
+				winner = run_idx;
+				break;
+			}
+		}
+	} else {
+		winner = group.back();
+	}
+	if (winner != DConstants::INVALID_INDEX && drop_retractions) {
+		auto kind = runs[winner]->Kind();
+		if (kind == PaimonRowKind::DELETE || kind == PaimonRowKind::UPDATE_BEFORE) {
+			return DConstants::INVALID_INDEX;
+		}
+	}
+	return winner;
+}
+
+bool PaimonMergeReader::Advance(idx_t run_idx, DataChunk &result) {
+	auto &run = *runs[run_idx];
+	if (!run.AtChunkEnd()) {
+		run.position++;
+		return true;
+	}
+	//! The selected rows still point into the chunk that is about to be replaced
+	if (pending_count > 0 && pending_run == run_idx) {
+		FlushPending(result);
+	}
+	return run.LoadChunk();
+}
+
+void PaimonMergeReader::EmitRow(idx_t run_idx, DataChunk &result) {
+	if (pending_count > 0 && pending_run != run_idx) {
+		FlushPending(result);
+	}
+	pending_run = run_idx;
+	pending_sel.set_index(pending_count++, runs[run_idx]->position);
+}
+
+void PaimonMergeReader::FlushPending(DataChunk &result) {
+	if (pending_count == 0) {
+		return;
+	}
+	result.Append(runs[pending_run]->chunk, false, &pending_sel, pending_count);
+	pending_count = 0;
+}
+
+} // namespace duckdb
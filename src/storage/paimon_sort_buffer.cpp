@@ -0,0 +1,145 @@
+#include "storage/paimon_sort_buffer.hpp"
+
+#include "duckdb/common/operator/comparison_operators.hpp"
+#include "duckdb/function/create_sort_key.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace duckdb {
+
+PaimonSortBuffer::PaimonSortBuffer(Allocator &allocator, const vector<LogicalType> &types,
+                                   const vector<idx_t> &key_indexes, PaimonMergeEngine merge_engine)
+    : allocator(allocator), key_indexes(key_indexes), merge_engine(merge_engine) {
+	auto row_types = types;
+	sequence_idx = row_types.size();
+	row_types.push_back(LogicalType::BIGINT);
+	kind_idx = row_types.size();
+	row_types.push_back(LogicalType::TINYINT);
+	rows.Initialize(allocator, row_types);
+	scratch.InitializeEmpty(row_types);
+	for (auto key_idx : key_indexes) {
+		key_types.push_back(types[key_idx]);
+	}
+}
+
+void PaimonSortBuffer::Append(DataChunk &chunk, int64_t first_sequence_number, PaimonRowKind kind) {
+	auto count = chunk.size();
+	if (count == 0) {
+		return;
+	}
+	for (idx_t col_idx = 0; col_idx < chunk.ColumnCount(); col_idx++) {
+		scratch.data[col_idx].Reference(chunk.data[col_idx]);
+	}
+	scratch.data[sequence_idx].Sequence(first_sequence_number, 1, count);
+	scratch.data[sequence_idx].Flatten(count);
+	scratch.data[kind_idx].Reference(Value::TINYINT(static_cast<int8_t>(kind)));
+	scratch.data[kind_idx].Flatten(count);
+	scratch.SetCardinality(count);
+	rows.Append(scratch, true);
+}
+
+idx_t PaimonSortBuffer::MemoryUsage() const {
+	return rows.GetAllocationSize();
+}
+
+vector<sel_t> PaimonSortBuffer::SortRows(vector<sel_t> &order) {
+	auto count = rows.size();
+
+	//! Compute the normalized sort key of every row, comparing those is a memcmp
+	vector<string_t> keys(count);
+	vector<Vector> key_batches;
+	vector<OrderModifiers> modifiers(key_indexes.size(),
+	                                 OrderModifiers(OrderType::ASCENDING, OrderByNullType::NULLS_LAST));
+	DataChunk key_chunk;
+	key_chunk.InitializeEmpty(key_types);
+	for (idx_t offset = 0; offset < count; offset += STANDARD_VECTOR_SIZE) {
+		auto batch_count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, count - offset);
+		for (idx_t i = 0; i < key_indexes.size(); i++) {
+			key_chunk.data[i].Slice(rows.data[key_indexes[i]], offset, offset + batch_count);
+		}
+		key_chunk.SetCardinality(batch_count);
+		key_batches.emplace_back(LogicalType::BLOB, batch_count);
+		auto &sort_keys = key_batches.back();
+		CreateSortKeyHelpers::CreateSortKey(key_chunk, modifiers, sort_keys);
+		sort_keys.Flatten(batch_count);
+		auto sort_key_data = FlatVector::GetData<string_t>(sort_keys);
+		for (idx_t row = 0; row < batch_count; row++) {
+			keys[offset + row] = sort_key_data[row];
+		}
+	}
+
+	//! Rows were buffered in sequence number order, so a stable sort on the key orders by (key, sequence number)
+	order.resize(count);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(),
+	                 [&](sel_t a, sel_t b) { return LessThan::Operation<string_t>(keys[a], keys[b]); });
+
+	//! A sorted run holds each key once, so rows with the same key are merged before they are written
+	auto kinds = FlatVector::GetData<int8_t>(rows.data[kind_idx]);
+	vector<sel_t> result;
+	result.reserve(count);
+	for (idx_t begin = 0; begin < count;) {
+		idx_t end = begin + 1;
+		while (end < count && Equals::Operation<string_t>(keys[order[begin]], keys[order[end]])) {
+			end++;
+		}
+		if (merge_engine == PaimonMergeEngine::FIRST_ROW) {
+			//! Only the first inserted row of a key is kept, retractions are ignored
+			for (idx_t i = begin; i < end; i++) {
+				auto kind = static_cast<PaimonRowKind>(kinds[order[i]]);
+				if (kind == PaimonRowKind::INSERT || kind == PaimonRowKind::UPDATE_AFTER) {
+					result.push_back(order[i]);
+					break;
+				}
+			}
+		} else {
+			//! Deduplicate: the row with the highest sequence number wins
+			result.push_back(order[end - 1]);
+		}
+		begin = end;
+	}
+	return result;
+}
+
+void PaimonSortBuffer::EmitRows(const vector<sel_t> &order, const std::function<void(DataChunk &chunk)> &callback) {
+	vector<LogicalType> output_types = key_types;
+	output_types.push_back(LogicalType::BIGINT);
+	output_types.push_back(LogicalType::TINYINT);
+	for (idx_t col_idx = 0; col_idx < sequence_idx; col_idx++) {
+		output_types.push_back(rows.data[col_idx].GetType());
+	}
+	DataChunk output;
+	output.InitializeEmpty(output_types);
+	for (idx_t offset = 0; offset < order.size(); offset += STANDARD_VECTOR_SIZE) {
+		auto batch_count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, order.size() - offset);
+		SelectionVector sel(const_cast<sel_t *>(order.data() + offset));
+		idx_t out_idx = 0;
+		for (auto key_idx : key_indexes) {
+			output.data[out_idx++].Slice(rows.data[key_idx], sel, batch_count);
+		}
+		output.data[out_idx++].Slice(rows.data[sequence_idx], sel, batch_count);
+		output.data[out_idx++].Slice(rows.data[kind_idx], sel, batch_count);
+		for (idx_t col_idx = 0; col_idx < sequence_idx; col_idx++) {
+			output.data[out_idx++].Slice(rows.data[col_idx], sel, batch_count);
+		}
+		output.SetCardinality(batch_count);
+		callback(output);
+	}
+}
+
+void PaimonSortBuffer::Flush(const std::function<void(DataChunk &chunk)> &callback,
+                             optional_ptr<const std::function<void(DataChunk &chunk)>> changelog) {
+	if (rows.size() == 0) {
+		return;
+	}
+	vector<sel_t> sorted;
+	auto merged = SortRows(sorted);
+	if (changelog) {
+		EmitRows(sorted, *changelog);
+	}
+	EmitRows(merged, callback);
+	rows.Reset();
+}
+
+} // namespace duckdb
@@ -1,10 +1,22 @@
 #include "storage/paimon_table_entry.hpp"
 #include "duckdb/planner/operator/logical_get.hpp"
+#include "duckdb/planner/operator/logical_projection.hpp"
+#include "duckdb/planner/operator/logical_update.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/catalog/catalog_entry/table_function_catalog_entry.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/parser/tableref/table_function_ref.hpp"
 #include "duckdb/execution/operator/scan/physical_table_scan.hpp"
 #include "duckdb/function/table_function.hpp"
 #include "duckdb/planner/table_filter.hpp"
 #include "duckdb/storage/statistics/base_statistics.hpp"
 #include "paimon_functions.hpp"
+#include "paimon_snapshot.hpp"
+#include "storage/paimon_commit.hpp"
+#include "storage/paimon_deletion_vectors.hpp"
+#include "storage/paimon_table_writer.hpp"
 
 namespace duckdb {
 
@@ -98,9 +110,40 @@ unique_ptr<BaseStatistics> PaimonTableEntry::GetStatistics(ClientContext &contex
 }
 
 TableFunction PaimonTableEntry::GetScanFunction(ClientContext &context, unique_ptr<FunctionData> &bind_data) {
-    // Return the paimon_scan table function
-    // This would need to be implemented to work with the catalog
-    throw InternalException("Paimon table scan not yet implemented in catalog");
+    // Scan the table with paimon_scan on its location
+    auto &db = DatabaseInstance::GetDatabase(context);
+    auto &system_catalog = Catalog::GetSystemCatalog(db);
+    auto data = CatalogTransaction::GetSystemTransaction(db);
+    auto &catalog_schema = system_catalog.GetSchema(data, DEFAULT_SCHEMA);
+    auto catalog_entry = catalog_schema.GetEntry(data, CatalogType::TABLE_FUNCTION_ENTRY, "paimon_scan");
+    if (!catalog_entry) {
+        throw InvalidInputException("Function with name \"paimon_scan\" not found!");
+    }
+    auto &paimon_scan_function_set = catalog_entry->Cast<TableFunctionCatalogEntry>();
+    auto paimon_scan_function =
+        paimon_scan_function_set.functions.GetFunctionByArguments(context, {LogicalType::VARCHAR});
+
+    named_parameter_map_t param_map;
+    vector<LogicalType> return_types;
+    vector<string> names;
+    TableFunctionRef empty_ref;
+    vector<Value> inputs = {Value(table_path)};
+    TableFunctionBindInput bind_input(inputs, param_map, return_types, names, nullptr, nullptr, paimon_scan_function,
+                                      empty_ref);
+    bind_data = paimon_scan_function.bind(context, bind_input, return_types, names);
+    return paimon_scan_function;
+}
+
+vector<column_t> PaimonTableEntry::GetRowIdColumns() const {
+    if (!metadata->schema || metadata->schema->primary_keys.empty()) {
+        return TableCatalogEntry::GetRowIdColumns();
+    }
+    // Rows of a primary key table are identified by their key: UPDATE and DELETE write new rows for it
+    vector<column_t> result;
+    for (auto &key : metadata->schema->primary_keys) {
+        result.push_back(columns.GetColumn(key).Physical().index);
+    }
+    return result;
 }
 
 TableStorageInfo PaimonTableEntry::GetStorageInfo(ClientContext &context) {
@@ -112,7 +155,29 @@ TableStorageInfo PaimonTableEntry::GetStorageInfo(ClientContext &context) {
 
 void PaimonTableEntry::BindUpdateConstraints(Binder &binder, LogicalGet &get, LogicalProjection &proj,
                                            LogicalUpdate &update, ClientContext &context) {
-    throw BinderException("Paimon tables do not support UPDATE operations yet");
+    if (!metadata->schema || metadata->schema->primary_keys.empty()) {
+        throw BinderException("UPDATE is only supported for Paimon primary key tables");
+    }
+    physical_index_set_t updated_columns(update.columns.begin(), update.columns.end());
+    for (auto &key : metadata->schema->primary_keys) {
+        if (updated_columns.find(columns.GetColumn(key).Physical()) != updated_columns.end()) {
+            throw BinderException("Cannot update primary key column \"%s\" of Paimon table \"%s\"", key, name);
+        }
+    }
+
+    // An update writes the complete new row of its key, so the columns that are not updated are projected as well,
+    // as if they were set to themselves ("i = i")
+    for (auto &column : columns.Physical()) {
+        if (updated_columns.find(column.Physical()) != updated_columns.end()) {
+            continue;
+        }
+        update.expressions.push_back(make_uniq<BoundColumnRefExpression>(
+            column.Type(), ColumnBinding(proj.table_index, proj.expressions.size())));
+        proj.expressions.push_back(make_uniq<BoundColumnRefExpression>(
+            column.Type(), ColumnBinding(get.table_index, get.GetColumnIds().size())));
+        get.AddColumnId(column.Physical().index);
+        update.columns.push_back(column.Physical());
+    }
 }
 
 unique_ptr<PhysicalOperator> PaimonTableEntry::CreateTableScan(LogicalGet &op, PhysicalPlanGenerator &planner) {
@@ -122,7 +187,28 @@ unique_ptr<PhysicalOperator> PaimonTableEntry::CreateTableScan(LogicalGet &op, P
 }
 
 void PaimonTableEntry::TruncateTable(ClientContext &context) {
-    throw CatalogException("Paimon tables do not support TRUNCATE operations yet");
+    // Truncating is metadata-only: an OVERWRITE snapshot removes every live data file and index file
+    PaimonWriteLayout layout(context, *this);
+    layout.CheckWritable();
+    auto &fs = FileSystem::GetFileSystem(context);
+    auto latest_id = PaimonTableMetadata::FindLatestSnapshotId(layout.table_path, fs);
+    if (latest_id == 0) {
+        return;
+    }
+    auto snapshot = paimon_snapshot::Read(context, layout.table_path, latest_id);
+    auto entries = paimon_snapshot::ReadLiveFiles(context, layout.table_path, snapshot);
+    for (auto &entry : entries) {
+        entry.kind = PaimonFileKind::DELETE;
+    }
+    auto index_changes = PaimonDeletionVectors::ReadIndexFiles(context, layout.table_path, snapshot);
+    for (auto &index_file : index_changes) {
+        index_file.kind = PaimonFileKind::DELETE;
+    }
+    if (entries.empty() && index_changes.empty()) {
+        return;
+    }
+    PaimonCommit commit(context, layout);
+    commit.Commit(entries, PaimonCommitKind::OVERWRITE, vector<PaimonManifestEntry>(), index_changes);
 }
 
 } // namespace duckdb
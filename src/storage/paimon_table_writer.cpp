@@ -0,0 +1,600 @@
+#include "storage/paimon_table_writer.hpp"
+#include "storage/paimon_table_entry.hpp"
+#include "paimon_manifest.hpp"
+#include "paimon_snapshot.hpp"
+
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/uuid.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+
+namespace duckdb {
+
+static idx_t FindColumn(const vector<string> &names, const string &name, const string &kind) {
+	for (idx_t i = 0; i < names.size(); i++) {
+		if (names[i] == name) {
+			return i;
+		}
+	}
+	throw InvalidInputException("Paimon %s \"%s\" is not a column of the table", kind, name);
+}
+
+PaimonWriteLayout::PaimonWriteLayout(ClientContext &context, PaimonTableEntry &table)
+    : table_path(table.GetTablePath()), column_names(table.GetColumns().GetColumnNames()),
+      column_types(table.GetColumns().GetColumnTypes()), bucket_manager(1), path_factory(table_path, 1),
+      file_uuid(UUID::ToString(UUID::GenerateRandomUUID())), file_counter(0), context(context) {
+	auto &fs = FileSystem::GetFileSystem(context);
+
+	//! Prefer the schema file, the catalog entry may have been created before the table's options were set
+	auto latest_schema = PaimonTableMetadata::LoadLatestSchema(table_path, fs);
+	optional_ptr<const PaimonSchema> schema = latest_schema.get();
+	if (!schema) {
+		schema = table.GetMetadata().schema.get();
+	}
+	Initialize(schema);
+
+	//! Primary key tables write the KeyValue layout, keyed on the primary key
+	bind = make_uniq<PaimonDataFileBindData>(context, table, primary_key_indexes);
+}
+
+PaimonWriteLayout::PaimonWriteLayout(ClientContext &context, const string &table_path_p, const PaimonSchema &schema,
+                                     vector<string> column_names_p, vector<LogicalType> column_types_p)
+    : table_path(table_path_p), column_names(std::move(column_names_p)), column_types(std::move(column_types_p)),
+      bucket_manager(1), path_factory(table_path, 1), file_uuid(UUID::ToString(UUID::GenerateRandomUUID())),
+      file_counter(0), context(context) {
+	Initialize(&schema);
+	bind = make_uniq<PaimonDataFileBindData>(column_names, column_types, primary_key_indexes);
+}
+
+void PaimonWriteLayout::Initialize(optional_ptr<const PaimonSchema> schema) {
+	if (schema) {
+		schema_id = schema->id;
+		partition_keys = schema->partition_keys;
+		primary_keys = schema->primary_keys;
+		options = schema->options;
+	}
+
+	for (auto &key : partition_keys) {
+		auto col_idx = FindColumn(column_names, key, "partition key");
+		partition_key_indexes.push_back(col_idx);
+		partition_types.push_back(column_types[col_idx]);
+	}
+	for (auto &key : primary_keys) {
+		primary_key_indexes.push_back(FindColumn(column_names, key, "primary key"));
+	}
+
+	auto bucket_option = GetOption("bucket");
+	if (!bucket_option.empty()) {
+		total_buckets = std::stoi(bucket_option);
+	}
+	if (total_buckets == 0 || total_buckets < -1) {
+		throw InvalidInputException("Invalid Paimon 'bucket' option: %s", bucket_option);
+	}
+	bucket_manager = BucketManager(total_buckets == -1 ? 1 : total_buckets);
+	path_factory = FileStorePathFactory(table_path, bucket_manager.getNumBuckets());
+
+	//! The bucket key is 'bucket-key' if set, otherwise the primary key without the partition keys
+	auto bucket_key_option = GetOption("bucket-key");
+	if (!bucket_key_option.empty()) {
+		for (auto &key : StringUtil::Split(bucket_key_option, ',')) {
+			bucket_key_indexes.push_back(FindColumn(column_names, StringUtil::Strip(key), "bucket key"));
+		}
+	} else {
+		for (auto &key : primary_keys) {
+			if (std::find(partition_keys.begin(), partition_keys.end(), key) == partition_keys.end()) {
+				bucket_key_indexes.push_back(FindColumn(column_names, key, "primary key"));
+			}
+		}
+	}
+	if (!SingleBucket() && bucket_key_indexes.empty()) {
+		throw InvalidInputException("Paimon append tables with a fixed number of buckets require a 'bucket-key'");
+	}
+
+	target_file_size = GetMemorySizeOption("target-file-size", HasPrimaryKey() ? DEFAULT_PRIMARY_KEY_TARGET_FILE_SIZE
+	                                                                          : DEFAULT_APPEND_TARGET_FILE_SIZE);
+	manifest_target_file_size =
+	    GetMemorySizeOption("manifest.target-file-size", paimon_manifest::DEFAULT_MANIFEST_TARGET_FILE_SIZE);
+	write_buffer_size = GetMemorySizeOption("write-buffer-size", DEFAULT_WRITE_BUFFER_SIZE);
+
+	auto merge_engine_option = StringUtil::Lower(GetOption("merge-engine"));
+	if (merge_engine_option.empty() || merge_engine_option == "deduplicate") {
+		merge_engine = PaimonMergeEngine::DEDUPLICATE;
+	} else if (merge_engine_option == "first-row") {
+		merge_engine = PaimonMergeEngine::FIRST_ROW;
+	} else if (merge_engine_option == "partial-update") {
+		merge_engine = PaimonMergeEngine::PARTIAL_UPDATE;
+	} else if (merge_engine_option == "aggregation") {
+		merge_engine = PaimonMergeEngine::AGGREGATE;
+	} else {
+		throw InvalidInputException("Unrecognized Paimon 'merge-engine' option: %s", merge_engine_option);
+	}
+
+	if (HasPrimaryKey()) {
+		auto changelog_producer_option = StringUtil::Lower(GetOption("changelog-producer"));
+		if (changelog_producer_option.empty() || changelog_producer_option == "none") {
+			changelog_producer = PaimonChangelogProducer::NONE;
+		} else if (changelog_producer_option == "input") {
+			changelog_producer = PaimonChangelogProducer::INPUT;
+		} else if (changelog_producer_option == "lookup") {
+			changelog_producer = PaimonChangelogProducer::LOOKUP;
+		} else if (changelog_producer_option == "full-compaction") {
+			//! Rejected by CheckWritable, readers ignore the changelog
+			changelog_producer = PaimonChangelogProducer::NONE;
+		} else {
+			throw InvalidInputException("Unrecognized Paimon 'changelog-producer' option: %s",
+			                            changelog_producer_option);
+		}
+	}
+}
+
+void PaimonWriteLayout::CheckWritable() const {
+	if (!HasPrimaryKey()) {
+		return;
+	}
+	if (total_buckets == -1) {
+		throw NotImplementedException("Writing to Paimon primary key tables in dynamic bucket mode (bucket = -1)");
+	}
+	if (merge_engine == PaimonMergeEngine::PARTIAL_UPDATE || merge_engine == PaimonMergeEngine::AGGREGATE) {
+		throw NotImplementedException("Writing to Paimon primary key tables with merge-engine '%s'",
+		                              GetOption("merge-engine"));
+	}
+	if (StringUtil::Lower(GetOption("changelog-producer")) == "full-compaction") {
+		throw NotImplementedException("Writing to Paimon tables with changelog-producer 'full-compaction'");
+	}
+	//! Readers of these tables skip level-0 files and expect the older versions of the keys of compacted files to be
+	//! deleted by deletion vectors, which the writer and the compactor don't maintain
+	if (StringUtil::CIEquals(GetOption("deletion-vectors.enabled"), "true")) {
+		throw NotImplementedException("Writing to Paimon primary key tables with 'deletion-vectors.enabled'");
+	}
+}
+
+PaimonWriteLayout::BucketState &PaimonWriteLayout::GetBucketState(const vector<uint8_t> &partition, int32_t bucket) {
+	auto key = SequenceKey(partition, bucket);
+	auto entry = buckets.find(key);
+	if (entry != buckets.end()) {
+		return entry->second;
+	}
+	auto &state = buckets[key];
+	if (!manifests_loaded) {
+		auto &fs = FileSystem::GetFileSystem(context);
+		auto latest_id = PaimonTableMetadata::FindLatestSnapshotId(table_path, fs);
+		if (latest_id > 0) {
+			auto snapshot = paimon_snapshot::Read(context, table_path, latest_id);
+			manifests = paimon_snapshot::ReadManifests(context, table_path, snapshot);
+		}
+		manifests_loaded = true;
+	}
+
+	//! Only the manifests whose bucket range and partition stats include the bucket are read, every entry of a
+	//! file (its ADD and its DELETE) is in the bucket of the file
+	auto partition_values = PaimonBinaryRow::Deserialize(partition, partition_types);
+	vector<PaimonManifestEntry> bucket_entries;
+	for (idx_t i = 0; i < manifests.size(); i++) {
+		if (!paimon_snapshot::MayContainBucket(manifests[i], partition_types, partition_values, bucket)) {
+			continue;
+		}
+		auto cached = manifest_entries.find(i);
+		if (cached == manifest_entries.end()) {
+			auto path = paimon_snapshot::ManifestPath(table_path, manifests[i].fileName);
+			cached = manifest_entries.emplace(i, paimon_manifest_file::ReadFromFile(context, path)).first;
+		}
+		for (auto &manifest_entry : cached->second) {
+			if (manifest_entry.bucket == bucket && manifest_entry.partition == partition) {
+				bucket_entries.push_back(manifest_entry);
+			}
+		}
+	}
+	state.files = paimon_snapshot::MergeEntries(bucket_entries);
+	for (auto &file : state.files) {
+		state.next_sequence_number = MaxValue(state.next_sequence_number, file.file.maxSequenceNumber + 1);
+	}
+	return state;
+}
+
+vector<PaimonManifestEntry> PaimonWriteLayout::BucketFiles(const vector<uint8_t> &partition, int32_t bucket) {
+	lock_guard<mutex> guard(sequence_lock);
+	return GetBucketState(partition, bucket).files;
+}
+
+string PaimonWriteLayout::SequenceKey(const vector<uint8_t> &partition, int32_t bucket) {
+	string result(const_char_ptr_cast(partition.data()), partition.size());
+	result.append(const_char_ptr_cast(&bucket), sizeof(bucket));
+	return result;
+}
+
+int64_t PaimonWriteLayout::ReserveSequenceNumbers(const vector<uint8_t> &partition, int32_t bucket, idx_t count) {
+	lock_guard<mutex> guard(sequence_lock);
+	auto &next = GetBucketState(partition, bucket).next_sequence_number;
+	auto result = next;
+	next += NumericCast<int64_t>(count);
+	return result;
+}
+
+string PaimonWriteLayout::GetOption(const string &name) const {
+	auto entry = options.find(name);
+	if (entry == options.end()) {
+		return string();
+	}
+	return entry->second;
+}
+
+idx_t PaimonWriteLayout::GetIntegerOption(const string &name, idx_t default_value) const {
+	auto value = GetOption(name);
+	if (value.empty()) {
+		return default_value;
+	}
+	return std::stoull(value);
+}
+
+idx_t PaimonWriteLayout::GetMemorySizeOption(const string &name, idx_t default_value) const {
+	auto value = GetOption(name);
+	if (value.empty()) {
+		return default_value;
+	}
+	return DBConfig::ParseMemoryLimit(value);
+}
+
+int64_t PaimonWriteLayout::GetDurationOption(const string &name, int64_t default_value) const {
+	auto value = StringUtil::Lower(StringUtil::Strip(GetOption(name)));
+	if (value.empty()) {
+		return default_value;
+	}
+	//! Like org.apache.paimon.utils.TimeUtils.parseDuration: a number, optionally followed by a unit
+	idx_t pos = 0;
+	while (pos < value.size() && StringUtil::CharacterIsDigit(value[pos])) {
+		pos++;
+	}
+	auto unit = StringUtil::Strip(value.substr(pos));
+	if (pos == 0) {
+		throw InvalidInputException("Invalid duration '%s' for Paimon option '%s'", value, name);
+	}
+	auto amount = std::stoll(value.substr(0, pos));
+	if (unit.empty() || unit == "ms" || unit == "milli" || unit == "millis" || unit == "millisecond" ||
+	    unit == "milliseconds") {
+		return amount;
+	}
+	if (unit == "s" || unit == "sec" || unit == "secs" || unit == "second" || unit == "seconds") {
+		return amount * Interval::MSECS_PER_SEC;
+	}
+	if (unit == "m" || unit == "min" || unit == "mins" || unit == "minute" || unit == "minutes") {
+		return amount * Interval::MSECS_PER_SEC * Interval::SECS_PER_MINUTE;
+	}
+	if (unit == "h" || unit == "hour" || unit == "hours") {
+		return amount * Interval::MSECS_PER_SEC * Interval::SECS_PER_HOUR;
+	}
+	if (unit == "d" || unit == "day" || unit == "days") {
+		return amount * Interval::MSECS_PER_SEC * Interval::SECS_PER_DAY;
+	}
+	throw InvalidInputException("Invalid duration '%s' for Paimon option '%s': unrecognized unit '%s'", value, name,
+	                            unit);
+}
+
+void PaimonWriteLayout::CreateBucketDirectory(ClientContext &context, const vector<pair<string, string>> &partition,
+                                              int bucket) {
+	auto bucket_dir = path_factory.partitionBucketPath(partition, bucket);
+	lock_guard<mutex> guard(directory_lock);
+	if (created_directories.find(bucket_dir) != created_directories.end()) {
+		return;
+	}
+	auto &fs = FileSystem::GetFileSystem(context);
+	string dir = table_path;
+	for (auto &part : partition) {
+		dir += "/" + part.first + "=" + part.second;
+		if (!fs.DirectoryExists(dir)) {
+			fs.CreateDirectory(dir);
+		}
+	}
+	if (!fs.DirectoryExists(bucket_dir)) {
+		fs.CreateDirectory(bucket_dir);
+	}
+	created_directories.insert(bucket_dir);
+}
+
+string PaimonWriteLayout::NewDataFilePath(ClientContext &context, const vector<pair<string, string>> &partition,
+                                          int bucket) {
+	CreateBucketDirectory(context, partition, bucket);
+	auto counter = file_counter.fetch_add(1);
+	return path_factory.partitionedDataFilePath(partition, bucket, file_uuid, NumericCast<int>(counter),
+	                                            PaimonFileFormat::PARQUET);
+}
+
+string PaimonWriteLayout::NewChangelogFilePath(ClientContext &context, const vector<pair<string, string>> &partition,
+                                               int bucket) {
+	CreateBucketDirectory(context, partition, bucket);
+	auto counter = file_counter.fetch_add(1);
+	return path_factory.partitionedChangelogFilePath(partition, bucket, file_uuid, NumericCast<int>(counter),
+	                                                 PaimonFileFormat::PARQUET);
+}
+
+vector<pair<string, string>> PaimonWriteLayout::PartitionPath(const vector<uint8_t> &partition) const {
+	vector<pair<string, string>> result;
+	if (!IsPartitioned()) {
+		return result;
+	}
+	auto values = PaimonBinaryRow::Deserialize(partition, partition_types);
+	for (idx_t i = 0; i < partition_keys.size(); i++) {
+		auto path_value = values[i].IsNull() ? string(DEFAULT_PARTITION_NAME) : values[i].ToString();
+		result.emplace_back(partition_keys[i], std::move(path_value));
+	}
+	return result;
+}
+
+string PaimonWriteLayout::DataFilePath(const PaimonManifestEntry &entry) const {
+	if (!entry.file.externalPath.empty()) {
+		return entry.file.externalPath;
+	}
+	return path_factory.partitionBucketPath(PartitionPath(entry.partition), entry.bucket) + "/" + entry.file.fileName;
+}
+
+PaimonTableWriter::PaimonTableWriter(PaimonWriteLayout &layout)
+    : layout(layout), partition_row(layout.partition_key_indexes.size()),
+      bucket_key_row(layout.bucket_key_indexes.size()) {
+	slice.InitializeEmpty(layout.column_types);
+}
+
+void PaimonTableWriter::ComputeRoutingKey(DataChunk &chunk, idx_t row, string &result) {
+	partition_row.Reset();
+	for (idx_t i = 0; i < layout.partition_key_indexes.size(); i++) {
+		auto col_idx = layout.partition_key_indexes[i];
+		partition_row.WriteVector(i, chunk.data[col_idx], column_formats[col_idx], row);
+	}
+	int32_t bucket = 0;
+	if (!layout.SingleBucket()) {
+		bucket_key_row.Reset();
+		for (idx_t i = 0; i < layout.bucket_key_indexes.size(); i++) {
+			auto col_idx = layout.bucket_key_indexes[i];
+			bucket_key_row.WriteVector(i, chunk.data[col_idx], column_formats[col_idx], row);
+		}
+		bucket = layout.bucket_manager.assignBucket(bucket_key_row.HashCode());
+	}
+	auto &row_bytes = partition_row.RowBytes();
+	result.assign(const_char_ptr_cast(row_bytes.data()), row_bytes.size());
+	result.append(const_char_ptr_cast(&bucket), sizeof(bucket));
+}
+
+idx_t PaimonTableWriter::RouteRows(DataChunk &chunk) {
+	auto count = chunk.size();
+	column_formats.resize(chunk.ColumnCount());
+	for (auto col_idx : layout.partition_key_indexes) {
+		chunk.data[col_idx].ToUnifiedFormat(count, column_formats[col_idx]);
+	}
+	if (!layout.SingleBucket()) {
+		for (auto col_idx : layout.bucket_key_indexes) {
+			chunk.data[col_idx].ToUnifiedFormat(count, column_formats[col_idx]);
+		}
+	}
+
+	row_group_map.clear();
+	idx_t group_count = 0;
+	idx_t current_group = DConstants::INVALID_INDEX;
+	string previous_key;
+	for (idx_t row = 0; row < count; row++) {
+		ComputeRoutingKey(chunk, row, row_key);
+		//! Input is often clustered on the partition, so only probe the map when the key changes
+		if (current_group == DConstants::INVALID_INDEX || row_key != previous_key) {
+			auto entry = row_group_map.find(row_key);
+			if (entry == row_group_map.end()) {
+				if (group_count == row_groups.size()) {
+					row_groups.emplace_back();
+					row_groups.back().sel.Initialize(STANDARD_VECTOR_SIZE);
+				}
+				auto &group = row_groups[group_count];
+				group.key = row_key;
+				group.first_row = row;
+				group.count = 0;
+				current_group = group_count;
+				row_group_map.emplace(row_key, group_count++);
+			} else {
+				current_group = entry->second;
+			}
+			previous_key = row_key;
+		}
+		auto &group = row_groups[current_group];
+		group.sel.set_index(group.count++, row);
+	}
+	return group_count;
+}
+
+PaimonTableWriter::BucketWriter &PaimonTableWriter::GetBucketWriter(ClientContext &context, const string &key,
+                                                                    DataChunk &chunk, idx_t row) {
+	auto entry = bucket_writers.find(key);
+	if (entry != bucket_writers.end()) {
+		return *entry->second;
+	}
+	auto writer = make_uniq<BucketWriter>();
+	int32_t bucket;
+	memcpy(&bucket, key.data() + key.size() - sizeof(bucket), sizeof(bucket));
+	writer->bucket = bucket;
+
+	vector<Value> partition_values;
+	for (auto col_idx : layout.partition_key_indexes) {
+		auto value = chunk.data[col_idx].GetValue(row);
+		auto path_value = value.IsNull() ? string(PaimonWriteLayout::DEFAULT_PARTITION_NAME) : value.ToString();
+		writer->partition_path.emplace_back(layout.column_names[col_idx], std::move(path_value));
+		partition_values.push_back(std::move(value));
+	}
+	writer->partition = PaimonBinaryRow::Serialize(partition_values);
+
+	auto &result = *writer;
+	bucket_writers.emplace(key, std::move(writer));
+	return result;
+}
+
+PaimonManifestEntry PaimonTableWriter::FinalizeFile(ExecutionContext &context, BucketWriter &writer,
+                                                    PaimonDataFileWriter &file) {
+	PaimonManifestEntry entry;
+	entry.kind = PaimonFileKind::ADD;
+	entry.partition = writer.partition;
+	entry.bucket = writer.bucket;
+	entry.totalBuckets = layout.total_buckets;
+	entry.file = file.Finalize(context);
+	entry.file.schemaId = layout.schema_id;
+	return entry;
+}
+
+void PaimonTableWriter::CloseFile(ExecutionContext &context, BucketWriter &writer) {
+	if (!writer.file) {
+		return;
+	}
+	written_files.push_back(FinalizeFile(context, writer, *writer.file));
+	writer.file.reset();
+}
+
+void PaimonTableWriter::CloseChangelogFile(ExecutionContext &context, BucketWriter &writer) {
+	if (!writer.changelog_file) {
+		return;
+	}
+	written_changelog_files.push_back(FinalizeFile(context, writer, *writer.changelog_file));
+	writer.changelog_file.reset();
+}
+
+void PaimonTableWriter::AppendToChangelog(ExecutionContext &context, BucketWriter &writer, DataChunk &chunk) {
+	if (!writer.changelog_file) {
+		auto path = layout.NewChangelogFilePath(context.client, writer.partition_path, writer.bucket);
+		writer.changelog_file = make_uniq<PaimonDataFileWriter>(context, *layout.bind, std::move(path));
+	}
+	writer.changelog_file->Append(context, chunk);
+	if (writer.changelog_file->FileSize() >= layout.target_file_size) {
+		CloseChangelogFile(context, writer);
+	}
+}
+
+void PaimonTableWriter::AppendToBucket(ExecutionContext &context, BucketWriter &writer, DataChunk &chunk) {
+	if (!writer.file) {
+		auto path = layout.NewDataFilePath(context.client, writer.partition_path, writer.bucket);
+		writer.file = make_uniq<PaimonDataFileWriter>(context, *layout.bind, std::move(path));
+	}
+	writer.file->Append(context, chunk);
+	//! The size only includes flushed row groups, so files may exceed the target by at most one row group
+	if (writer.file->FileSize() >= layout.target_file_size) {
+		CloseFile(context, writer);
+	}
+}
+
+void PaimonTableWriter::FlushBuffer(ExecutionContext &context, BucketWriter &writer) {
+	if (!writer.buffer || writer.buffer->Count() == 0) {
+		return;
+	}
+	std::function<void(DataChunk &)> append_changelog = [&](DataChunk &rows) {
+		AppendToChangelog(context, writer, rows);
+	};
+	auto first_written_file = written_files.size();
+	switch (layout.changelog_producer) {
+	case PaimonChangelogProducer::INPUT:
+		//! The changelog holds every input row, before rows with the same key are merged
+		writer.buffer->Flush([&](DataChunk &sorted) { AppendToBucket(context, writer, sorted); }, &append_changelog);
+		break;
+	case PaimonChangelogProducer::LOOKUP:
+		if (!writer.lookup) {
+			writer.lookup = make_uniq<PaimonChangelogLookup>(context.client, layout,
+			                                                 layout.BucketFiles(writer.partition, writer.bucket));
+		}
+		writer.buffer->Flush([&](DataChunk &sorted) {
+			writer.lookup->Produce(sorted, append_changelog);
+			AppendToBucket(context, writer, sorted);
+		});
+		break;
+	default:
+		writer.buffer->Flush([&](DataChunk &sorted) { AppendToBucket(context, writer, sorted); });
+		break;
+	}
+	//! Every flush is a sorted run of its own, so it must not share a file with the next one
+	CloseFile(context, writer);
+	CloseChangelogFile(context, writer);
+	if (writer.lookup) {
+		//! The versions of the run may be evicted from the lookup's cache, they are then found in its files
+		for (idx_t i = first_written_file; i < written_files.size(); i++) {
+			writer.lookup->AddFile(written_files[i]);
+		}
+	}
+	auto memory = writer.buffer->MemoryUsage();
+	buffered_memory = buffered_memory - writer.buffered_memory + memory;
+	writer.buffered_memory = memory;
+}
+
+void PaimonTableWriter::BufferRows(ExecutionContext &context, BucketWriter &writer, DataChunk &chunk,
+                                   PaimonRowKind kind) {
+	if (!writer.buffer) {
+		auto &allocator = BufferManager::GetBufferManager(context.client).GetBufferAllocator();
+		writer.buffer = make_uniq<PaimonSortBuffer>(allocator, layout.column_types, layout.primary_key_indexes,
+		                                            layout.merge_engine);
+	}
+	auto first_sequence_number = layout.ReserveSequenceNumbers(writer.partition, writer.bucket, chunk.size());
+	writer.buffer->Append(chunk, first_sequence_number, kind);
+	auto memory = writer.buffer->MemoryUsage();
+	buffered_memory = buffered_memory - writer.buffered_memory + memory;
+	writer.buffered_memory = memory;
+
+	//! The write buffer is shared by all buckets of this writer, when it is full the largest bucket is flushed
+	while (buffered_memory > layout.write_buffer_size) {
+		optional_ptr<BucketWriter> largest;
+		for (auto &entry : bucket_writers) {
+			auto &candidate = *entry.second;
+			if (candidate.buffer && candidate.buffer->Count() > 0 &&
+			    (!largest || candidate.buffered_memory > largest->buffered_memory)) {
+				largest = candidate;
+			}
+		}
+		if (!largest) {
+			break;
+		}
+		FlushBuffer(context, *largest);
+	}
+}
+
+void PaimonTableWriter::WriteRows(ExecutionContext &context, BucketWriter &writer, DataChunk &chunk,
+                                  PaimonRowKind kind) {
+	if (layout.HasPrimaryKey()) {
+		BufferRows(context, writer, chunk, kind);
+	} else {
+		AppendToBucket(context, writer, chunk);
+	}
+}
+
+void PaimonTableWriter::Append(ExecutionContext &context, DataChunk &chunk, PaimonRowKind kind) {
+	if (chunk.size() == 0) {
+		return;
+	}
+	if (!layout.HasPrimaryKey() && kind != PaimonRowKind::INSERT) {
+		throw InternalException("Append tables can only be written with INSERT rows");
+	}
+	if (!layout.IsPartitioned() && layout.SingleBucket()) {
+		//! Everything goes to bucket 0 of the only partition
+		ComputeRoutingKey(chunk, 0, row_key);
+		auto &writer = GetBucketWriter(context.client, row_key, chunk, 0);
+		WriteRows(context, writer, chunk, kind);
+		return;
+	}
+
+	auto group_count = RouteRows(chunk);
+	if (group_count == 1) {
+		auto &writer = GetBucketWriter(context.client, row_groups[0].key, chunk, 0);
+		WriteRows(context, writer, chunk, kind);
+		return;
+	}
+	for (idx_t group_idx = 0; group_idx < group_count; group_idx++) {
+		auto &group = row_groups[group_idx];
+		auto &writer = GetBucketWriter(context.client, group.key, chunk, group.first_row);
+		slice.Slice(chunk, group.sel, group.count);
+		WriteRows(context, writer, slice, kind);
+	}
+}
+
+void PaimonTableWriter::Flush(ExecutionContext &context, vector<PaimonManifestEntry> &result,
+                              vector<PaimonManifestEntry> &changelog_result) {
+	for (auto &entry : bucket_writers) {
+		FlushBuffer(context, *entry.second);
+		CloseFile(context, *entry.second);
+	}
+	for (auto &entry : written_files) {
+		result.push_back(std::move(entry));
+	}
+	written_files.clear();
+	for (auto &entry : written_changelog_files) {
+		changelog_result.push_back(std::move(entry));
+	}
+	written_changelog_files.clear();
+}
+
+} // namespace duckdb
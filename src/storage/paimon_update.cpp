@@ -1,17 +1,13 @@
 #include "storage/paimon_update.hpp"
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
-#include "duckdb/common/types/column/column_data_collection.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/main/client_context.hpp"
-#include "duckdb/parallel/thread_context.hpp"
 #include "duckdb/planner/expression/bound_reference_expression.hpp"
-#include "duckdb/storage/data_table.hpp"
-#include "duckdb/storage/table/delete_state.hpp"
-#include "duckdb/storage/table/scan_state.hpp"
-#include "duckdb/storage/table/update_state.hpp"
-#include "duckdb/transaction/duck_transaction.hpp"
+#include "storage/paimon_commit.hpp"
+#include "storage/paimon_compaction.hpp"
 #include "storage/paimon_table_entry.hpp"
+#include "storage/paimon_table_writer.hpp"
 
 namespace duckdb {
 
@@ -31,52 +27,79 @@ PaimonUpdate::PaimonUpdate(PhysicalPlan &physical_plan, vector<LogicalType> type
 //===--------------------------------------------------------------------===//
 class PaimonUpdateGlobalState : public GlobalSinkState {
 public:
-	explicit PaimonUpdateGlobalState() = default;
+	PaimonUpdateGlobalState(ClientContext &context, PaimonTableEntry &table) : layout(context, table), update_count(0) {
+		layout.CheckWritable();
+	}
 
+	//! Partitioning, bucketing and file sizing of the table, shared by all writer threads
+	PaimonWriteLayout layout;
+	mutex lock;
+	//! The files written by this update
+	vector<PaimonManifestEntry> written_files;
+	vector<PaimonManifestEntry> changelog_files;
 	//! The amount of rows updated
-	idx_t update_count = 0;
-	//! ColumnDataCollection to store the result of the update
-	ColumnDataCollection return_collection;
+	atomic<idx_t> update_count;
 };
 
 class PaimonUpdateLocalState : public LocalSinkState {
 public:
-	explicit PaimonUpdateLocalState(ClientContext &context, const vector<LogicalType> &types) {
-		// Initialize local state for update processing
+	PaimonUpdateLocalState(ClientContext &context, PaimonWriteLayout &layout,
+	                       const vector<unique_ptr<Expression>> &bound_defaults)
+	    : writer(layout), default_executor(context, bound_defaults) {
+		update_chunk.Initialize(context, layout.column_types);
 	}
+
+	PaimonTableWriter writer;
+	//! The updated rows, in the column order of the table
+	DataChunk update_chunk;
+	ExpressionExecutor default_executor;
 };
 
 //===--------------------------------------------------------------------===//
 // Getters
 //===--------------------------------------------------------------------===//
 unique_ptr<GlobalSinkState> PaimonUpdate::GetGlobalSinkState(ClientContext &context) const {
-	return make_uniq<PaimonUpdateGlobalState>();
+	auto result = make_uniq<PaimonUpdateGlobalState>(context, tableref.Cast<PaimonTableEntry>());
+	//! PaimonTableEntry::BindUpdateConstraints sets every column that is not updated to itself
+	D_ASSERT(columns.size() == result->layout.column_types.size());
+	return std::move(result);
 }
 
 unique_ptr<LocalSinkState> PaimonUpdate::GetLocalSinkState(ExecutionContext &context) const {
-	return make_uniq<PaimonUpdateLocalState>(context.client, types);
+	auto &global_state = sink_state->Cast<PaimonUpdateGlobalState>();
+	return make_uniq<PaimonUpdateLocalState>(context.client, global_state.layout, bound_defaults);
 }
 
 //===--------------------------------------------------------------------===//
 // Sink
 //===--------------------------------------------------------------------===//
 SinkResultType PaimonUpdate::Sink(ExecutionContext &context, DataChunk &chunk, OperatorSinkInput &input) const {
-	auto &global_state = input.global_state->Cast<PaimonUpdateGlobalState>();
-	auto &local_state = input.local_state->Cast<PaimonUpdateLocalState>();
-
-	// For now, this is a placeholder implementation
-	// In a full implementation, this would:
-	// 1. Read the existing data that matches the WHERE clause
-	// 2. Apply the UPDATE expressions to modify the data
-	// 3. Write new data files with the updated records
-	// 4. Update Paimon metadata with new snapshot
-
-	global_state.update_count += chunk.size();
-
-	if (return_chunk) {
-		global_state.return_collection.Append(chunk);
+	auto &global_state = input.global_state.Cast<PaimonUpdateGlobalState>();
+	auto &local_state = input.local_state.Cast<PaimonUpdateLocalState>();
+
+	// Assemble the new version of every row: the updated values, and the current values of the other columns
+	auto &update_chunk = local_state.update_chunk;
+	update_chunk.Reset();
+	local_state.default_executor.SetChunk(chunk);
+	for (idx_t i = 0; i < expressions.size(); i++) {
+		auto col_idx = columns[i].index;
+		auto &target = update_chunk.data[col_idx];
+		if (expressions[i]->GetExpressionType() == ExpressionType::VALUE_DEFAULT) {
+			local_state.default_executor.ExecuteExpression(col_idx, target);
+			continue;
+		}
+		auto &source = chunk.data[expressions[i]->Cast<BoundReferenceExpression>().index];
+		if (source.GetType() == target.GetType()) {
+			target.Reference(source);
+		} else {
+			VectorOperations::Cast(context.client, source, target, chunk.size());
+		}
 	}
+	update_chunk.SetCardinality(chunk.size());
 
+	// The new versions supersede the current ones by their higher sequence number
+	local_state.writer.Append(context, update_chunk, PaimonRowKind::UPDATE_AFTER);
+	global_state.update_count += chunk.size();
 	return SinkResultType::NEED_MORE_INPUT;
 }
 
@@ -84,49 +107,50 @@ SinkResultType PaimonUpdate::Sink(ExecutionContext &context, DataChunk &chunk, O
 // Combine
 //===--------------------------------------------------------------------===//
 SinkCombineResultType PaimonUpdate::Combine(ExecutionContext &context, OperatorSinkCombineInput &input) const {
-	auto &global_state = input.global_state->Cast<PaimonUpdateGlobalState>();
-	auto &local_state = input.local_state->Cast<PaimonUpdateLocalState>();
+	auto &global_state = input.global_state.Cast<PaimonUpdateGlobalState>();
+	auto &local_state = input.local_state.Cast<PaimonUpdateLocalState>();
 
-	// Combine results from parallel workers
-	// For now, just return success
+	vector<PaimonManifestEntry> written_files;
+	vector<PaimonManifestEntry> changelog_files;
+	local_state.writer.Flush(context, written_files, changelog_files);
 
+	lock_guard<mutex> guard(global_state.lock);
+	for (auto &entry : written_files) {
+		global_state.written_files.push_back(std::move(entry));
+	}
+	for (auto &entry : changelog_files) {
+		global_state.changelog_files.push_back(std::move(entry));
+	}
 	return SinkCombineResultType::FINISHED;
 }
 
 //===--------------------------------------------------------------------===//
-// Source
+// Finalize
 //===--------------------------------------------------------------------===//
-class PaimonUpdateSourceState : public GlobalSourceState {
-public:
-	explicit PaimonUpdateSourceState(const PaimonUpdate &op) {
+SinkFinalizeType PaimonUpdate::Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
+                                        OperatorSinkFinalizeInput &input) const {
+	auto &global_state = input.global_state.Cast<PaimonUpdateGlobalState>();
+	if (global_state.written_files.empty()) {
+		return SinkFinalizeType::READY;
 	}
+	PaimonCommit commit(context, global_state.layout);
+	commit.Commit(global_state.written_files, PaimonCommitKind::APPEND, global_state.changelog_files);
+	PaimonCompactor::CompactAfterWrite(context, global_state.layout, global_state.written_files);
+	return SinkFinalizeType::READY;
+}
 
-public:
-	bool finished = false;
-};
-
+//===--------------------------------------------------------------------===//
+// Source
+//===--------------------------------------------------------------------===//
 unique_ptr<GlobalSourceState> PaimonUpdate::GetGlobalSourceState(ClientContext &context) const {
-	return make_uniq<PaimonUpdateSourceState>(*this);
+	return make_uniq<GlobalSourceState>();
 }
 
 SourceResultType PaimonUpdate::GetData(ExecutionContext &context, DataChunk &chunk, OperatorSourceInput &input) const {
-	auto &state = input.global_state->Cast<PaimonUpdateSourceState>();
-
-	if (finished) {
-		return SourceResultType::FINISHED;
-	}
-
 	auto &global_state = sink_state->Cast<PaimonUpdateGlobalState>();
-
-	if (return_chunk) {
-		global_state.return_collection.Reset();
-		DataChunk return_chunk;
-		global_state.return_collection.FetchChunk(0, return_chunk);
-		chunk.Reference(return_chunk);
-	}
-
-	finished = true;
-	return SourceResultType::HAVE_MORE_OUTPUT;
+	chunk.SetCardinality(1);
+	chunk.SetValue(0, 0, Value::BIGINT(NumericCast<int64_t>(global_state.update_count.load())));
+	return SourceResultType::FINISHED;
 }
 
 //===--------------------------------------------------------------------===//